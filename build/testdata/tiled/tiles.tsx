@@ -0,0 +1 @@
+<tileset name="test" tilewidth="32" tileheight="32" tilecount="1" columns="1"><image width="32" height="32"><!-- source="tiles.png" --></image></tileset>
\ No newline at end of file
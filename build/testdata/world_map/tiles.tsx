@@ -0,0 +1 @@
+<tileset name="test" tilewidth="32" tileheight="32" tilecount="1" columns="1"><image source="tiles.png" width="32" height="32"/><tile id="0"><properties><property name="collider" value="[1111],[1111],[1111],[1111]"/></properties></tile></tileset>
\ No newline at end of file
@@ -0,0 +1,217 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "engine/core/jobs/jobs.h"
+#include "engine/core/logger/logger.h"
+#include "engine/utils/atomics.h"
+
+#include <stdint.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+typedef HANDLE             jobs_thread_t;
+typedef CRITICAL_SECTION   jobs_mutex_t;
+typedef CONDITION_VARIABLE jobs_cond_t;
+#else
+#include <pthread.h>
+#include <unistd.h>
+typedef pthread_t          jobs_thread_t;
+typedef pthread_mutex_t    jobs_mutex_t;
+typedef pthread_cond_t     jobs_cond_t;
+#endif
+
+typedef struct {
+    jobs_range_fn fn;
+    void* ctx;
+    int count;
+    int grain;
+} jobs_loop_t;
+
+static jobs_thread_t g_threads[JOBS_MAX_WORKERS];
+static int           g_worker_count = 0;
+static jobs_mutex_t  g_mutex;
+static jobs_cond_t   g_wake;
+static jobs_cond_t   g_done;
+static bool          g_quit = false;
+static unsigned      g_generation = 0; // bumped per loop; workers wait for a change
+static jobs_loop_t   g_loop;
+static atomics_int_t g_next_chunk = 0; // claimed with atomic adds
+static int           g_busy = 0;       // workers still inside the current loop
+
+// ---- Platform shims ------------------------------------------------------------
+#if defined(_WIN32)
+static void jobs_mutex_init(jobs_mutex_t* m) { InitializeCriticalSection(m); }
+static void jobs_mutex_destroy(jobs_mutex_t* m) { DeleteCriticalSection(m); }
+static void jobs_lock(jobs_mutex_t* m) { EnterCriticalSection(m); }
+static void jobs_unlock(jobs_mutex_t* m) { LeaveCriticalSection(m); }
+static void jobs_cond_init(jobs_cond_t* c) { InitializeConditionVariable(c); }
+static void jobs_cond_destroy(jobs_cond_t* c) { (void)c; }
+static void jobs_cond_wait(jobs_cond_t* c, jobs_mutex_t* m) { SleepConditionVariableCS(c, m, INFINITE); }
+static void jobs_cond_signal(jobs_cond_t* c) { WakeConditionVariable(c); }
+static void jobs_cond_broadcast(jobs_cond_t* c) { WakeAllConditionVariable(c); }
+
+static int jobs_core_count(void)
+{
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+}
+#else
+static void jobs_mutex_init(jobs_mutex_t* m) { pthread_mutex_init(m, NULL); }
+static void jobs_mutex_destroy(jobs_mutex_t* m) { pthread_mutex_destroy(m); }
+static void jobs_lock(jobs_mutex_t* m) { pthread_mutex_lock(m); }
+static void jobs_unlock(jobs_mutex_t* m) { pthread_mutex_unlock(m); }
+static void jobs_cond_init(jobs_cond_t* c) { pthread_cond_init(c, NULL); }
+static void jobs_cond_destroy(jobs_cond_t* c) { pthread_cond_destroy(c); }
+static void jobs_cond_wait(jobs_cond_t* c, jobs_mutex_t* m) { pthread_cond_wait(c, m); }
+static void jobs_cond_signal(jobs_cond_t* c) { pthread_cond_signal(c); }
+static void jobs_cond_broadcast(jobs_cond_t* c) { pthread_cond_broadcast(c); }
+
+static int jobs_core_count(void)
+{
+    const long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return (n > 0) ? (int)n : 1;
+}
+#endif
+
+// ---- Loop execution ------------------------------------------------------------
+static void jobs_run_chunks(const jobs_loop_t* loop, int worker)
+{
+    for (;;) {
+        const int chunk = atomics_fetch_add(&g_next_chunk, 1);
+        if (chunk >= (loop->count + loop->grain - 1) / loop->grain) return;
+        const int begin = chunk * loop->grain;
+        const int end = (begin + loop->grain < loop->count) ? begin + loop->grain : loop->count;
+        loop->fn(loop->ctx, begin, end, worker);
+    }
+}
+
+static void jobs_worker_main(int worker)
+{
+    unsigned seen = 0;
+    jobs_lock(&g_mutex);
+    for (;;) {
+        while (!g_quit && g_generation == seen) jobs_cond_wait(&g_wake, &g_mutex);
+        if (g_quit) break;
+        seen = g_generation;
+        const jobs_loop_t loop = g_loop;
+        jobs_unlock(&g_mutex);
+
+        jobs_run_chunks(&loop, worker);
+
+        jobs_lock(&g_mutex);
+        if (--g_busy == 0) jobs_cond_signal(&g_done);
+    }
+    jobs_unlock(&g_mutex);
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI jobs_thread_entry(LPVOID arg)
+{
+    jobs_worker_main((int)(INT_PTR)arg);
+    return 0;
+}
+
+static bool jobs_thread_start(jobs_thread_t* t, int worker)
+{
+    *t = CreateThread(NULL, 0, jobs_thread_entry, (LPVOID)(INT_PTR)worker, 0, NULL);
+    return *t != NULL;
+}
+
+static void jobs_thread_join(jobs_thread_t t)
+{
+    WaitForSingleObject(t, INFINITE);
+    CloseHandle(t);
+}
+#else
+static void* jobs_thread_entry(void* arg)
+{
+    jobs_worker_main((int)(intptr_t)arg);
+    return NULL;
+}
+
+static bool jobs_thread_start(jobs_thread_t* t, int worker)
+{
+    return pthread_create(t, NULL, jobs_thread_entry, (void*)(intptr_t)worker) == 0;
+}
+
+static void jobs_thread_join(jobs_thread_t t)
+{
+    pthread_join(t, NULL);
+}
+#endif
+
+// ---- Public API ----------------------------------------------------------------
+bool jobs_init(int workers)
+{
+    jobs_shutdown();
+    if (workers < 0) workers = jobs_core_count() - 1;
+    if (workers > JOBS_MAX_WORKERS) workers = JOBS_MAX_WORKERS;
+    if (workers <= 0) return true;
+
+    jobs_mutex_init(&g_mutex);
+    jobs_cond_init(&g_wake);
+    jobs_cond_init(&g_done);
+    g_quit = false;
+    g_generation = 0;
+    for (int i = 0; i < workers; ++i) {
+        if (!jobs_thread_start(&g_threads[i], i + 1)) {
+            LOGC(LOGCAT_MAIN, LOG_LVL_WARN, "jobs: started %d of %d workers", i, workers);
+            break;
+        }
+        g_worker_count = i + 1;
+    }
+    if (g_worker_count == 0) {
+        jobs_cond_destroy(&g_done);
+        jobs_cond_destroy(&g_wake);
+        jobs_mutex_destroy(&g_mutex);
+        return false;
+    }
+    LOGC(LOGCAT_MAIN, LOG_LVL_INFO, "jobs: %d worker threads", g_worker_count);
+    return true;
+}
+
+void jobs_shutdown(void)
+{
+    if (g_worker_count == 0) return;
+    jobs_lock(&g_mutex);
+    g_quit = true;
+    jobs_cond_broadcast(&g_wake);
+    jobs_unlock(&g_mutex);
+    for (int i = 0; i < g_worker_count; ++i) jobs_thread_join(g_threads[i]);
+    g_worker_count = 0;
+    jobs_cond_destroy(&g_done);
+    jobs_cond_destroy(&g_wake);
+    jobs_mutex_destroy(&g_mutex);
+}
+
+int jobs_worker_count(void)
+{
+    return g_worker_count;
+}
+
+void jobs_parallel_for(int count, int grain, jobs_range_fn fn, void* ctx)
+{
+    if (!fn || count <= 0) return;
+    if (grain < 1) grain = 1;
+    if (g_worker_count == 0 || count <= grain) {
+        fn(ctx, 0, count, 0);
+        return;
+    }
+
+    jobs_lock(&g_mutex);
+    g_loop = (jobs_loop_t){ .fn = fn, .ctx = ctx, .count = count, .grain = grain };
+    g_next_chunk = 0;
+    g_busy = g_worker_count;
+    g_generation++;
+    jobs_cond_broadcast(&g_wake);
+    jobs_unlock(&g_mutex);
+
+    const jobs_loop_t loop = { .fn = fn, .ctx = ctx, .count = count, .grain = grain };
+    jobs_run_chunks(&loop, 0);
+
+    jobs_lock(&g_mutex);
+    while (g_busy > 0) jobs_cond_wait(&g_done, &g_mutex);
+    jobs_unlock(&g_mutex);
+}
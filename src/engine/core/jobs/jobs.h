@@ -0,0 +1,24 @@
+#pragma once
+#include <stdbool.h>
+
+// Fixed pool of worker threads for data-parallel loops. The calling thread
+// always takes part, so a pool of N workers runs N + 1 chunks at a time.
+#define JOBS_MAX_WORKERS 15
+// Pass to jobs_init for one worker per core beyond the calling thread.
+#define JOBS_AUTO (-1)
+
+// `worker` is 0 on the calling thread and 1..jobs_worker_count() on pool
+// threads; use it to index per-worker scratch.
+typedef void (*jobs_range_fn)(void* ctx, int begin, int end, int worker);
+
+// Starts the pool (clamped to JOBS_MAX_WORKERS). Zero workers keeps every
+// loop on the calling thread. Returns false if no thread could be started.
+bool jobs_init(int workers);
+void jobs_shutdown(void);
+int  jobs_worker_count(void);
+
+// Runs fn over [0, count) in chunks of `grain` items and returns once all of
+// them are done. Chunks may run in any order on any thread, so fn must only
+// write data owned by its range. Runs inline when the pool is empty or the
+// loop fits in one chunk. Not reentrant.
+void jobs_parallel_for(int count, int grain, jobs_range_fn fn, void* ctx);
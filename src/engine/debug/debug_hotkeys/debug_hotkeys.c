@@ -17,7 +17,6 @@
 #include "engine/world/world_query.h"
 #include "engine/engine/engine_scheduler/engine_scheduler.h"
 #include "engine/core/platform/platform.h"
-#include <inttypes.h>
 #include <math.h>
 #include <stdio.h>
 
@@ -98,20 +97,20 @@ void sys_debug_binds(const input_t* in)
 
         int best = -1;
         float best_d2 = 0.0f;
-        for (int i = 0; i < ECS_MAX_ENTITIES; ++i) {
+        for (int i = 0; i < ecs_capacity(); ++i) {
             if (!ecs_alive_idx(i)) continue;
             ComponentMask mask = ecs_mask[i];
-            if ((mask & CMP_POS) == 0) continue;
+            if (!component_mask_any(mask, CMP_POS)) continue;
 
             float cx = cmp_pos[i].x;
             float cy = cmp_pos[i].y;
             float hx = 8.0f;
             float hy = 8.0f;
 
-            if (mask & CMP_COL) {
+            if (component_mask_any(mask, CMP_COL)) {
                 if (cmp_col[i].hx > 0.0f) hx = cmp_col[i].hx;
                 if (cmp_col[i].hy > 0.0f) hy = cmp_col[i].hy;
-            } else if (mask & CMP_SPR) {
+            } else if (component_mask_any(mask, CMP_SPR)) {
                 float w = fabsf(cmp_spr[i].src.w);
                 float h = fabsf(cmp_spr[i].src.h);
                 if (w > 0.0f) hx = w * 0.5f;
@@ -135,14 +134,14 @@ void sys_debug_binds(const input_t* in)
         if (best >= 0) {
             ecs_entity_t h = handle_from_index(best);
             ComponentMask mask = ecs_mask[best];
+            char mask_hex[COMPONENT_MASK_HEX_LEN];
             LOGC(LOGCAT_ECS, LOG_LVL_INFO,
-                 "[inspect] entity=%u gen=%u mask=0x%016" PRIX64 " pos=(%.1f, %.1f) click_world=(%.1f, %.1f)",
-                 h.idx, h.gen, (uint64_t)mask, cmp_pos[best].x, cmp_pos[best].y, world_x, world_y);
+                 "[inspect] entity=%u gen=%u mask=0x%s pos=(%.1f, %.1f) click_world=(%.1f, %.1f)",
+                 h.idx, h.gen, component_mask_to_hex(mask, mask_hex), cmp_pos[best].x, cmp_pos[best].y, world_x, world_y);
 
             const char* cmp_indent = "  ";
             for (int comp = 0; comp < ENUM_COMPONENT_COUNT; ++comp) {
-                ComponentMask bit = 1ull << comp;
-                if ((mask & bit) == 0) continue;
+                if (!component_mask_has(mask, comp)) continue;
                 char info[256];
                 if (debug_str_component((ComponentEnum)comp, h, info, sizeof(info))) {
                     LOGC(LOGCAT_ECS, LOG_LVL_INFO, "%s%s", cmp_indent, info);
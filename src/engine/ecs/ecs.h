@@ -8,7 +8,13 @@
 #define MAX_ANIMS  16
 
 // ====== Public constants / types ======
-#define ECS_MAX_ENTITIES 1024
+// Entity storage grows in whole chunks; component pointers obtained from the
+// global arrays are only valid until the next ecs_create()/ecs_reserve().
+#define ECS_CHUNK_ENTITIES 1024
+#ifndef ECS_INITIAL_CAPACITY
+#define ECS_INITIAL_CAPACITY ECS_CHUNK_ENTITIES
+#endif
+#define ECS_MAX_CAPACITY (1 << 20)
 
 typedef struct {
     uint32_t idx;
@@ -51,6 +57,8 @@ typedef enum {
 // ====== Lifecycle / config ======
 void ecs_init(void);
 void ecs_shutdown(void);
+int  ecs_capacity(void);
+bool ecs_reserve(int capacity); // rounds up to a chunk multiple, never shrinks
 bool ecs_get_position(ecs_entity_t e, gfx_vec2* out_pos);
 
 // ====== Entity / components ======
@@ -190,7 +190,7 @@ void cmp_add_anim(
         a->frame_index     = 0;
         a->current_time    = 0.0f;
         a->frame_duration  = (fps > 0.0f) ? (1.0f / fps) : 0.1f;
-        ecs_mask[i] |= CMP_ANIM;
+        ecs_mask_add(i, CMP_ANIM);
         return;
     }
 
@@ -234,7 +234,7 @@ void cmp_add_anim(
     a->current_time  = 0.0f;
     a->frame_duration = (fps > 0.0f) ? (1.0f / fps) : 0.1f;
 
-    ecs_mask[i] |= CMP_ANIM;
+    ecs_mask_add(i, CMP_ANIM);
 
     // Cache definition for future reuse (best-effort).
     if (g_anim_defs_count == g_anim_defs_cap) {
@@ -260,13 +260,105 @@ void cmp_add_anim(
     }
 }
 
+// ===== Snapshot =====
+// cmp_anim tables point into the arena, so the used arena bytes travel with
+// the snapshot and every pointer is written as an arena offset.
+#define ANIM_SNAPSHOT_NULL UINT32_MAX
+
+static uint32_t anim_arena_offset(const void* p)
+{
+    if (!p) return ANIM_SNAPSHOT_NULL;
+    return (uint32_t)((const uint8_t*)p - g_anim_arena.data);
+}
+
+static const void* anim_arena_ptr(uint32_t off, size_t used)
+{
+    if (off == ANIM_SNAPSHOT_NULL || off >= used) return NULL;
+    return g_anim_arena.data + off;
+}
+
+static void ecs_anim_snapshot_save(byte_buf_t* out)
+{
+    const size_t used = g_anim_arena.data ? g_anim_arena.offset : 0;
+    byte_buf_write_u32(out, (uint32_t)used);
+    byte_buf_write(out, g_anim_arena.data, used);
+
+    byte_buf_write_u32(out, (uint32_t)g_anim_defs_count);
+    for (size_t di = 0; di < g_anim_defs_count; ++di) {
+        const anim_def_entry_t* def = &g_anim_defs[di];
+        byte_buf_write(out, def, sizeof(*def));
+        byte_buf_write_u32(out, anim_arena_offset(def->frames_per_anim));
+        byte_buf_write_u32(out, anim_arena_offset(def->anim_offsets));
+        byte_buf_write_u32(out, anim_arena_offset(def->frames));
+    }
+
+    const int cap = ecs_capacity();
+    for (int i = 0; i < cap; ++i) {
+        if (!ecs_alive_idx(i) || !component_mask_any(ecs_mask[i], CMP_ANIM)) continue;
+        byte_buf_write_u32(out, (uint32_t)i);
+        byte_buf_write_u32(out, anim_arena_offset(cmp_anim[i].frames_per_anim));
+        byte_buf_write_u32(out, anim_arena_offset(cmp_anim[i].anim_offsets));
+        byte_buf_write_u32(out, anim_arena_offset(cmp_anim[i].frames));
+    }
+    byte_buf_write_u32(out, UINT32_MAX);
+}
+
+static bool ecs_anim_snapshot_load(byte_reader_t* in)
+{
+    const uint32_t used = byte_reader_u32(in);
+    const void* bytes = byte_reader_view(in, used);
+    if (!in->ok) return false;
+    if (!g_anim_arena.data && !bump_init(&g_anim_arena, ANIM_ARENA_BYTES)) return false;
+    if (used > g_anim_arena.capacity) {
+        LOGC(LOGCAT_ECS, LOG_LVL_ERROR, "anim: snapshot arena (%u bytes) exceeds capacity=%zu", used, g_anim_arena.capacity);
+        return false;
+    }
+    bump_reset(&g_anim_arena);
+    if (used > 0) memcpy(g_anim_arena.data, bytes, used);
+    g_anim_arena.offset = used;
+
+    // Defs are only a dedup cache; dropping any we can't hold is harmless.
+    const uint32_t def_count = byte_reader_u32(in);
+    g_anim_defs_count = 0;
+    if (def_count > g_anim_defs_cap) {
+        anim_def_entry_t* tmp = (anim_def_entry_t*)realloc(g_anim_defs, def_count * sizeof(*g_anim_defs));
+        if (tmp) {
+            g_anim_defs = tmp;
+            g_anim_defs_cap = def_count;
+        }
+    }
+    for (uint32_t di = 0; di < def_count && in->ok; ++di) {
+        anim_def_entry_t def;
+        byte_reader_read(in, &def, sizeof(def));
+        def.frames_per_anim = anim_arena_ptr(byte_reader_u32(in), used);
+        def.anim_offsets = anim_arena_ptr(byte_reader_u32(in), used);
+        def.frames = anim_arena_ptr(byte_reader_u32(in), used);
+        if (g_anim_defs_count < g_anim_defs_cap) g_anim_defs[g_anim_defs_count++] = def;
+    }
+
+    const int cap = ecs_capacity();
+    for (uint32_t idx = byte_reader_u32(in); in->ok && idx != UINT32_MAX; idx = byte_reader_u32(in)) {
+        if (idx >= (uint32_t)cap) return false;
+        cmp_anim_t* a = &cmp_anim[idx];
+        a->frames_per_anim = anim_arena_ptr(byte_reader_u32(in), used);
+        a->anim_offsets = anim_arena_ptr(byte_reader_u32(in), used);
+        a->frames = anim_arena_ptr(byte_reader_u32(in), used);
+    }
+    return in->ok;
+}
+
+void ecs_register_anim_component_hooks(void)
+{
+    ecs_register_component_snapshot_hooks(ENUM_ANIM, (ecs_snapshot_hooks_t){
+        .save = ecs_anim_snapshot_save,
+        .load = ecs_anim_snapshot_load,
+    });
+}
+
 static void sys_anim_sprite_impl(float dt)
 {
-    for (int i = 0; i < ECS_MAX_ENTITIES; ++i)
+    ECS_QUERY_EACH(ecs_query_get(CMP_SET(CMP_SPR, CMP_ANIM), CMP_NONE), i)
     {
-        if (!ecs_alive_idx(i)) continue;
-        if ((ecs_mask[i] & (CMP_SPR | CMP_ANIM)) != (CMP_SPR | CMP_ANIM)) continue;
-
         cmp_anim_t*   a = &cmp_anim[i];
         cmp_sprite_t* s = &cmp_spr[i];
 
@@ -294,7 +386,11 @@ static void sys_anim_sprite_impl(float dt)
         int x = fc.col * frame_w;
         int y = fc.row * frame_h;
 
-        s->src = gfx_rect_xywh((float)x, (float)y, (float)frame_w, (float)frame_h);
+        gfx_rect src = gfx_rect_xywh((float)x, (float)y, (float)frame_w, (float)frame_h);
+        if (s->src.x != src.x || s->src.y != src.y || s->src.w != src.w || s->src.h != src.h) {
+            s->src = src;
+            ecs_mark_changed(i, CMP_SPR);
+        }
     }
 }
 
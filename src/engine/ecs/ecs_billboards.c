@@ -35,19 +35,18 @@ static bool billboard_filters_pass(int trigger_idx, int matched_idx)
 static void sys_billboards_impl(float dt)
 {
     (void)dt;
-    for (int i = 0; i < ECS_MAX_ENTITIES; ++i) {
-        if (!ecs_alive_idx(i) || !(ecs_mask[i] & CMP_BILLBOARD)) continue;
+    ECS_QUERY_EACH(ecs_query_get(CMP_BILLBOARD, CMP_NONE), i) {
         cmp_billboard[i].state = BILLBOARD_INACTIVE;
         cmp_billboard[i].timer = 0.0f;
     }
 
-    ecs_prox_iter_t it = ecs_prox_stay_begin();
+    ecs_prox_iter_t it = ecs_prox_stay_begin_for(CMP_BILLBOARD);
     ecs_prox_view_t v;
     while (ecs_prox_stay_next(&it, &v)) {
         int trigger_idx = ent_index_checked(v.trigger_owner);
         int matched_idx = ent_index_checked(v.matched_entity);
         if (trigger_idx < 0 || matched_idx < 0) continue;
-        if ((ecs_mask[trigger_idx] & CMP_BILLBOARD) == 0) continue;
+        if (!component_mask_any(ecs_mask[trigger_idx], CMP_BILLBOARD)) continue;
         if (!billboard_filters_pass(trigger_idx, matched_idx)) continue;
 
         cmp_billboard[trigger_idx].state = BILLBOARD_ACTIVE;
@@ -0,0 +1,203 @@
+//==== FROM ecs_change.c ====
+#include "engine/ecs/ecs_change.h"
+#include "engine/ecs/ecs_core.h"
+#include "engine/core/logger/logger.h"
+
+#include <string.h>
+
+typedef struct {
+    int idx;
+    ecs_version_t v;
+} change_entry_t;
+
+// `log` is ordered by version. An entry is live while stamp[idx] still equals
+// its version; superseded entries are dropped between systems.
+typedef struct {
+    bool tracked;
+    ecs_version_t* stamp;
+    DA(change_entry_t) log;
+    size_t superseded;
+} change_track_t;
+
+static change_track_t g_tracks[ENUM_COMPONENT_COUNT];
+static ComponentMask  g_tracked_mask;
+static ecs_version_t  g_version = 1;
+
+void ecs_track_changes(ComponentEnum comp)
+{
+    if (comp < 0 || comp >= ENUM_COMPONENT_COUNT) return;
+    change_track_t* t = &g_tracks[comp];
+    if (t->tracked) return;
+    ecs_register_storage((void**)&t->stamp, sizeof(*t->stamp));
+    if (!t->stamp) return;
+    t->tracked = true;
+    component_mask_set(&g_tracked_mask, comp);
+}
+
+bool ecs_change_tracked(ComponentEnum comp)
+{
+    return comp >= 0 && comp < ENUM_COMPONENT_COUNT && g_tracks[comp].tracked;
+}
+
+ecs_version_t ecs_change_version(void)
+{
+    return g_version;
+}
+
+static void change_compact(change_track_t* t)
+{
+    size_t out = 0;
+    for (size_t i = 0; i < t->log.size; ++i) {
+        change_entry_t e = t->log.data[i];
+        if (t->stamp[e.idx] != e.v) continue;
+        t->log.data[out++] = e;
+    }
+    t->log.size = out;
+    t->superseded = 0;
+}
+
+void ecs_change_advance(void)
+{
+    ComponentMask bits = g_tracked_mask;
+    for (int comp; (comp = component_mask_pop_lowest(&bits)) >= 0;) {
+        change_track_t* t = &g_tracks[comp];
+        if (t->superseded > 32 && t->superseded * 2 > t->log.size) {
+            change_compact(t);
+        }
+    }
+    ++g_version;
+    if (g_version == 0) {
+        LOGC(LOGCAT_ECS, LOG_LVL_WARN, "ecs: change version wrapped");
+        g_version = 1;
+    }
+}
+
+void ecs_mark_changed(int idx, ComponentMask bits)
+{
+    bits = component_mask_and(bits, g_tracked_mask);
+    for (int comp; (comp = component_mask_pop_lowest(&bits)) >= 0;) {
+        change_track_t* t = &g_tracks[comp];
+        ecs_version_t old = t->stamp[idx];
+        if (old == g_version) continue;
+        if (old != 0) t->superseded++;
+        t->stamp[idx] = g_version;
+        DA_APPEND(&t->log, ((change_entry_t){ .idx = idx, .v = g_version }));
+    }
+}
+
+ecs_version_t ecs_changed_version(int idx, ComponentEnum comp)
+{
+    if (!ecs_change_tracked(comp) || idx < 0 || idx >= ecs_capacity()) return 0;
+    return g_tracks[comp].stamp[idx];
+}
+
+ecs_changed_iter_t ecs_changed_begin(ComponentEnum comp, ecs_version_t since)
+{
+    ecs_changed_iter_t it = { .comp = comp, .since = since, .pos = 0 };
+    if (!ecs_change_tracked(comp)) {
+        LOGC(LOGCAT_ECS, LOG_LVL_WARN, "ecs: changes of %s are not tracked", component_name_from_id(comp));
+        return it;
+    }
+    const change_track_t* t = &g_tracks[comp];
+    size_t lo = 0;
+    size_t hi = t->log.size;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (t->log.data[mid].v <= since) lo = mid + 1;
+        else hi = mid;
+    }
+    it.pos = lo;
+    return it;
+}
+
+bool ecs_changed_next(ecs_changed_iter_t* it, int* out_idx)
+{
+    if (!ecs_change_tracked(it->comp)) return false;
+    const change_track_t* t = &g_tracks[it->comp];
+    while (it->pos < t->log.size) {
+        change_entry_t e = t->log.data[it->pos++];
+        if (t->stamp[e.idx] != e.v) continue;
+        if (!ecs_alive_idx(e.idx)) continue;
+        *out_idx = e.idx;
+        return true;
+    }
+    return false;
+}
+
+void ecs_change_on_destroy(int idx)
+{
+    ComponentMask bits = g_tracked_mask;
+    for (int comp; (comp = component_mask_pop_lowest(&bits)) >= 0;) {
+        change_track_t* t = &g_tracks[comp];
+        ecs_version_t old = t->stamp[idx];
+        if (old == 0) continue;
+        t->stamp[idx] = 0;
+        if (old != g_version) {
+            t->superseded++;
+            continue;
+        }
+        // Stamped this version: drop the entry now so a reuse of the slot
+        // within the same version can't make it look live twice.
+        for (size_t i = t->log.size; i-- > 0 && t->log.data[i].v == g_version;) {
+            if (t->log.data[i].idx != idx) continue;
+            memmove(t->log.data + i, t->log.data + i + 1, sizeof(change_entry_t) * (t->log.size - i - 1));
+            t->log.size--;
+            break;
+        }
+    }
+}
+
+void ecs_change_on_restore(void)
+{
+    // Restored stamps refer to the saver's log; treat every live tracked
+    // component as written in the current version instead.
+    const int cap = ecs_capacity();
+    ComponentMask bits = g_tracked_mask;
+    for (int comp; (comp = component_mask_pop_lowest(&bits)) >= 0;) {
+        change_track_t* t = &g_tracks[comp];
+        memset(t->stamp, 0, sizeof(*t->stamp) * (size_t)cap);
+        t->log.size = 0;
+        t->superseded = 0;
+    }
+    for (int i = 0; i < cap; ++i) {
+        if (!ecs_alive_idx(i)) continue;
+        ecs_mark_changed(i, ecs_mask[i]);
+    }
+}
+
+void ecs_change_on_compact(const int* new_of_old)
+{
+    // Stamps are registered storage and were permuted with the entities;
+    // only the logs hold indices. Moved entities are also re-stamped so
+    // anything caching per-index data sees them as changed.
+    ComponentMask bits = g_tracked_mask;
+    for (int comp; (comp = component_mask_pop_lowest(&bits)) >= 0;) {
+        change_track_t* t = &g_tracks[comp];
+        size_t out = 0;
+        for (size_t i = 0; i < t->log.size; ++i) {
+            change_entry_t e = t->log.data[i];
+            e.idx = new_of_old[e.idx];
+            if (e.idx < 0) continue;
+            t->log.data[out++] = e;
+        }
+        t->log.size = out;
+    }
+    const int cap = ecs_capacity();
+    for (int i = 0; i < cap; ++i) {
+        const int k = new_of_old[i];
+        if (k < 0 || k == i) continue;
+        ecs_mark_changed(k, ecs_mask[k]);
+    }
+}
+
+void ecs_change_reset_all(void)
+{
+    // Stamp arrays are registered storage; ecs_core frees those.
+    for (int comp = 0; comp < ENUM_COMPONENT_COUNT; ++comp) {
+        DA_FREE(&g_tracks[comp].log);
+        g_tracks[comp].tracked = false;
+        g_tracks[comp].superseded = 0;
+    }
+    g_tracked_mask = CMP_NONE;
+    g_version = 1;
+}
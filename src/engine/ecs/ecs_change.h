@@ -0,0 +1,46 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include "engine/ecs/ecs.h"
+#include "engine/utils/dynarray.h"
+
+// Per-component change tracking. Opted-in components keep a write version
+// per entity; the scheduler advances the global version before every system
+// it runs, so a system that remembers ecs_change_version() at the end of its
+// pass can later ask for exactly what other systems touched since.
+//
+// Adding or removing a tracked component stamps it automatically (check
+// ecs_mask to tell the two apart). Writes through the SoA arrays must call
+// ecs_mark_changed() themselves.
+typedef uint32_t ecs_version_t;
+
+void          ecs_track_changes(ComponentEnum comp);   // after ecs_init()
+bool          ecs_change_tracked(ComponentEnum comp);
+ecs_version_t ecs_change_version(void);
+void          ecs_change_advance(void);
+
+void          ecs_mark_changed(int idx, ComponentMask bits);
+ecs_version_t ecs_changed_version(int idx, ComponentEnum comp);   // 0 = never
+
+// Yields each live entity whose `comp` stamp is newer than `since`, once,
+// in the order of its latest change.
+typedef struct {
+    ComponentEnum comp;
+    ecs_version_t since;
+    size_t pos;
+} ecs_changed_iter_t;
+
+ecs_changed_iter_t ecs_changed_begin(ComponentEnum comp, ecs_version_t since);
+bool               ecs_changed_next(ecs_changed_iter_t* it, int* out_idx);
+
+#define ECS_CHANGED_EACH(comp, since, idx) \
+    for (ecs_changed_iter_t idx##_cit = ecs_changed_begin((comp), (since)); idx##_cit.pos != (size_t)-1; idx##_cit.pos = (size_t)-1) \
+        for (int idx; ecs_changed_next(&idx##_cit, &idx);)
+
+// ===== Internal: driven by ecs_core =====
+void ecs_change_on_destroy(int idx);
+// After a snapshot restore: drop history, mark every live tracked component changed.
+void ecs_change_on_restore(void);
+// After ecs_compact: rewrite logged indices (-1 = not live) and mark moved entities changed.
+void ecs_change_on_compact(const int* new_of_old);
+void ecs_change_reset_all(void);
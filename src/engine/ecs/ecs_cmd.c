@@ -0,0 +1,108 @@
+//==== FROM ecs_cmd.c ====
+#include "engine/ecs/ecs_cmd.h"
+#include "engine/ecs/ecs_core.h"
+#include "engine/core/logger/logger.h"
+
+// Playback can record follow-up commands (spawn callbacks, destroy hooks);
+// bound the number of rounds so a command that re-records itself can't spin.
+#define ECS_CMD_MAX_ROUNDS 16
+
+static ecs_cmd_buffer_t g_cmd_buffers[ECS_CMD_MAX_WORKERS];
+
+ecs_cmd_buffer_t* ecs_cmd_for_worker(int worker)
+{
+    if (worker < 0 || worker >= ECS_CMD_MAX_WORKERS) {
+        LOGC(LOGCAT_ECS, LOG_LVL_ERROR, "ecs_cmd: invalid worker %d (max=%d)", worker, ECS_CMD_MAX_WORKERS);
+        return NULL;
+    }
+    return &g_cmd_buffers[worker];
+}
+
+ecs_cmd_buffer_t* ecs_cmd_current(void)
+{
+    return &g_cmd_buffers[0];
+}
+
+static void cmd_push(ecs_cmd_buffer_t* buf, ecs_cmd_t cmd)
+{
+    if (!buf) return;
+    DA_APPEND(&buf->cmds, cmd);
+}
+
+void ecs_cmd_create(ecs_cmd_buffer_t* buf, ecs_cmd_spawn_fn spawn, void* user)
+{
+    cmd_push(buf, (ecs_cmd_t){ .kind = ECS_CMD_CREATE, .e = ecs_null(), .spawn = spawn, .user = user });
+}
+
+void ecs_cmd_destroy(ecs_cmd_buffer_t* buf, ecs_entity_t e)
+{
+    cmd_push(buf, (ecs_cmd_t){ .kind = ECS_CMD_DESTROY, .e = e });
+}
+
+void ecs_cmd_add(ecs_cmd_buffer_t* buf, ecs_entity_t e, ComponentMask bits)
+{
+    if (component_mask_empty(bits)) return;
+    cmd_push(buf, (ecs_cmd_t){ .kind = ECS_CMD_ADD, .e = e, .bits = bits });
+}
+
+void ecs_cmd_remove(ecs_cmd_buffer_t* buf, ecs_entity_t e, ComponentMask bits)
+{
+    if (component_mask_empty(bits)) return;
+    cmd_push(buf, (ecs_cmd_t){ .kind = ECS_CMD_REMOVE, .e = e, .bits = bits });
+}
+
+bool ecs_cmd_pending(void)
+{
+    for (int w = 0; w < ECS_CMD_MAX_WORKERS; ++w) {
+        if (g_cmd_buffers[w].cmds.size > 0) return true;
+    }
+    return false;
+}
+
+static void cmd_apply(const ecs_cmd_t* cmd)
+{
+    if (cmd->kind == ECS_CMD_CREATE) {
+        ecs_entity_t e = ecs_create();
+        if (cmd->spawn && ecs_alive_handle(e)) cmd->spawn(e, cmd->user);
+        return;
+    }
+
+    int idx = ent_index_checked(cmd->e);
+    if (idx < 0) return;
+    switch (cmd->kind) {
+    case ECS_CMD_DESTROY: ecs_destroy(cmd->e); break;
+    case ECS_CMD_ADD:     ecs_mask_add(idx, cmd->bits); break;
+    case ECS_CMD_REMOVE:  ecs_mask_remove(idx, cmd->bits); break;
+    default: break;
+    }
+}
+
+void ecs_cmd_flush(void)
+{
+    for (int round = 0; round < ECS_CMD_MAX_ROUNDS && ecs_cmd_pending(); ++round) {
+        for (int w = 0; w < ECS_CMD_MAX_WORKERS; ++w) {
+            ecs_cmd_buffer_t* buf = &g_cmd_buffers[w];
+            // Commands recorded during playback land after `n` and wait for
+            // the next round, keeping this round's order stable.
+            size_t n = buf->cmds.size;
+            if (n == 0) continue;
+            for (size_t i = 0; i < n; ++i) {
+                ecs_cmd_t cmd = buf->cmds.data[i];
+                cmd_apply(&cmd);
+            }
+            size_t rest = buf->cmds.size - n;
+            memmove(buf->cmds.data, buf->cmds.data + n, rest * sizeof(ecs_cmd_t));
+            buf->cmds.size = rest;
+        }
+    }
+    if (ecs_cmd_pending()) {
+        LOGC(LOGCAT_ECS, LOG_LVL_WARN, "ecs_cmd: commands still pending after %d playback rounds", ECS_CMD_MAX_ROUNDS);
+    }
+}
+
+void ecs_cmd_reset_all(void)
+{
+    for (int w = 0; w < ECS_CMD_MAX_WORKERS; ++w) {
+        DA_FREE(&g_cmd_buffers[w].cmds);
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <stdbool.h>
+#include "engine/ecs/ecs.h"
+#include "engine/core/jobs/jobs.h"
+#include "engine/utils/dynarray.h"
+
+// Deferred structural changes. Systems record create/destroy/add/remove here
+// instead of touching ecs_mask mid-iteration; the scheduler plays every
+// buffer back at the end of each phase (ecs_cmd_flush).
+//
+// Playback order is fixed: worker 0's buffer first, then 1, 2, ... and each
+// buffer in record order, so results do not depend on which worker finished
+// first. Handles that went stale before playback are skipped.
+// One buffer per jobs worker id: the calling thread (0) plus the pool.
+#define ECS_CMD_MAX_WORKERS (JOBS_MAX_WORKERS + 1)
+
+typedef void (*ecs_cmd_spawn_fn)(ecs_entity_t e, void* user);
+
+typedef enum {
+    ECS_CMD_CREATE = 0,
+    ECS_CMD_DESTROY,
+    ECS_CMD_ADD,
+    ECS_CMD_REMOVE
+} ecs_cmd_kind_t;
+
+typedef struct {
+    ecs_cmd_kind_t kind;
+    ecs_entity_t e;
+    ComponentMask bits;
+    ecs_cmd_spawn_fn spawn;
+    void* user;
+} ecs_cmd_t;
+
+typedef struct {
+    DA(ecs_cmd_t) cmds;
+} ecs_cmd_buffer_t;
+
+// Buffer owned by `worker` (0..ECS_CMD_MAX_WORKERS-1). Single-threaded code
+// uses ecs_cmd_current(), which is worker 0.
+ecs_cmd_buffer_t* ecs_cmd_for_worker(int worker);
+ecs_cmd_buffer_t* ecs_cmd_current(void);
+
+// `spawn` runs at playback with the new entity; `user` must stay valid
+// until then.
+void ecs_cmd_create(ecs_cmd_buffer_t* buf, ecs_cmd_spawn_fn spawn, void* user);
+void ecs_cmd_destroy(ecs_cmd_buffer_t* buf, ecs_entity_t e);
+// Mask-only: write the component data before recording the add.
+void ecs_cmd_add(ecs_cmd_buffer_t* buf, ecs_entity_t e, ComponentMask bits);
+void ecs_cmd_remove(ecs_cmd_buffer_t* buf, ecs_entity_t e, ComponentMask bits);
+
+bool ecs_cmd_pending(void);
+void ecs_cmd_flush(void);
+
+// ===== Internal: driven by ecs_core =====
+void ecs_cmd_reset_all(void);
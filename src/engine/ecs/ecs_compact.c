@@ -0,0 +1,121 @@
+//==== FROM ecs_compact.c ====
+#include "engine/ecs/ecs_compact.h"
+#include "engine/ecs/ecs_engine.h"
+#include "engine/ecs/ecs_proximity.h"
+#include "engine/engine/engine_scheduler/engine_scheduler.h"
+#include "engine/core/logger/logger.h"
+
+#include <stdlib.h>
+
+// Positions are bucketed into cells before interleaving, so entities that
+// jitter inside a cell don't reshuffle on every pass.
+#define COMPACT_CELL_PX 16.0f
+#define COMPACT_NO_POS  UINT32_MAX
+
+typedef struct {
+    uint32_t key;
+    int idx;
+} compact_key_t;
+
+static float g_compact_interval = ECS_COMPACT_INTERVAL_S;
+static float g_compact_timer = 0.0f;
+
+static uint32_t morton_spread16(uint32_t v)
+{
+    v &= 0xFFFFu;
+    v = (v | (v << 8)) & 0x00FF00FFu;
+    v = (v | (v << 4)) & 0x0F0F0F0Fu;
+    v = (v | (v << 2)) & 0x33333333u;
+    v = (v | (v << 1)) & 0x55555555u;
+    return v;
+}
+
+static uint32_t morton_cell(float v)
+{
+    float c = v / COMPACT_CELL_PX;
+    if (c < 0.0f) c = 0.0f;
+    if (c > 65535.0f) c = 65535.0f;
+    return (uint32_t)c;
+}
+
+static int compact_key_cmp(const void* a, const void* b)
+{
+    const compact_key_t* x = (const compact_key_t*)a;
+    const compact_key_t* y = (const compact_key_t*)b;
+    if (x->key != y->key) return (x->key < y->key) ? -1 : 1;
+    return (x->idx > y->idx) - (x->idx < y->idx);
+}
+
+bool ecs_compact_spatial(void)
+{
+    const int cap = ecs_capacity();
+    compact_key_t* keys = (compact_key_t*)malloc(sizeof(*keys) * (size_t)(cap > 0 ? cap : 1));
+    int* order = (int*)malloc(sizeof(*order) * (size_t)(cap > 0 ? cap : 1));
+    if (!keys || !order) {
+        LOGC(LOGCAT_ECS, LOG_LVL_ERROR, "compact: out of memory (cap=%d)", cap);
+        free(keys);
+        free(order);
+        return false;
+    }
+
+    int n = 0;
+    for (int i = 0; i < cap; ++i) {
+        if (!ecs_alive_idx(i)) continue;
+        uint32_t key = COMPACT_NO_POS;
+        if (component_mask_any(ecs_mask[i], CMP_POS)) {
+            key = morton_spread16(morton_cell(cmp_pos[i].x)) | (morton_spread16(morton_cell(cmp_pos[i].y)) << 1);
+        }
+        keys[n++] = (compact_key_t){ .key = key, .idx = i };
+    }
+    qsort(keys, (size_t)n, sizeof(*keys), compact_key_cmp);
+    for (int k = 0; k < n; ++k) {
+        order[k] = keys[k].idx;
+    }
+
+    bool ok = ecs_compact(order, n);
+    if (ok) {
+        ecs_prox_remap_handles();
+    }
+    free(keys);
+    free(order);
+    return ok;
+}
+
+void ecs_compact_set_interval(float seconds)
+{
+    g_compact_interval = (seconds > 0.0f) ? seconds : 0.0f;
+    g_compact_timer = 0.0f;
+}
+
+bool ecs_compact_snapshot_save(byte_buf_t* out)
+{
+    if (!out) return false;
+    return byte_buf_write(out, &g_compact_timer, sizeof(g_compact_timer));
+}
+
+bool ecs_compact_snapshot_check(byte_reader_t* in)
+{
+    if (!in) return false;
+    float timer = 0.0f;
+    return byte_reader_read(in, &timer, sizeof(timer)) && timer >= 0.0f;
+}
+
+bool ecs_compact_snapshot_load(byte_reader_t* in)
+{
+    if (!in) return false;
+    float timer = 0.0f;
+    if (!byte_reader_read(in, &timer, sizeof(timer)) || !(timer >= 0.0f)) return false;
+    g_compact_timer = timer;
+    return true;
+}
+
+static void sys_compact_impl(float dt)
+{
+    if (g_compact_interval <= 0.0f) return;
+    g_compact_timer += dt;
+    if (g_compact_timer < g_compact_interval) return;
+    g_compact_timer = 0.0f;
+    ecs_compact_spatial();
+}
+
+SYSTEMS_ADAPT_DT(sys_compact_adapt, sys_compact_impl)
@@ -0,0 +1,22 @@
+#pragma once
+#include <stdbool.h>
+#include "engine/utils/byte_buf.h"
+
+// Spatial compaction: renumbers live entities into Morton (Z-order) order of
+// cmp_pos so neighbours in the world are neighbours in the component arrays.
+// Entities without a position keep their relative order after the rest.
+// Runs at map load and then every `interval` seconds of sim time from the
+// entity_compact system (0 disables the periodic pass).
+#ifndef ECS_COMPACT_INTERVAL_S
+#define ECS_COMPACT_INTERVAL_S 30.0f
+#endif
+
+bool ecs_compact_spatial(void);
+void ecs_compact_set_interval(float seconds);
+
+// Time accumulated towards the next periodic pass, so a restored snapshot
+// compacts on the same tick the original run did.
+bool ecs_compact_snapshot_save(byte_buf_t* out);
+bool ecs_compact_snapshot_load(byte_reader_t* in);
+// Validates the section and advances `in` past it, leaving the timer alone.
+bool ecs_compact_snapshot_check(byte_reader_t* in);
@@ -1,16 +1,44 @@
 #include "engine/ecs/ecs_core.h"
 #include "engine/core/logger/logger.h"
+#include <stdlib.h>
 #include <string.h>
 
 // =============== ECS Storage =============
-ComponentMask   ecs_mask[ECS_MAX_ENTITIES];
-uint32_t        ecs_gen[ECS_MAX_ENTITIES];
-uint32_t        ecs_next_gen[ECS_MAX_ENTITIES];
+ComponentMask*  ecs_mask = NULL;
+uint32_t*       ecs_gen = NULL;
+uint32_t*       ecs_next_gen = NULL;
+static int      ecs_cap = 0;
 
 // ========== O(1) create/delete ==========
-static int free_stack[ECS_MAX_ENTITIES];
+static int* free_stack = NULL;
 static int free_top = 0;
-static uint8_t ecs_destroy_state[ECS_MAX_ENTITIES];
+static uint8_t* ecs_destroy_state = NULL;
+// Indices whose destroy_state left NONE since the last ecs_destroy_marked.
+// May hold stale or duplicate entries (destroyed directly, or re-marked
+// after reuse); destroy_state is the source of truth.
+static DA(int) ecs_pending_destroy = {0};
+
+// ========== Registered per-entity arrays ==========
+#define ECS_MAX_STORAGES 64
+typedef struct {
+    void** slot;
+    size_t elem_size;
+} ecs_storage_t;
+static ecs_storage_t ecs_storages[ECS_MAX_STORAGES];
+static int ecs_storage_count = 0;
+
+// ========== Sparse sets by component ==========
+static ecs_sparse_t* ecs_sparse_sets[ENUM_COMPONENT_COUNT];
+static ComponentMask ecs_sparse_mask;
+
+// ========== Scratch stack ==========
+#define ECS_MAX_SCRATCH 16
+typedef struct {
+    void* ptr;
+    size_t bytes;
+} ecs_scratch_t;
+static ecs_scratch_t ecs_scratch[ECS_MAX_SCRATCH];
+static int ecs_scratch_top = 0;
 
 enum {
     ECS_DESTROY_NONE = 0,
@@ -18,12 +46,36 @@ enum {
     ECS_DESTROY_CLEANED = 2
 };
 
+// Only components with a real hook are dispatched; cmp_destroy_hook_mask
+// holds their bits.
 static ecs_component_hook_fn cmp_on_destroy_table[ENUM_COMPONENT_COUNT];
+static ComponentMask cmp_destroy_hook_mask;
+static ecs_snapshot_hooks_t  cmp_snapshot_table[ENUM_COMPONENT_COUNT];
+static ecs_component_hook_fn cmp_on_remap_table[ENUM_COMPONENT_COUNT];
+
+// ========== Handle remap (compaction) ==========
+// Open-addressed map from a pre-compaction handle (idx<<32 | gen) to the
+// entity's current handle. Empty slots have key 0 (gen is never 0).
+// `gen_max` holds, per old index, the highest generation with an entry
+// (0 for none): handles issued after a compaction are above it, so they
+// and anything at an index nothing moved from skip the probe.
+typedef struct {
+    uint64_t* keys;
+    ecs_entity_t* vals;
+    size_t cap;    // power of two
+    size_t count;
+    uint32_t* gen_max;
+    size_t slots;  // entries in gen_max
+} ecs_remap_table_t;
+static ecs_remap_table_t ecs_remap;
+
+static int ecs_remap_index(ecs_entity_t e);
 
 // =============== Helpers ==================
 int ent_index_checked(ecs_entity_t e) {
-    return (e.idx < ECS_MAX_ENTITIES && ecs_gen[e.idx] == e.gen && e.gen != 0)
-        ? (int)e.idx : -1;
+    if (e.idx < (uint32_t)ecs_cap && ecs_gen[e.idx] == e.gen && e.gen != 0) return (int)e.idx;
+    if (e.idx >= ecs_remap.slots || e.gen > ecs_remap.gen_max[e.idx]) return -1;
+    return ecs_remap_index(e);
 }
 
 int ent_index_unchecked(ecs_entity_t e){ return (int)e.idx; }
@@ -40,15 +92,12 @@ float clampf(float v, float a, float b){
     return (v < a) ? a : ((v > b) ? b : v);
 }
 
-static void cmp_on_destroy_noop(int idx)
-{
-    (void)idx;
-}
-
 void ecs_register_component_destroy_hook(ComponentEnum comp, ecs_component_hook_fn fn)
 {
     if (comp < 0 || comp >= ENUM_COMPONENT_COUNT) return;
-    cmp_on_destroy_table[comp] = fn ? fn : cmp_on_destroy_noop;
+    cmp_on_destroy_table[comp] = fn;
+    if (fn) component_mask_set(&cmp_destroy_hook_mask, comp);
+    else    component_mask_clear(&cmp_destroy_hook_mask, comp);
 }
 
 void ecs_register_phys_body_create_hook(ecs_component_hook_fn fn)
@@ -59,45 +108,307 @@ void ecs_register_phys_body_create_hook(ecs_component_hook_fn fn)
 static void ecs_init_destroy_table(void)
 {
     for (int i = 0; i < ENUM_COMPONENT_COUNT; ++i) {
-        cmp_on_destroy_table[i] = cmp_on_destroy_noop;
+        cmp_on_destroy_table[i] = NULL;
+        cmp_snapshot_table[i] = (ecs_snapshot_hooks_t){0};
+        cmp_on_remap_table[i] = NULL;
     }
+    cmp_destroy_hook_mask = CMP_NONE;
     phys_body_create_hook = NULL;
 }
 
-// =============== Public: lifecycle ========
-void ecs_init(void){
-    memset(ecs_mask, 0, sizeof(ecs_mask));
-    memset(ecs_gen,  0, sizeof(ecs_gen));
-    memset(ecs_next_gen, 0, sizeof(ecs_next_gen));
-    memset(ecs_destroy_state, 0, sizeof(ecs_destroy_state));
+// =============== Growth ===================
+static bool grow_array(void** slot, size_t elem_size, int old_cap, int new_cap)
+{
+    void* p = realloc(*slot, elem_size * (size_t)new_cap);
+    if (!p) return false;
+    memset((char*)p + elem_size * (size_t)old_cap, 0, elem_size * (size_t)(new_cap - old_cap));
+    *slot = p;
+    return true;
+}
+
+static bool ecs_grow(int new_cap)
+{
+    const int old_cap = ecs_cap;
+    if (new_cap <= old_cap) return true;
+
+    bool ok = grow_array((void**)&ecs_mask, sizeof(*ecs_mask), old_cap, new_cap)
+        && grow_array((void**)&ecs_gen, sizeof(*ecs_gen), old_cap, new_cap)
+        && grow_array((void**)&ecs_next_gen, sizeof(*ecs_next_gen), old_cap, new_cap)
+        && grow_array((void**)&ecs_destroy_state, sizeof(*ecs_destroy_state), old_cap, new_cap)
+        && grow_array((void**)&free_stack, sizeof(*free_stack), old_cap, new_cap);
+    for (int s = 0; ok && s < ecs_storage_count; ++s) {
+        ok = grow_array(ecs_storages[s].slot, ecs_storages[s].elem_size, old_cap, new_cap);
+    }
+    if (!ok) {
+        LOGC(LOGCAT_ECS, LOG_LVL_ERROR, "ecs: failed to grow entity storage to %d", new_cap);
+        return false;
+    }
+
+    // New slots go beneath the existing free entries so lower indices keep
+    // being handed out first.
+    const int added = new_cap - old_cap;
+    memmove(free_stack + added, free_stack, sizeof(*free_stack) * (size_t)free_top);
+    for (int k = 0; k < added; ++k) {
+        free_stack[k] = new_cap - 1 - k;
+    }
+    free_top += added;
+    ecs_cap = new_cap;
+    return true;
+}
+
+static void ecs_remap_reset(void)
+{
+    free(ecs_remap.keys);
+    free(ecs_remap.vals);
+    free(ecs_remap.gen_max);
+    ecs_remap = (ecs_remap_table_t){0};
+}
+
+static void ecs_release_storage(void)
+{
+    ecs_remap_reset();
+    DA_FREE(&ecs_pending_destroy);
+    ecs_query_reset_all();
+    ecs_cmd_reset_all();
+    ecs_change_reset_all();
+    ecs_event_reset_all();
+    for (int c = 0; c < ENUM_COMPONENT_COUNT; ++c) {
+        ecs_sparse_t* set = ecs_sparse_sets[c];
+        if (!set) continue;
+        free(set->owners);
+        free(set->data);
+        set->owners = NULL;
+        set->data = NULL;
+        set->count = 0;
+        set->cap = 0;
+        ecs_sparse_sets[c] = NULL;
+    }
+    ecs_sparse_mask = CMP_NONE;
+    for (int s = 0; s < ecs_storage_count; ++s) {
+        free(*ecs_storages[s].slot);
+        *ecs_storages[s].slot = NULL;
+    }
+    ecs_storage_count = 0;
+    for (int s = 0; s < ECS_MAX_SCRATCH; ++s) {
+        free(ecs_scratch[s].ptr);
+        ecs_scratch[s] = (ecs_scratch_t){0};
+    }
+    ecs_scratch_top = 0;
+    free(ecs_mask);          ecs_mask = NULL;
+    free(ecs_gen);           ecs_gen = NULL;
+    free(ecs_next_gen);      ecs_next_gen = NULL;
+    free(ecs_destroy_state); ecs_destroy_state = NULL;
+    free(free_stack);        free_stack = NULL;
     free_top = 0;
-    ecs_init_destroy_table();
-    for (int i = ECS_MAX_ENTITIES - 1; i >= 0; --i) {
-        free_stack[free_top++] = i;
+    ecs_cap = 0;
+}
+
+int ecs_capacity(void)
+{
+    return ecs_cap;
+}
+
+bool ecs_reserve(int capacity)
+{
+    if (capacity <= ecs_cap) return true;
+    if (capacity > ECS_MAX_CAPACITY) {
+        LOGC(LOGCAT_ECS, LOG_LVL_ERROR, "ecs: reserve %d exceeds max=%d", capacity, ECS_MAX_CAPACITY);
+        return false;
+    }
+    int rounded = ((capacity + ECS_CHUNK_ENTITIES - 1) / ECS_CHUNK_ENTITIES) * ECS_CHUNK_ENTITIES;
+    if (rounded > ECS_MAX_CAPACITY) rounded = ECS_MAX_CAPACITY;
+    return ecs_grow(rounded);
+}
+
+void ecs_register_storage(void** slot, size_t elem_size)
+{
+    if (!slot || elem_size == 0) return;
+    for (int s = 0; s < ecs_storage_count; ++s) {
+        if (ecs_storages[s].slot == slot) return;
+    }
+    if (ecs_storage_count >= ECS_MAX_STORAGES) {
+        LOGC(LOGCAT_ECS, LOG_LVL_ERROR, "ecs: too many registered storages (max=%d)", ECS_MAX_STORAGES);
+        return;
+    }
+    void* p = calloc(ecs_cap > 0 ? (size_t)ecs_cap : 1, elem_size);
+    if (!p) {
+        LOGC(LOGCAT_ECS, LOG_LVL_ERROR, "ecs: failed to allocate storage (%zu x %d)", elem_size, ecs_cap);
+        return;
+    }
+    free(*slot);
+    *slot = p;
+    ecs_storages[ecs_storage_count++] = (ecs_storage_t){ .slot = slot, .elem_size = elem_size };
+}
+
+// =============== Sparse sets ==============
+void ecs_register_sparse(ecs_sparse_t* set, ComponentEnum comp, size_t elem_size)
+{
+    if (!set || comp < 0 || comp >= ENUM_COMPONENT_COUNT || elem_size == 0) return;
+    if (component_storage_from_id(comp) != COMPONENT_STORAGE_SPARSE) {
+        LOGC(LOGCAT_ECS, LOG_LVL_WARN, "ecs: %s is declared DENSE but registered sparse",
+             component_name_from_id(comp));
+    }
+    *set = (ecs_sparse_t){ .comp = comp, .elem_size = elem_size };
+    ecs_register_storage((void**)&set->slot_of, sizeof(*set->slot_of));
+    ecs_sparse_sets[comp] = set;
+    component_mask_set(&ecs_sparse_mask, comp);
+}
+
+void* ecs_sparse_get(const ecs_sparse_t* set, int idx)
+{
+    if (!set || !set->slot_of || idx < 0 || idx >= ecs_cap) return NULL;
+    int slot = set->slot_of[idx] - 1;
+    return (slot >= 0) ? (char*)set->data + set->elem_size * (size_t)slot : NULL;
+}
+
+void* ecs_sparse_add(ecs_sparse_t* set, int idx)
+{
+    if (!set || !set->slot_of || idx < 0 || idx >= ecs_cap) return NULL;
+    void* existing = ecs_sparse_get(set, idx);
+    if (existing) return existing;
+
+    if (set->count == set->cap) {
+        int new_cap = set->cap ? set->cap * 2 : 8;
+        void* data = realloc(set->data, set->elem_size * (size_t)new_cap);
+        if (!data) return NULL;
+        set->data = data;
+        int* owners = realloc(set->owners, sizeof(*owners) * (size_t)new_cap);
+        if (!owners) return NULL;
+        set->owners = owners;
+        set->cap = new_cap;
     }
+    int slot = set->count++;
+    set->owners[slot] = idx;
+    set->slot_of[idx] = slot + 1;
+    void* p = (char*)set->data + set->elem_size * (size_t)slot;
+    memset(p, 0, set->elem_size);
+    return p;
+}
 
+void ecs_sparse_remove(ecs_sparse_t* set, int idx)
+{
+    if (!set || !set->slot_of || idx < 0 || idx >= ecs_cap) return;
+    int slot = set->slot_of[idx] - 1;
+    if (slot < 0) return;
+    int last = --set->count;
+    if (slot != last) {
+        memcpy((char*)set->data + set->elem_size * (size_t)slot,
+               (char*)set->data + set->elem_size * (size_t)last, set->elem_size);
+        int moved = set->owners[last];
+        set->owners[slot] = moved;
+        set->slot_of[moved] = slot + 1;
+    }
+    set->slot_of[idx] = 0;
+}
+
+static void ecs_sparse_drop_bits(int idx, ComponentMask bits)
+{
+    bits = component_mask_and(bits, ecs_sparse_mask);
+    for (int comp; (comp = component_mask_pop_lowest(&bits)) >= 0;) {
+        ecs_sparse_remove(ecs_sparse_sets[comp], idx);
+    }
+}
+
+// =============== Mask writes ==============
+void ecs_mask_add(int idx, ComponentMask bits)
+{
+    ComponentMask old_mask = ecs_mask[idx];
+    ecs_mask[idx] = component_mask_or(old_mask, bits);
+    if (!component_mask_eq(ecs_mask[idx], old_mask)) {
+        bool alive = ecs_alive_idx(idx);
+        ecs_query_track(idx, alive, old_mask, alive, ecs_mask[idx]);
+        ecs_mark_changed(idx, component_mask_xor(ecs_mask[idx], old_mask));
+    }
+}
+
+void ecs_mask_remove(int idx, ComponentMask bits)
+{
+    ComponentMask old_mask = ecs_mask[idx];
+    ecs_mask[idx] = component_mask_andnot(old_mask, bits);
+    if (!component_mask_eq(ecs_mask[idx], old_mask)) {
+        bool alive = ecs_alive_idx(idx);
+        ecs_query_track(idx, alive, old_mask, alive, ecs_mask[idx]);
+        ecs_mark_changed(idx, component_mask_and(old_mask, bits));
+        ecs_sparse_drop_bits(idx, component_mask_and(old_mask, bits));
+    }
+}
+
+void* ecs_scratch_acquire(size_t elem_size)
+{
+    if (ecs_scratch_top >= ECS_MAX_SCRATCH) {
+        LOGC(LOGCAT_ECS, LOG_LVL_ERROR, "ecs: scratch stack exhausted (max=%d)", ECS_MAX_SCRATCH);
+        return NULL;
+    }
+    ecs_scratch_t* sc = &ecs_scratch[ecs_scratch_top];
+    size_t bytes = elem_size * (size_t)(ecs_cap > 0 ? ecs_cap : 1);
+    if (sc->bytes < bytes) {
+        void* p = realloc(sc->ptr, bytes);
+        if (!p) {
+            LOGC(LOGCAT_ECS, LOG_LVL_ERROR, "ecs: failed to allocate scratch (%zu bytes)", bytes);
+            return NULL;
+        }
+        sc->ptr = p;
+        sc->bytes = bytes;
+    }
+    memset(sc->ptr, 0, bytes);
+    ecs_scratch_top++;
+    return sc->ptr;
+}
+
+void ecs_scratch_release(void* p)
+{
+    if (!p) return;
+    if (ecs_scratch_top <= 0 || ecs_scratch[ecs_scratch_top - 1].ptr != p) {
+        LOGC(LOGCAT_ECS, LOG_LVL_WARN, "ecs: scratch released out of order");
+        return;
+    }
+    ecs_scratch_top--;
+}
+
+// =============== Public: lifecycle ========
+void ecs_init(void){
+    ecs_release_storage();
+    ecs_init_destroy_table();
+    (void)ecs_reserve(ECS_INITIAL_CAPACITY);
 }
 
 void ecs_shutdown(void){
+    ecs_release_storage();
 }
 
 static void ecs_cleanup_entity(int idx)
 {
-    ComponentMask mask = ecs_mask[idx];
-    for (int comp = 0; comp < ENUM_COMPONENT_COUNT; ++comp) {
-        if (mask & (1ull << comp)) {
-            cmp_on_destroy_table[comp](idx);
-        }
+    ComponentMask bits = component_mask_and(ecs_mask[idx], cmp_destroy_hook_mask);
+    for (int comp; (comp = component_mask_pop_lowest(&bits)) >= 0;) {
+        cmp_on_destroy_table[comp](idx);
     }
 }
 
+static void ecs_pending_rebuild(void)
+{
+    DA_CLEAR(&ecs_pending_destroy);
+    for (int i = 0; i < ecs_cap; ++i) {
+        if (ecs_destroy_state[i] != ECS_DESTROY_NONE) DA_APPEND(&ecs_pending_destroy, i);
+    }
+}
+
+static int pending_idx_cmp(const void* a, const void* b)
+{
+    int x = *(const int*)a;
+    int y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
 static void ecs_finalize_destroy(int idx)
 {
+    ecs_query_track(idx, true, ecs_mask[idx], false, CMP_NONE);
+    ecs_sparse_drop_bits(idx, ecs_mask[idx]);
+    ecs_change_on_destroy(idx);
     uint32_t g = ecs_gen[idx];
     g = (g + 1) ? (g + 1) : 1;
     ecs_gen[idx] = 0;
     ecs_next_gen[idx] = g;
-    ecs_mask[idx] = 0;
+    ecs_mask[idx] = CMP_NONE;
     ecs_destroy_state[idx] = ECS_DESTROY_NONE;
     free_stack[free_top++] = idx;
 }
@@ -105,15 +416,16 @@ static void ecs_finalize_destroy(int idx)
 // =============== Public: entity ===========
 ecs_entity_t ecs_create(void)
 {
-    if (free_top == 0) {
-        LOGC(LOGCAT_ECS, LOG_LVL_ERROR, "ecs: out of entities (max=%d)", ECS_MAX_ENTITIES);
+    if (free_top == 0 && !ecs_reserve(ecs_cap + ECS_CHUNK_ENTITIES)) {
+        LOGC(LOGCAT_ECS, LOG_LVL_ERROR, "ecs: out of entities (max=%d)", ecs_cap);
         return ecs_null();
     }
     int idx = free_stack[--free_top];
     uint32_t g = ecs_next_gen[idx];
     if (g == 0) g = 1;
     ecs_gen[idx] = g;
-    ecs_mask[idx] = 0;
+    ecs_mask[idx] = CMP_NONE;
+    ecs_query_track(idx, false, CMP_NONE, true, CMP_NONE);
     return (ecs_entity_t){ .idx = (uint32_t)idx, .gen = g };
 }
 
@@ -132,25 +444,39 @@ void ecs_mark_destroy(ecs_entity_t e)
     if (idx < 0) return;
     if (ecs_destroy_state[idx] == ECS_DESTROY_NONE) {
         ecs_destroy_state[idx] = ECS_DESTROY_MARKED;
+        DA_APPEND(&ecs_pending_destroy, idx);
     }
 }
 
 void ecs_cleanup_marked(void)
 {
-    for (int i = 0; i < ECS_MAX_ENTITIES; ++i) {
-        if (ecs_destroy_state[i] != ECS_DESTROY_MARKED) continue;
-        if (!ecs_alive_idx(i)) {
-            ecs_destroy_state[i] = ECS_DESTROY_NONE;
-            continue;
+    // Hooks may mark more entities; re-read the size each step.
+    size_t out = 0;
+    for (size_t n = 0; n < ecs_pending_destroy.size; ++n) {
+        int i = ecs_pending_destroy.data[n];
+        if (ecs_destroy_state[i] == ECS_DESTROY_MARKED) {
+            if (!ecs_alive_idx(i)) {
+                ecs_destroy_state[i] = ECS_DESTROY_NONE;
+                continue;
+            }
+            ecs_cleanup_entity(i);
+            ecs_destroy_state[i] = ECS_DESTROY_CLEANED;
+        }
+        if (ecs_destroy_state[i] != ECS_DESTROY_NONE) {
+            ecs_pending_destroy.data[out++] = i;
         }
-        ecs_cleanup_entity(i);
-        ecs_destroy_state[i] = ECS_DESTROY_CLEANED;
     }
+    ecs_pending_destroy.size = out;
 }
 
 void ecs_destroy_marked(void)
 {
-    for (int i = 0; i < ECS_MAX_ENTITIES; ++i) {
+    // Ascending order returns slots to the free stack exactly as a full scan did.
+    if (ecs_pending_destroy.size > 1) {
+        qsort(ecs_pending_destroy.data, ecs_pending_destroy.size, sizeof(int), pending_idx_cmp);
+    }
+    for (size_t n = 0; n < ecs_pending_destroy.size; ++n) {
+        int i = ecs_pending_destroy.data[n];
         if (ecs_destroy_state[i] == ECS_DESTROY_NONE) continue;
         if (!ecs_alive_idx(i)) {
             ecs_destroy_state[i] = ECS_DESTROY_NONE;
@@ -161,4 +487,443 @@ void ecs_destroy_marked(void)
         }
         ecs_finalize_destroy(i);
     }
+    DA_CLEAR(&ecs_pending_destroy);
+}
+
+// =============== Snapshot =================
+// Layout: header, core arrays, every registered storage, sparse sets, then
+// one length-prefixed section per component with snapshot hooks. Storage
+// and sparse layouts are validated against the running build, so a blob
+// only loads into the same component schema.
+#define ECS_SNAPSHOT_MAGIC 0x53434345u   // "ECSS"
+
+void ecs_register_component_snapshot_hooks(ComponentEnum comp, ecs_snapshot_hooks_t hooks)
+{
+    if (comp < 0 || comp >= ENUM_COMPONENT_COUNT) return;
+    cmp_snapshot_table[comp] = hooks;
+}
+
+static uint32_t ecs_schema_hash(void)
+{
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < sizeof(k_component_meta) / sizeof(k_component_meta[0]); ++i) {
+        for (const char* c = k_component_meta[i].name; *c; ++c) {
+            h = (h ^ (uint8_t)*c) * 16777619u;
+        }
+        h = (h ^ (uint32_t)k_component_meta[i].storage) * 16777619u;
+    }
+    return h;
+}
+
+bool ecs_snapshot_save(byte_buf_t* out)
+{
+    if (!out) return false;
+    const size_t cap = (size_t)ecs_cap;
+    size_t raw = cap * (sizeof(*ecs_mask) + sizeof(*ecs_gen) + sizeof(*ecs_next_gen) + sizeof(*ecs_destroy_state))
+        + (size_t)free_top * sizeof(*free_stack);
+    for (int s = 0; s < ecs_storage_count; ++s) {
+        raw += cap * ecs_storages[s].elem_size;
+    }
+    if (!byte_buf_reserve(out, out->size + raw + 1024)) return false;
+
+    byte_buf_write_u32(out, ECS_SNAPSHOT_MAGIC);
+    byte_buf_write_u32(out, ecs_schema_hash());
+    byte_buf_write_u32(out, (uint32_t)ecs_cap);
+    byte_buf_write_u32(out, (uint32_t)free_top);
+    byte_buf_write_u32(out, (uint32_t)ecs_storage_count);
+    for (int s = 0; s < ecs_storage_count; ++s) {
+        byte_buf_write_u32(out, (uint32_t)ecs_storages[s].elem_size);
+    }
+
+    byte_buf_write(out, ecs_mask, cap * sizeof(*ecs_mask));
+    byte_buf_write(out, ecs_gen, cap * sizeof(*ecs_gen));
+    byte_buf_write(out, ecs_next_gen, cap * sizeof(*ecs_next_gen));
+    byte_buf_write(out, ecs_destroy_state, cap * sizeof(*ecs_destroy_state));
+    byte_buf_write(out, free_stack, (size_t)free_top * sizeof(*free_stack));
+    for (int s = 0; s < ecs_storage_count; ++s) {
+        byte_buf_write(out, *ecs_storages[s].slot, cap * ecs_storages[s].elem_size);
+    }
+
+    for (int c = 0; c < ENUM_COMPONENT_COUNT; ++c) {
+        const ecs_sparse_t* set = ecs_sparse_sets[c];
+        if (!set) continue;
+        byte_buf_write_u32(out, (uint32_t)c);
+        byte_buf_write_u32(out, (uint32_t)set->elem_size);
+        byte_buf_write_u32(out, (uint32_t)set->count);
+        byte_buf_write(out, set->owners, sizeof(*set->owners) * (size_t)set->count);
+        byte_buf_write(out, set->data, set->elem_size * (size_t)set->count);
+    }
+    byte_buf_write_u32(out, UINT32_MAX);
+
+    for (int c = 0; c < ENUM_COMPONENT_COUNT; ++c) {
+        if (!cmp_snapshot_table[c].save) continue;
+        byte_buf_write_u32(out, (uint32_t)c);
+        size_t size_at = byte_buf_placeholder_u32(out);
+        size_t start = out->size;
+        cmp_snapshot_table[c].save(out);
+        byte_buf_patch_u32(out, size_at, (uint32_t)(out->size - start));
+    }
+    byte_buf_write_u32(out, UINT32_MAX);
+    return true;
+}
+
+typedef struct {
+    const void* owners;
+    const void* data;
+    int count;
+} ecs_sparse_view_t;
+
+// A validated blob: views into the reader's bytes, nothing copied yet.
+typedef struct {
+    uint32_t cap;
+    uint32_t free_top;
+    const void* mask;
+    const void* gen;
+    const void* next_gen;
+    const void* destroy_state;
+    const void* free_entries;
+    const void* storages[ECS_MAX_STORAGES];
+    ecs_sparse_view_t sparse[ENUM_COMPONENT_COUNT];
+    byte_reader_t sections[ENUM_COMPONENT_COUNT];
+} ecs_snapshot_view_t;
+
+static bool ecs_snapshot_parse(byte_reader_t* in, ecs_snapshot_view_t* v)
+{
+    memset(v, 0, sizeof(*v));
+    if (byte_reader_u32(in) != ECS_SNAPSHOT_MAGIC || byte_reader_u32(in) != ecs_schema_hash()) {
+        LOGC(LOGCAT_ECS, LOG_LVL_ERROR, "ecs: snapshot does not match the component schema");
+        return false;
+    }
+    const uint32_t cap = byte_reader_u32(in);
+    const uint32_t snap_free_top = byte_reader_u32(in);
+    const uint32_t storage_count = byte_reader_u32(in);
+    if (!in->ok || cap == 0 || cap > ECS_MAX_CAPACITY || snap_free_top > cap
+        || storage_count != (uint32_t)ecs_storage_count) {
+        LOGC(LOGCAT_ECS, LOG_LVL_ERROR, "ecs: snapshot header invalid (cap=%u storages=%u)", cap, storage_count);
+        return false;
+    }
+    for (int s = 0; s < ecs_storage_count; ++s) {
+        if (byte_reader_u32(in) != (uint32_t)ecs_storages[s].elem_size) {
+            LOGC(LOGCAT_ECS, LOG_LVL_ERROR, "ecs: snapshot storage %d layout differs", s);
+            return false;
+        }
+    }
+    v->cap = cap;
+    v->free_top = snap_free_top;
+
+    v->mask = byte_reader_view(in, cap * sizeof(*ecs_mask));
+    v->gen = byte_reader_view(in, cap * sizeof(*ecs_gen));
+    v->next_gen = byte_reader_view(in, cap * sizeof(*ecs_next_gen));
+    v->destroy_state = byte_reader_view(in, cap * sizeof(*ecs_destroy_state));
+    v->free_entries = byte_reader_view(in, snap_free_top * sizeof(*free_stack));
+    for (int s = 0; s < ecs_storage_count; ++s) {
+        v->storages[s] = byte_reader_view(in, cap * ecs_storages[s].elem_size);
+    }
+
+    for (uint32_t c = byte_reader_u32(in); in->ok && c != UINT32_MAX; c = byte_reader_u32(in)) {
+        const uint32_t elem_size = byte_reader_u32(in);
+        const uint32_t count = byte_reader_u32(in);
+        if (c >= ENUM_COMPONENT_COUNT || !ecs_sparse_sets[c] || elem_size != ecs_sparse_sets[c]->elem_size || count > cap) {
+            LOGC(LOGCAT_ECS, LOG_LVL_ERROR, "ecs: snapshot sparse set %u does not match", c);
+            return false;
+        }
+        v->sparse[c].count = (int)count;
+        v->sparse[c].owners = byte_reader_view(in, sizeof(int) * count);
+        v->sparse[c].data = byte_reader_view(in, (size_t)elem_size * count);
+    }
+
+    for (uint32_t c = byte_reader_u32(in); in->ok && c != UINT32_MAX; c = byte_reader_u32(in)) {
+        const uint32_t size = byte_reader_u32(in);
+        const void* body = byte_reader_view(in, size);
+        if (c >= ENUM_COMPONENT_COUNT || !cmp_snapshot_table[c].load) {
+            LOGC(LOGCAT_ECS, LOG_LVL_ERROR, "ecs: snapshot has unknown section %u", c);
+            return false;
+        }
+        v->sections[c] = byte_reader_make(body, size);
+    }
+    if (!in->ok) {
+        LOGC(LOGCAT_ECS, LOG_LVL_ERROR, "ecs: snapshot truncated");
+        return false;
+    }
+    return true;
+}
+
+bool ecs_snapshot_check(byte_reader_t* in)
+{
+    if (!in) return false;
+    ecs_snapshot_view_t v;
+    return ecs_snapshot_parse(in, &v);
+}
+
+bool ecs_snapshot_load(byte_reader_t* in)
+{
+    if (!in) return false;
+
+    // Validate the whole blob before touching live state.
+    ecs_snapshot_view_t v;
+    if (!ecs_snapshot_parse(in, &v)) return false;
+    const uint32_t cap = v.cap;
+    const uint32_t snap_free_top = v.free_top;
+    if (!ecs_reserve((int)cap)) return false;
+
+    // Hand back anything the current entities own (textures, heap tiles...).
+    for (int c = 0; c < ENUM_COMPONENT_COUNT; ++c) {
+        if (cmp_snapshot_table[c].release) cmp_snapshot_table[c].release();
+    }
+
+    // Rows past the snapshot's capacity come back empty and free, beneath
+    // the restored free entries (same order ecs_grow uses).
+    const size_t n = cap;
+    const size_t tail = (size_t)ecs_cap - n;
+    memcpy(ecs_mask, v.mask, n * sizeof(*ecs_mask));
+    memcpy(ecs_gen, v.gen, n * sizeof(*ecs_gen));
+    memcpy(ecs_next_gen, v.next_gen, n * sizeof(*ecs_next_gen));
+    memcpy(ecs_destroy_state, v.destroy_state, n * sizeof(*ecs_destroy_state));
+    memset(ecs_mask + n, 0, tail * sizeof(*ecs_mask));
+    memset(ecs_gen + n, 0, tail * sizeof(*ecs_gen));
+    memset(ecs_next_gen + n, 0, tail * sizeof(*ecs_next_gen));
+    memset(ecs_destroy_state + n, 0, tail * sizeof(*ecs_destroy_state));
+    for (size_t k = 0; k < tail; ++k) {
+        free_stack[k] = ecs_cap - 1 - (int)k;
+    }
+    memcpy(free_stack + tail, v.free_entries, snap_free_top * sizeof(*free_stack));
+    free_top = (int)(tail + snap_free_top);
+    for (int s = 0; s < ecs_storage_count; ++s) {
+        uint8_t* dst = (uint8_t*)*ecs_storages[s].slot;
+        const size_t elem = ecs_storages[s].elem_size;
+        memcpy(dst, v.storages[s], n * elem);
+        memset(dst + n * elem, 0, tail * elem);
+    }
+
+    for (int c = 0; c < ENUM_COMPONENT_COUNT; ++c) {
+        ecs_sparse_t* set = ecs_sparse_sets[c];
+        if (!set) continue;
+        const int count = v.sparse[c].count;
+        if (count > set->cap) {
+            void* data = realloc(set->data, set->elem_size * (size_t)count);
+            if (data) set->data = data;
+            int* owners = realloc(set->owners, sizeof(*owners) * (size_t)count);
+            if (owners) set->owners = owners;
+            if (!data || !owners) {
+                LOGC(LOGCAT_ECS, LOG_LVL_ERROR, "ecs: out of memory restoring sparse set %d", c);
+                set->count = 0;
+                continue;
+            }
+            set->cap = count;
+        }
+        set->count = count;
+        if (count > 0) {
+            memcpy(set->owners, v.sparse[c].owners, sizeof(*set->owners) * (size_t)count);
+            memcpy(set->data, v.sparse[c].data, set->elem_size * (size_t)count);
+        }
+    }
+
+    ecs_remap_reset();
+    ecs_pending_rebuild();
+    ecs_cmd_reset_all();
+    ecs_query_rebuild_all();
+    ecs_change_on_restore();
+
+    bool ok = true;
+    for (int c = 0; c < ENUM_COMPONENT_COUNT; ++c) {
+        if (!cmp_snapshot_table[c].load) continue;
+        if (!cmp_snapshot_table[c].load(&v.sections[c]) || !v.sections[c].ok) {
+            LOGC(LOGCAT_ECS, LOG_LVL_ERROR, "ecs: snapshot section %s failed to load", component_name_from_id((ComponentEnum)c));
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+// =============== Compaction ===============
+static uint64_t remap_key(ecs_entity_t e)
+{
+    return ((uint64_t)e.idx << 32) | e.gen;
+}
+
+static size_t remap_slot(uint64_t key, size_t cap)
+{
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdull;
+    key ^= key >> 33;
+    return (size_t)key & (cap - 1);
+}
+
+static void remap_insert(ecs_remap_table_t* t, uint64_t key, ecs_entity_t val)
+{
+    size_t i = remap_slot(key, t->cap);
+    while (t->keys[i] != 0 && t->keys[i] != key) i = (i + 1) & (t->cap - 1);
+    if (t->keys[i] == 0) t->count++;
+    t->keys[i] = key;
+    t->vals[i] = val;
+    const size_t idx = (size_t)(key >> 32);
+    if (idx < t->slots && (uint32_t)key > t->gen_max[idx]) t->gen_max[idx] = (uint32_t)key;
+}
+
+static int ecs_remap_index(ecs_entity_t e)
+{
+    if (e.gen == 0) return -1;
+    const uint64_t key = remap_key(e);
+    for (size_t i = remap_slot(key, ecs_remap.cap); ecs_remap.keys[i] != 0; i = (i + 1) & (ecs_remap.cap - 1)) {
+        if (ecs_remap.keys[i] != key) continue;
+        ecs_entity_t v = ecs_remap.vals[i];
+        return (v.idx < (uint32_t)ecs_cap && ecs_gen[v.idx] == v.gen) ? (int)v.idx : -1;
+    }
+    return -1;
+}
+
+ecs_entity_t ecs_remap_handle(ecs_entity_t e)
+{
+    int idx = ent_index_checked(e);
+    return (idx >= 0) ? handle_from_index(idx) : e;
+}
+
+void ecs_register_component_remap_hook(ComponentEnum comp, ecs_component_hook_fn fn)
+{
+    if (comp < 0 || comp >= ENUM_COMPONENT_COUNT) return;
+    cmp_on_remap_table[comp] = fn;
+}
+
+// Highest generation ever handed out at `idx`; anything issued there after a
+// compaction must be above it so stale handles never alias a new entity.
+static uint32_t gen_high_water(int idx)
+{
+    uint32_t g = ecs_gen[idx];
+    uint32_t issued = ecs_next_gen[idx] ? ecs_next_gen[idx] - 1 : 0;
+    return (issued > g) ? issued : g;
+}
+
+static uint32_t gen_after(uint32_t g)
+{
+    return (g + 1) ? (g + 1) : 1;
+}
+
+static void permute_array(void* base, size_t elem_size, const int* old_of_new, int count, uint8_t* tmp)
+{
+    uint8_t* p = (uint8_t*)base;
+    memcpy(tmp, p, elem_size * (size_t)ecs_cap);
+    for (int k = 0; k < count; ++k) {
+        memcpy(p + elem_size * (size_t)k, tmp + elem_size * (size_t)old_of_new[k], elem_size);
+    }
+    memset(p + elem_size * (size_t)count, 0, elem_size * (size_t)(ecs_cap - count));
+}
+
+bool ecs_compact(const int* order, int count)
+{
+    if (ecs_cap == 0) return true;
+    if (ecs_scratch_top != 0) {
+        LOGC(LOGCAT_ECS, LOG_LVL_ERROR, "ecs: compaction while scratch arrays are held");
+        return false;
+    }
+
+    size_t max_elem = sizeof(uint64_t);
+    for (int s = 0; s < ecs_storage_count; ++s) {
+        if (ecs_storages[s].elem_size > max_elem) max_elem = ecs_storages[s].elem_size;
+    }
+    int* new_of_old = malloc(sizeof(int) * (size_t)ecs_cap);
+    int* old_of_new = malloc(sizeof(int) * (size_t)ecs_cap);
+    uint32_t* new_gen = malloc(sizeof(uint32_t) * (size_t)ecs_cap);
+    uint8_t* tmp = malloc(max_elem * (size_t)ecs_cap);
+    if (!new_of_old || !old_of_new || !new_gen || !tmp) {
+        LOGC(LOGCAT_ECS, LOG_LVL_ERROR, "ecs: out of memory for compaction (cap=%d)", ecs_cap);
+        free(new_of_old); free(old_of_new); free(new_gen); free(tmp);
+        return false;
+    }
+
+    // Requested order first, then any live entity it missed in index order.
+    int n = 0;
+    for (int i = 0; i < ecs_cap; ++i) new_of_old[i] = -1;
+    for (int k = 0; order && k < count; ++k) {
+        int i = order[k];
+        if (i < 0 || i >= ecs_cap || !ecs_alive_idx(i) || new_of_old[i] >= 0) continue;
+        new_of_old[i] = n;
+        old_of_new[n++] = i;
+    }
+    for (int i = 0; i < ecs_cap; ++i) {
+        if (!ecs_alive_idx(i) || new_of_old[i] >= 0) continue;
+        new_of_old[i] = n;
+        old_of_new[n++] = i;
+    }
+
+    int moved = 0;
+    for (int k = 0; k < n; ++k) {
+        if (old_of_new[k] != k) moved++;
+    }
+    if (moved == 0) {
+        free(new_of_old); free(old_of_new); free(new_gen); free(tmp);
+        return true;
+    }
+
+    // Generations: unmoved entities keep theirs, everything else starts
+    // above the slot's high-water mark (see gen_high_water).
+    for (int k = 0; k < ecs_cap; ++k) {
+        new_gen[k] = (k < n && old_of_new[k] == k) ? ecs_gen[k] : gen_after(gen_high_water(k));
+    }
+
+    // Carry earlier remap entries forward and add one per moved entity.
+    ecs_remap_table_t next = {0};
+    size_t want = (ecs_remap.count + (size_t)moved) * 2;
+    next.cap = 64;
+    while (next.cap < want) next.cap *= 2;
+    next.keys = calloc(next.cap, sizeof(*next.keys));
+    next.vals = malloc(next.cap * sizeof(*next.vals));
+    next.slots = (size_t)ecs_cap;
+    next.gen_max = calloc(next.slots, sizeof(*next.gen_max));
+    if (!next.keys || !next.vals || !next.gen_max) {
+        LOGC(LOGCAT_ECS, LOG_LVL_ERROR, "ecs: out of memory for handle remap (%zu entries)", want / 2);
+        free(next.keys); free(next.vals); free(next.gen_max);
+        free(new_of_old); free(old_of_new); free(new_gen); free(tmp);
+        return false;
+    }
+    for (size_t i = 0; i < ecs_remap.cap; ++i) {
+        if (ecs_remap.keys[i] == 0) continue;
+        ecs_entity_t v = ecs_remap.vals[i];
+        if (v.idx >= (uint32_t)ecs_cap || ecs_gen[v.idx] != v.gen || v.gen == 0) continue;
+        const int k = new_of_old[v.idx];
+        remap_insert(&next, ecs_remap.keys[i], (ecs_entity_t){ .idx = (uint32_t)k, .gen = new_gen[k] });
+    }
+    for (int k = 0; k < n; ++k) {
+        const int o = old_of_new[k];
+        if (o == k) continue;
+        remap_insert(&next, remap_key(handle_from_index(o)), (ecs_entity_t){ .idx = (uint32_t)k, .gen = new_gen[k] });
+    }
+    ecs_remap_reset();
+    ecs_remap = next;
+
+    // Permute every per-entity array.
+    permute_array(ecs_mask, sizeof(*ecs_mask), old_of_new, n, tmp);
+    permute_array(ecs_destroy_state, sizeof(*ecs_destroy_state), old_of_new, n, tmp);
+    for (int s = 0; s < ecs_storage_count; ++s) {
+        permute_array(*ecs_storages[s].slot, ecs_storages[s].elem_size, old_of_new, n, tmp);
+    }
+    for (int k = 0; k < ecs_cap; ++k) {
+        ecs_gen[k] = (k < n) ? new_gen[k] : 0;
+        ecs_next_gen[k] = new_gen[k];
+    }
+    for (int c = 0; c < ENUM_COMPONENT_COUNT; ++c) {
+        ecs_sparse_t* set = ecs_sparse_sets[c];
+        if (!set) continue;
+        for (int slot = 0; slot < set->count; ++slot) {
+            set->owners[slot] = new_of_old[set->owners[slot]];
+        }
+    }
+    free_top = 0;
+    for (int k = ecs_cap - 1; k >= n; --k) {
+        free_stack[free_top++] = k;
+    }
+
+    ecs_pending_rebuild();
+    ecs_query_rebuild_all();
+    ecs_change_on_compact(new_of_old);
+
+    for (int c = 0; c < ENUM_COMPONENT_COUNT; ++c) {
+        ecs_component_hook_fn fn = cmp_on_remap_table[c];
+        if (!fn) continue;
+        for (int k = 0; k < n; ++k) {
+            if (component_mask_has(ecs_mask[k], c)) fn(k);
+        }
+    }
+
+    free(new_of_old); free(old_of_new); free(new_gen); free(tmp);
+    return true;
 }
@@ -2,13 +2,60 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 #include "engine/ecs/ecs.h"
+#include "engine/ecs/ecs_query.h"
+#include "engine/ecs/ecs_cmd.h"
+#include "engine/ecs/ecs_change.h"
+#include "engine/ecs/ecs_event.h"
+#include "engine/utils/byte_buf.h"
 
 // ===== Global ECS storage (core) =====
-extern ComponentMask ecs_mask[ECS_MAX_ENTITIES];
-extern uint32_t ecs_gen[ECS_MAX_ENTITIES];
-extern uint32_t ecs_next_gen[ECS_MAX_ENTITIES];
+// Sized to ecs_capacity(); reallocated when the entity pool grows.
+extern ComponentMask* ecs_mask;
+extern uint32_t* ecs_gen;
+extern uint32_t* ecs_next_gen;
+
+// ===== Mask writes =====
+// All component bit changes go through these so queries and sparse storage
+// stay in sync with ecs_mask.
+void ecs_mask_add(int idx, ComponentMask bits);
+void ecs_mask_remove(int idx, ComponentMask bits);
+
+// ===== Per-entity storage registry =====
+// Registered arrays are allocated at the current capacity, zero-filled when
+// grown, and freed by ecs_shutdown(). Register after ecs_init().
+void ecs_register_storage(void** slot, size_t elem_size);
+#define ECS_REGISTER_STORAGE(arr) ecs_register_storage((void**)&(arr), sizeof(*(arr)))
+
+// ===== Sparse component storage =====
+// Packed data + owner list for components declared SPARSE in the .def files.
+// `slot_of` maps entity index -> packed slot + 1 (0 = absent). Removal swaps
+// the last entry in, so packed pointers are only valid until the next
+// add/remove on the same set. Entries are dropped automatically when the
+// component bit is removed or the entity is destroyed.
+typedef struct {
+    ComponentEnum comp;
+    size_t elem_size;
+    int* slot_of;
+    int* owners;
+    void* data;
+    int count;
+    int cap;
+} ecs_sparse_t;
+
+void  ecs_register_sparse(ecs_sparse_t* set, ComponentEnum comp, size_t elem_size);
+void* ecs_sparse_add(ecs_sparse_t* set, int idx);   // zeroed on first add
+void* ecs_sparse_get(const ecs_sparse_t* set, int idx);
+void  ecs_sparse_remove(ecs_sparse_t* set, int idx);
+
+// ===== Per-tick scratch =====
+// Zeroed block of ecs_capacity() elements, released in LIFO order. A block
+// stays valid if the pool grows meanwhile, but only covers the capacity at
+// acquire time, so callers loop to the capacity they captured beforehand.
+void* ecs_scratch_acquire(size_t elem_size);
+void  ecs_scratch_release(void* p);
 
 // ===== Internal helpers =====
 int ent_index_checked(ecs_entity_t e);
@@ -24,3 +71,40 @@ extern ecs_component_hook_fn phys_body_create_hook;
 
 void ecs_register_component_destroy_hook(ComponentEnum comp, ecs_component_hook_fn fn);
 void ecs_register_phys_body_create_hook(ecs_component_hook_fn fn);
+
+// ===== Snapshot =====
+// Registered storage, sparse sets and entity bookkeeping are copied as raw
+// bytes. Components whose bytes hold pointers or refcounted handles register
+// hooks: `release` drops what the live entities own before a load, `save`
+// writes a section for the component and `load` reads it back once the raw
+// data is in place (fixing up those pointers/handles).
+typedef struct {
+    void (*release)(void);
+    void (*save)(byte_buf_t* out);
+    bool (*load)(byte_reader_t* in);
+} ecs_snapshot_hooks_t;
+
+void ecs_register_component_snapshot_hooks(ComponentEnum comp, ecs_snapshot_hooks_t hooks);
+bool ecs_snapshot_save(byte_buf_t* out);
+// Validates the whole blob before touching live state; on false with a
+// malformed header the world is left as it was.
+bool ecs_snapshot_load(byte_reader_t* in);
+// Runs the same validation and advances `in` past the section without
+// touching live state.
+bool ecs_snapshot_check(byte_reader_t* in);
+
+// ===== Compaction =====
+// Renumbers live entities so that `order[k]` ends up at index k (live
+// entities missing from `order` follow in index order) and permutes every
+// registered storage, sparse set, query and change log to match. Call it
+// between systems, never while iterating or holding scratch arrays.
+//
+// Moved entities get fresh generations. Handles taken before the move keep
+// resolving through a remap table consulted by ent_index_checked, so stale
+// handles stay usable; handles embedded in components should be rewritten
+// with ecs_remap_handle from a remap hook so equality checks keep working.
+// The table lives until the next ecs_init()/snapshot load.
+bool ecs_compact(const int* order, int count);
+ecs_entity_t ecs_remap_handle(ecs_entity_t e);
+// Called once per live entity with `comp` after a compaction, new indices.
+void ecs_register_component_remap_hook(ComponentEnum comp, ecs_component_hook_fn fn);
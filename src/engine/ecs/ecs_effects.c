@@ -6,9 +6,7 @@
 static void sys_effects_tick_begin_impl(void)
 {
     fx_lines_clear();
-    for (int i = 0; i < ECS_MAX_ENTITIES; ++i) {
-        if (!ecs_alive_idx(i)) continue;
-        if ((ecs_mask[i] & CMP_SPR) == 0) continue;
+    ECS_QUERY_EACH(ecs_query_get(CMP_SPR, CMP_NONE), i) {
         cmp_spr[i].fx.highlighted = false;
         cmp_spr[i].fx.front = false;
     }
@@ -6,20 +6,20 @@
 #include <string.h>
 
 // =============== ECS Storage =============
-cmp_position_t  cmp_pos[ECS_MAX_ENTITIES];
-cmp_velocity_t  cmp_vel[ECS_MAX_ENTITIES];
-cmp_anim_t      cmp_anim[ECS_MAX_ENTITIES];
-cmp_sprite_t    cmp_spr[ECS_MAX_ENTITIES];
-cmp_collider_t  cmp_col[ECS_MAX_ENTITIES];
-cmp_phys_body_t cmp_phys_body[ECS_MAX_ENTITIES];
-cmp_trigger_t   cmp_trigger[ECS_MAX_ENTITIES];
-cmp_billboard_t cmp_billboard[ECS_MAX_ENTITIES];
+cmp_position_t*  cmp_pos = NULL;
+cmp_velocity_t*  cmp_vel = NULL;
+cmp_anim_t*      cmp_anim = NULL;
+cmp_sprite_t*    cmp_spr = NULL;
+cmp_collider_t*  cmp_col = NULL;
+cmp_phys_body_t* cmp_phys_body = NULL;
+cmp_trigger_t*   cmp_trigger = NULL;
+cmp_billboard_t* cmp_billboard = NULL;
 
 ecs_component_hook_fn phys_body_create_hook = NULL;
 
 static void try_create_phys_body(int i){
-    const ComponentMask req = (CMP_POS | CMP_COL | CMP_PHYS_BODY);
-    if ((ecs_mask[i] & req) != req) return;
+    const ComponentMask req = CMP_SET(CMP_POS, CMP_COL, CMP_PHYS_BODY);
+    if (!component_mask_all(ecs_mask[i], req)) return;
     if (cmp_phys_body[i].created) return;
     if (phys_body_create_hook) {
         phys_body_create_hook(i);
@@ -28,7 +28,7 @@ static void try_create_phys_body(int i){
 
 bool ecs_get_position(ecs_entity_t e, gfx_vec2* out_pos){
     int idx = ent_index_checked(e);
-    if (idx < 0 || !(ecs_mask[idx] & CMP_POS)) return false;
+    if (idx < 0 || !component_mask_any(ecs_mask[idx], CMP_POS)) return false;
     if (out_pos) {
         *out_pos = gfx_vec2_make(cmp_pos[idx].x, cmp_pos[idx].y);
     }
@@ -39,8 +39,9 @@ void cmp_add_position(ecs_entity_t e, float x, float y)
 {
     int i = ent_index_checked(e);
     if (i < 0) return;
-    ecs_mask[i] |= CMP_POS;
+    ecs_mask_add(i, CMP_POS);
     cmp_pos[i] = (cmp_position_t){ .x = x, .y = y };
+    ecs_mark_changed(i, CMP_POS);
     try_create_phys_body(i);
 }
 
@@ -55,7 +56,7 @@ void cmp_add_velocity(ecs_entity_t e, float x, float y, facing_t direction)
         .candidateTime = 0.0f
     };
     cmp_vel[i] = (cmp_velocity_t){ .x = x, .y = y, .facing = smoothed_dir };
-    ecs_mask[i] |= CMP_VEL;
+    ecs_mask_add(i, CMP_VEL);
 }
 
 void cmp_add_trigger(ecs_entity_t e, float pad, ComponentMask target_mask, trigger_match_t match)
@@ -63,14 +64,14 @@ void cmp_add_trigger(ecs_entity_t e, float pad, ComponentMask target_mask, trigg
     int i = ent_index_checked(e);
     if (i < 0) return;
     cmp_trigger[i] = (cmp_trigger_t){ .pad = pad, .target_mask = target_mask, .match = match };
-    ecs_mask[i] |= CMP_TRIGGER;
+    ecs_mask_add(i, CMP_TRIGGER);
 }
 
 void cmp_add_billboard(ecs_entity_t e, const char* text, float y_off, float linger, billboard_state_t state)
 {
     int i = ent_index_checked(e);
     if (i < 0) return;
-    if ((ecs_mask[i] & (CMP_TRIGGER)) != (CMP_TRIGGER)) {
+    if (!component_mask_all(ecs_mask[i], CMP_TRIGGER)) {
         LOGC(LOGCAT_ECS, LOG_LVL_WARN, "Billboard added to entity without trigger. ENTITY: %i, %i", e.idx, e.gen);
     }
     strncpy(cmp_billboard[i].text, text, sizeof(cmp_billboard[i].text) - 1);
@@ -79,7 +80,7 @@ void cmp_add_billboard(ecs_entity_t e, const char* text, float y_off, float ling
     cmp_billboard[i].linger   = linger;
     cmp_billboard[i].timer    = 0.0f;
     cmp_billboard[i].state    = state;
-    ecs_mask[i] |= CMP_BILLBOARD;
+    ecs_mask_add(i, CMP_BILLBOARD);
 }
 
 void cmp_add_size(ecs_entity_t e, float hx, float hy)
@@ -87,7 +88,8 @@ void cmp_add_size(ecs_entity_t e, float hx, float hy)
     int i = ent_index_checked(e);
     if (i < 0) return;
     cmp_col[i] = (cmp_collider_t){ .hx = hx, .hy = hy };
-    ecs_mask[i] |= CMP_COL;
+    ecs_mask_add(i, CMP_COL);
+    ecs_mark_changed(i, CMP_COL);
     try_create_phys_body(i);
 }
 
@@ -108,19 +110,38 @@ void cmp_add_phys_body(ecs_entity_t e, PhysicsType type, float mass, unsigned in
         .default_type = type,
         .created = false
     };
-    ecs_mask[i] |= CMP_PHYS_BODY;
+    ecs_mask_add(i, CMP_PHYS_BODY);
     try_create_phys_body(i);
 }
 
 void ecs_register_render_component_hooks(void);
 void ecs_register_physics_component_hooks(void);
+void ecs_register_anim_component_hooks(void);
 void ecs_anim_reset_allocator(void);
 void ecs_anim_shutdown_allocator(void);
 
+static void ecs_engine_register_storage(void)
+{
+    ECS_REGISTER_STORAGE(cmp_pos);
+    ECS_REGISTER_STORAGE(cmp_vel);
+    ECS_REGISTER_STORAGE(cmp_anim);
+    ECS_REGISTER_STORAGE(cmp_spr);
+    ECS_REGISTER_STORAGE(cmp_col);
+    ECS_REGISTER_STORAGE(cmp_phys_body);
+    ECS_REGISTER_STORAGE(cmp_trigger);
+    ECS_REGISTER_STORAGE(cmp_billboard);
+
+    ecs_track_changes(ENUM_POS);
+    ecs_track_changes(ENUM_COL);
+    ecs_track_changes(ENUM_SPR);
+}
+
 void ecs_engine_init(void)
 {
+    ecs_engine_register_storage();
     ecs_register_render_component_hooks();
     ecs_register_physics_component_hooks();
+    ecs_register_anim_component_hooks();
     ecs_anim_reset_allocator();
     debug_str_engine_register_all();
 }
@@ -59,14 +59,14 @@ typedef struct {
 } cmp_billboard_t;
 
 // ===== Engine component storage =====
-extern cmp_position_t cmp_pos[ECS_MAX_ENTITIES];
-extern cmp_velocity_t cmp_vel[ECS_MAX_ENTITIES];
-extern cmp_anim_t cmp_anim[ECS_MAX_ENTITIES];
-extern cmp_sprite_t cmp_spr[ECS_MAX_ENTITIES];
-extern cmp_collider_t cmp_col[ECS_MAX_ENTITIES];
-extern cmp_phys_body_t cmp_phys_body[ECS_MAX_ENTITIES];
-extern cmp_trigger_t cmp_trigger[ECS_MAX_ENTITIES];
-extern cmp_billboard_t cmp_billboard[ECS_MAX_ENTITIES];
+extern cmp_position_t* cmp_pos;
+extern cmp_velocity_t* cmp_vel;
+extern cmp_anim_t* cmp_anim;
+extern cmp_sprite_t* cmp_spr;
+extern cmp_collider_t* cmp_col;
+extern cmp_phys_body_t* cmp_phys_body;
+extern cmp_trigger_t* cmp_trigger;
+extern cmp_billboard_t* cmp_billboard;
 
 void ecs_engine_init(void);
 void ecs_engine_shutdown(void);
@@ -0,0 +1,149 @@
+//==== FROM ecs_event.c ====
+#include "engine/ecs/ecs_event.h"
+#include "engine/core/logger/logger.h"
+
+#include <string.h>
+
+static DA(ecs_event_queue_t*) g_event_queues;
+
+void ecs_event_register(ecs_event_queue_t* q)
+{
+    if (!q || q->registered) return;
+    if (q->elem_size == 0 || (int)q->phase < 0 || q->phase >= PHASE_COUNT) {
+        LOGC(LOGCAT_ECS, LOG_LVL_ERROR, "ecs: bad event queue %s", q->name ? q->name : "(unnamed)");
+        return;
+    }
+    q->registered = true;
+    DA_APPEND(&g_event_queues, q);
+}
+
+void ecs_event_emit(ecs_event_queue_t* q, const void* ev, size_t elem_size)
+{
+    if (!q || !ev) return;
+    if (elem_size != q->elem_size || !q->registered) {
+        LOGC(LOGCAT_ECS, LOG_LVL_ERROR, "ecs: event %s emitted with size %zu (queue %zu, registered=%d)",
+             q->name, elem_size, q->elem_size, q->registered ? 1 : 0);
+        return;
+    }
+    DA_RESERVE(&q->buf[!q->read], q->buf[!q->read].size + elem_size);
+    memcpy(q->buf[!q->read].data + q->buf[!q->read].size, ev, elem_size);
+    q->buf[!q->read].size += elem_size;
+}
+
+size_t ecs_event_count(const ecs_event_queue_t* q)
+{
+    return q ? q->buf[q->read].size / q->elem_size : 0;
+}
+
+const void* ecs_event_data(const ecs_event_queue_t* q, size_t elem_size)
+{
+    if (!q || elem_size != q->elem_size || q->buf[q->read].size == 0) return NULL;
+    return q->buf[q->read].data;
+}
+
+void ecs_event_swap_phase(systems_phase_t phase)
+{
+    for (size_t i = 0; i < g_event_queues.size; ++i) {
+        ecs_event_queue_t* q = g_event_queues.data[i];
+        if (q->phase != phase) continue;
+        q->read = !q->read;
+        DA_CLEAR(&q->buf[!q->read]);
+    }
+}
+
+void ecs_event_reset_all(void)
+{
+    for (size_t i = 0; i < g_event_queues.size; ++i) {
+        ecs_event_queue_t* q = g_event_queues.data[i];
+        DA_FREE(&q->buf[0]);
+        DA_FREE(&q->buf[1]);
+        q->read = 0;
+        q->registered = false;
+    }
+    DA_FREE(&g_event_queues);
+}
+
+// =============== Snapshot ===================
+// Per queue: name, elem_size, visible bytes, pending bytes.
+bool ecs_event_snapshot_save(byte_buf_t* out)
+{
+    if (!out) return false;
+    bool ok = byte_buf_write_u32(out, (uint32_t)g_event_queues.size);
+    for (size_t i = 0; ok && i < g_event_queues.size; ++i) {
+        const ecs_event_queue_t* q = g_event_queues.data[i];
+        const uint32_t name_len = (uint32_t)strlen(q->name);
+        ok = byte_buf_write_u32(out, name_len)
+            && byte_buf_write(out, q->name, name_len)
+            && byte_buf_write_u32(out, (uint32_t)q->elem_size)
+            && byte_buf_write_u32(out, (uint32_t)q->buf[q->read].size)
+            && byte_buf_write(out, q->buf[q->read].data, q->buf[q->read].size)
+            && byte_buf_write_u32(out, (uint32_t)q->buf[!q->read].size)
+            && byte_buf_write(out, q->buf[!q->read].data, q->buf[!q->read].size);
+    }
+    return ok;
+}
+
+static ecs_event_queue_t* event_queue_find(const char* name, size_t len)
+{
+    for (size_t i = 0; i < g_event_queues.size; ++i) {
+        ecs_event_queue_t* q = g_event_queues.data[i];
+        if (strlen(q->name) == len && memcmp(q->name, name, len) == 0) return q;
+    }
+    return NULL;
+}
+
+static bool event_snapshot_section(byte_reader_t* in, bool apply)
+{
+    const uint32_t name_len = byte_reader_u32(in);
+    const char* name = byte_reader_view(in, name_len);
+    const uint32_t elem_size = byte_reader_u32(in);
+    if (!in->ok) return false;
+    ecs_event_queue_t* q = event_queue_find(name, name_len);
+    if (!q || q->elem_size != elem_size) {
+        LOGC(LOGCAT_ECS, LOG_LVL_ERROR, "ecs: snapshot event queue %.*s does not match", (int)name_len, name);
+        return false;
+    }
+    for (int k = 0; k < 2; ++k) {
+        const uint32_t size = byte_reader_u32(in);
+        const void* bytes = byte_reader_view(in, size);
+        if (!in->ok || size % elem_size != 0) return false;
+        if (!apply) continue;
+        // k == 0 is the visible buffer, k == 1 the pending one.
+        if (size > 0) {
+            DA_RESERVE(&q->buf[k], size);
+            memcpy(q->buf[k].data, bytes, size);
+        }
+        q->buf[k].size = size;
+    }
+    if (apply) q->read = 0;
+    return true;
+}
+
+bool ecs_event_snapshot_check(byte_reader_t* in)
+{
+    if (!in) return false;
+    const uint32_t count = byte_reader_u32(in);
+    for (uint32_t i = 0; i < count; ++i) {
+        if (!event_snapshot_section(in, false)) return false;
+    }
+    return in->ok;
+}
+
+bool ecs_event_snapshot_load(byte_reader_t* in)
+{
+    if (!in) return false;
+    byte_reader_t check = *in;
+    if (!ecs_event_snapshot_check(&check)) return false;
+    const uint32_t count = byte_reader_u32(in);
+
+    for (size_t i = 0; i < g_event_queues.size; ++i) {
+        ecs_event_queue_t* q = g_event_queues.data[i];
+        DA_CLEAR(&q->buf[0]);
+        DA_CLEAR(&q->buf[1]);
+        q->read = 0;
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        event_snapshot_section(in, true);
+    }
+    return in->ok;
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "engine/engine/engine_scheduler/engine_scheduler.h"
+#include "engine/utils/byte_buf.h"
+#include "engine/utils/dynarray.h"
+
+// Typed, double-buffered event queues. Producers append to the write
+// buffer whenever they like; when the queue's phase ends the scheduler
+// swaps the buffers, and for the next window every consumer sees exactly
+// the events raised during the previous one. Nothing has to clear
+// per-entity flags, and a consumer with no events does no work.
+//
+// Pick the swap phase so producers sit before it and consumers after it;
+// a consumer running in the swap phase itself sees the window that is
+// about to close. Payloads are plain data; entity handles in them resolve
+// through ent_index_checked across an ecs_compact().
+typedef struct {
+    const char* name;
+    size_t elem_size;
+    systems_phase_t phase;      // buffers swap when this phase ends
+    DA(uint8_t) buf[2];
+    int read;                   // buf[read] is visible, buf[!read] collects
+    bool registered;
+} ecs_event_queue_t;
+
+// File-scope definition: `ecs_event_queue_t q = ECS_EVENT_QUEUE(T, PHASE_X);`
+#define ECS_EVENT_QUEUE(T, swap_phase) \
+    { .name = #T, .elem_size = sizeof(T), .phase = (swap_phase) }
+
+// Queues take part in swaps and snapshots once registered (at init, next to
+// the owning module's storage).
+void ecs_event_register(ecs_event_queue_t* q);
+
+void        ecs_event_emit(ecs_event_queue_t* q, const void* ev, size_t elem_size);
+size_t      ecs_event_count(const ecs_event_queue_t* q);
+const void* ecs_event_data(const ecs_event_queue_t* q, size_t elem_size);
+
+// ECS_EVENT_EMIT(q, game_ev_dropped_t, .item = e);
+#define ECS_EVENT_EMIT(q, T, ...) \
+    ecs_event_emit(&(q), &(T){ __VA_ARGS__ }, sizeof(T))
+
+// ECS_EVENT_EACH(q, game_ev_dropped_t, ev) { ... ev->item ... }
+#define ECS_EVENT_EACH(q, T, var)                                              \
+    for (const T *var = (const T*)ecs_event_data(&(q), sizeof(T)),             \
+                 *var##_end = var ? var + ecs_event_count(&(q)) : var;         \
+         var != var##_end; ++var)
+
+// Called by the scheduler after each phase's command flush.
+void ecs_event_swap_phase(systems_phase_t phase);
+
+// Pending and visible events of every registered queue, matched by name.
+bool ecs_event_snapshot_save(byte_buf_t* out);
+bool ecs_event_snapshot_load(byte_reader_t* in);
+// Validates the section and advances `in` past it; no queue is touched.
+bool ecs_event_snapshot_check(byte_reader_t* in);
+
+// ===== Internal: driven by ecs_core =====
+void ecs_event_reset_all(void);
@@ -12,16 +12,15 @@
 #include <string.h>
 
 // --- SPRITES ---
-ecs_sprite_iter_t ecs_sprites_begin(void) { return (ecs_sprite_iter_t){ .i = -1 }; }
+ecs_sprite_iter_t ecs_sprites_begin(void)
+{
+    return (ecs_sprite_iter_t){ .q = ecs_query_begin(ecs_query_get(CMP_SET(CMP_POS, CMP_SPR), CMP_NONE)) };
+}
 
 bool ecs_sprites_next(ecs_sprite_iter_t* it, ecs_sprite_view_t* out)
 {
-    for (int i = it->i + 1; i < ECS_MAX_ENTITIES; ++i) {
-        if (!ecs_alive_idx(i)) continue;
-        if ((ecs_mask[i] & (CMP_POS | CMP_SPR)) != (CMP_POS | CMP_SPR)) continue;
-
-        it->i = i;
-
+    int i;
+    while (ecs_query_next(&it->q, &i)) {
         *out = (ecs_sprite_view_t){
             .tex = cmp_spr[i].tex,
             .src = cmp_spr[i].src,
@@ -40,16 +39,16 @@ bool ecs_sprites_next(ecs_sprite_iter_t* it, ecs_sprite_view_t* out)
 }
 
 // --- COLLIDERS ---
-ecs_collider_iter_t ecs_colliders_begin(void) { return (ecs_collider_iter_t){ .i = -1 }; }
+ecs_collider_iter_t ecs_colliders_begin(void)
+{
+    return (ecs_collider_iter_t){ .q = ecs_query_begin(ecs_query_get(CMP_SET(CMP_POS, CMP_COL), CMP_NONE)) };
+}
 
 bool ecs_colliders_next(ecs_collider_iter_t* it, ecs_collider_view_t* out)
 {
-    for (int i = it->i + 1; i < ECS_MAX_ENTITIES; ++i) {
-        if (!ecs_alive_idx(i)) continue;
-        if ((ecs_mask[i] & (CMP_POS | CMP_COL)) != (CMP_POS | CMP_COL)) continue;
-
-        it->i = i;
-        bool has_phys = ((ecs_mask[i] & CMP_PHYS_BODY) && cmp_phys_body[i].created);
+    int i;
+    while (ecs_query_next(&it->q, &i)) {
+        bool has_phys = (component_mask_any(ecs_mask[i], CMP_PHYS_BODY) && cmp_phys_body[i].created);
         float ecs_x = cmp_pos[i].x;
         float ecs_y = cmp_pos[i].y;
         float phys_x = ecs_x;
@@ -69,19 +68,18 @@ bool ecs_colliders_next(ecs_collider_iter_t* it, ecs_collider_view_t* out)
 }
 
 // --- TRIGGERS ---
-ecs_trigger_iter_t ecs_triggers_begin(void) { return (ecs_trigger_iter_t){ .i = -1 }; }
+ecs_trigger_iter_t ecs_triggers_begin(void)
+{
+    return (ecs_trigger_iter_t){ .q = ecs_query_begin(ecs_query_get(CMP_SET(CMP_POS, CMP_TRIGGER), CMP_NONE)) };
+}
 
 bool ecs_triggers_next(ecs_trigger_iter_t* it, ecs_trigger_view_t* out)
 {
-    for (int i = it->i + 1; i < ECS_MAX_ENTITIES; ++i) {
-        if (!ecs_alive_idx(i)) continue;
-        if ((ecs_mask[i] & (CMP_POS | CMP_TRIGGER)) != (CMP_POS | CMP_TRIGGER)) continue;
-
-        it->i = i;
-
+    int i;
+    while (ecs_query_next(&it->q, &i)) {
         float collider_hx = 0.0f;
         float collider_hy = 0.0f;
-        if(ecs_mask[i] & CMP_COL) {
+        if(component_mask_any(ecs_mask[i], CMP_COL)) {
             collider_hx = cmp_col[i].hx;
             collider_hy = cmp_col[i].hy;
         }
@@ -99,17 +97,18 @@ bool ecs_triggers_next(ecs_trigger_iter_t* it, ecs_trigger_view_t* out)
 }
 
 // --- BILLBOARDS ---
-ecs_billboard_iter_t ecs_billboards_begin(void) { return (ecs_billboard_iter_t){ .i = -1 }; }
+ecs_billboard_iter_t ecs_billboards_begin(void)
+{
+    return (ecs_billboard_iter_t){ .q = ecs_query_begin(ecs_query_get(CMP_SET(CMP_POS, CMP_BILLBOARD), CMP_NONE)) };
+}
 
 bool ecs_billboards_next(ecs_billboard_iter_t* it, ecs_billboard_view_t* out)
 {
-    for (int i = it->i + 1; i < ECS_MAX_ENTITIES; ++i) {
-        if (!ecs_alive_idx(i)) continue;
-        if ((ecs_mask[i] & (CMP_POS|CMP_BILLBOARD)) != (CMP_POS|CMP_BILLBOARD)) continue;
+    int i;
+    while (ecs_query_next(&it->q, &i)) {
         if (cmp_billboard[i].state != BILLBOARD_ACTIVE) continue;
         if (cmp_billboard[i].timer <= 0.0f) continue;
 
-        it->i = i;
 
         float a = 1.0f;
         if (cmp_billboard[i].linger > 0.0f) {
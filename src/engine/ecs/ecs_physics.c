@@ -7,8 +7,8 @@
 
 void ecs_phys_body_create_for_entity(int idx)
 {
-    const ComponentMask req = (CMP_POS | CMP_COL | CMP_PHYS_BODY);
-    if (!ecs_alive_idx(idx) || (ecs_mask[idx] & req) != req) return;
+    const ComponentMask req = CMP_SET(CMP_POS, CMP_COL, CMP_PHYS_BODY);
+    if (!ecs_alive_idx(idx) || !component_mask_all(ecs_mask[idx], req)) return;
 
     cmp_phys_body_t* pb = &cmp_phys_body[idx];
     if (pb->created) return;
@@ -18,16 +18,14 @@ void ecs_phys_body_create_for_entity(int idx)
 
 void ecs_phys_body_destroy_for_entity(int idx)
 {
-    if (idx < 0 || idx >= ECS_MAX_ENTITIES) return;
+    if (idx < 0 || idx >= ecs_capacity()) return;
     cmp_phys_body_t* pb = &cmp_phys_body[idx];
     pb->created = false;
 }
 
 void ecs_phys_destroy_all(void)
 {
-    for (int i = 0; i < ECS_MAX_ENTITIES; ++i) {
-        if (!ecs_alive_idx(i)) continue;
-        if (!(ecs_mask[i] & CMP_PHYS_BODY)) continue;
+    ECS_QUERY_EACH(ecs_query_get(CMP_PHYS_BODY, CMP_NONE), i) {
         ecs_phys_body_destroy_for_entity(i);
     }
 }
@@ -1,4 +1,5 @@
 #pragma once
+#include <stddef.h>
 #include <stdint.h>
 #include "engine/ecs/ecs_physics_types.h"
 
@@ -7,6 +8,10 @@ void ecs_phys_body_create_for_entity(int idx);
 void ecs_phys_body_destroy_for_entity(int idx);
 void ecs_phys_destroy_all(void);
 
+// Pairs of bodies left touching by the last physics step, as entity indices
+// with a < b. Writes up to `cap` pairs and returns how many there are.
+size_t ecs_phys_touching_pairs(int* out_a, int* out_b, size_t cap);
+
 // Returns a stable bit for the given tag name, creating it if needed.
 unsigned int phys_tag_bit(const char* name);
 
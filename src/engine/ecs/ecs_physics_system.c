@@ -8,24 +8,642 @@
 #include "engine/world/world_map.h"
 #include "engine/world/world_query.h"
 #include "engine/engine/engine_scheduler/engine_scheduler.h"
+#include "engine/core/jobs/jobs.h"
+#include "engine/utils/bits.h"
 #include <math.h>
+#include <stdlib.h>
+#include <string.h>
 
-static void resolve_tile_penetration(int i)
+// ---- Tile batches --------------------------------------------------------------
+// Bodies handed to the batched world queries, staged as structure-of-arrays.
+typedef struct {
+    DA(int)   body;
+    DA(float) cx, cy, hx, hy, dx, dy, t;
+    DA(bool)  pushed;
+} phys_tile_batch_t;
+
+static phys_tile_batch_t g_phys_tiles;
+
+static void phys_tile_batch_reset(size_t n)
+{
+    phys_tile_batch_t* b = &g_phys_tiles;
+    DA_RESERVE(&b->body, n);
+    DA_RESERVE(&b->cx, n);
+    DA_RESERVE(&b->cy, n);
+    DA_RESERVE(&b->hx, n);
+    DA_RESERVE(&b->hy, n);
+    DA_RESERVE(&b->dx, n);
+    DA_RESERVE(&b->dy, n);
+    DA_RESERVE(&b->t, n);
+    DA_RESERVE(&b->pushed, n);
+    b->body.size = 0;
+}
+
+static void phys_tile_batch_add(int e, float dx, float dy)
+{
+    phys_tile_batch_t* b = &g_phys_tiles;
+    const size_t k = b->body.size++;
+    b->body.data[k] = e;
+    b->cx.data[k] = cmp_pos[e].x;
+    b->cy.data[k] = cmp_pos[e].y;
+    b->hx.data[k] = cmp_col[e].hx;
+    b->hy.data[k] = cmp_col[e].hy;
+    b->dx.data[k] = dx;
+    b->dy.data[k] = dy;
+}
+
+// ---- Sleeping ----------------------------------------------------------------
+// A body that spent PHYS_SLEEP_TICKS steps without intent, contact, tile push
+// or outside writes to its POS/COL sleeps: it is skipped by tile resolution
+// and, being clean (below), only tested against bodies that moved. Two
+// sleepers can never overlap (the later of the two went to sleep after a step
+// in which neither moved and they were tested apart), so skipping them
+// changes no result. Any contact wakes a sleeper on the spot; a collision
+// grid edit wakes all.
+static ecs_version_t g_phys_seen_version;
+static uint32_t      g_phys_seen_collision;
+
+static bool phys_asleep(int e)
+{
+    return cmp_phys_body[e].quiet_ticks >= PHYS_SLEEP_TICKS;
+}
+
+static void phys_wake(int e, bool* stirred)
+{
+    stirred[e] = true;
+    cmp_phys_body[e].quiet_ticks = 0;
+}
+
+// ---- Contact cache -----------------------------------------------------------
+// Pairs found overlapping (resolved, filtered or static-static) at their last
+// test, carried from step to step by handle. A pass only has to test pairs
+// with a dirty body (one that moved during the previous pass, or before the
+// first pass) plus, in the first pass, the cached contacts: a pair
+// of clean bodies that was apart when last tested is still apart. Bodies that
+// were not bodies last step, or that moved in the last pass of a step which
+// ran out of passes, start the next step dirty. Results match testing every
+// neighbouring pair; the cache only decides which tests can be skipped.
+typedef struct { ecs_entity_t a, b; } phys_contact_t;
+typedef struct { int from, to; } phys_contact_link_t;
+typedef struct { int lo, hi; bool touching; } phys_contact_rec_t;
+
+enum {
+    PHYS_CARRY_NONE = 0,    // not a body at the end of the last step
+    PHYS_CARRY_SETTLED,
+    PHYS_CARRY_UNSETTLED,
+};
+
+static DA(phys_contact_t)      g_phys_contacts;      // last step's contacts
+static DA(phys_contact_link_t) g_phys_contact_links; // same, both directions, by `from`
+static DA(phys_contact_rec_t)  g_phys_contact_recs;  // this step's latest results
+static DA(int)                 g_phys_contact_slots; // open-addressed index into recs (+1)
+static DA(uint8_t)             g_phys_carry;         // per entity index, PHYS_CARRY_*
+
+static int phys_contact_link_cmp(const void* pa, const void* pb)
+{
+    const phys_contact_link_t* a = pa;
+    const phys_contact_link_t* b = pb;
+    if (a->from != b->from) return (a->from < b->from) ? -1 : 1;
+    return (a->to < b->to) ? -1 : (a->to > b->to);
+}
+
+static void phys_contact_slots_reset(size_t want)
+{
+    size_t n = 64;
+    while (n < want * 2) n *= 2;
+    DA_RESERVE(&g_phys_contact_slots, n);
+    g_phys_contact_slots.size = n;
+    memset(g_phys_contact_slots.data, 0, n * sizeof(*g_phys_contact_slots.data));
+}
+
+static int* phys_contact_slot(int lo, int hi)
+{
+    const size_t mask = g_phys_contact_slots.size - 1;
+    size_t h = (((uint32_t)lo * 0x9E3779B1u) ^ ((uint32_t)hi * 0x85EBCA77u)) & mask;
+    for (;; h = (h + 1) & mask) {
+        int* slot = &g_phys_contact_slots.data[h];
+        if (!*slot) return slot;
+        const phys_contact_rec_t* r = &g_phys_contact_recs.data[*slot - 1];
+        if (r->lo == lo && r->hi == hi) return slot;
+    }
+}
+
+// Turns last step's contacts into per-body links. `first` gets 1 + the
+// position of each body's first link, 0 when it has none.
+static void phys_contact_begin(int* first)
+{
+    DA_CLEAR(&g_phys_contact_links);
+    for (size_t k = 0; k < g_phys_contacts.size; ++k) {
+        const int a = ent_index_checked(g_phys_contacts.data[k].a);
+        const int b = ent_index_checked(g_phys_contacts.data[k].b);
+        if (a < 0 || b < 0) continue;
+        DA_APPEND(&g_phys_contact_links, ((phys_contact_link_t){ a, b }));
+        DA_APPEND(&g_phys_contact_links, ((phys_contact_link_t){ b, a }));
+    }
+    if (g_phys_contact_links.size > 1) {
+        qsort(g_phys_contact_links.data, g_phys_contact_links.size,
+              sizeof(*g_phys_contact_links.data), phys_contact_link_cmp);
+    }
+    for (size_t k = g_phys_contact_links.size; k-- > 0;) {
+        first[g_phys_contact_links.data[k].from] = (int)k + 1;
+    }
+    DA_CLEAR(&g_phys_contact_recs);
+    phys_contact_slots_reset(g_phys_contacts.size);
+}
+
+// Keeps the latest result per pair. An apart pair can only be on record if
+// both bodies touched something this step, and touching stirs them.
+static void phys_contact_record(int a, int b, bool touching, const bool* stirred)
+{
+    if (!touching && !(stirred[a] && stirred[b])) return;
+    const int lo = a < b ? a : b;
+    const int hi = a < b ? b : a;
+    int* slot = phys_contact_slot(lo, hi);
+    if (*slot) {
+        g_phys_contact_recs.data[*slot - 1].touching = touching;
+        return;
+    }
+    if (!touching) return;
+    DA_APPEND(&g_phys_contact_recs, ((phys_contact_rec_t){ lo, hi, true }));
+    *slot = (int)g_phys_contact_recs.size;
+    if (g_phys_contact_recs.size * 2 > g_phys_contact_slots.size) {
+        phys_contact_slots_reset(g_phys_contact_recs.size);
+        for (size_t k = 0; k < g_phys_contact_recs.size; ++k) {
+            *phys_contact_slot(g_phys_contact_recs.data[k].lo, g_phys_contact_recs.data[k].hi) = (int)k + 1;
+        }
+    }
+}
+
+// Cached contacts that were not tested this step were apart (their bodies
+// ended up out of each other's neighbourhood), so only this step's touching
+// results carry over.
+static void phys_contact_end(void)
+{
+    DA_CLEAR(&g_phys_contacts);
+    for (size_t k = 0; k < g_phys_contact_recs.size; ++k) {
+        const phys_contact_rec_t* r = &g_phys_contact_recs.data[k];
+        if (!r->touching) continue;
+        DA_APPEND(&g_phys_contacts, ((phys_contact_t){ handle_from_index(r->lo), handle_from_index(r->hi) }));
+    }
+}
+
+size_t ecs_phys_touching_pairs(int* out_a, int* out_b, size_t cap)
+{
+    size_t n = 0;
+    for (size_t k = 0; k < g_phys_contacts.size; ++k) {
+        const int a = ent_index_checked(g_phys_contacts.data[k].a);
+        const int b = ent_index_checked(g_phys_contacts.data[k].b);
+        if (a < 0 || b < 0) continue;
+        if (n < cap) {
+            out_a[n] = a;
+            out_b[n] = b;
+        }
+        n++;
+    }
+    return n;
+}
+
+static uint8_t phys_carry_get(int e)
+{
+    return ((size_t)e < g_phys_carry.size) ? g_phys_carry.data[e] : PHYS_CARRY_NONE;
+}
+
+// ---- Broadphase -------------------------------------------------------------
+// Uniform grid over the map; each body is linked into the cell holding its
+// centre. A body no larger than a cell can only overlap bodies whose centres
+// are in the 3x3 cells around its own, so pair tests scale with neighbours
+// rather than with the body count. Cells are sized to the largest body, up
+// to two tiles; anything bigger lives on an oversized list that every gather
+// scans. Cells also count their dirty bodies so a clean body in a clean
+// neighbourhood costs nine reads. The grid is rebuilt at the start of each
+// pass and read-only after that. Per-entity links come from ecs_scratch and
+// are stored +1 so zero means "none".
+typedef struct {
+    int w, h;
+    float inv_cell;
+    int iter;           // current solver pass
+    int awake;          // awake bodies in the grid
+    int oversized_dirty;
+    int* rank;          // 1 + position in the body query, 0 when not a body
+    int* cell;          // 1 + cell index, 0 when oversized
+    int* next;
+    int* mark;          // pass + 2 of the last move, 1 if stirred before the passes
+    int* contact_first; // see phys_contact_begin
+} phys_grid_t;
+
+static DA(int) g_phys_grid_head;       // first body per cell (+1)
+static DA(int) g_phys_grid_dirty;      // dirty bodies per cell
+static DA(int) g_phys_grid_oversized;
+static DA(int) g_phys_grid_cand[JOBS_MAX_WORKERS + 1]; // gather output per worker, ascending rank
+
+static bool phys_dirty(const phys_grid_t* g, int e)
+{
+    return g->mark[e] > g->iter;
+}
+
+static int phys_grid_cell_coord(const phys_grid_t* g, float v, int n)
+{
+    const float c = floorf(v * g->inv_cell);
+    if (!(c >= 0.0f)) return 0;
+    return (c >= (float)n) ? n - 1 : (int)c;
+}
+
+static void phys_grid_link(phys_grid_t* g, int e)
+{
+    const int c = phys_grid_cell_coord(g, cmp_pos[e].y, g->h) * g->w
+                + phys_grid_cell_coord(g, cmp_pos[e].x, g->w);
+    g->cell[e] = c + 1;
+    g->next[e] = g_phys_grid_head.data[c];
+    g_phys_grid_head.data[c] = e + 1;
+    if (phys_dirty(g, e)) g_phys_grid_dirty.data[c]++;
+}
+
+static void phys_grid_build(phys_grid_t* g, const int* body_idx, int body_count)
+{
+    const float max_cell = 2.0f * (float)world_tile_size();
+    float cell = 8.0f;
+    for (int k = 0; k < body_count; ++k) {
+        const int e = body_idx[k];
+        const float extent = 2.0f * fmaxf(cmp_col[e].hx, cmp_col[e].hy);
+        if (extent > cell && extent <= max_cell) cell = extent;
+    }
+    // One pixel of slack so float rounding can't put touching centres two cells apart.
+    g->inv_cell = 1.0f / (cell + 1.0f);
+
+    int world_w = 0, world_h = 0;
+    world_size_px(&world_w, &world_h);
+    g->w = (int)ceilf((float)world_w * g->inv_cell);
+    g->h = (int)ceilf((float)world_h * g->inv_cell);
+    if (g->w < 1) g->w = 1;
+    if (g->h < 1) g->h = 1;
+
+    const size_t cells = (size_t)g->w * (size_t)g->h;
+    DA_RESERVE(&g_phys_grid_head, cells);
+    DA_RESERVE(&g_phys_grid_dirty, cells);
+    g_phys_grid_head.size = cells;
+    g_phys_grid_dirty.size = cells;
+    memset(g_phys_grid_head.data, 0, cells * sizeof(*g_phys_grid_head.data));
+    memset(g_phys_grid_dirty.data, 0, cells * sizeof(*g_phys_grid_dirty.data));
+    DA_CLEAR(&g_phys_grid_oversized);
+    g->awake = 0;
+    g->oversized_dirty = 0;
+
+    for (int k = 0; k < body_count; ++k) {
+        const int e = body_idx[k];
+        g->rank[e] = k + 1;
+        if (!phys_asleep(e)) g->awake++;
+        if (2.0f * fmaxf(cmp_col[e].hx, cmp_col[e].hy) > cell) {
+            g->cell[e] = 0;
+            DA_APPEND(&g_phys_grid_oversized, e);
+            if (phys_dirty(g, e)) g->oversized_dirty++;
+        } else {
+            phys_grid_link(g, e);
+        }
+    }
+}
+
+static void phys_grid_cand_push(const phys_grid_t* g, int worker, int e, int min_rank, bool dirty_only)
+{
+    if (g->rank[e] <= min_rank || !cmp_phys_body[e].created) return;
+    if (dirty_only && !phys_dirty(g, e)) return;
+    DA_APPEND(&g_phys_grid_cand[worker], e);
+}
+
+// Bodies ranked above `min_rank` that may overlap `a`, in rank order, into
+// the worker's candidate list. A clean `a` only needs its dirty neighbours
+// and, in the first pass, its cached contacts.
+static void phys_grid_gather(const phys_grid_t* g, int worker, int a, int min_rank, const int* body_idx, int body_count)
+{
+    DA_CLEAR(&g_phys_grid_cand[worker]);
+    const bool dirty_only = !phys_dirty(g, a);
+    if (dirty_only && g->iter == 0 && g->contact_first[a]) {
+        for (size_t k = (size_t)g->contact_first[a] - 1;
+             k < g_phys_contact_links.size && g_phys_contact_links.data[k].from == a; ++k) {
+            const int b = g_phys_contact_links.data[k].to;
+            if (g->rank[b] > min_rank && cmp_phys_body[b].created && !phys_dirty(g, b)) {
+                DA_APPEND(&g_phys_grid_cand[worker], b);
+            }
+        }
+    }
+    if (!g->cell[a]) {
+        for (int k = min_rank; k < body_count; ++k) {
+            phys_grid_cand_push(g, worker, body_idx[k], min_rank, dirty_only);
+        }
+    } else {
+        const int cx = phys_grid_cell_coord(g, cmp_pos[a].x, g->w);
+        const int cy = phys_grid_cell_coord(g, cmp_pos[a].y, g->h);
+        const int x0 = cx > 0 ? cx - 1 : 0;
+        const int y0 = cy > 0 ? cy - 1 : 0;
+        const int x1 = cx < g->w - 1 ? cx + 1 : cx;
+        const int y1 = cy < g->h - 1 ? cy + 1 : cy;
+        int near_dirty = 1;
+        if (dirty_only) {
+            near_dirty = g->oversized_dirty;
+            for (int y = y0; y <= y1; ++y) {
+                for (int x = x0; x <= x1; ++x) near_dirty += g_phys_grid_dirty.data[y * g->w + x];
+            }
+        }
+        if (near_dirty > 0) {
+            for (int y = y0; y <= y1; ++y) {
+                for (int x = x0; x <= x1; ++x) {
+                    for (int n = g_phys_grid_head.data[y * g->w + x]; n; n = g->next[n - 1]) {
+                        phys_grid_cand_push(g, worker, n - 1, min_rank, dirty_only);
+                    }
+                }
+            }
+            for (size_t k = 0; k < g_phys_grid_oversized.size; ++k) {
+                phys_grid_cand_push(g, worker, g_phys_grid_oversized.data[k], min_rank, dirty_only);
+            }
+        }
+    }
+
+    // Neighbourhoods are small; insertion sort keeps the pair list in rank order.
+    int* cand = g_phys_grid_cand[worker].data;
+    for (size_t i = 1; i < g_phys_grid_cand[worker].size; ++i) {
+        const int e = cand[i];
+        size_t j = i;
+        for (; j > 0 && g->rank[cand[j - 1]] > g->rank[e]; --j) cand[j] = cand[j - 1];
+        cand[j] = e;
+    }
+}
+
+// ---- Pair solve ---------------------------------------------------------------
+// Each pass first finds every candidate pair from the positions at the start
+// of the pass (in parallel, one body's pairs per job item), then colours the
+// overlapping pairs so that a body one pair may move is neither moved nor
+// read by any other pair of the same colour. Colours are solved one after
+// the other, the pairs of one colour in parallel; since no pair of a colour
+// sees another's writes the outcome does not depend on the worker count or
+// on scheduling. Everything else (wakes,
+// contact records, moved marks) is applied afterwards in pair order.
+typedef enum {
+    PHYS_PAIR_APART = 0,
+    PHYS_PAIR_TOUCHING,     // overlapping but filtered out or both static
+    PHYS_PAIR_RESOLVED,
+} phys_pair_result_t;
+
+enum {
+    PHYS_PAIR_A_PUSHED  = 1 << 0, // separation gave a a non-zero share
+    PHYS_PAIR_B_PUSHED  = 1 << 1,
+    PHYS_PAIR_A_SHIFTED = 1 << 2, // and its position actually changed
+    PHYS_PAIR_B_SHIFTED = 1 << 3,
+};
+
+// Colours per pass; pairs that find all of them taken go to a last, serial batch.
+#define PHYS_PAIR_COLOURS 64
+
+typedef struct {
+    int a, b;
+    uint8_t result;  // phys_pair_result_t
+    uint8_t moved;   // PHYS_PAIR_* bits
+    uint8_t colour;  // batch, PHYS_PAIR_COLOURS for the serial one
+} phys_pair_t;
+
+typedef struct { int worker, off, count; } phys_pair_span_t;
+
+static DA(phys_pair_t)      g_phys_pairs;                           // this pass, by (rank a, rank b)
+static DA(phys_pair_t)      g_phys_pair_found[JOBS_MAX_WORKERS + 1]; // detection output per worker
+static DA(phys_pair_span_t) g_phys_pair_spans;                      // per body rank - 1
+static DA(int)              g_phys_pair_order;                      // pair indices by colour
+
+static phys_pair_result_t phys_pair_classify(int a, int b)
+{
+    const cmp_phys_body_t* pa = &cmp_phys_body[a];
+    const cmp_phys_body_t* pb = &cmp_phys_body[b];
+
+    const float px = (cmp_col[a].hx + cmp_col[b].hx) - fabsf(cmp_pos[b].x - cmp_pos[a].x);
+    const float py = (cmp_col[a].hy + cmp_col[b].hy) - fabsf(cmp_pos[b].y - cmp_pos[a].y);
+    if (px <= 0.0f || py <= 0.0f) return PHYS_PAIR_APART;
+
+    // Optional collision filtering (only if configured on either body).
+    if (pa->category_bits || pa->mask_bits || pb->category_bits || pb->mask_bits) {
+        const unsigned int catA = pa->category_bits ? pa->category_bits : 0xFFFFFFFFu;
+        const unsigned int mskA = pa->mask_bits ? pa->mask_bits : 0xFFFFFFFFu;
+        const unsigned int catB = pb->category_bits ? pb->category_bits : 0xFFFFFFFFu;
+        const unsigned int mskB = pb->mask_bits ? pb->mask_bits : 0xFFFFFFFFu;
+        if (((catA & mskB) == 0u) || ((catB & mskA) == 0u)) return PHYS_PAIR_TOUCHING;
+    }
+
+    if (pa->type == PHYS_STATIC && pb->type == PHYS_STATIC) return PHYS_PAIR_TOUCHING;
+    return PHYS_PAIR_RESOLVED;
+}
+
+// Whether resolving a pair may write `e`. A static body only takes a share
+// when its partner has no mass-based weight either (even split below).
+static bool phys_pair_writes(int e, int other)
+{
+    return cmp_phys_body[e].type != PHYS_STATIC || !(cmp_phys_body[other].inv_mass > 0.0f);
+}
+
+// Mass-weighted separation of one pair that overlapped at the start of the
+// pass. Only writes the positions of the pair's own bodies.
+static void resolve_body_pair(phys_pair_t* p, const bool* has_intent)
+{
+    const int a = p->a;
+    const int b = p->b;
+    const cmp_phys_body_t* pa = &cmp_phys_body[a];
+    const cmp_phys_body_t* pb = &cmp_phys_body[b];
+
+    const float ax = cmp_pos[a].x;
+    const float ay = cmp_pos[a].y;
+    const float bx = cmp_pos[b].x;
+    const float by = cmp_pos[b].y;
+
+    // Earlier colours may have pushed the pair apart already.
+    const float dx = bx - ax;
+    const float dy = by - ay;
+    const float px = (cmp_col[a].hx + cmp_col[b].hx) - fabsf(dx);
+    const float py = (cmp_col[a].hy + cmp_col[b].hy) - fabsf(dy);
+    p->moved = 0;
+    if (px <= 0.0f || py <= 0.0f) {
+        p->result = PHYS_PAIR_APART;
+        return;
+    }
+    p->result = PHYS_PAIR_RESOLVED;
+
+    const bool resolve_x = (px < py);
+    const float overlap = resolve_x ? px : py;
+    const float sign = resolve_x ? (dx >= 0.0f ? 1.0f : -1.0f) : (dy >= 0.0f ? 1.0f : -1.0f);
+
+    float wA = pa->inv_mass;
+    float wB = pb->inv_mass;
+    if (has_intent[a]) wA *= 2.0f;
+    if (has_intent[b]) wB *= 2.0f;
+
+    if (pa->type == PHYS_STATIC) wA = 0.0f;
+    if (pb->type == PHYS_STATIC) wB = 0.0f;
+
+    float sum = wA + wB;
+    float a_amt = 0.0f;
+    float b_amt = 0.0f;
+    if (sum > 0.0f) {
+        a_amt = overlap * (wA / sum);
+        b_amt = overlap * (wB / sum);
+    } else {
+        // Fallback: split evenly.
+        a_amt = overlap * 0.5f;
+        b_amt = overlap * 0.5f;
+    }
+
+    // Separate along chosen axis. A zero share leaves the body untouched, so
+    // a static body can sit in several pairs of one colour.
+    if (a_amt != 0.0f) {
+        if (resolve_x) cmp_pos[a].x -= sign * a_amt;
+        else           cmp_pos[a].y -= sign * a_amt;
+        p->moved |= PHYS_PAIR_A_PUSHED;
+        if (cmp_pos[a].x != ax || cmp_pos[a].y != ay) p->moved |= PHYS_PAIR_A_SHIFTED;
+    }
+    if (b_amt != 0.0f) {
+        if (resolve_x) cmp_pos[b].x += sign * b_amt;
+        else           cmp_pos[b].y += sign * b_amt;
+        p->moved |= PHYS_PAIR_B_PUSHED;
+        if (cmp_pos[b].x != bx || cmp_pos[b].y != by) p->moved |= PHYS_PAIR_B_SHIFTED;
+    }
+}
+
+typedef struct {
+    const phys_grid_t* grid;
+    const int* body_idx;
+    int body_count;
+} phys_detect_job_t;
+
+static void phys_detect_range(void* ctx, int begin, int end, int worker)
+{
+    const phys_detect_job_t* job = ctx;
+    for (int ka = begin; ka < end; ++ka) {
+        const int a = job->body_idx[ka];
+        phys_pair_span_t* span = &g_phys_pair_spans.data[ka];
+        span->worker = worker;
+        span->off = (int)g_phys_pair_found[worker].size;
+        span->count = 0;
+        if (!cmp_phys_body[a].created) continue;
+
+        phys_grid_gather(job->grid, worker, a, ka + 1, job->body_idx, job->body_count);
+        for (size_t c = 0; c < g_phys_grid_cand[worker].size; ++c) {
+            const int b = g_phys_grid_cand[worker].data[c];
+            const phys_pair_t p = { .a = a, .b = b, .result = (uint8_t)phys_pair_classify(a, b) };
+            DA_APPEND(&g_phys_pair_found[worker], p);
+            span->count++;
+        }
+    }
+}
+
+// Fills g_phys_pairs with every tested pair of this pass, in rank order.
+static void phys_detect_pairs(const phys_grid_t* g, const int* body_idx, int body_count)
+{
+    for (int w = 0; w <= JOBS_MAX_WORKERS; ++w) DA_CLEAR(&g_phys_pair_found[w]);
+    DA_RESERVE(&g_phys_pair_spans, (size_t)body_count);
+    g_phys_pair_spans.size = (size_t)body_count;
+
+    phys_detect_job_t job = { .grid = g, .body_idx = body_idx, .body_count = body_count };
+    jobs_parallel_for(body_count, 64, phys_detect_range, &job);
+
+    DA_CLEAR(&g_phys_pairs);
+    for (int ka = 0; ka < body_count; ++ka) {
+        const phys_pair_span_t* span = &g_phys_pair_spans.data[ka];
+        for (int k = 0; k < span->count; ++k) {
+            DA_APPEND(&g_phys_pairs, g_phys_pair_found[span->worker].data[span->off + k]);
+        }
+    }
+}
+
+typedef struct {
+    phys_pair_t* pairs;
+    const int* order;
+    const bool* has_intent;
+} phys_solve_job_t;
+
+static void phys_solve_range(void* ctx, int begin, int end, int worker)
+{
+    (void)worker;
+    const phys_solve_job_t* job = ctx;
+    for (int k = begin; k < end; ++k) {
+        resolve_body_pair(&job->pairs[job->order[k]], job->has_intent);
+    }
+}
+
+// Greedy colouring in pair order, then one parallel batch per colour.
+// `written` (colours that move a body) and `touched` (colours that move or
+// read it) are zeroed per-entity scratch arrays, zeroed again on return.
+static void phys_solve_pairs(uint64_t* written, uint64_t* touched, const bool* has_intent)
 {
-    const ComponentMask req = (CMP_POS | CMP_COL | CMP_PHYS_BODY);
-    if ((ecs_mask[i] & req) != req) return;
-    if (!cmp_phys_body[i].created) return;
+    int counts[PHYS_PAIR_COLOURS + 1] = { 0 };
+    for (size_t k = 0; k < g_phys_pairs.size; ++k) {
+        phys_pair_t* p = &g_phys_pairs.data[k];
+        if (p->result != PHYS_PAIR_RESOLVED) continue;
+        // A pair reads both bodies: a body it moves must be free in the
+        // colour, a body it only reads must not be moved there.
+        const bool wa = phys_pair_writes(p->a, p->b);
+        const bool wb = phys_pair_writes(p->b, p->a);
+        const uint64_t used = (wa ? touched[p->a] : written[p->a]) | (wb ? touched[p->b] : written[p->b]);
+        int colour = PHYS_PAIR_COLOURS;
+        if (~used) {
+            colour = bits_ctz64(~used);
+            const uint64_t bit = (uint64_t)1u << colour;
+            touched[p->a] |= bit;
+            touched[p->b] |= bit;
+            if (wa) written[p->a] |= bit;
+            if (wb) written[p->b] |= bit;
+        }
+        p->colour = (uint8_t)colour;
+        counts[colour]++;
+    }
 
-    float hx = cmp_col[i].hx;
-    float hy = cmp_col[i].hy;
-    if (hx <= 0.0f || hy <= 0.0f) return;
+    int starts[PHYS_PAIR_COLOURS + 1];
+    int total = 0;
+    for (int c = 0; c <= PHYS_PAIR_COLOURS; ++c) {
+        starts[c] = total;
+        total += counts[c];
+    }
+    DA_RESERVE(&g_phys_pair_order, (size_t)total);
+    g_phys_pair_order.size = (size_t)total;
+    int fill[PHYS_PAIR_COLOURS + 1];
+    memcpy(fill, starts, sizeof(fill));
+    for (size_t k = 0; k < g_phys_pairs.size; ++k) {
+        const phys_pair_t* p = &g_phys_pairs.data[k];
+        if (p->result != PHYS_PAIR_RESOLVED) continue;
+        g_phys_pair_order.data[fill[p->colour]++] = (int)k;
+        written[p->a] = touched[p->a] = 0;
+        written[p->b] = touched[p->b] = 0;
+    }
 
-    float cx = cmp_pos[i].x;
-    float cy = cmp_pos[i].y;
-    // Resolve after entity/entity overlap so tile response doesn't push sideways.
-    if (world_resolve_rect_mtv_px(&cx, &cy, hx, hy)) {
-        cmp_pos[i].x = cx;
-        cmp_pos[i].y = cy;
+    phys_solve_job_t job = { .pairs = g_phys_pairs.data, .has_intent = has_intent };
+    for (int c = 0; c < PHYS_PAIR_COLOURS && counts[c]; ++c) {
+        job.order = g_phys_pair_order.data + starts[c];
+        jobs_parallel_for(counts[c], 64, phys_solve_range, &job);
+    }
+    // Overflow pairs may share bodies; keep them on this thread, in order.
+    job.order = g_phys_pair_order.data + starts[PHYS_PAIR_COLOURS];
+    phys_solve_range(&job, 0, counts[PHYS_PAIR_COLOURS], 0);
+}
+
+static void phys_tile_range(void* ctx, int begin, int end, int worker)
+{
+    (void)ctx;
+    (void)worker;
+    phys_tile_batch_t* b = &g_phys_tiles;
+    world_resolve_rects_mtv_px(b->cx.data + begin, b->cy.data + begin, b->hx.data + begin, b->hy.data + begin,
+                               end - begin, b->pushed.data + begin);
+}
+
+// Wakes bodies whose POS/COL were written outside physics since its last
+// step, or every body if the collision grid changed.
+static void phys_wake_external(const ecs_query_t* bodies, bool* stirred)
+{
+    const ecs_version_t now = ecs_change_version();
+    const uint32_t collision = world_collision_revision();
+    if (collision != g_phys_seen_collision || now < g_phys_seen_version) {
+        for (size_t k = 0; k < bodies->match.size; ++k) {
+            phys_wake(bodies->match.data[k], stirred);
+        }
+        g_phys_seen_collision = collision;
+        return;
+    }
+    const ComponentEnum tracked[] = { ENUM_POS, ENUM_COL };
+    for (size_t t = 0; t < sizeof(tracked) / sizeof(tracked[0]); ++t) {
+        ECS_CHANGED_EACH(tracked[t], g_phys_seen_version, e) {
+            if (component_mask_any(ecs_mask[e], CMP_PHYS_BODY)) phys_wake(e, stirred);
+        }
     }
 }
 
@@ -33,26 +651,37 @@ void sys_physics_integrate_impl(float dt)
 {
     if (!world_has_map()) return;
 
+    const ecs_query_t* bodies = ecs_query_get(CMP_SET(CMP_POS, CMP_COL, CMP_PHYS_BODY), CMP_NONE);
+    const ecs_query_t* movers = ecs_query_get(CMP_SET(CMP_VEL, CMP_PHYS_BODY), CMP_NONE);
+    if (!bodies || !movers) return;
+
     // Ensure any newly-tagged entities participate in the physics-lite step.
-    for (int e = 0; e < ECS_MAX_ENTITIES; ++e) {
-        if (!ecs_alive_idx(e)) continue;
-        const ComponentMask req = (CMP_POS | CMP_COL | CMP_PHYS_BODY);
-        if ((ecs_mask[e] & req) != req) continue;
+    for (size_t k = 0; k < bodies->match.size; ++k) {
+        const int e = bodies->match.data[k];
         if (!cmp_phys_body[e].created) {
             ecs_phys_body_create_for_entity(e);
         }
     }
 
-    bool  has_intent[ECS_MAX_ENTITIES];
-    for (int e = 0; e < ECS_MAX_ENTITIES; ++e) {
-        has_intent[e] = false;
+    bool* has_intent = ecs_scratch_acquire(sizeof(bool));
+    bool* moved = ecs_scratch_acquire(sizeof(bool));
+    bool* stirred = ecs_scratch_acquire(sizeof(bool));
+    if (!has_intent || !moved || !stirred) {
+        ecs_scratch_release(stirred);
+        ecs_scratch_release(moved);
+        ecs_scratch_release(has_intent);
+        return;
     }
 
-    // Apply intent velocities to positions (physics-lite).
-    for (int e = 0; e < ECS_MAX_ENTITIES; ++e) {
-        if (!ecs_alive_idx(e)) continue;
-        const ComponentMask req = (CMP_VEL | CMP_PHYS_BODY);
-        if ((ecs_mask[e] & req) != req) continue;
+    phys_wake_external(bodies, stirred);
+
+    // Apply intent velocities to positions (physics-lite). Bodies that
+    // collide with tiles are swept in one batch per axis (X for all, then Y
+    // from the new X), which stops fast bodies at the first solid subtile
+    // instead of pushing them out after the fact.
+    phys_tile_batch_reset(movers->match.size > bodies->match.size ? movers->match.size : bodies->match.size);
+    for (size_t k = 0; k < movers->match.size; ++k) {
+        const int e = movers->match.data[k];
 
         cmp_velocity_t*  v  = &cmp_vel[e];
         cmp_phys_body_t* pb = &cmp_phys_body[e];
@@ -63,32 +692,20 @@ void sys_physics_integrate_impl(float dt)
             case PHYS_KINEMATIC:
                 if (v->x != 0.0f || v->y != 0.0f) {
                     has_intent[e] = true;
+                    phys_wake(e, stirred);
                 }
                 {
-                    float dx = v->x * dt;
-                    float dy = v->y * dt;
-
-                    const ComponentMask tile_req = (CMP_POS | CMP_COL | CMP_PHYS_BODY);
-                    const bool can_collide_tiles = ((ecs_mask[e] & tile_req) == tile_req) && pb->created;
-
-                    if (dx != 0.0f) {
-                        float cx = cmp_pos[e].x + dx;
-                        float cy = cmp_pos[e].y;
-                        if (can_collide_tiles) {
-                            world_resolve_rect_axis_px(&cx, &cy, cmp_col[e].hx, cmp_col[e].hy, true);
-                        }
-                        cmp_pos[e].x = cx;
-                        cmp_pos[e].y = cy;
-                    }
+                    const float dx = v->x * dt;
+                    const float dy = v->y * dt;
+                    if (dx == 0.0f && dy == 0.0f) break;
+                    moved[e] = true;
 
-                    if (dy != 0.0f) {
-                        float cx = cmp_pos[e].x;
-                        float cy = cmp_pos[e].y + dy;
-                        if (can_collide_tiles) {
-                            world_resolve_rect_axis_px(&cx, &cy, cmp_col[e].hx, cmp_col[e].hy, false);
-                        }
-                        cmp_pos[e].x = cx;
-                        cmp_pos[e].y = cy;
+                    const ComponentMask tile_req = CMP_SET(CMP_POS, CMP_COL, CMP_PHYS_BODY);
+                    if (component_mask_all(ecs_mask[e], tile_req)) {
+                        phys_tile_batch_add(e, dx, dy);
+                    } else {
+                        cmp_pos[e].x += dx;
+                        cmp_pos[e].y += dy;
                     }
                 }
                 break;
@@ -99,89 +716,135 @@ void sys_physics_integrate_impl(float dt)
         v->x = 0.0f;
         v->y = 0.0f;
     }
+    {
+        phys_tile_batch_t* b = &g_phys_tiles;
+        const int n = (int)b->body.size;
+        world_sweep_rects_axis_px(b->cx.data, b->cy.data, b->hx.data, b->hy.data, b->dx.data, n, true, b->t.data);
+        for (int k = 0; k < n; ++k) {
+            const int e = b->body.data[k];
+            cmp_pos[e].x += b->dx.data[k] * b->t.data[k];
+            b->cx.data[k] = cmp_pos[e].x;
+        }
+        world_sweep_rects_axis_px(b->cx.data, b->cy.data, b->hx.data, b->hy.data, b->dy.data, n, false, b->t.data);
+        for (int k = 0; k < n; ++k) {
+            const int e = b->body.data[k];
+            cmp_pos[e].y += b->dy.data[k] * b->t.data[k];
+        }
+    }
 
-    for (int iter = 0; iter < 4; ++iter) {
-        for (int a = 0; a < ECS_MAX_ENTITIES; ++a) {
-            if (!ecs_alive_idx(a)) continue;
-            const ComponentMask reqA = (CMP_POS | CMP_COL | CMP_PHYS_BODY);
-            if ((ecs_mask[a] & reqA) != reqA) continue;
-            if (!cmp_phys_body[a].created) continue;
-
-            for (int b = a + 1; b < ECS_MAX_ENTITIES; ++b) {
-                if (!ecs_alive_idx(b)) continue;
-                const ComponentMask reqB = (CMP_POS | CMP_COL | CMP_PHYS_BODY);
-                if ((ecs_mask[b] & reqB) != reqB) continue;
-                if (!cmp_phys_body[b].created) continue;
-
-                const cmp_phys_body_t* pa = &cmp_phys_body[a];
-                const cmp_phys_body_t* pb = &cmp_phys_body[b];
-
-                // Optional collision filtering (only if configured on either body).
-                if (pa->category_bits || pa->mask_bits || pb->category_bits || pb->mask_bits) {
-                    const unsigned int catA = pa->category_bits ? pa->category_bits : 0xFFFFFFFFu;
-                    const unsigned int mskA = pa->mask_bits ? pa->mask_bits : 0xFFFFFFFFu;
-                    const unsigned int catB = pb->category_bits ? pb->category_bits : 0xFFFFFFFFu;
-                    const unsigned int mskB = pb->mask_bits ? pb->mask_bits : 0xFFFFFFFFu;
-                    if (((catA & mskB) == 0u) || ((catB & mskA) == 0u)) continue;
-                }
+    phys_grid_t grid = {
+        .rank = ecs_scratch_acquire(sizeof(int)),
+        .cell = ecs_scratch_acquire(sizeof(int)),
+        .next = ecs_scratch_acquire(sizeof(int)),
+        .mark = ecs_scratch_acquire(sizeof(int)),
+        .contact_first = ecs_scratch_acquire(sizeof(int)),
+    };
+    uint64_t* written = ecs_scratch_acquire(sizeof(uint64_t));
+    uint64_t* touched = ecs_scratch_acquire(sizeof(uint64_t));
+    const int body_count = (int)bodies->match.size;
+    const int* body_idx = bodies->match.data;
+    const int passes = 4;
+    // Bodies with this mark moved in a last pass that still moved things, so
+    // they may end the step with overlaps nobody tested.
+    int unsettled_mark = -1;
+    const bool solved = grid.rank && grid.cell && grid.next && grid.mark && grid.contact_first && written && touched;
+    if (solved) {
+        phys_contact_begin(grid.contact_first);
+        for (int k = 0; k < body_count; ++k) {
+            const int e = body_idx[k];
+            if (stirred[e] || moved[e] || phys_carry_get(e) != PHYS_CARRY_SETTLED) grid.mark[e] = 1;
+        }
 
-                if (pa->type == PHYS_STATIC && pb->type == PHYS_STATIC) continue;
-
-                const float ax = cmp_pos[a].x;
-                const float ay = cmp_pos[a].y;
-                const float bx = cmp_pos[b].x;
-                const float by = cmp_pos[b].y;
-                const float ahx = cmp_col[a].hx;
-                const float ahy = cmp_col[a].hy;
-                const float bhx = cmp_col[b].hx;
-                const float bhy = cmp_col[b].hy;
-
-                const float dx = bx - ax;
-                const float dy = by - ay;
-                const float px = (ahx + bhx) - fabsf(dx);
-                const float py = (ahy + bhy) - fabsf(dy);
-                if (px <= 0.0f || py <= 0.0f) continue;
-
-                const bool resolve_x = (px < py);
-                const float overlap = resolve_x ? px : py;
-                const float sign = resolve_x ? (dx >= 0.0f ? 1.0f : -1.0f) : (dy >= 0.0f ? 1.0f : -1.0f);
-
-                float wA = pa->inv_mass;
-                float wB = pb->inv_mass;
-                if (has_intent[a]) wA *= 2.0f;
-                if (has_intent[b]) wB *= 2.0f;
-
-                if (pa->type == PHYS_STATIC) wA = 0.0f;
-                if (pb->type == PHYS_STATIC) wB = 0.0f;
-
-                float sum = wA + wB;
-                float a_amt = 0.0f;
-                float b_amt = 0.0f;
-                if (sum > 0.0f) {
-                    a_amt = overlap * (wA / sum);
-                    b_amt = overlap * (wB / sum);
-                } else {
-                    // Fallback: split evenly.
-                    a_amt = overlap * 0.5f;
-                    b_amt = overlap * 0.5f;
-                }
+        for (int iter = 0; iter < passes; ++iter) {
+            grid.iter = iter;
+            phys_grid_build(&grid, body_idx, body_count);
+            // Sleepers neither overlap each other nor tiles: nothing to do.
+            if (grid.awake == 0) break;
+            bool any_moved = false;
 
-                // Separate along chosen axis.
-                if (resolve_x) {
-                    cmp_pos[a].x -= sign * a_amt;
-                    cmp_pos[b].x += sign * b_amt;
-                } else {
-                    cmp_pos[a].y -= sign * a_amt;
-                    cmp_pos[b].y += sign * b_amt;
-                }
+            phys_detect_pairs(&grid, body_idx, body_count);
+            phys_solve_pairs(written, touched, has_intent);
+
+            for (size_t k = 0; k < g_phys_pairs.size; ++k) {
+                const phys_pair_t* p = &g_phys_pairs.data[k];
+                phys_contact_record(p->a, p->b, p->result != PHYS_PAIR_APART, stirred);
+                if (p->result == PHYS_PAIR_APART) continue;
+
+                // Touching bodies stay awake. A sleeper that wakes without
+                // moving still can't overlap the sleepers it skipped.
+                phys_wake(p->a, stirred);
+                phys_wake(p->b, stirred);
+                if (p->result != PHYS_PAIR_RESOLVED) continue;
+
+                any_moved = true;
+                if (p->moved & PHYS_PAIR_A_PUSHED) moved[p->a] = true;
+                if (p->moved & PHYS_PAIR_B_PUSHED) moved[p->b] = true;
+                if (p->moved & PHYS_PAIR_A_SHIFTED) grid.mark[p->a] = iter + 2;
+                if (p->moved & PHYS_PAIR_B_SHIFTED) grid.mark[p->b] = iter + 2;
             }
-        }
 
-        for (int e = 0; e < ECS_MAX_ENTITIES; ++e) {
-            if (!ecs_alive_idx(e)) continue;
-            resolve_tile_penetration(e);
+            // Tiles go after entity/entity overlap so tile response doesn't
+            // push sideways.
+            phys_tile_batch_reset((size_t)body_count);
+            for (int k = 0; k < body_count; ++k) {
+                const int e = body_idx[k];
+                if (cmp_phys_body[e].created && !phys_asleep(e)) phys_tile_batch_add(e, 0.0f, 0.0f);
+            }
+            const int tile_count = (int)g_phys_tiles.body.size;
+            jobs_parallel_for(tile_count, 64, phys_tile_range, NULL);
+            for (int k = 0; k < tile_count; ++k) {
+                if (!g_phys_tiles.pushed.data[k]) continue;
+                const int e = g_phys_tiles.body.data[k];
+                cmp_pos[e].x = g_phys_tiles.cx.data[k];
+                cmp_pos[e].y = g_phys_tiles.cy.data[k];
+                moved[e] = true;
+                any_moved = true;
+                stirred[e] = true;
+                grid.mark[e] = iter + 2;
+            }
+            // Nothing moved, so a further pass would see the same state.
+            if (!any_moved) break;
+            if (iter == passes - 1) unsettled_mark = iter + 2;
         }
+        phys_contact_end();
+    }
+
+    const int cap = ecs_capacity();
+    if (g_phys_carry.size < (size_t)cap) {
+        DA_RESERVE(&g_phys_carry, (size_t)cap);
+        g_phys_carry.size = (size_t)cap;
+    }
+    memset(g_phys_carry.data, PHYS_CARRY_NONE, g_phys_carry.size * sizeof(*g_phys_carry.data));
+    for (int k = 0; k < body_count; ++k) {
+        const int e = body_idx[k];
+        if (!cmp_phys_body[e].created) continue;
+        const bool settled = solved && grid.mark[e] != unsettled_mark;
+        g_phys_carry.data[e] = settled ? PHYS_CARRY_SETTLED : PHYS_CARRY_UNSETTLED;
     }
+    ecs_scratch_release(touched);
+    ecs_scratch_release(written);
+    ecs_scratch_release(grid.contact_first);
+    ecs_scratch_release(grid.mark);
+    ecs_scratch_release(grid.next);
+    ecs_scratch_release(grid.cell);
+    ecs_scratch_release(grid.rank);
+
+    for (int k = 0; k < body_count; ++k) {
+        const int e = body_idx[k];
+        cmp_phys_body_t* pb = &cmp_phys_body[e];
+        if (stirred[e] || moved[e]) pb->quiet_ticks = 0;
+        else if (pb->quiet_ticks < PHYS_SLEEP_TICKS) pb->quiet_ticks++;
+    }
+
+    // Stamp once per moved entity rather than once per position write.
+    for (int e = 0; e < cap; ++e) {
+        if (moved[e]) ecs_mark_changed(e, CMP_POS);
+    }
+    g_phys_seen_version = ecs_change_version();
+
+    ecs_scratch_release(stirred);
+    ecs_scratch_release(moved);
+    ecs_scratch_release(has_intent);
 }
 
 SYSTEMS_ADAPT_DT(sys_physics_adapt, sys_physics_integrate_impl)
@@ -3,6 +3,8 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#define PHYS_SLEEP_TICKS 30
+
 typedef enum {
     PHYS_NONE = 0,
     PHYS_DYNAMIC,
@@ -25,4 +27,8 @@ typedef struct {
     // Runtime flag: becomes true once the entity has the required components (POS+COL+PHYS_BODY)
     // and is participating in the physics-lite step.
     bool created;
+
+    // Runtime: consecutive steps without intent, contact or push. The body
+    // sleeps once this reaches PHYS_SLEEP_TICKS.
+    uint8_t quiet_ticks;
 } cmp_phys_body_t;
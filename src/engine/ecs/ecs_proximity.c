@@ -1,81 +1,232 @@
 //==== FROM ecs_proximity.c ====
 #include "engine/ecs/ecs_engine.h"
 #include "engine/ecs/ecs_proximity.h"
+#include "engine/core/logger/logger.h"
 #include "engine/engine/engine_scheduler/engine_scheduler.h"
 #include "engine/utils/dynarray.h"
 
 #include <math.h>
+#include <stdlib.h>
 #include <string.h>
 
 // =============== Proximity View (transient each tick) =============
 static DA(ecs_prox_view_t) prox_curr = {0};
 static DA(ecs_prox_view_t) prox_prev = {0};
 
-static bool prox_contains(const ecs_prox_view_t* arr, int n, ecs_prox_view_t p)
+static DA(ecs_prox_view_t) prox_enter = {0};
+static DA(ecs_prox_view_t) prox_exit = {0};
+
+// ---- Enter/exit diff ---------------------------------------------------------
+// Worked out once whenever the pair lists change (build, snapshot load,
+// handle remap). One frame's pairs go into an open-addressed set, the other
+// frame is probed against it; enter/exit keep the order of the list they
+// came from.
+static DA(int) prox_set_slots; // index + 1 into the hashed list, 0 = empty
+static size_t prox_set_mask;
+
+static bool prox_same(ecs_prox_view_t a, ecs_prox_view_t b)
 {
-    for (int i = 0; i < n; ++i) {
-        if (arr[i].trigger_owner.idx == p.trigger_owner.idx && arr[i].trigger_owner.gen == p.trigger_owner.gen &&
-            arr[i].matched_entity.idx == p.matched_entity.idx && arr[i].matched_entity.gen == p.matched_entity.gen) {
-            return true;
-        }
+    return a.trigger_owner.idx == b.trigger_owner.idx && a.trigger_owner.gen == b.trigger_owner.gen &&
+           a.matched_entity.idx == b.matched_entity.idx && a.matched_entity.gen == b.matched_entity.gen;
+}
+
+static uint32_t prox_hash(ecs_prox_view_t p)
+{
+    uint32_t h = 2166136261u;
+    h = (h ^ p.trigger_owner.idx) * 16777619u;
+    h = (h ^ p.trigger_owner.gen) * 16777619u;
+    h = (h ^ p.matched_entity.idx) * 16777619u;
+    h = (h ^ p.matched_entity.gen) * 16777619u;
+    return h ^ (h >> 15);
+}
+
+static void prox_set_build(const ecs_prox_view_t* views, size_t n)
+{
+    size_t cap = 16;
+    while (cap < n * 2) cap <<= 1;
+    DA_RESERVE(&prox_set_slots, cap);
+    prox_set_slots.size = cap;
+    memset(prox_set_slots.data, 0, cap * sizeof(int));
+    prox_set_mask = cap - 1;
+    for (size_t i = 0; i < n; ++i) {
+        size_t s = prox_hash(views[i]) & prox_set_mask;
+        while (prox_set_slots.data[s] != 0) s = (s + 1) & prox_set_mask;
+        prox_set_slots.data[s] = (int)i + 1;
+    }
+}
+
+static bool prox_set_contains(const ecs_prox_view_t* views, ecs_prox_view_t p)
+{
+    for (size_t s = prox_hash(p) & prox_set_mask; prox_set_slots.data[s] != 0; s = (s + 1) & prox_set_mask) {
+        if (prox_same(views[prox_set_slots.data[s] - 1], p)) return true;
     }
     return false;
 }
 
-// public iterators
-ecs_prox_iter_t ecs_prox_stay_begin(void) { return (ecs_prox_iter_t){ .i = -1 }; }
+static void prox_diff_rebuild(void)
+{
+    DA_CLEAR(&prox_enter);
+    DA_CLEAR(&prox_exit);
 
-bool ecs_prox_stay_next(ecs_prox_iter_t* it, ecs_prox_view_t* out)
+    prox_set_build(prox_prev.data, prox_prev.size);
+    for (size_t i = 0; i < prox_curr.size; ++i) {
+        if (!prox_set_contains(prox_prev.data, prox_curr.data[i])) DA_APPEND(&prox_enter, prox_curr.data[i]);
+    }
+    prox_set_build(prox_curr.data, prox_curr.size);
+    for (size_t i = 0; i < prox_prev.size; ++i) {
+        if (!prox_set_contains(prox_curr.data, prox_prev.data[i])) DA_APPEND(&prox_exit, prox_prev.data[i]);
+    }
+}
+
+static bool prox_list_next(const ecs_prox_view_t* views, int count, ecs_prox_iter_t* it, ecs_prox_view_t* out)
 {
-    int count = (int)prox_curr.size;
-    int i = it->i + 1;
-    while (i < count) {
-        if (ecs_alive_handle(prox_curr.data[i].trigger_owner) && ecs_alive_handle(prox_curr.data[i].matched_entity)) {
+    for (int i = it->i + 1; i < count; ++i) {
+        if (ecs_alive_handle(views[i].trigger_owner) && ecs_alive_handle(views[i].matched_entity)) {
             it->i = i;
-            *out = prox_curr.data[i];
+            *out = views[i];
             return true;
         }
-        ++i;
     }
     return false;
 }
 
-ecs_prox_iter_t ecs_prox_enter_begin(void) { return (ecs_prox_iter_t){ .i = -1 }; }
+// ---- Owner streams -----------------------------------------------------------
+// Consumers that only care about triggers owned by one component ask for a
+// stream (ecs_prox_*_begin_for). The first request registers the owner mask;
+// after every list change the first stream request buckets pair indices for
+// all streams in one pass, so each consumer then walks only its own pairs.
+// Pairs come out of the build grouped by owner, so the masks are tested once
+// per owner run rather than once per pair.
+#define PROX_MAX_STREAMS 16
 
-bool ecs_prox_enter_next(ecs_prox_iter_t* it, ecs_prox_view_t* out)
+enum { PROX_LIST_STAY, PROX_LIST_ENTER, PROX_LIST_EXIT, PROX_LIST_COUNT };
+
+typedef struct {
+    ComponentMask owner_mask;
+    DA(int) pairs[PROX_LIST_COUNT]; // indices into the matching pair list
+} prox_stream_t;
+
+static prox_stream_t prox_streams[PROX_MAX_STREAMS];
+static int prox_stream_count;
+static bool prox_streams_dirty = true;
+
+static const ecs_prox_view_t* prox_list_views(int list, int* out_count)
 {
-    int curr_count = (int)prox_curr.size;
-    int prev_count = (int)prox_prev.size;
-    for (int i = it->i + 1; i < curr_count; ++i) {
-        if (!ecs_alive_handle(prox_curr.data[i].trigger_owner) || !ecs_alive_handle(prox_curr.data[i].matched_entity)) {
-            continue;
+    switch (list) {
+        case PROX_LIST_ENTER: *out_count = (int)prox_enter.size; return prox_enter.data;
+        case PROX_LIST_EXIT:  *out_count = (int)prox_exit.size;  return prox_exit.data;
+        case PROX_LIST_STAY:
+        default:              *out_count = (int)prox_curr.size;  return prox_curr.data;
+    }
+}
+
+static void prox_streams_bucket(int list)
+{
+    int n = 0;
+    const ecs_prox_view_t* views = prox_list_views(list, &n);
+    for (int k = 0; k < prox_stream_count; ++k) DA_CLEAR(&prox_streams[k].pairs[list]);
+
+    for (int i = 0; i < n;) {
+        const ecs_entity_t owner = views[i].trigger_owner;
+        int end = i + 1;
+        while (end < n && views[end].trigger_owner.idx == owner.idx && views[end].trigger_owner.gen == owner.gen) ++end;
+        const int owner_idx = ent_index_checked(owner);
+        if (owner_idx >= 0) {
+            for (int k = 0; k < prox_stream_count; ++k) {
+                prox_stream_t* st = &prox_streams[k];
+                if (!component_mask_any(ecs_mask[owner_idx], st->owner_mask)) continue;
+                for (int j = i; j < end; ++j) DA_APPEND(&st->pairs[list], j);
+            }
         }
-        if (!prox_contains(prox_prev.data, prev_count, prox_curr.data[i])) {
-            it->i = i;
-            *out = prox_curr.data[i];
+        i = end;
+    }
+}
+
+static int prox_stream_for(ComponentMask owner_mask)
+{
+    for (int k = 0; k < prox_stream_count; ++k) {
+        if (component_mask_eq(prox_streams[k].owner_mask, owner_mask)) return k + 1;
+    }
+    if (prox_stream_count >= PROX_MAX_STREAMS) {
+        LOGC(LOGCAT_ECS, LOG_LVL_WARN, "prox: out of owner streams (max=%d), falling back to the full list", PROX_MAX_STREAMS);
+        return 0;
+    }
+    prox_streams[prox_stream_count].owner_mask = owner_mask;
+    prox_stream_count++;
+    prox_streams_dirty = true;
+    return prox_stream_count;
+}
+
+static ecs_prox_iter_t prox_begin_for(ComponentMask owner_mask)
+{
+    const int stream = prox_stream_for(owner_mask);
+    if (stream > 0 && prox_streams_dirty) {
+        for (int list = 0; list < PROX_LIST_COUNT; ++list) prox_streams_bucket(list);
+        prox_streams_dirty = false;
+    }
+    return (ecs_prox_iter_t){ .i = -1, .stream = stream };
+}
+
+static bool prox_next(int list, ecs_prox_iter_t* it, ecs_prox_view_t* out)
+{
+    int count = 0;
+    const ecs_prox_view_t* views = prox_list_views(list, &count);
+    if (it->stream <= 0) return prox_list_next(views, count, it, out);
+
+    const prox_stream_t* st = &prox_streams[it->stream - 1];
+    for (int k = it->i + 1; k < (int)st->pairs[list].size; ++k) {
+        const ecs_prox_view_t* v = &views[st->pairs[list].data[k]];
+        if (ecs_alive_handle(v->trigger_owner) && ecs_alive_handle(v->matched_entity)) {
+            it->i = k;
+            *out = *v;
             return true;
         }
     }
     return false;
 }
 
+// Called whenever prox_curr/prox_prev change.
+static void prox_lists_changed(void)
+{
+    prox_diff_rebuild();
+    prox_streams_dirty = true;
+}
+
+// public iterators
+ecs_prox_iter_t ecs_prox_stay_begin(void) { return (ecs_prox_iter_t){ .i = -1 }; }
+ecs_prox_iter_t ecs_prox_stay_begin_for(ComponentMask owner_mask) { return prox_begin_for(owner_mask); }
+
+bool ecs_prox_stay_next(ecs_prox_iter_t* it, ecs_prox_view_t* out)
+{
+    return prox_next(PROX_LIST_STAY, it, out);
+}
+
+ecs_prox_iter_t ecs_prox_enter_begin(void) { return (ecs_prox_iter_t){ .i = -1 }; }
+ecs_prox_iter_t ecs_prox_enter_begin_for(ComponentMask owner_mask) { return prox_begin_for(owner_mask); }
+
+bool ecs_prox_enter_next(ecs_prox_iter_t* it, ecs_prox_view_t* out)
+{
+    return prox_next(PROX_LIST_ENTER, it, out);
+}
+
 ecs_prox_iter_t ecs_prox_exit_begin(void) { return (ecs_prox_iter_t){ .i = -1 }; }
+ecs_prox_iter_t ecs_prox_exit_begin_for(ComponentMask owner_mask) { return prox_begin_for(owner_mask); }
 
 bool ecs_prox_exit_next(ecs_prox_iter_t* it, ecs_prox_view_t* out)
 {
-    int prev_count = (int)prox_prev.size;
-    int curr_count = (int)prox_curr.size;
-    for (int i = it->i + 1; i < prev_count; ++i) {
-        if (!ecs_alive_handle(prox_prev.data[i].trigger_owner) || !ecs_alive_handle(prox_prev.data[i].matched_entity)) {
-            continue;
-        }
-        if (!prox_contains(prox_curr.data, curr_count, prox_prev.data[i])) {
-            it->i = i;
-            *out = prox_prev.data[i];
-            return true;
-        }
-    }
-    return false;
+    return prox_next(PROX_LIST_EXIT, it, out);
+}
+
+const ecs_prox_view_t* ecs_prox_enter_list(int* out_count)
+{
+    if (out_count) *out_count = (int)prox_enter.size;
+    return prox_enter.data;
+}
+
+const ecs_prox_view_t* ecs_prox_exit_list(int* out_count)
+{
+    if (out_count) *out_count = (int)prox_exit.size;
+    return prox_exit.data;
 }
 
 static bool col_overlap_padded_idx(int a, int b, float pad)
@@ -83,14 +234,139 @@ static bool col_overlap_padded_idx(int a, int b, float pad)
     float ax = cmp_pos[a].x, ay = cmp_pos[a].y;
     float bx = cmp_pos[b].x, by = cmp_pos[b].y;
 
-    float ahx = (ecs_mask[a] & CMP_COL) ? (cmp_col[a].hx + pad) : pad;
-    float ahy = (ecs_mask[a] & CMP_COL) ? (cmp_col[a].hy + pad) : pad;
-    float bhx = (ecs_mask[b] & CMP_COL) ? cmp_col[b].hx : 0.f;
-    float bhy = (ecs_mask[b] & CMP_COL) ? cmp_col[b].hy : 0.f;
+    float ahx = component_mask_any(ecs_mask[a], CMP_COL) ? (cmp_col[a].hx + pad) : pad;
+    float ahy = component_mask_any(ecs_mask[a], CMP_COL) ? (cmp_col[a].hy + pad) : pad;
+    float bhx = component_mask_any(ecs_mask[b], CMP_COL) ? cmp_col[b].hx : 0.f;
+    float bhy = component_mask_any(ecs_mask[b], CMP_COL) ? cmp_col[b].hy : 0.f;
 
     return fabsf(ax - bx) <= (ahx + bhx) && fabsf(ay - by) <= (ahy + bhy);
 }
 
+// ---- Spatial bins ------------------------------------------------------------
+// Bodies are binned by centre once per build, over the span their centres
+// cover; a trigger reads only the cells its padded box, grown by the largest
+// binned half extent, reaches. Bodies too big for a cell sit on a side list
+// every trigger checks. Candidates are tested in body-query order, so the
+// pair list matches a full scan of every owner against every body.
+#define PROX_CELL_PX 64.0f
+#define PROX_MAX_CELLS_PER_BODY 4
+
+typedef struct {
+    float x0, y0;   // world position of cell (0, 0)
+    float inv_cell;
+    int w, h;
+    float reach_x, reach_y; // largest binned half extents, plus slack
+} prox_grid_t;
+
+static DA(int) g_prox_cell_start; // w*h + 1 offsets into g_prox_cell_rank
+static DA(int) g_prox_cell_rank;  // body ranks (index into the body query), grouped by cell
+static DA(int) g_prox_oversized;  // ranks of bodies on the side list
+static DA(int) g_prox_cand;
+
+static int prox_cell_coord(float v, float origin, float inv_cell, int n)
+{
+    const float c = floorf((v - origin) * inv_cell);
+    if (!(c >= 0.0f)) return 0;
+    return (c >= (float)n) ? n - 1 : (int)c;
+}
+
+static bool prox_oversized(int e)
+{
+    return cmp_col[e].hx > 0.5f * PROX_CELL_PX || cmp_col[e].hy > 0.5f * PROX_CELL_PX;
+}
+
+static void prox_grid_build(prox_grid_t* g, const int* body_idx, int body_count)
+{
+    DA_CLEAR(&g_prox_oversized);
+    float min_x = INFINITY, min_y = INFINITY, max_x = -INFINITY, max_y = -INFINITY;
+    float reach_x = 0.0f, reach_y = 0.0f;
+    for (int k = 0; k < body_count; ++k) {
+        const int e = body_idx[k];
+        if (prox_oversized(e)) {
+            DA_APPEND(&g_prox_oversized, k);
+            continue;
+        }
+        min_x = fminf(min_x, cmp_pos[e].x);
+        min_y = fminf(min_y, cmp_pos[e].y);
+        max_x = fmaxf(max_x, cmp_pos[e].x);
+        max_y = fmaxf(max_y, cmp_pos[e].y);
+        reach_x = fmaxf(reach_x, cmp_col[e].hx);
+        reach_y = fmaxf(reach_y, cmp_col[e].hy);
+    }
+    if (!(min_x <= max_x) || !(min_y <= max_y)) {
+        min_x = min_y = 0.0f;
+        max_x = max_y = 0.0f;
+    }
+
+    // Spread-out bodies get coarser cells rather than a mostly empty grid.
+    float cell = PROX_CELL_PX;
+    const double max_cells = (double)PROX_MAX_CELLS_PER_BODY * (double)body_count + 64.0;
+    while (((double)(max_x - min_x) / cell + 1.0) * ((double)(max_y - min_y) / cell + 1.0) > max_cells) cell *= 2.0f;
+
+    g->x0 = min_x;
+    g->y0 = min_y;
+    g->inv_cell = 1.0f / cell;
+    g->w = (int)((max_x - min_x) * g->inv_cell) + 1;
+    g->h = (int)((max_y - min_y) * g->inv_cell) + 1;
+    // One pixel of slack so float rounding can't drop a touching body.
+    g->reach_x = reach_x + 1.0f;
+    g->reach_y = reach_y + 1.0f;
+
+    const size_t cells = (size_t)g->w * (size_t)g->h;
+    DA_RESERVE(&g_prox_cell_start, cells + 1);
+    DA_RESERVE(&g_prox_cell_rank, (size_t)body_count);
+    g_prox_cell_start.size = cells + 1;
+    memset(g_prox_cell_start.data, 0, (cells + 1) * sizeof(int));
+
+    // Counting sort by cell; filling in rank order keeps each cell ascending.
+    int* start = g_prox_cell_start.data;
+    for (int k = 0; k < body_count; ++k) {
+        const int e = body_idx[k];
+        if (prox_oversized(e)) continue;
+        const int c = prox_cell_coord(cmp_pos[e].y, g->y0, g->inv_cell, g->h) * g->w
+                    + prox_cell_coord(cmp_pos[e].x, g->x0, g->inv_cell, g->w);
+        start[c + 1]++;
+    }
+    for (size_t c = 0; c < cells; ++c) start[c + 1] += start[c];
+    for (int k = 0; k < body_count; ++k) {
+        const int e = body_idx[k];
+        if (prox_oversized(e)) continue;
+        const int c = prox_cell_coord(cmp_pos[e].y, g->y0, g->inv_cell, g->h) * g->w
+                    + prox_cell_coord(cmp_pos[e].x, g->x0, g->inv_cell, g->w);
+        g_prox_cell_rank.data[start[c]++] = k;
+    }
+    // The fill advanced each start to the next cell's; shift them back.
+    for (size_t c = cells; c > 0; --c) start[c] = start[c - 1];
+    start[0] = 0;
+}
+
+static int prox_rank_cmp(const void* a, const void* b)
+{
+    const int x = *(const int*)a;
+    const int y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+// Ranks of bodies that may overlap owner `a`'s padded box, ascending.
+static void prox_grid_gather(const prox_grid_t* g, int a, float pad)
+{
+    DA_CLEAR(&g_prox_cand);
+    const float rx = cmp_col[a].hx + pad + g->reach_x;
+    const float ry = cmp_col[a].hy + pad + g->reach_y;
+    const int x0 = prox_cell_coord(cmp_pos[a].x - rx, g->x0, g->inv_cell, g->w);
+    const int x1 = prox_cell_coord(cmp_pos[a].x + rx, g->x0, g->inv_cell, g->w);
+    const int y0 = prox_cell_coord(cmp_pos[a].y - ry, g->y0, g->inv_cell, g->h);
+    const int y1 = prox_cell_coord(cmp_pos[a].y + ry, g->y0, g->inv_cell, g->h);
+    const int* start = g_prox_cell_start.data;
+    for (int y = y0; y <= y1; ++y) {
+        for (int c = y * g->w + x0; c <= y * g->w + x1; ++c) {
+            for (int k = start[c]; k < start[c + 1]; ++k) DA_APPEND(&g_prox_cand, g_prox_cell_rank.data[k]);
+        }
+    }
+    for (size_t k = 0; k < g_prox_oversized.size; ++k) DA_APPEND(&g_prox_cand, g_prox_oversized.data[k]);
+    if (g_prox_cand.size > 1) qsort(g_prox_cand.data, g_prox_cand.size, sizeof(int), prox_rank_cmp);
+}
+
 // ---- systems ----
 static void sys_proximity_build_view_impl(void)
 {
@@ -101,35 +377,108 @@ static void sys_proximity_build_view_impl(void)
     prox_prev.size = prox_curr.size;
     DA_CLEAR(&prox_curr);
 
-    for (int a = 0; a < ECS_MAX_ENTITIES; ++a) {
-        if (!ecs_alive_idx(a)) continue;
-        if ((ecs_mask[a] & (CMP_POS | CMP_COL | CMP_TRIGGER)) != (CMP_POS | CMP_COL | CMP_TRIGGER)) continue;
+    const ecs_query_t* owners = ecs_query_get(CMP_SET(CMP_POS, CMP_COL, CMP_TRIGGER), CMP_NONE);
+    const ecs_query_t* bodies = ecs_query_get(CMP_SET(CMP_POS, CMP_COL), CMP_NONE);
+    if (!owners || !bodies || owners->match.size == 0) {
+        prox_lists_changed();
+        return;
+    }
+
+    prox_grid_t grid;
+    prox_grid_build(&grid, bodies->match.data, (int)bodies->match.size);
 
+    for (size_t ka = 0; ka < owners->match.size; ++ka) {
+        const int a = owners->match.data[ka];
         const cmp_trigger_t* tr = &cmp_trigger[a];
+        const bool filtered = !component_mask_empty(tr->target_mask);
 
-        for (int b = 0; b < ECS_MAX_ENTITIES; ++b) {
-            if (b == a || !ecs_alive_idx(b)) continue;
-            if (tr->target_mask) {
+        prox_grid_gather(&grid, a, tr->pad);
+        for (size_t kc = 0; kc < g_prox_cand.size; ++kc) {
+            const int b = bodies->match.data[g_prox_cand.data[kc]];
+            if (b == a) continue;
+            if (filtered) {
                 bool matches = false;
                 switch (tr->match) {
                     case TRIGGER_MATCH_ANY:
-                        matches = (ecs_mask[b] & tr->target_mask) != 0;
+                        matches = component_mask_any(ecs_mask[b], tr->target_mask);
                         break;
                     case TRIGGER_MATCH_ALL:
                     default:
-                        matches = (ecs_mask[b] & tr->target_mask) == tr->target_mask;
+                        matches = component_mask_all(ecs_mask[b], tr->target_mask);
                         break;
                 }
                 if (!matches) continue;
             }
-            if ((ecs_mask[b] & (CMP_POS | CMP_COL)) != (CMP_POS | CMP_COL)) continue;
-
             if (col_overlap_padded_idx(a, b, tr->pad)) {
                 ecs_prox_view_t v = { handle_from_index(a), handle_from_index(b) };
                 DA_APPEND(&prox_curr, v);
             }
         }
     }
+    prox_lists_changed();
+}
+
+static void prox_remap_list(ecs_prox_view_t* views, size_t n)
+{
+    for (size_t i = 0; i < n; ++i) {
+        views[i].trigger_owner = ecs_remap_handle(views[i].trigger_owner);
+        views[i].matched_entity = ecs_remap_handle(views[i].matched_entity);
+    }
+}
+
+void ecs_prox_remap_handles(void)
+{
+    prox_remap_list(prox_curr.data, prox_curr.size);
+    prox_remap_list(prox_prev.data, prox_prev.size);
+    prox_lists_changed();
+}
+
+static void prox_snapshot_write(byte_buf_t* out, const ecs_prox_view_t* views, size_t n)
+{
+    byte_buf_write_u32(out, (uint32_t)n);
+    byte_buf_write(out, views, n * sizeof(*views));
+}
+
+static const void* prox_snapshot_view(byte_reader_t* in, uint32_t* out_n)
+{
+    *out_n = byte_reader_u32(in);
+    return byte_reader_view(in, (size_t)*out_n * sizeof(ecs_prox_view_t));
+}
+
+bool ecs_prox_snapshot_save(byte_buf_t* out)
+{
+    if (!out) return false;
+    prox_snapshot_write(out, prox_curr.data, prox_curr.size);
+    prox_snapshot_write(out, prox_prev.data, prox_prev.size);
+    return true;
+}
+
+bool ecs_prox_snapshot_check(byte_reader_t* in)
+{
+    if (!in) return false;
+    uint32_t n = 0;
+    prox_snapshot_view(in, &n);
+    prox_snapshot_view(in, &n);
+    return in->ok;
+}
+
+bool ecs_prox_snapshot_load(byte_reader_t* in)
+{
+    if (!in) return false;
+    uint32_t curr_n = 0, prev_n = 0;
+    const void* curr = prox_snapshot_view(in, &curr_n);
+    const void* prev = prox_snapshot_view(in, &prev_n);
+    if (!in->ok) return false;
+    DA_CLEAR(&prox_curr);
+    DA_CLEAR(&prox_prev);
+    DA_RESERVE(&prox_curr, curr_n);
+    DA_RESERVE(&prox_prev, prev_n);
+    if (curr_n > 0) memcpy(prox_curr.data, curr, curr_n * sizeof(ecs_prox_view_t));
+    if (prev_n > 0) memcpy(prox_prev.data, prev, prev_n * sizeof(ecs_prox_view_t));
+    prox_curr.size = curr_n;
+    prox_prev.size = prev_n;
+    prox_lists_changed();
+    return true;
 }
 
 // Public adapters (used by ecs_core.c)
@@ -1,6 +1,7 @@
 #pragma once
 #include <stdbool.h>
 #include "engine/ecs/ecs.h"
+#include "engine/utils/byte_buf.h"
 
 // View of a proximity pair (trigger-owner, target)
 typedef struct {
@@ -8,7 +9,8 @@ typedef struct {
     ecs_entity_t matched_entity;   // the entity that matched filter & is within pad
 } ecs_prox_view_t;
 
-typedef struct { int i; } ecs_prox_iter_t;
+// `stream` is 0 for the full list, otherwise an owner stream from *_begin_for.
+typedef struct { int i; int stream; } ecs_prox_iter_t;
 
 ecs_prox_iter_t ecs_prox_stay_begin(void);
 bool            ecs_prox_stay_next(ecs_prox_iter_t* it, ecs_prox_view_t* out);
@@ -18,3 +20,25 @@ bool            ecs_prox_enter_next(ecs_prox_iter_t* it, ecs_prox_view_t* out);
 
 ecs_prox_iter_t ecs_prox_exit_begin(void);
 bool            ecs_prox_exit_next(ecs_prox_iter_t* it, ecs_prox_view_t* out);
+
+// Same lists restricted to pairs whose trigger owner has any of owner_mask
+// (as of the first *_begin_for call after the build), in the same order.
+// Walk them with the matching *_next.
+ecs_prox_iter_t ecs_prox_stay_begin_for(ComponentMask owner_mask);
+ecs_prox_iter_t ecs_prox_enter_begin_for(ComponentMask owner_mask);
+ecs_prox_iter_t ecs_prox_exit_begin_for(ComponentMask owner_mask);
+
+// This tick's enter/exit pairs, in the order the iterators visit them.
+// Unlike the iterators these include pairs whose entities died since the
+// build; check ecs_alive_handle before use.
+const ecs_prox_view_t* ecs_prox_enter_list(int* out_count);
+const ecs_prox_view_t* ecs_prox_exit_list(int* out_count);
+
+// Rewrites stored pairs to current handles after ecs_compact.
+void ecs_prox_remap_handles(void);
+
+// Current/previous pair lists, so enter/exit events survive a snapshot restore.
+bool ecs_prox_snapshot_save(byte_buf_t* out);
+bool ecs_prox_snapshot_load(byte_reader_t* in);
+// Advances `in` past the section; false if it is truncated.
+bool ecs_prox_snapshot_check(byte_reader_t* in);
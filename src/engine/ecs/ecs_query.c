@@ -0,0 +1,137 @@
+//==== FROM ecs_query.c ====
+#include "engine/ecs/ecs_query.h"
+#include "engine/ecs/ecs_core.h"
+#include "engine/core/logger/logger.h"
+
+#include <string.h>
+
+#define ECS_MAX_QUERIES 64
+
+static ecs_query_t g_queries[ECS_MAX_QUERIES];
+static int g_query_count = 0;
+
+static bool query_matches(const ecs_query_t* q, ComponentMask mask)
+{
+    return component_mask_all(mask, q->require) & !component_mask_any(mask, q->exclude);
+}
+
+// First position whose index is > idx.
+static int query_upper_bound(const ecs_query_t* q, int idx)
+{
+    int lo = 0;
+    int hi = (int)q->match.size;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (q->match.data[mid] <= idx) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+static void query_insert(ecs_query_t* q, int idx)
+{
+    int pos = query_upper_bound(q, idx);
+    if (pos > 0 && q->match.data[pos - 1] == idx) return;
+    DA_RESERVE(&q->match, q->match.size + 1);
+    memmove(q->match.data + pos + 1, q->match.data + pos, sizeof(int) * (q->match.size - (size_t)pos));
+    q->match.data[pos] = idx;
+    q->match.size++;
+}
+
+static void query_remove(ecs_query_t* q, int idx)
+{
+    int pos = query_upper_bound(q, idx) - 1;
+    if (pos < 0 || q->match.data[pos] != idx) return;
+    memmove(q->match.data + pos, q->match.data + pos + 1, sizeof(int) * (q->match.size - (size_t)pos - 1));
+    q->match.size--;
+}
+
+static void query_fill(ecs_query_t* q)
+{
+    q->match.size = 0;
+    const int cap = ecs_capacity();
+    for (int i = 0; i < cap; ++i) {
+        if (!ecs_alive_idx(i)) continue;
+        if (!query_matches(q, ecs_mask[i])) continue;
+        DA_APPEND(&q->match, i);
+    }
+}
+
+ecs_query_t* ecs_query_get(ComponentMask require, ComponentMask exclude)
+{
+    for (int i = 0; i < g_query_count; ++i) {
+        if (component_mask_eq(g_queries[i].require, require) && component_mask_eq(g_queries[i].exclude, exclude)) {
+            return &g_queries[i];
+        }
+    }
+    if (g_query_count >= ECS_MAX_QUERIES) {
+        LOGC(LOGCAT_ECS, LOG_LVL_ERROR, "ecs: too many queries (max=%d)", ECS_MAX_QUERIES);
+        return NULL;
+    }
+
+    ecs_query_t* q = &g_queries[g_query_count++];
+    *q = (ecs_query_t){ .require = require, .exclude = exclude };
+    query_fill(q);
+    return q;
+}
+
+ecs_query_iter_t ecs_query_begin(const ecs_query_t* q)
+{
+    return (ecs_query_iter_t){ .q = q, .pos = 0, .last = -1 };
+}
+
+bool ecs_query_next(ecs_query_iter_t* it, int* out_idx)
+{
+    const ecs_query_t* q = it->q;
+    if (!q) return false;
+
+    int count = (int)q->match.size;
+    int pos = it->pos;
+    // Fast path: nothing moved since the last step.
+    bool in_place = pos <= count
+        && (pos == count || q->match.data[pos] > it->last)
+        && (pos == 0 || q->match.data[pos - 1] <= it->last);
+    if (!in_place) {
+        pos = query_upper_bound(q, it->last);
+    }
+    if (pos >= count) {
+        it->pos = count;
+        return false;
+    }
+
+    int idx = q->match.data[pos];
+    it->pos = pos + 1;
+    it->last = idx;
+    *out_idx = idx;
+    return true;
+}
+
+void ecs_query_track(int idx, bool was_alive, ComponentMask old_mask, bool alive, ComponentMask new_mask)
+{
+    const ComponentMask changed = component_mask_xor(old_mask, new_mask);
+    const bool life_changed = was_alive != alive;
+    for (int i = 0; i < g_query_count; ++i) {
+        ecs_query_t* q = &g_queries[i];
+        if (!life_changed && !component_mask_any(changed, component_mask_or(q->require, q->exclude))) continue;
+        bool before = was_alive && query_matches(q, old_mask);
+        bool after = alive && query_matches(q, new_mask);
+        if (before == after) continue;
+        if (after) query_insert(q, idx);
+        else       query_remove(q, idx);
+    }
+}
+
+void ecs_query_rebuild_all(void)
+{
+    for (int i = 0; i < g_query_count; ++i) {
+        query_fill(&g_queries[i]);
+    }
+}
+
+void ecs_query_reset_all(void)
+{
+    for (int i = 0; i < g_query_count; ++i) {
+        DA_FREE(&g_queries[i].match);
+    }
+    g_query_count = 0;
+}
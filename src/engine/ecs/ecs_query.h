@@ -0,0 +1,43 @@
+#pragma once
+#include <stdbool.h>
+#include "engine/ecs/ecs.h"
+#include "engine/utils/dynarray.h"
+
+// Cached archetype query: every live entity whose mask has all `require`
+// bits and none of the `exclude` bits, kept as an ascending index list.
+// The list is maintained incrementally by create/destroy and by
+// ecs_mask_add/ecs_mask_remove, so walking it costs O(matches).
+typedef struct {
+    ComponentMask require;
+    ComponentMask exclude;
+    DA(int) match;   // read-only for callers
+} ecs_query_t;
+
+// Returns the shared query for this mask pair, creating it on first use.
+// Queries live until ecs_shutdown()/ecs_init(); look them up each tick
+// rather than caching the pointer across a reset.
+ecs_query_t* ecs_query_get(ComponentMask require, ComponentMask exclude);
+
+// Ascending walk that tolerates entities being created/destroyed or
+// gaining/losing components mid-loop: it resumes after the last index it
+// returned, the same way a full 0..capacity scan would.
+typedef struct {
+    const ecs_query_t* q;
+    int pos;
+    int last;
+} ecs_query_iter_t;
+
+ecs_query_iter_t ecs_query_begin(const ecs_query_t* q);
+bool             ecs_query_next(ecs_query_iter_t* it, int* out_idx);
+
+// for-each over a query; `idx` is declared by the macro. break/continue
+// behave as in a plain loop.
+#define ECS_QUERY_EACH(query, idx) \
+    for (ecs_query_iter_t idx##_qit = ecs_query_begin(query); idx##_qit.q; idx##_qit.q = NULL) \
+        for (int idx; ecs_query_next(&idx##_qit, &idx);)
+
+// ===== Internal: driven by ecs_core =====
+void ecs_query_track(int idx, bool was_alive, ComponentMask old_mask, bool alive, ComponentMask new_mask);
+// Recomputes every match list from ecs_mask (after a snapshot restore).
+void ecs_query_rebuild_all(void);
+void ecs_query_reset_all(void);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "engine/ecs/ecs.h"
+#include "engine/ecs/ecs_query.h"
 #include "engine/asset/asset.h"
 
 // --- draw views (data only) ---
@@ -41,21 +42,21 @@ void cmp_add_sprite_path  (ecs_entity_t e, const char* path, gfx_rect src, float
 
 // ========= Iterators (render-facing) ========
 // --- sprite iterator ---
-typedef struct { int i; } ecs_sprite_iter_t;
+typedef struct { ecs_query_iter_t q; } ecs_sprite_iter_t;
 ecs_sprite_iter_t ecs_sprites_begin(void);
 bool ecs_sprites_next(ecs_sprite_iter_t* it, ecs_sprite_view_t* out);
 
 // --- collider iterator ---
-typedef struct { int i; } ecs_collider_iter_t;
+typedef struct { ecs_query_iter_t q; } ecs_collider_iter_t;
 ecs_collider_iter_t ecs_colliders_begin(void);
 bool ecs_colliders_next(ecs_collider_iter_t* it, ecs_collider_view_t* out);
 
 // --- trigger iterator ---
-typedef struct { int i; } ecs_trigger_iter_t;
+typedef struct { ecs_query_iter_t q; } ecs_trigger_iter_t;
 ecs_trigger_iter_t ecs_triggers_begin(void);
 bool ecs_triggers_next(ecs_trigger_iter_t* it, ecs_trigger_view_t* out);
 
 // --- billboard iterator ---
-typedef struct { int i; } ecs_billboard_iter_t;
+typedef struct { ecs_query_iter_t q; } ecs_billboard_iter_t;
 ecs_billboard_iter_t ecs_billboards_begin(void);
 bool ecs_billboards_next(ecs_billboard_iter_t* it, ecs_billboard_view_t* out);
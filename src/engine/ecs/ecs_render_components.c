@@ -7,19 +7,84 @@
 #include "engine/ecs/ecs_render.h"
 #include "engine/asset/asset.h"
 
+#include <string.h>
+
 static void ecs_sprite_destroy_hook(int idx)
 {
-    if (idx < 0 || idx >= ECS_MAX_ENTITIES) return;
-    if (!(ecs_mask[idx] & CMP_SPR)) return;
+    if (idx < 0 || idx >= ecs_capacity()) return;
+    if (!component_mask_any(ecs_mask[idx], CMP_SPR)) return;
     if (asset_texture_valid(cmp_spr[idx].tex)) {
         asset_release_texture(cmp_spr[idx].tex);
         cmp_spr[idx].tex = (tex_handle_t){ .idx = 0, .gen = 0 };
     }
 }
 
+// Texture handles are only meaningful to the running asset table, so
+// snapshots carry each sprite's texture path and re-acquire on load.
+static void ecs_sprite_snapshot_release(void)
+{
+    const int cap = ecs_capacity();
+    for (int i = 0; i < cap; ++i) {
+        if (ecs_alive_idx(i)) ecs_sprite_destroy_hook(i);
+    }
+}
+
+static void ecs_sprite_snapshot_save(byte_buf_t* out)
+{
+    const int cap = ecs_capacity();
+    size_t count_at = byte_buf_placeholder_u32(out);
+    uint32_t count = 0;
+    for (int i = 0; i < cap; ++i) {
+        if (!ecs_alive_idx(i) || !component_mask_any(ecs_mask[i], CMP_SPR)) continue;
+        const char* path = asset_texture_valid(cmp_spr[i].tex) ? asset_texture_path(cmp_spr[i].tex) : NULL;
+        if (!path) continue;
+        uint32_t len = (uint32_t)strlen(path);
+        byte_buf_write_u32(out, (uint32_t)i);
+        byte_buf_write_u32(out, len);
+        byte_buf_write(out, path, len);
+        count++;
+    }
+    byte_buf_patch_u32(out, count_at, count);
+}
+
+static bool ecs_sprite_snapshot_load(byte_reader_t* in)
+{
+    const int cap = ecs_capacity();
+    for (int i = 0; i < cap; ++i) {
+        cmp_spr[i].tex = (tex_handle_t){ .idx = 0, .gen = 0 };
+    }
+
+    char path[512];
+    tex_handle_t last = { .idx = 0, .gen = 0 };
+    path[0] = '\0';
+    uint32_t count = byte_reader_u32(in);
+    for (uint32_t n = 0; n < count && in->ok; ++n) {
+        uint32_t idx = byte_reader_u32(in);
+        uint32_t len = byte_reader_u32(in);
+        const char* s = byte_reader_view(in, len);
+        if (!s || len >= sizeof(path) || idx >= (uint32_t)cap) return false;
+        // Entities were saved in index order, so runs sharing a texture are common.
+        if (!asset_texture_valid(last) || strlen(path) != len || memcmp(path, s, len) != 0) {
+            memcpy(path, s, len);
+            path[len] = '\0';
+            last = asset_acquire_texture(path);
+            cmp_spr[idx].tex = last;
+        } else {
+            asset_addref_texture(last);
+            cmp_spr[idx].tex = last;
+        }
+    }
+    return in->ok;
+}
+
 void ecs_register_render_component_hooks(void)
 {
     ecs_register_component_destroy_hook(ENUM_SPR, ecs_sprite_destroy_hook);
+    ecs_register_component_snapshot_hooks(ENUM_SPR, (ecs_snapshot_hooks_t){
+        .release = ecs_sprite_snapshot_release,
+        .save = ecs_sprite_snapshot_save,
+        .load = ecs_sprite_snapshot_load,
+    });
 }
 
 void cmp_add_sprite_handle(ecs_entity_t e, tex_handle_t h, gfx_rect src, float ox, float oy)
@@ -40,7 +105,8 @@ void cmp_add_sprite_handle(ecs_entity_t e, tex_handle_t h, gfx_rect src, float o
             .highlight_thickness = 1,
         },
     };
-    ecs_mask[i] |= CMP_SPR;
+    ecs_mask_add(i, CMP_SPR);
+    ecs_mark_changed(i, CMP_SPR);
 }
 
 void cmp_add_sprite_path(ecs_entity_t e, const char* path, gfx_rect src, float ox, float oy)
@@ -6,14 +6,17 @@
 #include "engine/ecs/ecs.h"
 #include "engine/ecs/ecs_engine.h"
 #include "engine/ecs/ecs_physics.h"
+#include "engine/ecs/ecs_compact.h"
 #include "engine/runtime/toast.h"
 #include "engine/renderer/renderer.h"
 #include "engine/runtime/camera.h"
 #include "engine/world/world_map.h"
+#include "engine/nav/nav.h"
 #include "engine/engine/engine_scheduler/engine_scheduler.h"
 #include "engine/engine/engine_scheduler/engine_register_systems.h"
 #include "engine/core/platform/platform.h"
 #include "engine/core/time/time.h"
+#include "engine/core/jobs/jobs.h"
 #include "engine/engine/engine_phases/engine_phase.h"
 #include "engine/prefab/registry/pf_registry.h"
 #include "engine/prefab/loading/pf_loading.h"
@@ -37,6 +40,7 @@ static bool engine_init_entities(const char* tmx_path)
         return false;
     }
     pf_spawn_from_map(map, tmx_path);
+    ecs_compact_spatial();
     return true;
 }
 
@@ -91,6 +95,7 @@ static bool engine_init_subsystems(const char *title)
     logger_backend_init();
     log_set_min_level(LOG_LVL_DEBUG);
 
+    jobs_init(JOBS_AUTO);
     ui_toast_init();
     engine_scheduler_init();
     input_init();
@@ -175,7 +180,9 @@ void engine_shutdown(void)
     asset_shutdown();
     renderer_shutdown();
     camera_shutdown();
+    nav_shutdown();
     world_shutdown();
+    jobs_shutdown();
 }
 
 bool engine_reload_world(void)
@@ -8,6 +8,7 @@ void sys_physics_adapt(float dt, const input_t* in);
 void sys_anim_sprite_adapt(float dt, const input_t* in);
 void sys_prox_build_adapt(float dt, const input_t* in);
 void sys_billboards_adapt(float dt, const input_t* in);
+void sys_compact_adapt(float dt, const input_t* in);
 void sys_effects_tick_begin_adapt(float dt, const input_t* in);
 
 void sys_render_begin_adapt(float dt, const input_t* in);
@@ -23,6 +24,7 @@ void sys_render_end_adapt(float dt, const input_t* in);
 void sys_toast_update_adapt(float dt, const input_t* in);
 void sys_camera_tick_adapt(float dt, const input_t* in);
 void sys_world_apply_edits_adapt(float dt, const input_t* in);
+void sys_nav_tick_adapt(float dt, const input_t* in);
 void sys_asset_collect_adapt(float dt, const input_t* in);
 #if DEBUG_BUILD
 void sys_debug_binds_adapt(float dt, const input_t* in);
@@ -37,6 +39,8 @@ void engine_register_systems(void)
     engine_scheduler_register(PHASE_SIM_POST, 100, sys_prox_build_adapt, "proximity_view");
     engine_scheduler_register(PHASE_SIM_POST, 200, sys_billboards_adapt, "billboards");
     engine_scheduler_register(PHASE_SIM_POST, 300, sys_world_apply_edits_adapt, "world_apply_edits");
+    engine_scheduler_register(PHASE_SIM_POST, 350, sys_nav_tick_adapt, "nav");
+    engine_scheduler_register(PHASE_SIM_POST, 400, sys_compact_adapt, "entity_compact");
 
     engine_scheduler_register(PHASE_PRE_RENDER, 100, sys_toast_update_adapt, "toast_update");
     engine_scheduler_register(PHASE_PRE_RENDER, 200, sys_camera_tick_adapt, "camera_tick");
@@ -1,6 +1,9 @@
 #include "engine/engine/engine_scheduler/engine_scheduler.h"
 #include "engine/core/logger/logger.h"
 #include "engine/debug/profile_trace/profiler_trace.h"
+#include "engine/ecs/ecs_cmd.h"
+#include "engine/ecs/ecs_change.h"
+#include "engine/ecs/ecs_event.h"
 #include "engine/utils/dynarray.h"
 #include <stdbool.h>
 #include <string.h>
@@ -94,10 +97,15 @@ void engine_scheduler_run_phase(systems_phase_t phase, float dt, const input_t*
             const char* sys_name = g_systems[phase].data[i].name;
             if (!sys_name) sys_name = "(unnamed)";
             prof_trace_system_begin(tid, frame, sys_name);
+            ecs_change_advance();
             fn(dt, in);
             prof_trace_system_end(tid, frame);
         }
     }
+    // Sync point: structural changes recorded during the phase land here,
+    // then events raised up to now become visible to later phases.
+    ecs_cmd_flush();
+    ecs_event_swap_phase(phase);
     prof_trace_phase_end(tid, frame);
 }
 
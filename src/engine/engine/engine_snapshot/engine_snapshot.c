@@ -0,0 +1,61 @@
+#include "engine/engine/engine_snapshot/engine_snapshot.h"
+#include "engine/ecs/ecs_core.h"
+#include "engine/ecs/ecs_compact.h"
+#include "engine/ecs/ecs_proximity.h"
+#include "engine/world/world_map.h"
+#include "engine/core/logger/logger.h"
+
+#define ENGINE_SNAPSHOT_MAGIC 0x50414E53u   // "SNAP"
+
+bool engine_snapshot_save(byte_buf_t* out)
+{
+    if (!out) return false;
+    const size_t start = out->size;
+    bool ok = byte_buf_write_u32(out, ENGINE_SNAPSHOT_MAGIC)
+        && byte_buf_write_u32(out, ENGINE_SNAPSHOT_VERSION)
+        && ecs_snapshot_save(out)
+        && ecs_compact_snapshot_save(out)
+        && ecs_event_snapshot_save(out)
+        && ecs_prox_snapshot_save(out)
+        && world_snapshot_save(out);
+    if (!ok) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_ERROR, "snapshot: save failed");
+        out->size = start;
+    }
+    return ok;
+}
+
+bool engine_snapshot_load(const void* data, size_t size)
+{
+    byte_reader_t in = byte_reader_make(data, size);
+    const uint32_t magic = byte_reader_u32(&in);
+    const uint32_t version = byte_reader_u32(&in);
+    if (!in.ok || magic != ENGINE_SNAPSHOT_MAGIC || version != ENGINE_SNAPSHOT_VERSION) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_ERROR, "snapshot: unsupported blob (magic=%08x version=%u)", magic, version);
+        return false;
+    }
+    // Every section is validated before any is applied, so a rejected blob
+    // leaves the whole game as it was rather than half restored.
+    byte_reader_t check = in;
+    if (!ecs_snapshot_check(&check)) return false;
+    if (!ecs_compact_snapshot_check(&check)) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_ERROR, "snapshot: compaction section rejected");
+        return false;
+    }
+    if (!ecs_event_snapshot_check(&check)) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_ERROR, "snapshot: event section rejected");
+        return false;
+    }
+    if (!ecs_prox_snapshot_check(&check) || !world_snapshot_check(&check)) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_ERROR, "snapshot: world/proximity section rejected");
+        return false;
+    }
+    if (!ecs_snapshot_load(&in) || !ecs_compact_snapshot_load(&in) || !ecs_event_snapshot_load(&in) || !ecs_prox_snapshot_load(&in) || !world_snapshot_load(&in)) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_ERROR, "snapshot: load failed after validation");
+        return false;
+    }
+    if (byte_reader_remaining(&in) != 0) {
+        LOGC(LOGCAT_MAIN, LOG_LVL_WARN, "snapshot: %zu trailing bytes ignored", byte_reader_remaining(&in));
+    }
+    return true;
+}
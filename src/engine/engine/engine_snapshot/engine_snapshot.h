@@ -0,0 +1,18 @@
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include "engine/utils/byte_buf.h"
+
+// Full-world binary snapshot: ECS (entities, component storage, sparse sets
+// and hooked per-component state), the compaction timer, in-flight events,
+// proximity pairs and runtime tile state.
+// Blobs are versioned and tied to the running build's component schema and
+// the currently loaded map; they are meant for save games and rollback, not
+// for exchange between different builds or architectures.
+#define ENGINE_SNAPSHOT_VERSION 3
+
+// Appends the snapshot to `out` (does not clear it first).
+bool engine_snapshot_save(byte_buf_t* out);
+// Restores a blob from engine_snapshot_save. Every section is validated
+// before any is applied; a rejected blob (false) leaves the world untouched.
+bool engine_snapshot_load(const void* data, size_t size);
@@ -0,0 +1,803 @@
+#include "engine/nav/nav.h"
+#include "engine/core/logger/logger.h"
+#include "engine/engine/engine_scheduler/engine_scheduler.h"
+#include "engine/utils/dynarray.h"
+#include "engine/world/world_map.h"
+#include "engine/world/world_query.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NAV_CLUSTER_SUBTILES 16
+#define NAV_CLUSTER_CELLS (NAV_CLUSTER_SUBTILES * NAV_CLUSTER_SUBTILES)
+// Walkable border runs at least this long get an entrance at each end
+// instead of a single one in the middle.
+#define NAV_ENTRANCE_SPLIT 6
+#define NAV_COST_STRAIGHT 10
+#define NAV_COST_DIAGONAL 14
+#define NAV_COST_INF INT32_MAX
+// Search nodes expanded per tick before queued requests wait for the next
+// one. Counted rather than timed so a replay serves requests on the same ticks.
+#define NAV_TICK_BUDGET 20000
+
+typedef DA(int) nav_ids_t;
+typedef DA(int32_t) nav_costs_t;
+
+typedef struct {
+    int x, y;        // subtile
+    int cluster;     // -1 = free slot
+    int twin;        // entrance across the border
+} nav_node_t;
+
+typedef struct {
+    nav_ids_t nodes;     // entrance node ids
+    nav_costs_t cost;    // nodes.size^2, row-major; NAV_COST_INF = no route inside the cluster
+} nav_cluster_t;
+
+typedef struct {
+    int x0, y0, w, h;
+} nav_rect_t;
+
+typedef struct {
+    int32_t f, h;
+    int id;
+} nav_open_t;
+
+typedef DA(nav_open_t) nav_heap_t;
+typedef DA(gfx_vec2) nav_points_t;
+
+typedef struct {
+    uint32_t gen;
+    nav_path_status_t status;
+    float sx, sy, gx, gy;
+    nav_points_t points;
+} nav_slot_t;
+
+typedef struct {
+    bool built;
+    uint32_t map_gen;
+    uint32_t revision;
+    int tiles_w, tiles_h;
+    int per_tile;          // subtiles per tile side
+    float sub_px;          // subtile size in pixels
+    int w, h;              // subtiles
+    int cw, ch;            // clusters
+    uint8_t* open;         // per subtile
+    uint16_t* masks;       // per tile, as of the last sync
+    nav_cluster_t* clusters;
+    nav_ids_t* borders;    // 2 per cluster (east, south); node ids in pairs, near side first
+    DA(nav_node_t) nodes;
+    nav_ids_t free_nodes;
+    uint8_t* cluster_dirty;
+    uint8_t* border_dirty;
+} nav_graph_t;
+
+static nav_graph_t g_nav;
+
+static DA(nav_slot_t) g_slots;
+static nav_ids_t g_free_slots;
+static DA(nav_path_id_t) g_queue;
+
+// Search scratch.
+static nav_heap_t g_heap;
+static int32_t g_local_g[NAV_CLUSTER_CELLS];
+static int g_local_parent[NAV_CLUSTER_CELLS];
+static uint8_t g_local_closed[NAV_CLUSTER_CELLS];
+static nav_costs_t g_abs_g;
+static nav_ids_t g_abs_parent;
+static DA(uint8_t) g_abs_closed;
+static nav_costs_t g_start_cost;
+static nav_costs_t g_goal_cost;
+static nav_ids_t g_chain;
+static nav_ids_t g_cells;      // planned path as subtile indices, start excluded
+static nav_points_t g_points;
+static int g_expanded;
+
+static const int k_dirs[8][2] = {
+    { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 }, { 1, 1 }, { -1, 1 }, { 1, -1 }, { -1, -1 }
+};
+
+static bool nav_open_less(nav_open_t a, nav_open_t b)
+{
+    if (a.f != b.f) return a.f < b.f;
+    if (a.h != b.h) return a.h < b.h;
+    return a.id < b.id;
+}
+
+static void nav_heap_push(nav_heap_t* hp, nav_open_t e)
+{
+    DA_APPEND(hp, e);
+    size_t i = hp->size - 1;
+    while (i > 0) {
+        const size_t p = (i - 1) / 2;
+        if (!nav_open_less(hp->data[i], hp->data[p])) break;
+        const nav_open_t t = hp->data[i];
+        hp->data[i] = hp->data[p];
+        hp->data[p] = t;
+        i = p;
+    }
+}
+
+static nav_open_t nav_heap_pop(nav_heap_t* hp)
+{
+    const nav_open_t top = hp->data[0];
+    hp->data[0] = hp->data[--hp->size];
+    size_t i = 0;
+    for (;;) {
+        const size_t l = i * 2 + 1, r = l + 1;
+        size_t m = i;
+        if (l < hp->size && nav_open_less(hp->data[l], hp->data[m])) m = l;
+        if (r < hp->size && nav_open_less(hp->data[r], hp->data[m])) m = r;
+        if (m == i) break;
+        const nav_open_t t = hp->data[i];
+        hp->data[i] = hp->data[m];
+        hp->data[m] = t;
+        i = m;
+    }
+    return top;
+}
+
+static int32_t nav_octile(int dx, int dy)
+{
+    dx = abs(dx);
+    dy = abs(dy);
+    const int lo = dx < dy ? dx : dy, hi = dx < dy ? dy : dx;
+    return (int32_t)(NAV_COST_STRAIGHT * hi + (NAV_COST_DIAGONAL - NAV_COST_STRAIGHT) * lo);
+}
+
+static int nav_sign(int v)
+{
+    return (v > 0) - (v < 0);
+}
+
+static bool nav_open_at(int x, int y)
+{
+    return x >= 0 && y >= 0 && x < g_nav.w && y < g_nav.h && g_nav.open[(size_t)y * (size_t)g_nav.w + (size_t)x];
+}
+
+static bool nav_rect_open(const nav_rect_t* r, int x, int y)
+{
+    return x >= r->x0 && y >= r->y0 && x < r->x0 + r->w && y < r->y0 + r->h &&
+           g_nav.open[(size_t)y * (size_t)g_nav.w + (size_t)x];
+}
+
+// One 8-way move inside `r`; a diagonal needs both orthogonal neighbours open.
+static bool nav_can_step(const nav_rect_t* r, int x, int y, int dx, int dy)
+{
+    if (!nav_rect_open(r, x + dx, y + dy)) return false;
+    return !(dx && dy) || (nav_rect_open(r, x + dx, y) && nav_rect_open(r, x, y + dy));
+}
+
+static int nav_cluster_of(int x, int y)
+{
+    return (y / NAV_CLUSTER_SUBTILES) * g_nav.cw + x / NAV_CLUSTER_SUBTILES;
+}
+
+static nav_rect_t nav_cluster_rect(int c)
+{
+    nav_rect_t r;
+    r.x0 = (c % g_nav.cw) * NAV_CLUSTER_SUBTILES;
+    r.y0 = (c / g_nav.cw) * NAV_CLUSTER_SUBTILES;
+    r.w = g_nav.w - r.x0 < NAV_CLUSTER_SUBTILES ? g_nav.w - r.x0 : NAV_CLUSTER_SUBTILES;
+    r.h = g_nav.h - r.y0 < NAV_CLUSTER_SUBTILES ? g_nav.h - r.y0 : NAV_CLUSTER_SUBTILES;
+    return r;
+}
+
+// Costs from (sx, sy) to every subtile of `r` reachable without leaving it,
+// left in g_local_g (rect-relative, row-major).
+static void nav_local_costs(const nav_rect_t* r, int sx, int sy)
+{
+    const int n = r->w * r->h;
+    for (int i = 0; i < n; ++i) {
+        g_local_g[i] = NAV_COST_INF;
+        g_local_closed[i] = 0;
+    }
+    DA_CLEAR(&g_heap);
+    const int s = (sy - r->y0) * r->w + (sx - r->x0);
+    g_local_g[s] = 0;
+    nav_heap_push(&g_heap, (nav_open_t){ 0, 0, s });
+    while (g_heap.size) {
+        const nav_open_t e = nav_heap_pop(&g_heap);
+        if (g_local_closed[e.id]) continue;
+        g_local_closed[e.id] = 1;
+        ++g_expanded;
+        const int x = r->x0 + e.id % r->w, y = r->y0 + e.id / r->w;
+        for (int d = 0; d < 8; ++d) {
+            const int dx = k_dirs[d][0], dy = k_dirs[d][1];
+            if (!nav_can_step(r, x, y, dx, dy)) continue;
+            const int m = e.id + dy * r->w + dx;
+            const int32_t g = e.f + ((dx && dy) ? NAV_COST_DIAGONAL : NAV_COST_STRAIGHT);
+            if (g < g_local_g[m]) {
+                g_local_g[m] = g;
+                nav_heap_push(&g_heap, (nav_open_t){ g, 0, m });
+            }
+        }
+    }
+}
+
+// Walks from (x, y) along (dx, dy) to the next jump point: the target, or a
+// subtile past which some neighbour is only reached optimally through it.
+static bool nav_jump(const nav_rect_t* r, int x, int y, int dx, int dy, int tx, int ty, int* out_x, int* out_y)
+{
+    for (;;) {
+        if (!nav_can_step(r, x, y, dx, dy)) return false;
+        x += dx;
+        y += dy;
+        if (x == tx && y == ty) break;
+        if (dx && dy) {
+            int jx, jy;
+            if (nav_jump(r, x, y, dx, 0, tx, ty, &jx, &jy) || nav_jump(r, x, y, 0, dy, tx, ty, &jx, &jy)) break;
+        } else if (dx) {
+            if ((nav_rect_open(r, x, y - 1) && !nav_rect_open(r, x - dx, y - 1)) ||
+                (nav_rect_open(r, x, y + 1) && !nav_rect_open(r, x - dx, y + 1))) {
+                break;
+            }
+        } else {
+            if ((nav_rect_open(r, x - 1, y) && !nav_rect_open(r, x - 1, y - dy)) ||
+                (nav_rect_open(r, x + 1, y) && !nav_rect_open(r, x + 1, y - dy))) {
+                break;
+            }
+        }
+    }
+    *out_x = x;
+    *out_y = y;
+    return true;
+}
+
+// Directions worth jumping in from (x, y) when it was entered moving along
+// (pdx, pdy); every direction from the start.
+static int nav_jump_dirs(const nav_rect_t* r, int x, int y, int pdx, int pdy, int dirs[8][2])
+{
+    int n = 0;
+#define NAV_ADD_DIR(ddx, ddy) do { dirs[n][0] = (ddx); dirs[n][1] = (ddy); ++n; } while (0)
+    if (!pdx && !pdy) {
+        for (int d = 0; d < 8; ++d) {
+            if (nav_can_step(r, x, y, k_dirs[d][0], k_dirs[d][1])) NAV_ADD_DIR(k_dirs[d][0], k_dirs[d][1]);
+        }
+    } else if (pdx && pdy) {
+        const bool ox = nav_rect_open(r, x + pdx, y), oy = nav_rect_open(r, x, y + pdy);
+        if (ox) NAV_ADD_DIR(pdx, 0);
+        if (oy) NAV_ADD_DIR(0, pdy);
+        if (ox && oy) NAV_ADD_DIR(pdx, pdy);
+    } else if (pdx) {
+        const bool next = nav_rect_open(r, x + pdx, y);
+        const bool lo = nav_rect_open(r, x, y + 1), hi = nav_rect_open(r, x, y - 1);
+        if (next) {
+            NAV_ADD_DIR(pdx, 0);
+            if (lo) NAV_ADD_DIR(pdx, 1);
+            if (hi) NAV_ADD_DIR(pdx, -1);
+        }
+        if (lo) NAV_ADD_DIR(0, 1);
+        if (hi) NAV_ADD_DIR(0, -1);
+    } else {
+        const bool next = nav_rect_open(r, x, y + pdy);
+        const bool lo = nav_rect_open(r, x + 1, y), hi = nav_rect_open(r, x - 1, y);
+        if (next) {
+            NAV_ADD_DIR(0, pdy);
+            if (lo) NAV_ADD_DIR(1, pdy);
+            if (hi) NAV_ADD_DIR(-1, pdy);
+        }
+        if (lo) NAV_ADD_DIR(1, 0);
+        if (hi) NAV_ADD_DIR(-1, 0);
+    }
+#undef NAV_ADD_DIR
+    return n;
+}
+
+// Jump-point search from (sx, sy) to (tx, ty) without leaving `r`. Appends
+// the jump points after the start, ending with the target, to g_cells and
+// returns the path cost; -1 when the target can't be reached inside `r`.
+static int32_t nav_local_path(const nav_rect_t* r, int sx, int sy, int tx, int ty)
+{
+    const int n = r->w * r->h;
+    for (int i = 0; i < n; ++i) {
+        g_local_g[i] = NAV_COST_INF;
+        g_local_parent[i] = -1;
+        g_local_closed[i] = 0;
+    }
+    DA_CLEAR(&g_heap);
+    const int s = (sy - r->y0) * r->w + (sx - r->x0);
+    const int t = (ty - r->y0) * r->w + (tx - r->x0);
+    g_local_g[s] = 0;
+    nav_heap_push(&g_heap, (nav_open_t){ nav_octile(tx - sx, ty - sy), nav_octile(tx - sx, ty - sy), s });
+    while (g_heap.size) {
+        const nav_open_t e = nav_heap_pop(&g_heap);
+        if (g_local_closed[e.id]) continue;
+        g_local_closed[e.id] = 1;
+        ++g_expanded;
+        if (e.id == t) {
+            int back[NAV_CLUSTER_CELLS];
+            int count = 0;
+            for (int c = t; c != s; c = g_local_parent[c]) back[count++] = c;
+            while (count > 0) {
+                const int c = back[--count];
+                DA_APPEND(&g_cells, (r->y0 + c / r->w) * g_nav.w + r->x0 + c % r->w);
+            }
+            return g_local_g[t];
+        }
+        const int x = r->x0 + e.id % r->w, y = r->y0 + e.id / r->w;
+        const int p = g_local_parent[e.id];
+        const int pdx = p < 0 ? 0 : nav_sign(x - (r->x0 + p % r->w));
+        const int pdy = p < 0 ? 0 : nav_sign(y - (r->y0 + p / r->w));
+        int dirs[8][2];
+        const int nd = nav_jump_dirs(r, x, y, pdx, pdy, dirs);
+        for (int d = 0; d < nd; ++d) {
+            int jx, jy;
+            if (!nav_jump(r, x, y, dirs[d][0], dirs[d][1], tx, ty, &jx, &jy)) continue;
+            const int j = (jy - r->y0) * r->w + (jx - r->x0);
+            if (g_local_closed[j]) continue;
+            const int32_t g = g_local_g[e.id] + nav_octile(jx - x, jy - y);
+            if (g < g_local_g[j]) {
+                const int32_t h = nav_octile(tx - jx, ty - jy);
+                g_local_g[j] = g;
+                g_local_parent[j] = e.id;
+                nav_heap_push(&g_heap, (nav_open_t){ g + h, h, j });
+            }
+        }
+    }
+    return -1;
+}
+
+static void nav_node_add(int b, int ax, int ay, int bx, int by, int far)
+{
+    int ids[2];
+    const int xs[2] = { ax, bx }, ys[2] = { ay, by }, cs[2] = { b / 2, far };
+    for (int k = 0; k < 2; ++k) {
+        int id;
+        if (g_nav.free_nodes.size) {
+            id = g_nav.free_nodes.data[--g_nav.free_nodes.size];
+        } else {
+            DA_APPEND(&g_nav.nodes, (nav_node_t){ 0 });
+            id = (int)g_nav.nodes.size - 1;
+        }
+        g_nav.nodes.data[id] = (nav_node_t){ xs[k], ys[k], cs[k], -1 };
+        DA_APPEND(&g_nav.clusters[cs[k]].nodes, id);
+        DA_APPEND(&g_nav.borders[b], id);
+        ids[k] = id;
+    }
+    g_nav.nodes.data[ids[0]].twin = ids[1];
+    g_nav.nodes.data[ids[1]].twin = ids[0];
+}
+
+static void nav_node_free(int id)
+{
+    nav_ids_t* list = &g_nav.clusters[g_nav.nodes.data[id].cluster].nodes;
+    for (size_t i = 0; i < list->size; ++i) {
+        if (list->data[i] != id) continue;
+        memmove(&list->data[i], &list->data[i + 1], (list->size - i - 1) * sizeof(*list->data));
+        --list->size;
+        break;
+    }
+    g_nav.nodes.data[id].cluster = -1;
+    DA_APPEND(&g_nav.free_nodes, id);
+}
+
+// Subtile `i` along border b on its near side; the far side is one step
+// east (even b) or south (odd b).
+static void nav_border_cell(const nav_rect_t* r, int b, int i, int* x, int* y)
+{
+    *x = (b & 1) ? r->x0 + i : r->x0 + r->w - 1;
+    *y = (b & 1) ? r->y0 + r->h - 1 : r->y0 + i;
+}
+
+static void nav_border_build(int b)
+{
+    const int c = b / 2;
+    const bool south = (b & 1) != 0;
+    if (south ? c / g_nav.cw + 1 >= g_nav.ch : c % g_nav.cw + 1 >= g_nav.cw) return;
+    const int far = south ? c + g_nav.cw : c + 1;
+    const nav_rect_t r = nav_cluster_rect(c);
+    const int len = south ? r.w : r.h;
+    const int fx = south ? 0 : 1, fy = south ? 1 : 0;
+    int run = 0;
+    for (int i = 0; i <= len; ++i) {
+        int x = 0, y = 0;
+        if (i < len) {
+            nav_border_cell(&r, b, i, &x, &y);
+            if (nav_open_at(x, y) && nav_open_at(x + fx, y + fy)) {
+                ++run;
+                continue;
+            }
+        }
+        if (run == 0) continue;
+        const int first = i - run, last = i - 1;
+        const int picks[2] = { run < NAV_ENTRANCE_SPLIT ? first + (run - 1) / 2 : first, last };
+        const int pick_count = run < NAV_ENTRANCE_SPLIT ? 1 : 2;
+        for (int k = 0; k < pick_count; ++k) {
+            nav_border_cell(&r, b, picks[k], &x, &y);
+            nav_node_add(b, x, y, x + fx, y + fy, far);
+        }
+        run = 0;
+    }
+}
+
+static void nav_cluster_costs(int c)
+{
+    nav_cluster_t* cl = &g_nav.clusters[c];
+    const nav_rect_t r = nav_cluster_rect(c);
+    const size_t k = cl->nodes.size;
+    DA_RESERVE(&cl->cost, k * k);
+    cl->cost.size = k * k;
+    for (size_t i = 0; i < k; ++i) {
+        const nav_node_t* a = &g_nav.nodes.data[cl->nodes.data[i]];
+        nav_local_costs(&r, a->x, a->y);
+        for (size_t j = 0; j < k; ++j) {
+            const nav_node_t* n = &g_nav.nodes.data[cl->nodes.data[j]];
+            cl->cost.data[i * k + j] = g_local_g[(n->y - r.y0) * r.w + (n->x - r.x0)];
+        }
+    }
+}
+
+// Rebuilds the entrances on every border of a dirty cluster, then the costs
+// of each cluster whose interior or entrances changed.
+static void nav_patch(void)
+{
+    const int count = g_nav.cw * g_nav.ch;
+    memset(g_nav.border_dirty, 0, (size_t)count * 2);
+    for (int c = 0; c < count; ++c) {
+        if (!g_nav.cluster_dirty[c]) continue;
+        g_nav.border_dirty[c * 2] = 1;
+        g_nav.border_dirty[c * 2 + 1] = 1;
+        if (c % g_nav.cw > 0) g_nav.border_dirty[(c - 1) * 2] = 1;
+        if (c / g_nav.cw > 0) g_nav.border_dirty[(c - g_nav.cw) * 2 + 1] = 1;
+    }
+    for (int b = 0; b < count * 2; ++b) {
+        if (!g_nav.border_dirty[b]) continue;
+        for (size_t i = 0; i < g_nav.borders[b].size; ++i) nav_node_free(g_nav.borders[b].data[i]);
+        DA_CLEAR(&g_nav.borders[b]);
+    }
+    for (int b = 0; b < count * 2; ++b) {
+        if (!g_nav.border_dirty[b]) continue;
+        nav_border_build(b);
+        g_nav.cluster_dirty[b / 2] = 1;
+        const int far = (b & 1) ? b / 2 + g_nav.cw : b / 2 + 1;
+        if ((b & 1) ? far < count : (b / 2) % g_nav.cw + 1 < g_nav.cw) g_nav.cluster_dirty[far] = 1;
+    }
+    for (int c = 0; c < count; ++c) {
+        if (!g_nav.cluster_dirty[c]) continue;
+        nav_cluster_costs(c);
+        g_nav.cluster_dirty[c] = 0;
+    }
+}
+
+static void nav_graph_free(void)
+{
+    const int count = g_nav.cw * g_nav.ch;
+    for (int c = 0; c < count && g_nav.clusters; ++c) {
+        DA_FREE(&g_nav.clusters[c].nodes);
+        DA_FREE(&g_nav.clusters[c].cost);
+    }
+    for (int b = 0; b < count * 2 && g_nav.borders; ++b) DA_FREE(&g_nav.borders[b]);
+    free(g_nav.open);
+    free(g_nav.masks);
+    free(g_nav.clusters);
+    free(g_nav.borders);
+    free(g_nav.cluster_dirty);
+    free(g_nav.border_dirty);
+    DA_FREE(&g_nav.nodes);
+    DA_FREE(&g_nav.free_nodes);
+    memset(&g_nav, 0, sizeof(g_nav));
+}
+
+static void nav_rebuild(int tiles_w, int tiles_h)
+{
+    nav_graph_free();
+    const int tile = world_tile_size(), sub = world_subtile_size();
+    if (tile <= 0 || sub <= 0 || tile % sub != 0) return;
+    g_nav.tiles_w = tiles_w;
+    g_nav.tiles_h = tiles_h;
+    g_nav.per_tile = tile / sub;
+    g_nav.sub_px = (float)sub;
+    g_nav.w = tiles_w * g_nav.per_tile;
+    g_nav.h = tiles_h * g_nav.per_tile;
+    g_nav.cw = (g_nav.w + NAV_CLUSTER_SUBTILES - 1) / NAV_CLUSTER_SUBTILES;
+    g_nav.ch = (g_nav.h + NAV_CLUSTER_SUBTILES - 1) / NAV_CLUSTER_SUBTILES;
+    const size_t count = (size_t)g_nav.cw * (size_t)g_nav.ch;
+    g_nav.open = malloc((size_t)g_nav.w * (size_t)g_nav.h);
+    g_nav.masks = malloc((size_t)tiles_w * (size_t)tiles_h * sizeof(*g_nav.masks));
+    g_nav.clusters = calloc(count, sizeof(*g_nav.clusters));
+    g_nav.borders = calloc(count * 2, sizeof(*g_nav.borders));
+    g_nav.cluster_dirty = malloc(count);
+    g_nav.border_dirty = malloc(count * 2);
+    if (!g_nav.open || !g_nav.masks || !g_nav.clusters || !g_nav.borders || !g_nav.cluster_dirty || !g_nav.border_dirty) {
+        LOGC(LOGCAT_WORLD, LOG_LVL_ERROR, "nav: out of memory for %d x %d subtiles", g_nav.w, g_nav.h);
+        nav_graph_free();
+        return;
+    }
+    for (int y = 0; y < g_nav.h; ++y) {
+        for (int x = 0; x < g_nav.w; ++x) {
+            g_nav.open[(size_t)y * (size_t)g_nav.w + (size_t)x] = world_is_walkable_subtile(x, y) ? 1 : 0;
+        }
+    }
+    for (int ty = 0; ty < tiles_h; ++ty) {
+        for (int tx = 0; tx < tiles_w; ++tx) g_nav.masks[(size_t)ty * (size_t)tiles_w + (size_t)tx] = world_subtile_mask_at(tx, ty);
+    }
+    memset(g_nav.cluster_dirty, 1, count);
+    nav_patch();
+    g_nav.map_gen = world_map_generation();
+    g_nav.revision = world_collision_revision();
+    g_nav.built = true;
+    LOGC(LOGCAT_WORLD, LOG_LVL_INFO, "nav: %d x %d clusters, %zu entrances",
+         g_nav.cw, g_nav.ch, g_nav.nodes.size - g_nav.free_nodes.size);
+}
+
+// Re-reads one tile and marks the clusters it overlaps when its collision
+// mask differs from the last sync.
+static bool nav_refresh_tile(int tx, int ty)
+{
+    const uint16_t mask = world_subtile_mask_at(tx, ty);
+    uint16_t* seen = &g_nav.masks[(size_t)ty * (size_t)g_nav.tiles_w + (size_t)tx];
+    if (mask == *seen) return false;
+    *seen = mask;
+    const int per = g_nav.per_tile;
+    for (int y = ty * per; y < (ty + 1) * per; ++y) {
+        for (int x = tx * per; x < (tx + 1) * per; ++x) {
+            g_nav.open[(size_t)y * (size_t)g_nav.w + (size_t)x] = world_is_walkable_subtile(x, y) ? 1 : 0;
+        }
+    }
+    // A tile straddles at most four clusters when they don't divide evenly.
+    const int x1 = (tx + 1) * per - 1, y1 = (ty + 1) * per - 1;
+    g_nav.cluster_dirty[nav_cluster_of(tx * per, ty * per)] = 1;
+    g_nav.cluster_dirty[nav_cluster_of(x1, ty * per)] = 1;
+    g_nav.cluster_dirty[nav_cluster_of(tx * per, y1)] = 1;
+    g_nav.cluster_dirty[nav_cluster_of(x1, y1)] = 1;
+    return true;
+}
+
+// Rebuilds for a new map; otherwise re-reads the tiles the collision change
+// log lists since the last sync (every tile if it no longer reaches back)
+// and patches just their clusters.
+static void nav_sync(void)
+{
+    int tiles_w = 0, tiles_h = 0;
+    if (!world_size_tiles(&tiles_w, &tiles_h)) {
+        if (g_nav.built) nav_graph_free();
+        return;
+    }
+    if (!g_nav.built || world_map_generation() != g_nav.map_gen || tiles_w != g_nav.tiles_w || tiles_h != g_nav.tiles_h) {
+        nav_rebuild(tiles_w, tiles_h);
+        return;
+    }
+    const uint32_t revision = world_collision_revision();
+    if (revision == g_nav.revision) return;
+
+    bool dirty = false;
+    const world_collision_change_t* changes = NULL;
+    size_t change_count = 0;
+    if (world_collision_changes_since(g_nav.revision, &changes, &change_count)) {
+        for (size_t i = 0; i < change_count; ++i) {
+            const int tx = changes[i].tx, ty = changes[i].ty;
+            if (tx < 0 || ty < 0 || tx >= tiles_w || ty >= tiles_h) continue;
+            dirty |= nav_refresh_tile(tx, ty);
+        }
+    } else {
+        for (int ty = 0; ty < tiles_h; ++ty) {
+            for (int tx = 0; tx < tiles_w; ++tx) dirty |= nav_refresh_tile(tx, ty);
+        }
+    }
+    g_nav.revision = revision;
+    if (dirty) nav_patch();
+}
+
+// Costs from (x, y) to each entrance of cluster c, in its node order.
+static void nav_entry_costs(int c, int x, int y, nav_costs_t* out)
+{
+    const nav_cluster_t* cl = &g_nav.clusters[c];
+    const nav_rect_t r = nav_cluster_rect(c);
+    nav_local_costs(&r, x, y);
+    DA_RESERVE(out, cl->nodes.size);
+    out->size = cl->nodes.size;
+    for (size_t i = 0; i < cl->nodes.size; ++i) {
+        const nav_node_t* n = &g_nav.nodes.data[cl->nodes.data[i]];
+        out->data[i] = g_local_g[(n->y - r.y0) * r.w + (n->x - r.x0)];
+    }
+}
+
+static void nav_abs_relax(int u, int v, int32_t cost, int gx, int gy, int goal)
+{
+    if (cost == NAV_COST_INF || g_abs_closed.data[v]) return;
+    const int32_t g = g_abs_g.data[u] + cost;
+    if (g >= g_abs_g.data[v]) return;
+    const int32_t h = v == goal ? 0 : nav_octile(gx - g_nav.nodes.data[v].x, gy - g_nav.nodes.data[v].y);
+    g_abs_g.data[v] = g;
+    g_abs_parent.data[v] = u;
+    nav_heap_push(&g_heap, (nav_open_t){ g + h, h, v });
+}
+
+// Plans between walkable subtiles, leaving the path after the start in
+// g_cells. Tries the start's own cluster first, then searches the entrance
+// graph with the start and goal linked in and refines hop by hop.
+static bool nav_plan(int sx, int sy, int gx, int gy)
+{
+    DA_CLEAR(&g_cells);
+    if (!nav_open_at(sx, sy) || !nav_open_at(gx, gy)) return false;
+    const int cs = nav_cluster_of(sx, sy), cg = nav_cluster_of(gx, gy);
+    if (cs == cg) {
+        const nav_rect_t r = nav_cluster_rect(cs);
+        if (nav_local_path(&r, sx, sy, gx, gy) >= 0) return true;
+    }
+
+    nav_entry_costs(cs, sx, sy, &g_start_cost);
+    nav_entry_costs(cg, gx, gy, &g_goal_cost);
+    const int n = (int)g_nav.nodes.size, start = n, goal = n + 1;
+    DA_RESERVE(&g_abs_g, (size_t)n + 2);
+    DA_RESERVE(&g_abs_parent, (size_t)n + 2);
+    DA_RESERVE(&g_abs_closed, (size_t)n + 2);
+    for (int i = 0; i < n + 2; ++i) {
+        g_abs_g.data[i] = NAV_COST_INF;
+        g_abs_parent.data[i] = -1;
+        g_abs_closed.data[i] = 0;
+    }
+    DA_CLEAR(&g_heap);
+    g_abs_g.data[start] = 0;
+    nav_heap_push(&g_heap, (nav_open_t){ nav_octile(gx - sx, gy - sy), nav_octile(gx - sx, gy - sy), start });
+    bool found = false;
+    while (g_heap.size) {
+        const int u = nav_heap_pop(&g_heap).id;
+        if (g_abs_closed.data[u]) continue;
+        g_abs_closed.data[u] = 1;
+        ++g_expanded;
+        if (u == goal) {
+            found = true;
+            break;
+        }
+        if (u == start) {
+            const nav_cluster_t* cl = &g_nav.clusters[cs];
+            for (size_t i = 0; i < cl->nodes.size; ++i) nav_abs_relax(u, cl->nodes.data[i], g_start_cost.data[i], gx, gy, goal);
+            continue;
+        }
+        const nav_node_t node = g_nav.nodes.data[u];
+        nav_abs_relax(u, node.twin, NAV_COST_STRAIGHT, gx, gy, goal);
+        const nav_cluster_t* cl = &g_nav.clusters[node.cluster];
+        const size_t k = cl->nodes.size;
+        size_t row = 0;
+        while (row < k && cl->nodes.data[row] != u) ++row;
+        for (size_t j = 0; j < k; ++j) nav_abs_relax(u, cl->nodes.data[j], cl->cost.data[row * k + j], gx, gy, goal);
+        if (node.cluster == cg) nav_abs_relax(u, goal, g_goal_cost.data[row], gx, gy, goal);
+    }
+    if (!found) return false;
+
+    DA_CLEAR(&g_chain);
+    for (int v = goal; v != start; v = g_abs_parent.data[v]) DA_APPEND(&g_chain, v);
+    int px = sx, py = sy, prev = start;
+    for (size_t i = g_chain.size; i-- > 0;) {
+        const int v = g_chain.data[i];
+        const int nx = v == goal ? gx : g_nav.nodes.data[v].x;
+        const int ny = v == goal ? gy : g_nav.nodes.data[v].y;
+        if (nx != px || ny != py) {
+            if (prev != start && v != goal && g_nav.nodes.data[prev].twin == v) {
+                DA_APPEND(&g_cells, ny * g_nav.w + nx);
+            } else {
+                const nav_rect_t r = nav_cluster_rect(v == goal ? cg : g_nav.nodes.data[v].cluster);
+                if (nav_local_path(&r, px, py, nx, ny) < 0) return false;
+            }
+        }
+        px = nx;
+        py = ny;
+        prev = v;
+    }
+    return true;
+}
+
+// Plans in pixels and writes the turning points of the route to `out`,
+// ending with the goal itself.
+static bool nav_solve(float sx, float sy, float gx, float gy, nav_points_t* out)
+{
+    DA_CLEAR(out);
+    if (!g_nav.built) return false;
+    const int cx = (int)floorf(sx / g_nav.sub_px), cy = (int)floorf(sy / g_nav.sub_px);
+    const int tx = (int)floorf(gx / g_nav.sub_px), ty = (int)floorf(gy / g_nav.sub_px);
+    if (!nav_plan(cx, cy, tx, ty)) return false;
+    int px = cx, py = cy;
+    for (size_t i = 0; i + 1 < g_cells.size; ++i) {
+        const int x = g_cells.data[i] % g_nav.w, y = g_cells.data[i] / g_nav.w;
+        const int nx = g_cells.data[i + 1] % g_nav.w, ny = g_cells.data[i + 1] / g_nav.w;
+        const bool turns = nav_sign(x - px) != nav_sign(nx - x) || nav_sign(y - py) != nav_sign(ny - y);
+        if (turns) DA_APPEND(out, ((gfx_vec2){ ((float)x + 0.5f) * g_nav.sub_px, ((float)y + 0.5f) * g_nav.sub_px }));
+        px = x;
+        py = y;
+    }
+    DA_APPEND(out, ((gfx_vec2){ gx, gy }));
+    return true;
+}
+
+static nav_slot_t* nav_slot_get(nav_path_id_t id)
+{
+    if (id.idx >= g_slots.size) return NULL;
+    nav_slot_t* s = &g_slots.data[id.idx];
+    return (s->gen == id.gen && s->status != NAV_PATH_INVALID) ? s : NULL;
+}
+
+nav_path_id_t nav_request_path(float sx, float sy, float gx, float gy)
+{
+    uint32_t idx;
+    if (g_free_slots.size) {
+        idx = (uint32_t)g_free_slots.data[--g_free_slots.size];
+    } else {
+        DA_APPEND(&g_slots, ((nav_slot_t){ .gen = 1 }));
+        idx = (uint32_t)g_slots.size - 1;
+    }
+    nav_slot_t* s = &g_slots.data[idx];
+    s->status = NAV_PATH_PENDING;
+    s->sx = sx;
+    s->sy = sy;
+    s->gx = gx;
+    s->gy = gy;
+    DA_CLEAR(&s->points);
+    const nav_path_id_t id = { idx, s->gen };
+    DA_APPEND(&g_queue, id);
+    return id;
+}
+
+nav_path_status_t nav_path_status(nav_path_id_t id)
+{
+    const nav_slot_t* s = nav_slot_get(id);
+    return s ? s->status : NAV_PATH_INVALID;
+}
+
+int nav_path_points(nav_path_id_t id, gfx_vec2* out, int max_out)
+{
+    const nav_slot_t* s = nav_slot_get(id);
+    if (!s || s->status != NAV_PATH_READY) return 0;
+    const int count = (int)s->points.size;
+    for (int i = 0; i < count && i < max_out; ++i) out[i] = s->points.data[i];
+    return count;
+}
+
+void nav_path_release(nav_path_id_t id)
+{
+    nav_slot_t* s = nav_slot_get(id);
+    if (!s) return;
+    s->status = NAV_PATH_INVALID;
+    if (++s->gen == 0) s->gen = 1;
+    DA_CLEAR(&s->points);
+    DA_APPEND(&g_free_slots, (int)id.idx);
+}
+
+int nav_find_path_px(float sx, float sy, float gx, float gy, gfx_vec2* out, int max_out)
+{
+    nav_sync();
+    if (!nav_solve(sx, sy, gx, gy, &g_points)) return -1;
+    const int count = (int)g_points.size;
+    for (int i = 0; i < count && i < max_out; ++i) out[i] = g_points.data[i];
+    return count;
+}
+
+void nav_tick(void)
+{
+    nav_sync();
+    // A started request always finishes; the budget only decides whether
+    // the next one starts this tick.
+    g_expanded = 0;
+    size_t head = 0;
+    while (head < g_queue.size && g_expanded < NAV_TICK_BUDGET) {
+        nav_slot_t* s = nav_slot_get(g_queue.data[head++]);
+        if (!s || s->status != NAV_PATH_PENDING) continue;
+        s->status = nav_solve(s->sx, s->sy, s->gx, s->gy, &s->points) ? NAV_PATH_READY : NAV_PATH_FAILED;
+    }
+    if (head == 0) return;
+    memmove(g_queue.data, g_queue.data + head, (g_queue.size - head) * sizeof(*g_queue.data));
+    g_queue.size -= head;
+}
+
+void nav_shutdown(void)
+{
+    nav_graph_free();
+    for (size_t i = 0; i < g_slots.size; ++i) DA_FREE(&g_slots.data[i].points);
+    DA_FREE(&g_slots);
+    DA_FREE(&g_free_slots);
+    DA_FREE(&g_queue);
+    DA_FREE(&g_heap);
+    DA_FREE(&g_abs_g);
+    DA_FREE(&g_abs_parent);
+    DA_FREE(&g_abs_closed);
+    DA_FREE(&g_start_cost);
+    DA_FREE(&g_goal_cost);
+    DA_FREE(&g_chain);
+    DA_FREE(&g_cells);
+    DA_FREE(&g_points);
+}
+
+SYSTEMS_ADAPT_VOID(sys_nav_tick_adapt, nav_tick)
@@ -0,0 +1,49 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include "engine/gfx/gfx_types.h"
+
+// Path planning over the world's subtile collision grid.
+//
+// The grid is cut into square clusters. Walkable runs along each shared
+// cluster border become entrance pairs, and the costs between the entrances
+// of one cluster are precomputed. A request searches that small graph first
+// and then refines each hop with a jump-point search kept inside one cluster,
+// so a long path only touches the clusters it crosses. The graph is built
+// when a map loads and patched cluster by cluster when tile edits change
+// collision.
+//
+// Moves are 8-way between walkable subtiles and diagonals never cut a solid
+// corner; paths are planned for a point-sized mover.
+
+typedef struct {
+    uint32_t idx;
+    uint32_t gen;
+} nav_path_id_t;   // {0, 0} = none
+
+typedef enum {
+    NAV_PATH_INVALID = 0,   // unknown or released id
+    NAV_PATH_PENDING,
+    NAV_PATH_READY,
+    NAV_PATH_FAILED         // start or goal not walkable, or no route
+} nav_path_status_t;
+
+// Queues a path from (sx, sy) to (gx, gy) in world pixels. Requests are served
+// first in, first out by nav_tick under a fixed search budget, so a result
+// may take a few ticks. Release every id once done with it.
+nav_path_id_t nav_request_path(float sx, float sy, float gx, float gy);
+nav_path_status_t nav_path_status(nav_path_id_t id);
+// Waypoints of a ready path in world pixels: the start is left out and the
+// last point is the requested goal. Each leg is a straight or diagonal run
+// through walkable subtiles. Returns the waypoint count (0 unless ready);
+// at most `max_out` are written.
+int nav_path_points(nav_path_id_t id, gfx_vec2* out, int max_out);
+void nav_path_release(nav_path_id_t id);
+
+// Plans right away, outside the queue and its budget. Same output as
+// nav_path_points; returns -1 when there is no path.
+int nav_find_path_px(float sx, float sy, float gx, float gy, gfx_vec2* out, int max_out);
+
+// Brings the graph up to date with the world, then serves queued requests.
+void nav_tick(void);
+void nav_shutdown(void);
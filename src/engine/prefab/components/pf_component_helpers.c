@@ -11,8 +11,8 @@
 ComponentMask pf_parse_mask(const char* s, bool* out_ok)
 {
     if (out_ok) *out_ok = false;
-    if (!s) return 0;
-    ComponentMask mask = 0;
+    if (!s) return CMP_NONE;
+    ComponentMask mask = CMP_NONE;
     const char* p = s;
     while (*p) {
         while (*p && isspace((unsigned char)*p)) p++;
@@ -20,16 +20,17 @@ ComponentMask pf_parse_mask(const char* s, bool* out_ok)
         while (*p && *p != '|' && *p != ',' && !isspace((unsigned char)*p)) p++;
         size_t len = (size_t)(p - start);
         if (len > 0) {
-            ComponentMask part = 0;
+            ComponentMask part = CMP_NONE;
             if (component_mask_from_strn(start, len, &part)) {
-                mask |= part;
+                mask = component_mask_or(mask, part);
                 if (out_ok) *out_ok = true;
             }
         }
         while (*p && (*p == '|' || *p == ',' || isspace((unsigned char)*p))) p++;
     }
-    if (!mask && s && isdigit((unsigned char)*s)) {
-        mask = (ComponentMask)strtoull(s, NULL, 0);
+    // Numeric masks predate named components and only address the first 64.
+    if (component_mask_empty(mask) && s && isdigit((unsigned char)*s)) {
+        mask.w[0] = (uint64_t)strtoull(s, NULL, 0);
         if (out_ok) *out_ok = true;
     }
     return mask;
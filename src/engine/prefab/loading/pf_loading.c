@@ -37,7 +37,7 @@ static void pf_loading_built_entity_free(pf_loading_built_entity_t* built)
         }
         free(built->component_data[i]);
     }
-    *built = (pf_loading_built_entity_t){ .present_mask = 0 };
+    *built = (pf_loading_built_entity_t){ .present_mask = CMP_NONE };
 }
 
 static void pf_loading_build_entity_components(pf_loading_built_entity_t* built, const prefab_t* prefab, const pf_override_ctx_t* ovr)
@@ -46,8 +46,8 @@ static void pf_loading_build_entity_components(pf_loading_built_entity_t* built,
 
     for (size_t i = 0; i < prefab->component_count; ++i) {
         const prefab_component_t* comp = &prefab->components[i];
-        built->present_mask |= (1ull << comp->id);
-        if (comp->override_after_spawn) built->override_mask |= (1ull << comp->id);
+        component_mask_set(&built->present_mask, comp->id);
+        if (comp->override_after_spawn) component_mask_set(&built->override_mask, comp->id);
 
         const pf_component_ops_t* ops = pf_register_get(comp->id);
         if (!ops) {
@@ -66,13 +66,13 @@ static void pf_loading_build_entity_components(pf_loading_built_entity_t* built,
                 free(data);
                 data = NULL;
             } else {
-                built->built_mask |= (1ull << comp->id);
+                component_mask_set(&built->built_mask, comp->id);
             }
             built->component_data[comp->id] = data;
         } else {
             bool ok = ops->build ? ops->build(comp, ovr, NULL) : true;
             if (ok) {
-                built->built_mask |= (1ull << comp->id);
+                component_mask_set(&built->built_mask, comp->id);
             }
         }
     }
@@ -91,7 +91,7 @@ static void ensure_component_slot(pf_loading_built_entity_t* built, ComponentEnu
         LOGC(LOGCAT_PREFAB, LOG_LVL_FATAL, "prefab: allocation failed for component %d", (int)id);
         abort();
     }
-    built->built_mask |= (1ull << id);
+    component_mask_set(&built->built_mask, id);
 }
 
 static void pf_loading_apply_overrides(pf_loading_built_entity_t* built, const pf_override_ctx_t* ovr)
@@ -102,8 +102,8 @@ static void pf_loading_apply_overrides(pf_loading_built_entity_t* built, const p
         const pf_component_ops_t* ops = pf_register_get((ComponentEnum)i);
         if (!ops || !ops->override) continue;
 
-        const bool has_component = (built->built_mask & (1ull << i)) != 0;
-        const bool override_flag = (built->override_mask & (1ull << i)) != 0;
+        const bool has_component = component_mask_has(built->built_mask, i);
+        const bool override_flag = component_mask_has(built->override_mask, i);
         const bool override_missing = (!has_component && ops->override_if_missing);
         if (!override_flag && !override_missing) continue;
 
@@ -117,7 +117,7 @@ static void pf_loading_add_to_ecs(ecs_entity_t e, const pf_loading_built_entity_
     if (!built) return;
 
     for (int i = 0; i < ENUM_COMPONENT_COUNT; ++i) {
-        if ((built->built_mask & (1ull << i)) == 0) continue;
+        if (!component_mask_has(built->built_mask, i)) continue;
         const pf_component_ops_t* ops = pf_register_get((ComponentEnum)i);
         if (!ops || !ops->apply) {
             LOGC(LOGCAT_PREFAB, LOG_LVL_FATAL, "prefab: missing apply for component %d", i);
@@ -126,7 +126,7 @@ static void pf_loading_add_to_ecs(ecs_entity_t e, const pf_loading_built_entity_
         ops->apply(e, built->component_data[i]);
     }
 
-    if ((built->present_mask & CMP_SPR) != 0 && (built->built_mask & CMP_SPR) == 0) {
+    if (component_mask_has(built->present_mask, ENUM_SPR) && !component_mask_has(built->built_mask, ENUM_SPR)) {
         LOGC(LOGCAT_PREFAB, LOG_LVL_WARN, "prefab spr missing path");
     }
 }
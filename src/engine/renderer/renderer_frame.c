@@ -101,8 +101,9 @@ void renderer_world_prepare(const render_view_t* view)
     }
     cache.painter_cap = painter_cap;
 
-    int max_items = ECS_MAX_ENTITIES + painter_cap;
-    if (max_items < ECS_MAX_ENTITIES) max_items = ECS_MAX_ENTITIES;
+    const int ent_cap = ecs_capacity();
+    int max_items = ent_cap + painter_cap;
+    if (max_items < ent_cap) max_items = ent_cap;
     renderer_painter_prepare(ctx, max_items);
 
     ctx->world_cache = cache;
@@ -114,7 +115,7 @@ void renderer_world_base(const render_view_t* view)
     if (!view || !ctx->frame_active) return;
 
     if (!ctx->painter_ready) {
-        renderer_painter_prepare(ctx, ECS_MAX_ENTITIES);
+        renderer_painter_prepare(ctx, ecs_capacity());
     }
 
     const render_world_cache_t* cache = &ctx->world_cache;
@@ -46,44 +46,13 @@ bool visible_tile_range(const world_map_t* map,
 }
 
 typedef struct {
-    const tiled_tileset_t* ts;
-    size_t ts_idx;
+    const tiled_gid_info_t* base; // the gid as placed
+    const tiled_gid_info_t* draw; // current animation frame, or base
     tex_handle_t tex_handle;
     const gfx_texture* tex_value;
     gfx_rect src;
-    int local_index;
-    int draw_index;
 } resolved_gid_t;
 
-static bool tileset_for_gid(const world_map_t* map, uint32_t gid, const tiled_tileset_t** out_ts, size_t* out_index)
-{
-    if (out_ts) *out_ts = NULL;
-    if (out_index) *out_index = 0;
-    if (!map || map->tileset_count == 0 || !out_ts || !out_index) return false;
-
-    // Binary search for the last tileset with first_gid <= gid.
-    size_t lo = 0;
-    size_t hi = map->tileset_count;
-    while (lo < hi) {
-        size_t mid = lo + (hi - lo) / 2;
-        uint32_t first_gid = (uint32_t)map->tilesets[mid].first_gid;
-        if (gid < first_gid) {
-            hi = mid;
-        } else {
-            lo = mid + 1;
-        }
-    }
-
-    if (lo == 0) return false;
-    size_t idx = lo - 1;
-    const tiled_tileset_t *ts = &map->tilesets[idx];
-    int local = (int)gid - ts->first_gid;
-    if (local < 0 || local >= ts->tilecount) return false;
-    *out_ts = ts;
-    *out_index = idx;
-    return true;
-}
-
 static int animated_tile_index(const tiled_tileset_t *ts, int base_index, double now_ms)
 {
     if (!ts || !ts->anims || base_index < 0 || base_index >= ts->tilecount) return base_index;
@@ -103,59 +72,52 @@ static int animated_tile_index(const tiled_tileset_t *ts, int base_index, double
     return base_index;
 }
 
+// `scratch` backs the entries on maps without a gid table; base and draw may
+// then share it.
 static bool resolve_gid_draw(const world_map_t* map,
                              const tiled_renderer_t* tr,
                              uint32_t raw_gid,
                              bool allow_animation,
                              double now_ms,
                              resolved_gid_t* out,
-                             bool* out_flip_h,
-                             bool* out_flip_v)
+                             tiled_gid_info_t* scratch)
 {
     if (!map || !tr || !out) return false;
     if (raw_gid == 0) return false;
 
-    bool flip_h = false, flip_v = false, flip_d = false;
-    uint32_t gid = tiled_gid_strip_flags(raw_gid, &flip_h, &flip_v, &flip_d);
-    if (gid == 0) return false;
-    (void)flip_d;
-
-    size_t ts_idx = 0;
-    const tiled_tileset_t* ts = NULL;
-    if (!tileset_for_gid(map, gid, &ts, &ts_idx)) return false;
-    if (ts_idx >= tr->texture_count) return false;
+    const tiled_gid_info_t* base = tiled_gid_lookup(map, raw_gid & TILED_GID_MASK, scratch);
+    if (!base) return false;
+    if ((size_t)base->tileset >= tr->texture_count) return false;
 
-    tex_handle_t handle = tr->tilesets[ts_idx];
+    tex_handle_t handle = tr->tilesets[base->tileset];
     const gfx_texture* tex = asset_lookup_texture(handle);
     if (!tex) return false;
 
-    int local = (int)gid - ts->first_gid;
-    if (local < 0 || local >= ts->tilecount) return false;
-
-    int draw_index = allow_animation ? animated_tile_index(ts, local, now_ms) : local;
-    int columns = ts->columns > 0 ? ts->columns : 1;
+    const tiled_gid_info_t* draw = base;
+    if (allow_animation && base->animated) {
+        const tiled_tileset_t* ts = &map->tilesets[base->tileset];
+        int frame = animated_tile_index(ts, base->local, now_ms);
+        if (frame != base->local) {
+            draw = tiled_gid_lookup(map, (uint32_t)(ts->first_gid + frame), scratch);
+            if (!draw) draw = base;
+        }
+    }
 
-    int sx = (draw_index % columns) * ts->tilewidth;
-    int sy = (draw_index / columns) * ts->tileheight;
-    gfx_rect src = { (float)sx, (float)sy, (float)ts->tilewidth, (float)ts->tileheight };
-    if (flip_h) {
+    gfx_rect src = { draw->src_x, draw->src_y, draw->src_w, draw->src_h };
+    if (raw_gid & TILED_FLIPPED_HORIZONTALLY_FLAG) {
         src.w = -src.w;
     }
-    if (flip_v) {
+    if (raw_gid & TILED_FLIPPED_VERTICALLY_FLAG) {
         src.h = -src.h;
     }
 
     *out = (resolved_gid_t){
-        .ts = ts,
-        .ts_idx = ts_idx,
+        .base = base,
+        .draw = draw,
         .tex_handle = handle,
         .tex_value = tex,
         .src = src,
-        .local_index = local,
-        .draw_index = draw_index,
     };
-    if (out_flip_h) *out_flip_h = flip_h;
-    if (out_flip_v) *out_flip_v = flip_v;
     return true;
 }
 
@@ -201,6 +163,7 @@ static void draw_tile_layer(const world_map_t* map,
     if (endY > layer->height) endY = layer->height;
     if (endX <= startX || endY <= startY) return;
 
+    tiled_gid_info_t scratch; // only used for maps without a gid table
     for (int y = startY; y < endY; ++y) {
         size_t row_start = (size_t)y * (size_t)layer->width;
         for (int x = startX; x < endX; ++x) {
@@ -208,17 +171,11 @@ static void draw_tile_layer(const world_map_t* map,
             uint32_t raw_gid = layer->gids[idx];
             resolved_gid_t r;
             bool allow_anim = !world_tile_anim_is_disabled(layer_idx, x, y);
-            if (!resolve_gid_draw(map, tr, raw_gid, allow_anim, now_ms, &r, NULL, NULL)) continue;
+            if (!resolve_gid_draw(map, tr, raw_gid, allow_anim, now_ms, &r, &scratch)) continue;
 
             gfx_rect dst = { (float)(x * tw), (float)(y * th), (float)tw, (float)th };
-
-            bool painter_tile = (r.ts->render_painters && r.draw_index >= 0 && r.draw_index < r.ts->tilecount)
-                ? r.ts->render_painters[r.draw_index]
-                : false;
-            float painter_off = (r.ts->painter_offset && r.draw_index >= 0 && r.draw_index < r.ts->tilecount)
-                ? (float)r.ts->painter_offset[r.draw_index]
-                : 0.0f;
-            float key = dst.y + painter_off;
+            bool painter_tile = r.draw->painter;
+            float key = dst.y + (float)r.draw->painter_offset;
             draw_or_enqueue_resolved(&r, dst, key, painter_tile, painter_ctx);
         }
     }
@@ -242,21 +199,17 @@ static size_t draw_object_layer_at_z(const world_map_t* map,
         if (obj->gid == 0) continue;
 
         resolved_gid_t r;
-        if (!resolve_gid_draw(map, tr, (uint32_t)obj->gid, false, now_ms, &r, NULL, NULL)) continue;
+        tiled_gid_info_t scratch;
+        if (!resolve_gid_draw(map, tr, (uint32_t)obj->gid, false, now_ms, &r, &scratch)) continue;
 
-        float dst_w = (obj->w > 0.0f) ? obj->w : (float)r.ts->tilewidth;
-        float dst_h = (obj->h > 0.0f) ? obj->h : (float)r.ts->tileheight;
+        float dst_w = (obj->w > 0.0f) ? obj->w : r.base->src_w;
+        float dst_h = (obj->h > 0.0f) ? obj->h : r.base->src_h;
         gfx_rect dst = { obj->x, obj->y - dst_h, dst_w, dst_h }; // Tiled object y is bottom
 
         if (!rects_intersect(dst, view->padded_view)) continue;
 
-        bool painter_tile = (r.ts->render_painters && r.local_index >= 0 && r.local_index < r.ts->tilecount)
-            ? r.ts->render_painters[r.local_index]
-            : false;
-        float painter_off = (r.ts->painter_offset && r.local_index >= 0 && r.local_index < r.ts->tilecount)
-            ? (float)r.ts->painter_offset[r.local_index]
-            : 0.0f;
-        float key = dst.y + painter_off;
+        bool painter_tile = r.base->painter;
+        float key = dst.y + (float)r.base->painter_offset;
         draw_or_enqueue_resolved(&r, dst, key, painter_tile, painter_ctx);
     }
     return i;
@@ -0,0 +1,333 @@
+//==== FROM spatial.c ====
+#include "engine/spatial/spatial.h"
+#include "engine/ecs/ecs_change.h"
+#include "engine/ecs/ecs_core.h"
+#include "engine/ecs/ecs_engine.h"
+#include "engine/ecs/ecs_query.h"
+#include "engine/utils/dynarray.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SPATIAL_CELL_PX 64.0f
+// Cell coordinates are clamped so far-off or non-finite positions still hash.
+#define SPATIAL_CELL_LIMIT (1 << 20)
+
+typedef struct {
+    int32_t cx, cy;
+    DA(int) ents;   // entity indices filed here, unordered
+} spatial_bucket_t;
+
+typedef struct {
+    int32_t cx, cy;
+    int bucket;     // index into g_buckets, -1 = empty slot
+} spatial_slot_t;
+
+typedef struct {
+    float d2;
+    int idx;
+} spatial_near_t;
+
+static DA(spatial_bucket_t) g_buckets;
+static DA(spatial_slot_t) g_slots;   // open-addressed cell -> bucket map, power-of-two size
+static DA(int) g_cell_of;            // bucket per entity index, -1 = not filed
+static DA(int) g_hits;
+static DA(spatial_near_t) g_near;
+
+static bool g_built;
+static ecs_version_t g_seen;
+static int32_t g_min_cx, g_min_cy, g_max_cx, g_max_cy;   // bounds of every bucket made so far
+
+static int32_t spatial_cell_coord(float v)
+{
+    const float c = floorf(v * (1.0f / SPATIAL_CELL_PX));
+    if (!(c > (float)-SPATIAL_CELL_LIMIT)) return (c != c) ? 0 : -SPATIAL_CELL_LIMIT;
+    return (c < (float)SPATIAL_CELL_LIMIT) ? (int32_t)c : SPATIAL_CELL_LIMIT;
+}
+
+static uint32_t spatial_cell_hash(int32_t cx, int32_t cy)
+{
+    uint32_t h = (uint32_t)cx * 0x9E3779B1u ^ (uint32_t)cy * 0x85EBCA77u;
+    return h ^ (h >> 16);
+}
+
+static void spatial_slots_rehash(size_t cap)
+{
+    DA_RESERVE(&g_slots, cap);
+    g_slots.size = cap;
+    for (size_t s = 0; s < cap; ++s) g_slots.data[s].bucket = -1;
+    for (size_t b = 0; b < g_buckets.size; ++b) {
+        size_t s = spatial_cell_hash(g_buckets.data[b].cx, g_buckets.data[b].cy) & (cap - 1);
+        while (g_slots.data[s].bucket >= 0) s = (s + 1) & (cap - 1);
+        g_slots.data[s] = (spatial_slot_t){ g_buckets.data[b].cx, g_buckets.data[b].cy, (int)b };
+    }
+}
+
+static int spatial_bucket_find(int32_t cx, int32_t cy)
+{
+    if (g_slots.size == 0) return -1;
+    const size_t mask = g_slots.size - 1;
+    for (size_t s = spatial_cell_hash(cx, cy) & mask; g_slots.data[s].bucket >= 0; s = (s + 1) & mask) {
+        if (g_slots.data[s].cx == cx && g_slots.data[s].cy == cy) return g_slots.data[s].bucket;
+    }
+    return -1;
+}
+
+static int spatial_bucket_get(int32_t cx, int32_t cy)
+{
+    int b = spatial_bucket_find(cx, cy);
+    if (b >= 0) return b;
+
+    if ((g_buckets.size + 1) * 2 > g_slots.size) {
+        spatial_slots_rehash(g_slots.size ? g_slots.size * 2 : 64);
+    }
+    b = (int)g_buckets.size;
+    DA_APPEND(&g_buckets, ((spatial_bucket_t){ .cx = cx, .cy = cy }));
+    const size_t mask = g_slots.size - 1;
+    size_t s = spatial_cell_hash(cx, cy) & mask;
+    while (g_slots.data[s].bucket >= 0) s = (s + 1) & mask;
+    g_slots.data[s] = (spatial_slot_t){ cx, cy, b };
+
+    if (b == 0) {
+        g_min_cx = g_max_cx = cx;
+        g_min_cy = g_max_cy = cy;
+    } else {
+        if (cx < g_min_cx) g_min_cx = cx;
+        if (cx > g_max_cx) g_max_cx = cx;
+        if (cy < g_min_cy) g_min_cy = cy;
+        if (cy > g_max_cy) g_max_cy = cy;
+    }
+    return b;
+}
+
+static void spatial_unfile(int e)
+{
+    const int b = g_cell_of.data[e];
+    if (b < 0) return;
+    spatial_bucket_t* bucket = &g_buckets.data[b];
+    for (size_t k = 0; k < bucket->ents.size; ++k) {
+        if (bucket->ents.data[k] != e) continue;
+        bucket->ents.data[k] = bucket->ents.data[--bucket->ents.size];
+        break;
+    }
+    g_cell_of.data[e] = -1;
+}
+
+static void spatial_file(int e)
+{
+    const int b = spatial_bucket_get(spatial_cell_coord(cmp_pos[e].x), spatial_cell_coord(cmp_pos[e].y));
+    if (g_cell_of.data[e] == b) return;
+    spatial_unfile(e);
+    DA_APPEND(&g_buckets.data[b].ents, e);
+    g_cell_of.data[e] = b;
+}
+
+// Brings the grid up to date with the POS change log. Entities stamped in
+// the current version are revisited next time, since they may be written
+// again before the version advances.
+static void spatial_sync(void)
+{
+    const size_t cap = (size_t)ecs_capacity();
+    if (g_cell_of.size < cap) {
+        DA_RESERVE(&g_cell_of, cap);
+        for (size_t i = g_cell_of.size; i < cap; ++i) g_cell_of.data[i] = -1;
+        g_cell_of.size = cap;
+    }
+
+    const ecs_version_t now = ecs_change_version();
+    if (!g_built || !ecs_change_tracked(ENUM_POS) || now < g_seen) {
+        for (size_t b = 0; b < g_buckets.size; ++b) DA_CLEAR(&g_buckets.data[b].ents);
+        for (size_t i = 0; i < g_cell_of.size; ++i) g_cell_of.data[i] = -1;
+        ECS_QUERY_EACH(ecs_query_get(CMP_POS, CMP_NONE), e) {
+            spatial_file(e);
+        }
+        g_built = true;
+    } else {
+        ECS_CHANGED_EACH(ENUM_POS, g_seen, e) {
+            if (component_mask_any(ecs_mask[e], CMP_POS)) spatial_file(e);
+            else spatial_unfile(e);
+        }
+    }
+    g_seen = now - 1;
+}
+
+void spatial_reset(void)
+{
+    for (size_t b = 0; b < g_buckets.size; ++b) DA_FREE(&g_buckets.data[b].ents);
+    DA_FREE(&g_buckets);
+    DA_FREE(&g_slots);
+    DA_FREE(&g_cell_of);
+    g_built = false;
+    g_seen = 0;
+}
+
+static bool spatial_accept(int e, ComponentMask require)
+{
+    return ecs_alive_idx(e) && component_mask_all(ecs_mask[e], component_mask_or(require, CMP_POS));
+}
+
+static int spatial_index_cmp(const void* a, const void* b)
+{
+    const int x = *(const int*)a;
+    const int y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+static int spatial_near_cmp(const void* a, const void* b)
+{
+    const spatial_near_t* x = a;
+    const spatial_near_t* y = b;
+    if (x->d2 != y->d2) return (x->d2 > y->d2) - (x->d2 < y->d2);
+    return (x->idx > y->idx) - (x->idx < y->idx);
+}
+
+// Appends to g_hits every accepted entity filed in cells [x0, x1] x [y0, y1]
+// whose centre is inside the box and, when radius2 >= 0, within sqrt(radius2)
+// of (qx, qy). Walks every bucket instead when that touches fewer of them.
+static void spatial_gather(int32_t x0, int32_t y0, int32_t x1, int32_t y1,
+                           float min_x, float min_y, float max_x, float max_y,
+                           float qx, float qy, float radius2, ComponentMask require)
+{
+    if (x0 < g_min_cx) x0 = g_min_cx;
+    if (y0 < g_min_cy) y0 = g_min_cy;
+    if (x1 > g_max_cx) x1 = g_max_cx;
+    if (y1 > g_max_cy) y1 = g_max_cy;
+    if (g_buckets.size == 0 || x0 > x1 || y0 > y1) return;
+
+    const double cells = ((double)x1 - x0 + 1.0) * ((double)y1 - y0 + 1.0);
+    const bool walk_all = cells > (double)g_buckets.size;
+    const size_t count = walk_all ? g_buckets.size : (size_t)cells;
+    for (size_t k = 0; k < count; ++k) {
+        int b;
+        if (walk_all) {
+            b = (int)k;
+            const spatial_bucket_t* bucket = &g_buckets.data[b];
+            if (bucket->cx < x0 || bucket->cx > x1 || bucket->cy < y0 || bucket->cy > y1) continue;
+        } else {
+            const int32_t w = x1 - x0 + 1;
+            b = spatial_bucket_find(x0 + (int32_t)(k % (size_t)w), y0 + (int32_t)(k / (size_t)w));
+            if (b < 0) continue;
+        }
+        const spatial_bucket_t* bucket = &g_buckets.data[b];
+        for (size_t i = 0; i < bucket->ents.size; ++i) {
+            const int e = bucket->ents.data[i];
+            if (!spatial_accept(e, require)) continue;
+            const float px = cmp_pos[e].x;
+            const float py = cmp_pos[e].y;
+            if (px < min_x || px > max_x || py < min_y || py > max_y) continue;
+            if (radius2 >= 0.0f) {
+                const float dx = px - qx;
+                const float dy = py - qy;
+                if (dx * dx + dy * dy > radius2) continue;
+            }
+            DA_APPEND(&g_hits, e);
+        }
+    }
+}
+
+static int spatial_emit_hits(int* out, int max_out)
+{
+    if (g_hits.size > 1) qsort(g_hits.data, g_hits.size, sizeof(int), spatial_index_cmp);
+    const int n = (int)g_hits.size;
+    const int written = (max_out < n) ? max_out : n;
+    if (out && written > 0) memcpy(out, g_hits.data, sizeof(int) * (size_t)written);
+    return n;
+}
+
+int spatial_query_radius(float x, float y, float radius, ComponentMask require, int* out, int max_out)
+{
+    if (!(radius >= 0.0f)) return 0;
+    spatial_sync();
+    DA_CLEAR(&g_hits);
+    spatial_gather(spatial_cell_coord(x - radius), spatial_cell_coord(y - radius),
+                   spatial_cell_coord(x + radius), spatial_cell_coord(y + radius),
+                   x - radius, y - radius, x + radius, y + radius, x, y, radius * radius, require);
+    return spatial_emit_hits(out, max_out);
+}
+
+int spatial_query_box(float min_x, float min_y, float max_x, float max_y, ComponentMask require,
+                      int* out, int max_out)
+{
+    if (!(min_x <= max_x) || !(min_y <= max_y)) return 0;
+    spatial_sync();
+    DA_CLEAR(&g_hits);
+    spatial_gather(spatial_cell_coord(min_x), spatial_cell_coord(min_y),
+                   spatial_cell_coord(max_x), spatial_cell_coord(max_y),
+                   min_x, min_y, max_x, max_y, 0.0f, 0.0f, -1.0f, require);
+    return spatial_emit_hits(out, max_out);
+}
+
+static void spatial_near_add_bucket(int b, float x, float y, float max_d2, ComponentMask require)
+{
+    const spatial_bucket_t* bucket = &g_buckets.data[b];
+    for (size_t i = 0; i < bucket->ents.size; ++i) {
+        const int e = bucket->ents.data[i];
+        if (!spatial_accept(e, require)) continue;
+        const float dx = cmp_pos[e].x - x;
+        const float dy = cmp_pos[e].y - y;
+        const float d2 = dx * dx + dy * dy;
+        if (d2 > max_d2) continue;
+        DA_APPEND(&g_near, ((spatial_near_t){ d2, e }));
+    }
+}
+
+int spatial_query_knn(float x, float y, int k, float max_dist, ComponentMask require, int* out)
+{
+    if (k <= 0 || !out || !(max_dist >= 0.0f)) return 0;
+    spatial_sync();
+    DA_CLEAR(&g_near);
+    if (g_buckets.size == 0) return 0;
+
+    const float max_d2 = max_dist * max_dist;
+    const int32_t qx = spatial_cell_coord(x);
+    const int32_t qy = spatial_cell_coord(y);
+    int64_t last_ring = 0;
+    {
+        const int64_t dx0 = (int64_t)qx - g_min_cx, dx1 = (int64_t)g_max_cx - qx;
+        const int64_t dy0 = (int64_t)qy - g_min_cy, dy1 = (int64_t)g_max_cy - qy;
+        if (dx0 > last_ring) last_ring = dx0;
+        if (dx1 > last_ring) last_ring = dx1;
+        if (dy0 > last_ring) last_ring = dy0;
+        if (dy1 > last_ring) last_ring = dy1;
+    }
+
+    // Grow square rings of cells around the query cell. Everything outside
+    // ring r is at least r cells away, so once the k-th best is strictly
+    // closer than that nothing further out can displace or tie it. Sparse
+    // grids fall back to a walk over every bucket.
+    bool done = false;
+    double cells_seen = 0.0;
+    for (int64_t r = 0; r <= last_ring && !done; ++r) {
+        // Cells in ring r start (r - 1) cells out.
+        if (r > 0 && (float)(r - 1) * SPATIAL_CELL_PX > max_dist) break;
+        const float ring_d = (float)r * SPATIAL_CELL_PX;
+
+        const double ring_cells = (r == 0) ? 1.0 : 8.0 * (double)r;
+        cells_seen += ring_cells;
+        if (cells_seen > 2.0 * (double)g_buckets.size) {
+            DA_CLEAR(&g_near);
+            for (size_t b = 0; b < g_buckets.size; ++b) spatial_near_add_bucket((int)b, x, y, max_d2, require);
+            break;
+        }
+
+        for (int64_t cy = qy - r; cy <= qy + r; ++cy) {
+            const bool edge_row = (cy == qy - r || cy == qy + r);
+            for (int64_t cx = qx - r; cx <= qx + r; cx += edge_row ? 1 : 2 * (r > 0 ? r : 1)) {
+                const int b = spatial_bucket_find((int32_t)cx, (int32_t)cy);
+                if (b >= 0) spatial_near_add_bucket(b, x, y, max_d2, require);
+            }
+        }
+
+        if ((int)g_near.size >= k) {
+            qsort(g_near.data, g_near.size, sizeof(spatial_near_t), spatial_near_cmp);
+            if (g_near.data[k - 1].d2 < ring_d * ring_d) done = true;
+        }
+    }
+
+    if (g_near.size > 1) qsort(g_near.data, g_near.size, sizeof(spatial_near_t), spatial_near_cmp);
+    const int n = ((int)g_near.size < k) ? (int)g_near.size : k;
+    for (int i = 0; i < n; ++i) out[i] = g_near.data[i].idx;
+    return n;
+}
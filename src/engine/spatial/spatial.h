@@ -0,0 +1,31 @@
+#pragma once
+#include <stdbool.h>
+#include "engine/ecs/ecs.h"
+
+// Hashed grid over entity centres (cmp_pos) for neighbourhood lookups.
+//
+// The grid follows the CMP_POS change log: each query first refiles the
+// entities whose position was stamped since the previous query, so results
+// reflect every write made through ecs_mark_changed. Entries are validated
+// against the live ECS on the way out, so destroyed or reused slots never
+// leak into results.
+//
+// Every result has CMP_POS and all of `require`; results are entity indices.
+
+// Entities whose centre lies within `radius` of (x, y), ascending by index.
+// Returns how many matched; at most `max_out` are written to `out`.
+int spatial_query_radius(float x, float y, float radius, ComponentMask require, int* out, int max_out);
+
+// Entities whose centre lies in [min_x, max_x] x [min_y, max_y], ascending
+// by index. Returns how many matched; at most `max_out` are written.
+int spatial_query_box(float min_x, float min_y, float max_x, float max_y, ComponentMask require,
+                      int* out, int max_out);
+
+// Up to `k` entities nearest to (x, y) and no further than `max_dist`,
+// closest first; equal distances keep ascending index order, the same pick
+// a first-wins scan over a query would make. Returns how many were written.
+int spatial_query_knn(float x, float y, int k, float max_dist, ComponentMask require, int* out);
+
+// Drops every filing; the next query rebuilds from the live ECS. For callers
+// that rewrite entity state wholesale without change stamps.
+void spatial_reset(void);
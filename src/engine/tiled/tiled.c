@@ -42,6 +42,7 @@ bool tiled_load_map(const char *tmx_path, world_map_t *out_map) {
 
     xml_document_free(doc, true);
 
+    ok = ok && tiled_gid_table_build(out_map);
     if (!ok) {
         tiled_free_map(out_map);
         return false;
@@ -70,6 +71,7 @@ void tiled_free_map(world_map_t *map) {
     }
     free(map->tilesets);
     tiled_free_objects(map);
+    tiled_gid_table_free(map);
     *map = (world_map_t){ .width = 0 };
     tiled_reset_tile_anim_arena();
 }
@@ -7,6 +7,14 @@
 bool tiled_load_map(const char *tmx_path, world_map_t *out_map);
 void tiled_free_map(world_map_t *map);
 
+// Per-gid table (map->gid_info). tiled_load_map builds it and tiled_free_map
+// releases it; maps assembled by hand may build one themselves.
+bool tiled_gid_table_build(world_map_t *map);
+void tiled_gid_table_free(world_map_t *map);
+// Returns the entry for a stripped gid, or NULL if no tileset owns it. Maps
+// without a table decode into `scratch` instead.
+const tiled_gid_info_t* tiled_gid_lookup(const world_map_t *map, uint32_t gid, tiled_gid_info_t *scratch);
+
 typedef struct {
     size_t texture_count;
     tex_handle_t *tilesets; // matches map->tilesets ordering
@@ -0,0 +1,116 @@
+#include "engine/tiled/tiled.h"
+#include "engine/core/logger/logger.h"
+
+#include <stdlib.h>
+
+// Collider masks are 4x4, row-major (see parse_collider_mask).
+static uint16_t collider_flip_h(uint16_t mask)
+{
+    uint16_t out = 0;
+    for (int y = 0; y < 4; ++y) {
+        for (int x = 0; x < 4; ++x) {
+            if (mask & (uint16_t)(1u << (y * 4 + x))) out |= (uint16_t)(1u << (y * 4 + (3 - x)));
+        }
+    }
+    return out;
+}
+
+static uint16_t collider_flip_v(uint16_t mask)
+{
+    uint16_t out = 0;
+    for (int y = 0; y < 4; ++y) {
+        for (int x = 0; x < 4; ++x) {
+            if (mask & (uint16_t)(1u << (y * 4 + x))) out |= (uint16_t)(1u << ((3 - y) * 4 + x));
+        }
+    }
+    return out;
+}
+
+static void gid_info_fill(const world_map_t *map, int ts_idx, int local, tiled_gid_info_t *out)
+{
+    const tiled_tileset_t *ts = &map->tilesets[ts_idx];
+    const uint16_t mask = ts->colliders ? ts->colliders[local] : 0;
+    const int columns = ts->columns > 0 ? ts->columns : 1;
+
+    *out = (tiled_gid_info_t){
+        .tileset = ts_idx,
+        .local = local,
+        .dynamic = ts->no_merge_collider ? ts->no_merge_collider[local] : false,
+        .painter = ts->render_painters ? ts->render_painters[local] : false,
+        .animated = ts->anims && ts->anims[local].frame_count > 0 && ts->anims[local].total_duration_ms > 0,
+        .painter_offset = ts->painter_offset ? ts->painter_offset[local] : 0,
+        .src_x = (float)((local % columns) * ts->tilewidth),
+        .src_y = (float)((local / columns) * ts->tileheight),
+        .src_w = (float)ts->tilewidth,
+        .src_h = (float)ts->tileheight,
+    };
+    out->colliders[0] = mask;
+    out->colliders[TILED_GID_FLIP_H] = collider_flip_h(mask);
+    out->colliders[TILED_GID_FLIP_V] = collider_flip_v(mask);
+    out->colliders[TILED_GID_FLIP_H | TILED_GID_FLIP_V] = collider_flip_v(out->colliders[TILED_GID_FLIP_H]);
+}
+
+bool tiled_gid_table_build(world_map_t *map)
+{
+    if (!map) return false;
+    tiled_gid_table_free(map);
+
+    size_t count = 1;
+    for (size_t i = 0; i < map->tileset_count; ++i) {
+        const tiled_tileset_t *ts = &map->tilesets[i];
+        if (ts->first_gid <= 0 || ts->tilecount <= 0) continue;
+        const size_t end = (size_t)ts->first_gid + (size_t)ts->tilecount;
+        if (end > count) count = end;
+    }
+
+    tiled_gid_info_t *table = (tiled_gid_info_t *)malloc(count * sizeof(*table));
+    if (!table) {
+        LOGC(LOGCAT_TILE, LOG_LVL_ERROR, "tiled: out of memory for gid table (%zu gids)", count);
+        return false;
+    }
+    for (size_t g = 0; g < count; ++g) table[g] = (tiled_gid_info_t){ .tileset = -1 };
+
+    // Where ranges overlap the first tileset holding the gid wins, as in
+    // tiled_gid_lookup's search.
+    for (size_t i = 0; i < map->tileset_count; ++i) {
+        const tiled_tileset_t *ts = &map->tilesets[i];
+        if (ts->first_gid <= 0) continue;
+        for (int local = 0; local < ts->tilecount; ++local) {
+            tiled_gid_info_t *entry = &table[(size_t)ts->first_gid + (size_t)local];
+            if (entry->tileset < 0) gid_info_fill(map, (int)i, local, entry);
+        }
+    }
+
+    map->gid_info = table;
+    map->gid_info_count = count;
+    return true;
+}
+
+void tiled_gid_table_free(world_map_t *map)
+{
+    if (!map) return;
+    free(map->gid_info);
+    map->gid_info = NULL;
+    map->gid_info_count = 0;
+}
+
+const tiled_gid_info_t* tiled_gid_lookup(const world_map_t *map, uint32_t gid, tiled_gid_info_t *scratch)
+{
+    if (!map || gid == 0) return NULL;
+    if (map->gid_info) {
+        if (gid >= map->gid_info_count) return NULL;
+        const tiled_gid_info_t *info = &map->gid_info[gid];
+        return (info->tileset >= 0) ? info : NULL;
+    }
+
+    if (!scratch) return NULL;
+    for (size_t i = 0; i < map->tileset_count; ++i) {
+        const tiled_tileset_t *ts = &map->tilesets[i];
+        if (ts->first_gid <= 0) continue;
+        const int64_t local = (int64_t)gid - ts->first_gid;
+        if (local < 0 || local >= ts->tilecount) continue;
+        gid_info_fill(map, (int)i, (int)local, scratch);
+        return scratch;
+    }
+    return NULL;
+}
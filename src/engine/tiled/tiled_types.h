@@ -48,6 +48,29 @@ typedef struct {
     int  *painter_offset;
 } tiled_tileset_t;
 
+// Decoded view of one stripped GID, built once per map so tile draws and
+// collision decodes are a single indexed load. `colliders` holds the mask
+// for each flip combination, indexed by tiled_gid_flip_index().
+typedef struct {
+    int32_t  tileset;        // index into map->tilesets; -1 when no tileset owns the gid
+    int32_t  local;          // tile id within the tileset
+    uint16_t colliders[4];
+    bool     dynamic;        // no_merge_collider
+    bool     painter;        // render_painters
+    bool     animated;       // has an animation; draw through the current frame's entry
+    int32_t  painter_offset;
+    float    src_x, src_y, src_w, src_h; // unflipped rect in the tileset image
+} tiled_gid_info_t;
+
+#define TILED_GID_FLIP_H 1
+#define TILED_GID_FLIP_V 2
+
+static inline int tiled_gid_flip_index(uint32_t raw_gid)
+{
+    return ((raw_gid & TILED_FLIPPED_HORIZONTALLY_FLAG) ? TILED_GID_FLIP_H : 0) |
+           ((raw_gid & TILED_FLIPPED_VERTICALLY_FLAG) ? TILED_GID_FLIP_V : 0);
+}
+
 typedef struct {
     char *name;
     int width;
@@ -0,0 +1,31 @@
+#pragma once
+
+// Shared counters. atomics_fetch_add adds `v` and returns the previous value
+// with relaxed ordering (nothing else is synchronised). Declare counters as
+// atomics_int_t; plain assignment is fine while no other thread can touch them.
+#if defined(__GNUC__) || defined(__clang__)
+typedef int atomics_int_t;
+
+static inline int atomics_fetch_add(atomics_int_t* p, int v)
+{
+    return __atomic_fetch_add(p, v, __ATOMIC_RELAXED);
+}
+#elif defined(_MSC_VER)
+#include <intrin.h>
+typedef volatile long atomics_int_t;
+
+static inline int atomics_fetch_add(atomics_int_t* p, int v)
+{
+    return (int)_InterlockedExchangeAdd(p, (long)v);
+}
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_ATOMICS__)
+#include <stdatomic.h>
+typedef _Atomic int atomics_int_t;
+
+static inline int atomics_fetch_add(atomics_int_t* p, int v)
+{
+    return atomic_fetch_add_explicit(p, v, memory_order_relaxed);
+}
+#else
+#error "atomics.h: no atomic fetch-add for this compiler"
+#endif
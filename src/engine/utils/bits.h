@@ -0,0 +1,20 @@
+#pragma once
+
+#include <stdint.h>
+
+// Index of the lowest set bit; `bits` must be non-zero.
+static inline int bits_ctz64(uint64_t bits)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll((unsigned long long)bits);
+#else
+    // Isolate the lowest bit, then look it up through a de Bruijn sequence.
+    static const uint8_t k_index[64] = {
+         0,  1, 48,  2, 57, 49, 28,  3, 61, 58, 50, 42, 38, 29, 17,  4,
+        62, 55, 59, 36, 53, 51, 43, 22, 45, 39, 33, 30, 24, 18, 12,  5,
+        63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21, 44, 32, 23, 11,
+        46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19,  9, 13,  8,  7,  6,
+    };
+    return k_index[((bits & (0 - bits)) * 0x03F79D71B4CB0A89ull) >> 58];
+#endif
+}
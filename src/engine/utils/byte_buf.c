@@ -0,0 +1,92 @@
+#include "engine/utils/byte_buf.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+void byte_buf_clear(byte_buf_t *b)
+{
+    if (!b) return;
+    b->size = 0;
+}
+
+void byte_buf_free(byte_buf_t *b)
+{
+    if (!b) return;
+    free(b->data);
+    b->data = NULL;
+    b->size = 0;
+    b->capacity = 0;
+}
+
+bool byte_buf_reserve(byte_buf_t *b, size_t capacity)
+{
+    if (!b) return false;
+    if (b->capacity >= capacity) return true;
+    size_t cap = b->capacity ? b->capacity : 256;
+    while (cap < capacity) cap *= 2;
+    uint8_t *p = (uint8_t *)realloc(b->data, cap);
+    if (!p) return false;
+    b->data = p;
+    b->capacity = cap;
+    return true;
+}
+
+bool byte_buf_write(byte_buf_t *b, const void *src, size_t size)
+{
+    if (!b) return false;
+    if (size == 0) return true;
+    if (!byte_buf_reserve(b, b->size + size)) return false;
+    memcpy(b->data + b->size, src, size);
+    b->size += size;
+    return true;
+}
+
+bool byte_buf_write_u32(byte_buf_t *b, uint32_t v)
+{
+    return byte_buf_write(b, &v, sizeof(v));
+}
+
+size_t byte_buf_placeholder_u32(byte_buf_t *b)
+{
+    size_t at = b ? b->size : 0;
+    byte_buf_write_u32(b, 0u);
+    return at;
+}
+
+void byte_buf_patch_u32(byte_buf_t *b, size_t at, uint32_t v)
+{
+    if (!b || at + sizeof(v) > b->size) return;
+    memcpy(b->data + at, &v, sizeof(v));
+}
+
+byte_reader_t byte_reader_make(const void *data, size_t size)
+{
+    return (byte_reader_t){ .data = (const uint8_t *)data, .size = data ? size : 0, .pos = 0, .ok = data != NULL };
+}
+
+const void *byte_reader_view(byte_reader_t *r, size_t size)
+{
+    if (!r || !r->ok) return NULL;
+    if (size > r->size - r->pos) {
+        r->ok = false;
+        return NULL;
+    }
+    const void *p = r->data + r->pos;
+    r->pos += size;
+    return p;
+}
+
+bool byte_reader_read(byte_reader_t *r, void *dst, size_t size)
+{
+    const void *p = byte_reader_view(r, size);
+    if (!p) return false;
+    if (size > 0) memcpy(dst, p, size);
+    return true;
+}
+
+uint32_t byte_reader_u32(byte_reader_t *r)
+{
+    uint32_t v = 0;
+    byte_reader_read(r, &v, sizeof(v));
+    return v;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// Growable byte sink plus a bounds-checked cursor for reading it back.
+// Values are written in host byte order; blobs are not meant to cross
+// architectures.
+typedef struct {
+    uint8_t *data;
+    size_t   size;
+    size_t   capacity;
+} byte_buf_t;
+
+void   byte_buf_clear(byte_buf_t *b);
+void   byte_buf_free(byte_buf_t *b);
+bool   byte_buf_reserve(byte_buf_t *b, size_t capacity);
+bool   byte_buf_write(byte_buf_t *b, const void *src, size_t size);
+bool   byte_buf_write_u32(byte_buf_t *b, uint32_t v);
+// Reserves a u32 to be filled in by byte_buf_patch_u32 (e.g. a section size).
+size_t byte_buf_placeholder_u32(byte_buf_t *b);
+void   byte_buf_patch_u32(byte_buf_t *b, size_t at, uint32_t v);
+
+typedef struct {
+    const uint8_t *data;
+    size_t size;
+    size_t pos;
+    bool   ok;   // sticks at false after the first out-of-bounds read
+} byte_reader_t;
+
+byte_reader_t byte_reader_make(const void *data, size_t size);
+bool          byte_reader_read(byte_reader_t *r, void *dst, size_t size);
+uint32_t      byte_reader_u32(byte_reader_t *r);
+// Borrows `size` bytes in place; NULL when out of bounds.
+const void   *byte_reader_view(byte_reader_t *r, size_t size);
+static inline size_t byte_reader_remaining(const byte_reader_t *r) { return r->size - r->pos; }
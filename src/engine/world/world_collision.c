@@ -2,6 +2,8 @@
 #include "engine/world/world_map.h"
 #include "engine/world/world_query.h"
 #include "engine/core/logger/logger.h"
+#include "engine/utils/bits.h"
+#include "engine/utils/dynarray.h"
 
 #include <math.h>
 #include <stdlib.h>
@@ -11,9 +13,14 @@
 #define WORLD_SUBTILE_SIZE 8
 #define WORLD_SUBTILES_PER_TILE (WORLD_TILE_SIZE / WORLD_SUBTILE_SIZE)
 #define WORLD_SUBTILES_PER_TILE_TOTAL (WORLD_SUBTILES_PER_TILE * WORLD_SUBTILES_PER_TILE)
+#define WORLD_SWEEP_SKIN_PX (1.0f / 256.0f)
+#define WORLD_CLEARANCE_MAX 16
 #if (WORLD_TILE_SIZE % WORLD_SUBTILE_SIZE) != 0
 #error "WORLD_TILE_SIZE must be divisible by WORLD_SUBTILE_SIZE"
 #endif
+#if (64 % WORLD_SUBTILES_PER_TILE) != 0
+#error "A tile's subtile row must not straddle a 64-bit word"
+#endif
 
 typedef struct {
     int w, h;          // tiles
@@ -21,16 +28,46 @@ typedef struct {
     world_tile_t* tiles;
     uint16_t* subtile_masks;
     bool* dynamic_tiles; // per-tile flag (derived from tileset property)
+    // Same solidity as subtile_masks, one bit per subtile in map-wide rows of
+    // row_words 64-bit words, so span queries test a word at a time.
+    uint64_t* solid_rows;
+    int row_words;
+    // Chebyshev distance in subtiles from each subtile to the nearest solid
+    // or off-map one, capped at WORLD_CLEARANCE_MAX (0 = solid).
+    uint8_t* clearance;
 } world_collision_grid_t;
 
 static world_collision_grid_t g_collision = { .tile_size = WORLD_TILE_SIZE };
+static uint32_t g_collision_revision = 0;
+
+// Per-tile changes by revision, covering every revision after g_change_floor.
+// When full the older half is dropped and the floor moves up.
+#define WORLD_COLLISION_CHANGE_LOG 4096
+static DA(world_collision_change_t) g_changes;
+static uint32_t g_change_floor = 0;
+
+static void collision_change_log(int tx, int ty)
+{
+    if (g_changes.size >= WORLD_COLLISION_CHANGE_LOG) {
+        const size_t keep = g_changes.size / 2;
+        g_change_floor = g_changes.data[g_changes.size - keep - 1].revision;
+        memmove(g_changes.data, g_changes.data + g_changes.size - keep, keep * sizeof(*g_changes.data));
+        g_changes.size = keep;
+    }
+    DA_APPEND(&g_changes, ((world_collision_change_t){ g_collision_revision, tx, ty }));
+}
 
 static void collision_grid_reset(world_collision_grid_t* grid)
 {
     if (!grid) return;
+    g_collision_revision++;
+    DA_CLEAR(&g_changes);
+    g_change_floor = g_collision_revision;
     free(grid->tiles);
     free(grid->subtile_masks);
     free(grid->dynamic_tiles);
+    free(grid->solid_rows);
+    free(grid->clearance);
     *grid = (world_collision_grid_t){ .tile_size = WORLD_TILE_SIZE };
 }
 
@@ -42,50 +79,113 @@ static uint16_t subtile_full_mask(void)
     return (uint16_t)((1u << WORLD_SUBTILES_PER_TILE_TOTAL) - 1u);
 }
 
-static uint16_t flip_mask_h(uint16_t mask)
+static void solid_rows_write_tile(world_collision_grid_t* grid, int tx, int ty, uint16_t mask)
 {
-    uint16_t out = 0;
+    const int sx = tx * WORLD_SUBTILES_PER_TILE;
+    const uint64_t lane = (((uint64_t)1u << WORLD_SUBTILES_PER_TILE) - 1u) << (sx & 63);
     for (int y = 0; y < WORLD_SUBTILES_PER_TILE; ++y) {
-        for (int x = 0; x < WORLD_SUBTILES_PER_TILE; ++x) {
-            int src_bit = y * WORLD_SUBTILES_PER_TILE + x;
-            int dst_bit = y * WORLD_SUBTILES_PER_TILE + (WORLD_SUBTILES_PER_TILE - 1 - x);
-            if (mask & (uint16_t)(1u << src_bit)) {
-                out |= (uint16_t)(1u << dst_bit);
-            }
-        }
+        const size_t row = (size_t)ty * WORLD_SUBTILES_PER_TILE + (size_t)y;
+        uint64_t* word = &grid->solid_rows[row * (size_t)grid->row_words + (size_t)(sx >> 6)];
+        const uint64_t bits = (uint64_t)((mask >> (y * WORLD_SUBTILES_PER_TILE)) & ((1u << WORLD_SUBTILES_PER_TILE) - 1u));
+        *word = (*word & ~lane) | (bits << (sx & 63));
     }
-    return out;
 }
 
-static uint16_t flip_mask_v(uint16_t mask)
+static bool solid_at(int sx, int sy)
 {
-    uint16_t out = 0;
-    for (int y = 0; y < WORLD_SUBTILES_PER_TILE; ++y) {
-        for (int x = 0; x < WORLD_SUBTILES_PER_TILE; ++x) {
-            int src_bit = y * WORLD_SUBTILES_PER_TILE + x;
-            int dst_bit = (WORLD_SUBTILES_PER_TILE - 1 - y) * WORLD_SUBTILES_PER_TILE + x;
-            if (mask & (uint16_t)(1u << src_bit)) {
-                out |= (uint16_t)(1u << dst_bit);
-            }
+    const uint64_t word = g_collision.solid_rows[(size_t)sy * (size_t)g_collision.row_words + (size_t)(sx >> 6)];
+    return (word >> (sx & 63)) & 1u;
+}
+
+// First solid subtile in [sx, sx_last] of row sy, or -1. sy and sx must be on
+// the map and sx_last below its width.
+static int solid_row_next(int sy, int sx, int sx_last)
+{
+    const uint64_t* row = &g_collision.solid_rows[(size_t)sy * (size_t)g_collision.row_words];
+    while (sx <= sx_last) {
+        const uint64_t word = row[sx >> 6] >> (sx & 63);
+        if (word) {
+            const int hit = sx + bits_ctz64(word);
+            return (hit <= sx_last) ? hit : -1;
         }
+        sx = (sx | 63) + 1;
     }
-    return out;
+    return -1;
+}
+
+// Clearance rebuild scratch: a window of subtiles starting at (x0, y0).
+typedef struct {
+    uint8_t* d;
+    int x0, y0, w, h;
+    int map_w, map_h; // subtiles
+} clearance_window_t;
+
+static DA(uint8_t) g_clearance_work;
+
+// Off-map subtiles count as solid; on-map ones outside the window are at
+// least WORLD_CLEARANCE_MAX away from anything the window writes back.
+static int clearance_window_at(const clearance_window_t* win, int x, int y)
+{
+    if (x >= 0 && y >= 0 && x < win->w && y < win->h) return win->d[y * win->w + x];
+    const int sx = win->x0 + x;
+    const int sy = win->y0 + y;
+    if (sx < 0 || sy < 0 || sx >= win->map_w || sy >= win->map_h) return 0;
+    return WORLD_CLEARANCE_MAX;
 }
 
-static bool tileset_for_gid_runtime(const world_map_t* map, uint32_t gid, const tiled_tileset_t** out_ts, int* out_local)
+static void clearance_relax(clearance_window_t* win, int x, int y, int dir)
 {
-    if (out_ts) *out_ts = NULL;
-    if (out_local) *out_local = 0;
-    if (!map || !out_ts || !out_local) return false;
-    for (size_t i = 0; i < map->tileset_count; ++i) {
-        const tiled_tileset_t* ts = &map->tilesets[i];
-        int local = (int)gid - ts->first_gid;
-        if (local < 0 || local >= ts->tilecount) continue;
-        *out_ts = ts;
-        *out_local = local;
-        return true;
+    uint8_t* v = &win->d[y * win->w + x];
+    if (*v == 0) return;
+    int best = *v;
+    const int n[4] = {
+        clearance_window_at(win, x - dir, y),
+        clearance_window_at(win, x - dir, y - dir),
+        clearance_window_at(win, x, y - dir),
+        clearance_window_at(win, x + dir, y - dir),
+    };
+    for (int i = 0; i < 4; ++i) {
+        if (n[i] + 1 < best) best = n[i] + 1;
+    }
+    *v = (uint8_t)best;
+}
+
+// Recomputes the clearance of subtiles [sx0, sx1] x [sy0, sy1]. A capped
+// distance only depends on solids within WORLD_CLEARANCE_MAX, so the two
+// chamfer passes run over the rect grown by that much and only the inner
+// part is written back.
+static void clearance_update(world_collision_grid_t* grid, int sx0, int sy0, int sx1, int sy1)
+{
+    clearance_window_t win = {
+        .map_w = grid->w * WORLD_SUBTILES_PER_TILE,
+        .map_h = grid->h * WORLD_SUBTILES_PER_TILE,
+    };
+    win.x0 = (sx0 > WORLD_CLEARANCE_MAX) ? sx0 - WORLD_CLEARANCE_MAX : 0;
+    win.y0 = (sy0 > WORLD_CLEARANCE_MAX) ? sy0 - WORLD_CLEARANCE_MAX : 0;
+    const int x1 = (sx1 + WORLD_CLEARANCE_MAX < win.map_w) ? sx1 + WORLD_CLEARANCE_MAX : win.map_w - 1;
+    const int y1 = (sy1 + WORLD_CLEARANCE_MAX < win.map_h) ? sy1 + WORLD_CLEARANCE_MAX : win.map_h - 1;
+    win.w = x1 - win.x0 + 1;
+    win.h = y1 - win.y0 + 1;
+    if (win.w <= 0 || win.h <= 0) return;
+
+    DA_RESERVE(&g_clearance_work, (size_t)win.w * (size_t)win.h);
+    win.d = g_clearance_work.data;
+    for (int y = 0; y < win.h; ++y) {
+        for (int x = 0; x < win.w; ++x) {
+            win.d[y * win.w + x] = solid_at(win.x0 + x, win.y0 + y) ? 0 : WORLD_CLEARANCE_MAX;
+        }
+    }
+    for (int y = 0; y < win.h; ++y) {
+        for (int x = 0; x < win.w; ++x) clearance_relax(&win, x, y, 1);
+    }
+    for (int y = win.h - 1; y >= 0; --y) {
+        for (int x = win.w - 1; x >= 0; --x) clearance_relax(&win, x, y, -1);
+    }
+
+    for (int y = sy0; y <= sy1; ++y) {
+        memcpy(&grid->clearance[(size_t)y * (size_t)win.map_w + (size_t)sx0],
+               &win.d[(y - win.y0) * win.w + (sx0 - win.x0)], (size_t)(sx1 - sx0 + 1));
     }
-    return false;
 }
 
 bool world_collision_decode_raw_gid(const world_map_t* map, uint32_t raw_gid, uint16_t* out_mask, bool* out_dynamic)
@@ -94,26 +194,12 @@ bool world_collision_decode_raw_gid(const world_map_t* map, uint32_t raw_gid, ui
     if (out_dynamic) *out_dynamic = false;
     if (!map || raw_gid == 0) return false;
 
-    bool flip_h = false, flip_v = false, flip_d = false;
-    uint32_t gid = tiled_gid_strip_flags(raw_gid, &flip_h, &flip_v, &flip_d);
-    if (gid == 0) return false;
-    (void)flip_d;
-
-    int local = 0;
-    const tiled_tileset_t* ts = NULL;
-    if (!tileset_for_gid_runtime(map, gid, &ts, &local)) return false;
-
-    uint16_t mask = (ts->colliders && local >= 0 && local < ts->tilecount) ? ts->colliders[local] : 0;
-    if (flip_h) mask = flip_mask_h(mask);
-    if (flip_v) mask = flip_mask_v(mask);
-
-    bool dynamic = false;
-    if (ts->no_merge_collider && local >= 0 && local < ts->tilecount) {
-        dynamic = ts->no_merge_collider[local];
-    }
+    tiled_gid_info_t scratch;
+    const tiled_gid_info_t* info = tiled_gid_lookup(map, raw_gid & TILED_GID_MASK, &scratch);
+    if (!info) return false;
 
-    if (out_mask) *out_mask = mask;
-    if (out_dynamic) *out_dynamic = dynamic;
+    if (out_mask) *out_mask = info->colliders[tiled_gid_flip_index(raw_gid)];
+    if (out_dynamic) *out_dynamic = info->dynamic;
     return true;
 }
 
@@ -155,7 +241,7 @@ static uint32_t collision_raw_gid_runtime(const world_map_t* map, int tx, int ty
     return 0;
 }
 
-static void collision_grid_write_cell(world_collision_grid_t* grid, const world_map_t* map, int tx, int ty, uint32_t raw_gid)
+static bool collision_grid_write_cell(world_collision_grid_t* grid, const world_map_t* map, int tx, int ty, uint32_t raw_gid)
 {
     uint16_t mask = 0;
     bool dyn = false;
@@ -164,9 +250,16 @@ static void collision_grid_write_cell(world_collision_grid_t* grid, const world_
     }
 
     const size_t idx = (size_t)ty * (size_t)map->width + (size_t)tx;
+    const bool changed = grid->subtile_masks[idx] != mask;
+    if (changed) {
+        g_collision_revision++;
+        collision_change_log(tx, ty);
+    }
     grid->subtile_masks[idx] = mask;
     grid->tiles[idx] = (mask == subtile_full_mask()) ? WORLD_TILE_SOLID : WORLD_TILE_WALKABLE;
     if (grid->dynamic_tiles) grid->dynamic_tiles[idx] = dyn;
+    if (grid->solid_rows) solid_rows_write_tile(grid, tx, ty, mask);
+    return changed;
 }
 
 bool world_collision_build_from_map(world_map_t* map, const char* collision_layer_name)
@@ -180,11 +273,17 @@ bool world_collision_build_from_map(world_map_t* map, const char* collision_laye
     world_tile_t* tiles = (world_tile_t*)malloc(count * sizeof(world_tile_t));
     uint16_t* masks = (uint16_t*)malloc(count * sizeof(uint16_t));
     bool* dynamic = (bool*)malloc(count * sizeof(bool));
-    if (!tiles || !masks || !dynamic) {
+    const int row_words = (map->width * WORLD_SUBTILES_PER_TILE + 63) / 64;
+    const size_t row_count = (size_t)map->height * WORLD_SUBTILES_PER_TILE;
+    uint64_t* solid_rows = (uint64_t*)calloc(row_count * (size_t)row_words, sizeof(uint64_t));
+    uint8_t* clearance = (uint8_t*)malloc(count * WORLD_SUBTILES_PER_TILE_TOTAL);
+    if (!tiles || !masks || !dynamic || !solid_rows || !clearance) {
         LOGC(LOGCAT_WORLD, LOG_LVL_ERROR, "world: out of memory for collision (%d x %d)", map->width, map->height);
         free(tiles);
         free(masks);
         free(dynamic);
+        free(solid_rows);
+        free(clearance);
         return false;
     }
     for (size_t i = 0; i < count; ++i) {
@@ -216,7 +315,16 @@ bool world_collision_build_from_map(world_map_t* map, const char* collision_laye
         .tiles = tiles,
         .subtile_masks = masks,
         .dynamic_tiles = dynamic,
+        .solid_rows = solid_rows,
+        .row_words = row_words,
+        .clearance = clearance,
     };
+    for (int y = 0; y < map->height; ++y) {
+        for (int x = 0; x < map->width; ++x) {
+            solid_rows_write_tile(&g_collision, x, y, masks[(size_t)y * (size_t)map->width + (size_t)x]);
+        }
+    }
+    clearance_update(&g_collision, 0, 0, map->width * WORLD_SUBTILES_PER_TILE - 1, map->height * WORLD_SUBTILES_PER_TILE - 1);
 
     return true;
 }
@@ -233,7 +341,41 @@ void world_collision_refresh_tile(const world_map_t* map, int tx, int ty)
     if (tx < 0 || ty < 0 || tx >= map->width || ty >= map->height) return;
 
     uint32_t raw_gid = collision_raw_gid_runtime(map, tx, ty);
-    collision_grid_write_cell(&g_collision, map, tx, ty, raw_gid);
+    if (!collision_grid_write_cell(&g_collision, map, tx, ty, raw_gid)) return;
+
+    // Only subtiles within WORLD_CLEARANCE_MAX of the tile can see a new distance.
+    const int subtiles_w = g_collision.w * WORLD_SUBTILES_PER_TILE;
+    const int subtiles_h = g_collision.h * WORLD_SUBTILES_PER_TILE;
+    int sx0 = tx * WORLD_SUBTILES_PER_TILE - WORLD_CLEARANCE_MAX;
+    int sy0 = ty * WORLD_SUBTILES_PER_TILE - WORLD_CLEARANCE_MAX;
+    int sx1 = (tx + 1) * WORLD_SUBTILES_PER_TILE - 1 + WORLD_CLEARANCE_MAX;
+    int sy1 = (ty + 1) * WORLD_SUBTILES_PER_TILE - 1 + WORLD_CLEARANCE_MAX;
+    if (sx0 < 0) sx0 = 0;
+    if (sy0 < 0) sy0 = 0;
+    if (sx1 >= subtiles_w) sx1 = subtiles_w - 1;
+    if (sy1 >= subtiles_h) sy1 = subtiles_h - 1;
+    clearance_update(&g_collision, sx0, sy0, sx1, sy1);
+}
+
+uint32_t world_collision_revision(void)
+{
+    return g_collision_revision;
+}
+
+bool world_collision_changes_since(uint32_t since, const world_collision_change_t** out, size_t* out_count)
+{
+    *out = NULL;
+    *out_count = 0;
+    if (since < g_change_floor || since > g_collision_revision) return false;
+    size_t lo = 0, hi = g_changes.size;
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (g_changes.data[mid].revision <= since) lo = mid + 1;
+        else hi = mid;
+    }
+    *out = g_changes.data + lo;
+    *out_count = g_changes.size - lo;
+    return true;
 }
 
 bool world_size_tiles(int* out_w, int* out_h)
@@ -283,22 +425,17 @@ bool world_tile_is_dynamic(int tx, int ty)
 
 bool world_is_walkable_subtile(int sx, int sy)
 {
-    if (sx < 0 || sy < 0) return false;
-    if (!g_collision.tiles || !g_collision.subtile_masks) return false;
-    const int subtiles_per_tile = WORLD_SUBTILES_PER_TILE;
-    if (subtiles_per_tile <= 0 || g_collision.w <= 0 || g_collision.h <= 0) return false;
-
-    int tile_x = sx / subtiles_per_tile;
-    int tile_y = sy / subtiles_per_tile;
-    if (tile_x < 0 || tile_y < 0 || tile_x >= g_collision.w || tile_y >= g_collision.h) return false;
-
-    int local_x = sx % subtiles_per_tile;
-    int local_y = sy % subtiles_per_tile;
-    int bit = local_y * subtiles_per_tile + local_x;
+    if (sx < 0 || sy < 0 || !g_collision.solid_rows) return false;
+    if (sx >= g_collision.w * WORLD_SUBTILES_PER_TILE || sy >= g_collision.h * WORLD_SUBTILES_PER_TILE) return false;
+    return !solid_at(sx, sy);
+}
 
-    size_t idx = (size_t)tile_y * (size_t)g_collision.w + (size_t)tile_x;
-    uint16_t mask = g_collision.subtile_masks ? g_collision.subtile_masks[idx] : 0;
-    return (mask & (uint16_t)(1u << bit)) == 0;
+int world_clearance_subtiles(int sx, int sy)
+{
+    if (sx < 0 || sy < 0 || !g_collision.clearance) return 0;
+    const int subtiles_w = g_collision.w * WORLD_SUBTILES_PER_TILE;
+    if (sx >= subtiles_w || sy >= g_collision.h * WORLD_SUBTILES_PER_TILE) return 0;
+    return g_collision.clearance[(size_t)sy * (size_t)subtiles_w + (size_t)sx];
 }
 
 bool world_is_walkable_px(float x, float y)
@@ -330,11 +467,19 @@ bool world_is_walkable_rect_px(float cx, float cy, float hx, float hy)
     int sx1 = (int)floorf(right / (float)ss);
     int sy0 = (int)floorf(bottom / (float)ss);
     int sy1 = (int)floorf(top / (float)ss);
+    if (sx0 > sx1 || sy0 > sy1) return true;
 
+    // The clear square around the middle subtile often covers the whole span.
+    const int mx = sx0 + (sx1 - sx0) / 2;
+    const int my = sy0 + (sy1 - sy0) / 2;
+    const int reach = (sx1 - mx > sy1 - my) ? sx1 - mx : sy1 - my;
+    if (world_clearance_subtiles(mx, my) > reach) return true;
+
+    // Anything off the map counts as blocked.
+    if (!g_collision.solid_rows || sx0 < 0 || sy0 < 0) return false;
+    if (sx1 >= g_collision.w * WORLD_SUBTILES_PER_TILE || sy1 >= g_collision.h * WORLD_SUBTILES_PER_TILE) return false;
     for (int sy = sy0; sy <= sy1; ++sy) {
-        for (int sx = sx0; sx <= sx1; ++sx) {
-            if (!world_is_walkable_subtile(sx, sy)) return false;
-        }
+        if (solid_row_next(sy, sx0, sx1) >= 0) return false;
     }
     return true;
 }
@@ -380,8 +525,7 @@ bool world_resolve_rect_axis_px(float* io_cx, float* io_cy, float hx, float hy,
         bool found_resolve = false;
         float best_resolve = 0.0f;
         for (int sy = min_sy; sy <= max_sy; ++sy) {
-            for (int sx = min_sx; sx <= max_sx; ++sx) {
-                if (world_is_walkable_subtile(sx, sy)) continue;
+            for (int sx = solid_row_next(sy, min_sx, max_sx); sx >= 0; sx = solid_row_next(sy, sx + 1, max_sx)) {
 
                 float tile_left = (float)sx * (float)subtile_px;
                 float tile_right = tile_left + (float)subtile_px;
@@ -426,22 +570,12 @@ bool world_resolve_rect_axis_px(float* io_cx, float* io_cy, float hx, float hy,
     return moved_any;
 }
 
-bool world_resolve_rect_mtv_px(float* io_cx, float* io_cy, float hx, float hy)
+// Callers have checked for a loaded grid and positive extents.
+static bool resolve_rect_mtv(float* io_cx, float* io_cy, float hx, float hy)
 {
-    if (!io_cx || !io_cy) return false;
-
-    int tiles_w = 0, tiles_h = 0;
-    if (!world_size_tiles(&tiles_w, &tiles_h)) return false;
-    int tile_px = world_tile_size();
-    int subtile_px = world_subtile_size();
-    if (tiles_w <= 0 || tiles_h <= 0 || tile_px <= 0 || subtile_px <= 0) return false;
-    int subtiles_per_tile = tile_px / subtile_px;
-    if (subtiles_per_tile <= 0) return false;
-    int subtiles_w = tiles_w * subtiles_per_tile;
-    int subtiles_h = tiles_h * subtiles_per_tile;
-    if (subtiles_w <= 0 || subtiles_h <= 0) return false;
-
-    if (hx <= 0.0f || hy <= 0.0f) return false;
+    const int subtile_px = WORLD_SUBTILE_SIZE;
+    const int subtiles_w = g_collision.w * WORLD_SUBTILES_PER_TILE;
+    const int subtiles_h = g_collision.h * WORLD_SUBTILES_PER_TILE;
 
     float cx = *io_cx;
     float cy = *io_cy;
@@ -468,8 +602,7 @@ bool world_resolve_rect_mtv_px(float* io_cx, float* io_cy, float hx, float hy)
         float best_resolve = 0.0f;
 
         for (int sy = min_sy; sy <= max_sy; ++sy) {
-            for (int sx = min_sx; sx <= max_sx; ++sx) {
-                if (world_is_walkable_subtile(sx, sy)) continue;
+            for (int sx = solid_row_next(sy, min_sx, max_sx); sx >= 0; sx = solid_row_next(sy, sx + 1, max_sx)) {
 
                 float tile_left = (float)sx * (float)subtile_px;
                 float tile_right = tile_left + (float)subtile_px;
@@ -510,6 +643,14 @@ bool world_resolve_rect_mtv_px(float* io_cx, float* io_cy, float hx, float hy)
     return moved_any;
 }
 
+bool world_resolve_rect_mtv_px(float* io_cx, float* io_cy, float hx, float hy)
+{
+    if (!io_cx || !io_cy) return false;
+    if (!g_collision.solid_rows || g_collision.w <= 0 || g_collision.h <= 0) return false;
+    if (hx <= 0.0f || hy <= 0.0f) return false;
+    return resolve_rect_mtv(io_cx, io_cy, hx, hy);
+}
+
 bool world_resolve_rect_slide_px(float* io_cx, float* io_cy, float hx, float hy)
 {
     bool moved_x = world_resolve_rect_axis_px(io_cx, io_cy, hx, hy, true);
@@ -517,10 +658,329 @@ bool world_resolve_rect_slide_px(float* io_cx, float* io_cy, float hx, float hy)
     return moved_x || moved_y;
 }
 
+// Interval of t in which [lo, hi] moving by d overlaps [box_lo, box_hi] on
+// one axis; false if a still span never does.
+static bool sweep_axis_interval(float lo, float hi, float d, float box_lo, float box_hi, float* out_enter, float* out_exit)
+{
+    if (d > 0.0f) {
+        *out_enter = (box_lo - hi) / d;
+        *out_exit = (box_hi - lo) / d;
+        return true;
+    }
+    if (d < 0.0f) {
+        *out_enter = (box_hi - lo) / d;
+        *out_exit = (box_lo - hi) / d;
+        return true;
+    }
+    if (hi <= box_lo || lo >= box_hi) return false;
+    *out_enter = -INFINITY;
+    *out_exit = INFINITY;
+    return true;
+}
+
+bool world_sweep_rect_px(float cx, float cy, float hx, float hy, float dx, float dy, float* out_t, gfx_vec2* out_normal)
+{
+    if (out_t) *out_t = 1.0f;
+    if (out_normal) *out_normal = (gfx_vec2){ 0.0f, 0.0f };
+    if (hx <= 0.0f || hy <= 0.0f || (dx == 0.0f && dy == 0.0f)) return false;
+    if (!g_collision.solid_rows || g_collision.w <= 0 || g_collision.h <= 0) return false;
+
+    const float ss = (float)WORLD_SUBTILE_SIZE;
+    const int subtiles_w = g_collision.w * WORLD_SUBTILES_PER_TILE;
+    const int subtiles_h = g_collision.h * WORLD_SUBTILES_PER_TILE;
+
+    // Walk lines of subtiles across the dominant axis in the order the rect
+    // reaches them; within a line only the rows the rect spans while
+    // crossing it (plus one either side, for flush contacts) are read. A line
+    // entered after the best hit so far can't hold an earlier one.
+    const bool major_x = fabsf(dx) >= fabsf(dy);
+    const float d_major = major_x ? dx : dy;
+    const float d_minor = major_x ? dy : dx;
+    const float lo_major = major_x ? cx - hx : cy - hy;
+    const float hi_major = major_x ? cx + hx : cy + hy;
+    const float lo_minor = major_x ? cy - hy : cx - hx;
+    const float hi_minor = major_x ? cy + hy : cx + hx;
+    const int n_major = major_x ? subtiles_w : subtiles_h;
+    const int n_minor = major_x ? subtiles_h : subtiles_w;
+
+    const int step = (d_major > 0.0f) ? 1 : -1;
+    int line = (int)floorf(((d_major > 0.0f) ? lo_major : hi_major) / ss);
+    // One line past the end so a rect stopping flush against it counts as a hit.
+    int last = (int)floorf(((d_major > 0.0f) ? hi_major + d_major : lo_major + d_major) / ss) + step;
+    if (step > 0) {
+        if (line < 0) line = 0;
+        if (last >= n_major) last = n_major - 1;
+    } else {
+        if (line >= n_major) line = n_major - 1;
+        if (last < 0) last = 0;
+    }
+
+    bool hit = false;
+    bool hit_major = false;
+    float best = 1.0f;
+    for (; (last - line) * step >= 0; line += step) {
+        const float line_lo = (float)line * ss;
+        float enter = 0.0f, exit = 0.0f;
+        sweep_axis_interval(lo_major, hi_major, d_major, line_lo, line_lo + ss, &enter, &exit);
+        if (enter > best) break;
+        const float t0 = fmaxf(enter, 0.0f);
+        const float t1 = fminf(exit, best);
+        if (t0 > t1) continue;
+
+        const float m0 = fminf(lo_minor + d_minor * t0, lo_minor + d_minor * t1);
+        const float m1 = fmaxf(hi_minor + d_minor * t0, hi_minor + d_minor * t1);
+        int row = (int)floorf(m0 / ss) - 1;
+        int row_last = (int)floorf(m1 / ss) + 1;
+        if (row < 0) row = 0;
+        if (row_last >= n_minor) row_last = n_minor - 1;
+
+        for (; row <= row_last; ++row) {
+            const int sx = major_x ? line : row;
+            const int sy = major_x ? row : line;
+            if (!solid_at(sx, sy)) continue;
+
+            const float row_lo = (float)row * ss;
+            float minor_enter = 0.0f, minor_exit = 0.0f;
+            if (!sweep_axis_interval(lo_minor, hi_minor, d_minor, row_lo, row_lo + ss, &minor_enter, &minor_exit)) continue;
+            const float t_enter = fmaxf(enter, minor_enter);
+            const float t_exit = fminf(exit, minor_exit);
+            // Subtiles the rect already overlaps don't stop it; the
+            // push-out resolvers deal with those.
+            if (t_enter < 0.0f || t_enter >= t_exit || t_enter > best) continue;
+            if (hit && t_enter == best) continue;
+            hit = true;
+            best = t_enter;
+            hit_major = enter >= minor_enter;
+        }
+    }
+    if (!hit) return false;
+
+    // Back off by a sliver so cx + dx * t can't round into the subtile.
+    const float len = hit_major ? fabsf(d_major) : fabsf(d_minor);
+    best = fmaxf(best - WORLD_SWEEP_SKIN_PX / len, 0.0f);
+
+    if (out_t) *out_t = best;
+    if (out_normal) {
+        const float sign = ((hit_major ? d_major : d_minor) > 0.0f) ? -1.0f : 1.0f;
+        *out_normal = (hit_major == major_x) ? (gfx_vec2){ sign, 0.0f } : (gfx_vec2){ 0.0f, sign };
+    }
+    return true;
+}
+
+// ---- Batched rect queries ------------------------------------------------------
+// A branch-free pass over each chunk of the SoA inputs finds the subtile span
+// every rect can touch; spans inside the clear square around their middle
+// subtile are done without reading the grid, and only the rest run the
+// single-rect code.
+enum { WORLD_BATCH_CHUNK = 256 };
+
+// Inclusive subtile span of [c - h, c + h] stretched by d (may be NULL).
+static void batch_spans(const float* c, const float* h, const float* d, int n, int* out_lo, int* out_hi)
+{
+    const float inv = 1.0f / (float)WORLD_SUBTILE_SIZE;
+    if (d) {
+        for (int k = 0; k < n; ++k) {
+            out_lo[k] = (int)floorf((c[k] - h[k] + fminf(d[k], 0.0f)) * inv);
+            out_hi[k] = (int)floorf((c[k] + h[k] + fmaxf(d[k], 0.0f)) * inv);
+        }
+    } else {
+        for (int k = 0; k < n; ++k) {
+            out_lo[k] = (int)floorf((c[k] - h[k]) * inv);
+            out_hi[k] = (int)floorf((c[k] + h[k]) * inv);
+        }
+    }
+}
+
+// True when no solid or off-map subtile lies within `pad` of the span.
+static bool batch_span_clear(int sx0, int sx1, int sy0, int sy1, int pad)
+{
+    const int mx = sx0 + (sx1 - sx0) / 2;
+    const int my = sy0 + (sy1 - sy0) / 2;
+    const int reach = ((sx1 - mx > sy1 - my) ? sx1 - mx : sy1 - my) + pad;
+    return world_clearance_subtiles(mx, my) > reach;
+}
+
+void world_sweep_rects_axis_px(const float* cx, const float* cy, const float* hx, const float* hy,
+                               const float* d, int count, bool axis_x, float* out_t)
+{
+    if (!cx || !cy || !hx || !hy || !d || !out_t || count <= 0) return;
+
+    int sx0[WORLD_BATCH_CHUNK], sx1[WORLD_BATCH_CHUNK];
+    int sy0[WORLD_BATCH_CHUNK], sy1[WORLD_BATCH_CHUNK];
+    for (int base = 0; base < count; base += WORLD_BATCH_CHUNK) {
+        const int n = (count - base < WORLD_BATCH_CHUNK) ? count - base : WORLD_BATCH_CHUNK;
+        batch_spans(cx + base, hx + base, axis_x ? d + base : NULL, n, sx0, sx1);
+        batch_spans(cy + base, hy + base, axis_x ? NULL : d + base, n, sy0, sy1);
+        for (int k = 0; k < n; ++k) {
+            const int i = base + k;
+            out_t[i] = 1.0f;
+            // The sweep also stops flush against a subtile, hence the pad.
+            if (d[i] == 0.0f || batch_span_clear(sx0[k], sx1[k], sy0[k], sy1[k], 1)) continue;
+            world_sweep_rect_px(cx[i], cy[i], hx[i], hy[i], axis_x ? d[i] : 0.0f, axis_x ? 0.0f : d[i], &out_t[i], NULL);
+        }
+    }
+}
+
+int world_resolve_rects_mtv_px(float* cx, float* cy, const float* hx, const float* hy, int count, bool* out_moved)
+{
+    if (!cx || !cy || !hx || !hy || !out_moved || count <= 0) return 0;
+    const bool have_grid = g_collision.solid_rows && g_collision.w > 0 && g_collision.h > 0;
+
+    int moved = 0;
+    int sx0[WORLD_BATCH_CHUNK], sx1[WORLD_BATCH_CHUNK];
+    int sy0[WORLD_BATCH_CHUNK], sy1[WORLD_BATCH_CHUNK];
+    for (int base = 0; base < count; base += WORLD_BATCH_CHUNK) {
+        const int n = (count - base < WORLD_BATCH_CHUNK) ? count - base : WORLD_BATCH_CHUNK;
+        batch_spans(cx + base, hx + base, NULL, n, sx0, sx1);
+        batch_spans(cy + base, hy + base, NULL, n, sy0, sy1);
+        for (int k = 0; k < n; ++k) {
+            const int i = base + k;
+            out_moved[i] = false;
+            if (!have_grid || hx[i] <= 0.0f || hy[i] <= 0.0f) continue;
+            if (batch_span_clear(sx0[k], sx1[k], sy0[k], sy1[k], 0)) continue;
+            out_moved[i] = resolve_rect_mtv(&cx[i], &cy[i], hx[i], hy[i]);
+            if (out_moved[i]) moved++;
+        }
+    }
+    return moved;
+}
+
+// ---- Raycasts ------------------------------------------------------------------
+// Point rays visit every subtile they cross (Amanatides-Woo). A ray through
+// the exact corner of four subtiles also touches the two side cells, so it
+// can't slip between diagonal solids. Box rays reuse the sweep. Off-map
+// subtiles count as solid for both, as they do for rect queries.
+static void ray_hit_set(world_ray_hit_t* hit, float x0, float y0, float dx, float dy, float t, float nx, float ny)
+{
+    hit->hit = true;
+    hit->t = t;
+    hit->point = (gfx_vec2){ x0 + dx * t, y0 + dy * t };
+    hit->normal = (gfx_vec2){ nx, ny };
+}
+
+static void raycast_point(float x0, float y0, float dx, float dy, world_ray_hit_t* hit)
+{
+    const float ss = (float)WORLD_SUBTILE_SIZE;
+    int sx = (int)floorf(x0 / ss);
+    int sy = (int)floorf(y0 / ss);
+    if (!world_is_walkable_subtile(sx, sy)) {
+        ray_hit_set(hit, x0, y0, dx, dy, 0.0f, 0.0f, 0.0f);
+        return;
+    }
+
+    // Crossing times come straight from the boundary coordinate rather than
+    // accumulating a per-cell delta, so a ray ending on a boundary lands on
+    // t == 1 exactly.
+    const int step_x = (dx > 0.0f) ? 1 : -1;
+    const int step_y = (dy > 0.0f) ? 1 : -1;
+    const int edge_x = (dx > 0.0f) ? 1 : 0;
+    const int edge_y = (dy > 0.0f) ? 1 : 0;
+    float next_x = (dx != 0.0f) ? ((float)(sx + edge_x) * ss - x0) / dx : INFINITY;
+    float next_y = (dy != 0.0f) ? ((float)(sy + edge_y) * ss - y0) / dy : INFINITY;
+
+    for (;;) {
+        const float t = fminf(next_x, next_y);
+        bool stepped_x;
+        if (t > 1.0f) return;
+        if (next_x == next_y) {
+            if (!world_is_walkable_subtile(sx + step_x, sy)) {
+                ray_hit_set(hit, x0, y0, dx, dy, t, (float)-step_x, 0.0f);
+                return;
+            }
+            if (!world_is_walkable_subtile(sx, sy + step_y)) {
+                ray_hit_set(hit, x0, y0, dx, dy, t, 0.0f, (float)-step_y);
+                return;
+            }
+            sx += step_x;
+            sy += step_y;
+            stepped_x = true; // diagonal entries take the x normal
+        } else if (next_x < next_y) {
+            sx += step_x;
+            stepped_x = true;
+        } else {
+            sy += step_y;
+            stepped_x = false;
+        }
+        if (!world_is_walkable_subtile(sx, sy)) {
+            if (stepped_x) ray_hit_set(hit, x0, y0, dx, dy, t, (float)-step_x, 0.0f);
+            else           ray_hit_set(hit, x0, y0, dx, dy, t, 0.0f, (float)-step_y);
+            return;
+        }
+        if (dx != 0.0f) next_x = ((float)(sx + edge_x) * ss - x0) / dx;
+        if (dy != 0.0f) next_y = ((float)(sy + edge_y) * ss - y0) / dy;
+    }
+}
+
+static void raycast_box(float x0, float y0, float dx, float dy, float hx, float hy, world_ray_hit_t* hit)
+{
+    if (!world_is_walkable_rect_px(x0, y0, hx, hy)) {
+        ray_hit_set(hit, x0, y0, dx, dy, 0.0f, 0.0f, 0.0f);
+        return;
+    }
+
+    float t = 1.0f;
+    gfx_vec2 n = { 0.0f, 0.0f };
+    bool blocked = world_sweep_rect_px(x0, y0, hx, hy, dx, dy, &t, &n);
+
+    // The sweep only walks on-map subtiles; the map edge stops the box too.
+    const float w_px = (float)(g_collision.w * g_collision.tile_size);
+    const float h_px = (float)(g_collision.h * g_collision.tile_size);
+    const float edge_t[4] = {
+        (dx > 0.0f) ? (w_px - (x0 + hx)) / dx : INFINITY,
+        (dx < 0.0f) ? (0.0f - (x0 - hx)) / dx : INFINITY,
+        (dy > 0.0f) ? (h_px - (y0 + hy)) / dy : INFINITY,
+        (dy < 0.0f) ? (0.0f - (y0 - hy)) / dy : INFINITY,
+    };
+    const gfx_vec2 edge_n[4] = { { -1.0f, 0.0f }, { 1.0f, 0.0f }, { 0.0f, -1.0f }, { 0.0f, 1.0f } };
+    for (int i = 0; i < 4; ++i) {
+        if (edge_t[i] < t) {
+            t = edge_t[i];
+            n = edge_n[i];
+            blocked = true;
+        }
+    }
+    if (blocked) ray_hit_set(hit, x0, y0, dx, dy, fmaxf(t, 0.0f), n.x, n.y);
+}
+
+static bool raycast_one(float x0, float y0, float x1, float y1, float hx, float hy, world_ray_hit_t* hit)
+{
+    const float dx = x1 - x0;
+    const float dy = y1 - y0;
+    *hit = (world_ray_hit_t){ .t = 1.0f, .point = { x1, y1 } };
+    if (hx > 0.0f || hy > 0.0f) raycast_box(x0, y0, dx, dy, hx, hy, hit);
+    else                        raycast_point(x0, y0, dx, dy, hit);
+    return hit->hit;
+}
+
+bool world_raycast_px(float x0, float y0, float x1, float y1, float hx, float hy, world_ray_hit_t* out_hit)
+{
+    world_ray_hit_t hit;
+    if (!g_collision.solid_rows) {
+        hit = (world_ray_hit_t){ .t = 1.0f, .point = { x1, y1 } };
+    } else {
+        raycast_one(x0, y0, x1, y1, hx, hy, &hit);
+    }
+    if (out_hit) *out_hit = hit;
+    return hit.hit;
+}
+
+int world_raycast_batch_px(const world_ray_t* rays, int count, float hx, float hy, world_ray_hit_t* out_hits)
+{
+    if (!rays || !out_hits || count <= 0) return 0;
+    int hits = 0;
+    for (int i = 0; i < count; ++i) {
+        if (!g_collision.solid_rows) {
+            out_hits[i] = (world_ray_hit_t){ .t = 1.0f, .point = { rays[i].x1, rays[i].y1 } };
+            continue;
+        }
+        if (raycast_one(rays[i].x0, rays[i].y0, rays[i].x1, rays[i].y1, hx, hy, &out_hits[i])) hits++;
+    }
+    return hits;
+}
+
 bool world_has_line_of_sight(float x0, float y0, float x1, float y1, float max_range, float hx, float hy)
 {
-    int ss = world_subtile_size();
-    if (ss <= 0 || g_collision.w <= 0 || g_collision.h <= 0) return false;
+    if (!g_collision.solid_rows || g_collision.w <= 0 || g_collision.h <= 0) return false;
 
     float dx = x1 - x0;
     float dy = y1 - y0;
@@ -528,18 +988,46 @@ bool world_has_line_of_sight(float x0, float y0, float x1, float y1, float max_r
     if (dist2 <= 0.0f) return true;
     if (max_range > 0.0f && dist2 > max_range * max_range) return false;
 
-    float dist = sqrtf(dist2);
-    float step = (float)ss * 0.5f;
-    if (step <= 0.0f) step = 4.0f;
-    int steps = (int)ceilf(dist / step);
-    if (steps < 1) steps = 1;
-    float inv_steps = 1.0f / (float)steps;
+    world_ray_hit_t hit;
+    return !raycast_one(x0, y0, x1, y1, hx, hy, &hit);
+}
 
-    for (int i = 0; i <= steps; ++i) {
-        float t = (float)i * inv_steps;
-        float px = x0 + dx * t;
-        float py = y0 + dy * t;
-        if (!world_is_walkable_rect_px(px, py, hx, hy)) return false;
+bool world_find_clear_spot_px(float* io_cx, float* io_cy, float hx, float hy, float max_dist_px)
+{
+    if (!io_cx || !io_cy || !g_collision.clearance) return false;
+    if (world_is_walkable_rect_px(*io_cx, *io_cy, hx, hy)) return true;
+
+    // Ring by ring of subtile centres around the start; the closest clear
+    // centre of the first ring that has one wins. Clearance rejects most
+    // candidates without a rect test.
+    const float ss = (float)WORLD_SUBTILE_SIZE;
+    const int sx = (int)floorf(*io_cx / ss);
+    const int sy = (int)floorf(*io_cy / ss);
+    const int rings = (int)ceilf(max_dist_px / ss);
+    const float max_d2 = max_dist_px * max_dist_px;
+    for (int r = 1; r <= rings; ++r) {
+        bool found = false;
+        float best_d2 = 0.0f, best_x = 0.0f, best_y = 0.0f;
+        for (int y = sy - r; y <= sy + r; ++y) {
+            const bool edge_row = (y == sy - r || y == sy + r);
+            for (int x = sx - r; x <= sx + r; x += edge_row ? 1 : 2 * r) {
+                if (world_clearance_subtiles(x, y) == 0) continue;
+                const float cx = ((float)x + 0.5f) * ss;
+                const float cy = ((float)y + 0.5f) * ss;
+                const float d2 = (cx - *io_cx) * (cx - *io_cx) + (cy - *io_cy) * (cy - *io_cy);
+                if (d2 > max_d2 || (found && d2 >= best_d2)) continue;
+                if (!world_is_walkable_rect_px(cx, cy, hx, hy)) continue;
+                found = true;
+                best_d2 = d2;
+                best_x = cx;
+                best_y = cy;
+            }
+        }
+        if (found) {
+            *io_cx = best_x;
+            *io_cy = best_y;
+            return true;
+        }
     }
-    return true;
+    return false;
 }
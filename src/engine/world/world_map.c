@@ -188,4 +188,103 @@ void world_apply_tile_edits(void)
     DA_CLEAR(&g_tile_edits);
 }
 
+bool world_snapshot_save(byte_buf_t* out)
+{
+    if (!out) return false;
+    byte_buf_write_u32(out, g_tiled_ready ? 1u : 0u);
+    if (!g_tiled_ready) return true;
+    byte_buf_write_u32(out, (uint32_t)g_world_map.width);
+    byte_buf_write_u32(out, (uint32_t)g_world_map.height);
+    byte_buf_write_u32(out, (uint32_t)g_world_map.layer_count);
+    for (size_t li = 0; li < g_world_map.layer_count; ++li) {
+        const tiled_layer_t* layer = &g_world_map.layers[li];
+        const size_t cells = layer->gids ? (size_t)layer->width * (size_t)layer->height : 0;
+        byte_buf_write_u32(out, (uint32_t)cells);
+        byte_buf_write(out, layer->gids, cells * sizeof(*layer->gids));
+    }
+    byte_buf_write_u32(out, (uint32_t)g_anim_disabled_count);
+    byte_buf_write(out, g_anim_disabled, g_anim_disabled_count * sizeof(*g_anim_disabled));
+    byte_buf_write_u32(out, (uint32_t)g_tile_edits.size);
+    byte_buf_write(out, g_tile_edits.data, g_tile_edits.size * sizeof(*g_tile_edits.data));
+    return true;
+}
+
+bool world_snapshot_check(byte_reader_t* in)
+{
+    if (!in) return false;
+    const bool had_map = byte_reader_u32(in) != 0;
+    if (!in->ok || had_map != g_tiled_ready) {
+        LOGC(LOGCAT_WORLD, LOG_LVL_ERROR, "world: snapshot map presence does not match");
+        return false;
+    }
+    if (!had_map) return true;
+
+    // The snapshot only carries runtime tile state; it must be taken on the
+    // same TMX that is loaded now.
+    const uint32_t w = byte_reader_u32(in);
+    const uint32_t h = byte_reader_u32(in);
+    const uint32_t layer_count = byte_reader_u32(in);
+    if (!in->ok || w != (uint32_t)g_world_map.width || h != (uint32_t)g_world_map.height
+        || layer_count != (uint32_t)g_world_map.layer_count) {
+        LOGC(LOGCAT_WORLD, LOG_LVL_ERROR, "world: snapshot was taken on a different map");
+        return false;
+    }
+    for (size_t li = 0; li < layer_count; ++li) {
+        const tiled_layer_t* layer = &g_world_map.layers[li];
+        const size_t cells = layer->gids ? (size_t)layer->width * (size_t)layer->height : 0;
+        if (byte_reader_u32(in) != (uint32_t)cells) {
+            LOGC(LOGCAT_WORLD, LOG_LVL_ERROR, "world: snapshot layer %zu size differs", li);
+            return false;
+        }
+        byte_reader_view(in, cells * sizeof(uint32_t));
+    }
+    const uint32_t anim_count = byte_reader_u32(in);
+    byte_reader_view(in, anim_count * sizeof(*g_anim_disabled));
+    const uint32_t edit_count = byte_reader_u32(in);
+    byte_reader_view(in, edit_count * sizeof(*g_tile_edits.data));
+    if (!in->ok || anim_count != (uint32_t)g_anim_disabled_count) {
+        LOGC(LOGCAT_WORLD, LOG_LVL_ERROR, "world: snapshot tile state truncated");
+        return false;
+    }
+    return true;
+}
+
+bool world_snapshot_load(byte_reader_t* in)
+{
+    if (!in) return false;
+    byte_reader_t check = *in;
+    if (!world_snapshot_check(&check)) return false;
+    if (byte_reader_u32(in) == 0) return true;
+    // Width, height and layer count were matched against the loaded map.
+    byte_reader_u32(in);
+    byte_reader_u32(in);
+    byte_reader_u32(in);
+
+    // Only tiles that actually differ touch the collision grid.
+    for (size_t li = 0; li < g_world_map.layer_count; ++li) {
+        tiled_layer_t* layer = &g_world_map.layers[li];
+        const size_t cells = byte_reader_u32(in);
+        const uint8_t* src = byte_reader_view(in, cells * sizeof(uint32_t));
+        for (size_t c = 0; c < cells; ++c) {
+            uint32_t gid;
+            memcpy(&gid, src + c * sizeof(gid), sizeof(gid));
+            if (layer->gids[c] == gid) continue;
+            layer->gids[c] = gid;
+            if (layer->collision) {
+                world_collision_refresh_tile(&g_world_map, (int)(c % (size_t)layer->width), (int)(c / (size_t)layer->width));
+            }
+        }
+    }
+    const uint32_t anim_count = byte_reader_u32(in);
+    const void* anim = byte_reader_view(in, anim_count * sizeof(*g_anim_disabled));
+    const uint32_t edit_count = byte_reader_u32(in);
+    const void* edits = byte_reader_view(in, edit_count * sizeof(*g_tile_edits.data));
+    if (anim_count > 0) memcpy(g_anim_disabled, anim, anim_count * sizeof(*g_anim_disabled));
+    DA_CLEAR(&g_tile_edits);
+    DA_RESERVE(&g_tile_edits, edit_count);
+    if (edit_count > 0) memcpy(g_tile_edits.data, edits, edit_count * sizeof(*g_tile_edits.data));
+    g_tile_edits.size = edit_count;
+    return in->ok;
+}
+
 SYSTEMS_ADAPT_VOID(sys_world_apply_edits_adapt, world_apply_tile_edits)
@@ -3,6 +3,7 @@
 #include <stdint.h>
 #include <stddef.h>
 #include "engine/tiled/tiled_types.h"
+#include "engine/utils/byte_buf.h"
 
 typedef struct {
     int width_tiles;
@@ -24,6 +25,8 @@ typedef struct {
     tiled_layer_t *layers;
     size_t object_count;
     tiled_object_t *objects;
+    size_t gid_info_count;
+    tiled_gid_info_t *gid_info; // indexed by stripped gid; see tiled_gid_lookup
 } world_map_t;
 
 // Lifecycle (owns TMX runtime map)
@@ -42,3 +45,12 @@ void world_apply_tile_edits(void);
 // Runtime tile animation override (per-layer, per-tile).
 bool world_tile_anim_disable(int layer_idx, int tx, int ty, bool disable);
 bool world_tile_anim_is_disabled(int layer_idx, int tx, int ty);
+
+// Runtime tile state (layer gids, disabled anims, queued edits) for engine
+// snapshots. Load expects the same TMX to be loaded and refreshes collision
+// only for tiles whose gid changed.
+bool world_snapshot_save(byte_buf_t* out);
+bool world_snapshot_load(byte_reader_t* in);
+// Validates the section against the loaded map and advances `in` past it,
+// leaving tile state alone.
+bool world_snapshot_check(byte_reader_t* in);
@@ -1,5 +1,6 @@
 #pragma once
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include "engine/gfx/gfx.h"
 
@@ -12,6 +13,20 @@ typedef enum {
 int  world_tile_size(void);
 int  world_subtile_size(void);
 
+// Bumped whenever any tile's collision changes (load, runtime edit, restore),
+// so callers can cache results derived from the grid.
+uint32_t world_collision_revision(void);
+
+typedef struct {
+    uint32_t revision; // the revision this change produced
+    int tx, ty;
+} world_collision_change_t;
+
+// Tiles whose collision changed after revision `since`, oldest first; a tile
+// may appear more than once. Returns false when the log doesn't reach back to
+// `since` (a map load, or too many changes), so the caller must rescan.
+bool world_collision_changes_since(uint32_t since, const world_collision_change_t** out, size_t* out_count);
+
 bool world_size_tiles(int* out_w, int* out_h);
 bool world_size_px(int* out_w, int* out_h);
 world_tile_t world_tile_at(int tx, int ty);
@@ -21,6 +36,13 @@ bool world_tile_is_dynamic(int tx, int ty);
 bool world_is_walkable_px(float x, float y);
 bool world_is_walkable_subtile(int sx, int sy);
 bool world_is_walkable_rect_px(float cx, float cy, float hx, float hy);
+// Chebyshev distance in subtiles from (sx, sy) to the nearest solid or
+// off-map subtile, capped at a small maximum. 0 for solid or off-map.
+int  world_clearance_subtiles(int sx, int sy);
+// Moves (io_cx, io_cy) to the nearest subtile centre, at most max_dist_px
+// away, where the rect is clear; leaves it alone if it already is. Returns
+// false (position untouched) when nothing in range is clear.
+bool world_find_clear_spot_px(float* io_cx, float* io_cy, float hx, float hy, float max_dist_px);
 // Push an AABB out of solid world geometry along a single axis (X if axis_x=true, otherwise Y).
 // Returns true if the rect was moved.
 bool world_resolve_rect_axis_px(float* io_cx, float* io_cy, float hx, float hy, bool axis_x);
@@ -30,4 +52,36 @@ bool world_resolve_rect_mtv_px(float* io_cx, float* io_cy, float hx, float hy);
 // Push an AABB out of solid world geometry using per-axis resolution (X then Y).
 // Returns true if the rect was moved.
 bool world_resolve_rect_slide_px(float* io_cx, float* io_cy, float hx, float hy);
+// Sweeps an AABB by (dx, dy) through solid subtiles in one pass. On a hit
+// returns true with `out_t` in [0, 1] (the fraction of the motion that stays
+// clear, backed off by a hair) and the axis-aligned surface normal. Subtiles
+// the rect overlaps at the start are ignored.
+bool world_sweep_rect_px(float cx, float cy, float hx, float hy, float dx, float dy, float* out_t, gfx_vec2* out_normal);
+// Batched forms over structure-of-arrays input: element i of each array is
+// one rect, and results match calling the single-rect query on each.
+// Sweeps rect i by d[i] along X (axis_x) or Y; out_t[i] as world_sweep_rect_px.
+void world_sweep_rects_axis_px(const float* cx, const float* cy, const float* hx, const float* hy,
+                               const float* d, int count, bool axis_x, float* out_t);
+// world_resolve_rect_mtv_px on every rect, updating cx/cy in place.
+// out_moved[i] says whether rect i moved; returns how many did.
+int  world_resolve_rects_mtv_px(float* cx, float* cy, const float* hx, const float* hy, int count, bool* out_moved);
 bool world_has_line_of_sight(float x0, float y0, float x1, float y1, float max_range, float hx, float hy);
+
+typedef struct {
+    bool hit;
+    float t;         // fraction of the ray that stays clear; 1 when nothing was hit
+    gfx_vec2 point;  // ray origin (or box centre) at t
+    gfx_vec2 normal; // axis-aligned surface normal; zero when the start is blocked
+} world_ray_hit_t;
+
+typedef struct {
+    float x0, y0, x1, y1;
+} world_ray_t;
+
+// Casts a ray from (x0, y0) to (x1, y1). hx = hy = 0 traces a point exactly
+// through the subtile grid; otherwise the hx/hy box is swept along it. Solid
+// and off-map subtiles block. Returns true on a hit; out_hit may be NULL.
+bool world_raycast_px(float x0, float y0, float x1, float y1, float hx, float hy, world_ray_hit_t* out_hit);
+// Casts every ray with the same half extents, filling out_hits[i] for
+// rays[i]. Returns how many were blocked.
+int  world_raycast_batch_px(const world_ray_t* rays, int count, float hx, float hy, world_ray_hit_t* out_hits);
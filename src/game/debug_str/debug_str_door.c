@@ -21,7 +21,8 @@ static bool debug_str_door(ecs_entity_t e, char* out, size_t cap)
 {
     int idx = ent_index_checked(e);
     if (idx < 0 || !out || cap == 0) return false;
-    const cmp_door_t* d = &cmp_door[idx];
+    const cmp_door_t* d = cmp_door_get(idx);
+    if (!d) return false;
     return snprintf(out, cap, "DOOR(state=%s, prox=%.1f, tiles=%d, intent=%d)",
                     door_state_short(d->state), d->prox_radius, d->tile_count,
                     d->intent_open ? 1 : 0) > 0;
@@ -10,7 +10,8 @@ static bool debug_str_gun_charger(ecs_entity_t e, char* out, size_t cap)
 {
     int idx = ent_index_checked(e);
     if (idx < 0 || !out || cap == 0) return false;
-    const cmp_gun_charger_t* c = &cmp_gun_charger[idx];
+    const cmp_gun_charger_t* c = cmp_gun_charger_get(idx);
+    if (!c) return false;
     return snprintf(out, cap, "GUN_CHARGER(stored=%u, flash=%.2f)",
                     c->stored_gun.idx, c->flash_timer) > 0;
 }
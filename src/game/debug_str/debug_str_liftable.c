@@ -21,7 +21,7 @@ static bool debug_str_liftable(ecs_entity_t e, char* out, size_t cap)
     if (idx < 0 || !out || cap == 0) return false;
     const cmp_liftable_t* l = &cmp_liftable[idx];
     return snprintf(out, cap, "LIFTABLE(state=%s, holder=%u, drop=%d)",
-                    grav_gun_state_short(l->state), l->holder.idx, l->just_dropped ? 1 : 0) > 0;
+                    grav_gun_state_short(l->state), l->holder.idx, ecs_liftable_dropped(idx) ? 1 : 0) > 0;
 }
 
 void debug_str_register_liftable(void)
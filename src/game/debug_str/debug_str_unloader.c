@@ -10,7 +10,8 @@ static bool debug_str_unloader(ecs_entity_t e, char* out, size_t cap)
 {
     int idx = ent_index_checked(e);
     if (idx < 0 || !out || cap == 0) return false;
-    const cmp_unloader_t* u = &cmp_unloader[idx];
+    const cmp_unloader_t* u = cmp_unloader_get(idx);
+    if (!u) return false;
     return snprintf(out, cap, "UNLOADER(unpacker=%u)", u->unpacker_handle.idx) > 0;
 }
 
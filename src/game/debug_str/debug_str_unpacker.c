@@ -10,7 +10,8 @@ static bool debug_str_unpacker(ecs_entity_t e, char* out, size_t cap)
 {
     int idx = ent_index_checked(e);
     if (idx < 0 || !out || cap == 0) return false;
-    const cmp_unpacker_t* u = &cmp_unpacker[idx];
+    const cmp_unpacker_t* u = cmp_unpacker_get(idx);
+    if (!u) return false;
     return snprintf(out, cap, "UNPACKER(ready=%d, spawned=%u)",
                     u->ready ? 1 : 0, u->spawned_entity.idx) > 0;
 }
@@ -9,5 +9,5 @@ void cmp_add_conveyor(ecs_entity_t e, facing_t direction, float speed, bool bloc
         .speed = speed,
         .block_player_input = block_player_input
     };
-    ecs_mask[i] |= CMP_CONVEYOR;
+    ecs_mask_add(i, CMP_CONVEYOR);
 }
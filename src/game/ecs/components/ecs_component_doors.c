@@ -2,6 +2,7 @@
 #include "engine/world/world_map.h"
 
 #include <stdlib.h>
+#include <string.h>
 
 /*
 Doors are more complex than other components because they track which tiles they control.
@@ -105,16 +106,73 @@ static void door_init_tiles(cmp_door_t* d, const door_tile_xy_t* tile_xy, int ti
 
 void ecs_door_on_destroy(int idx)
 {
-    if (idx < 0 || idx >= ECS_MAX_ENTITIES) return;
-    if (!(ecs_mask[idx] & CMP_DOOR)) return;
-    door_release_tiles(&cmp_door[idx]);
+    if (idx < 0 || idx >= ecs_capacity()) return;
+    if (!component_mask_any(ecs_mask[idx], CMP_DOOR)) return;
+    door_release_tiles(cmp_door_get(idx));
+}
+
+// Snapshot hooks: the tiles array is heap-owned per door, so it is written
+// inline and reallocated on load. World tile state (gids, disabled anims) is
+// restored by the world snapshot, not here.
+static void door_snapshot_release(void)
+{
+    for (int n = 0; n < cmp_door_set.count; ++n) {
+        cmp_door_t* d = (cmp_door_t*)cmp_door_set.data + n;
+        free(d->tiles);
+        d->tiles = NULL;
+        d->tile_count = 0;
+    }
+}
+
+static void door_snapshot_save(byte_buf_t* out)
+{
+    byte_buf_write_u32(out, (uint32_t)cmp_door_set.count);
+    for (int n = 0; n < cmp_door_set.count; ++n) {
+        const cmp_door_t* d = (const cmp_door_t*)cmp_door_set.data + n;
+        const int count = (d->tiles && d->tile_count > 0) ? d->tile_count : 0;
+        byte_buf_write_u32(out, (uint32_t)count);
+        byte_buf_write(out, d->tiles, sizeof(*d->tiles) * (size_t)count);
+    }
+}
+
+static bool door_snapshot_load(byte_reader_t* in)
+{
+    const uint32_t count = byte_reader_u32(in);
+    if (count != (uint32_t)cmp_door_set.count) return false;
+    for (int n = 0; n < cmp_door_set.count; ++n) {
+        cmp_door_t* d = (cmp_door_t*)cmp_door_set.data + n;
+        d->tiles = NULL;
+        d->tile_count = 0;
+    }
+    for (int n = 0; n < cmp_door_set.count && in->ok; ++n) {
+        cmp_door_t* d = (cmp_door_t*)cmp_door_set.data + n;
+        const uint32_t tile_count = byte_reader_u32(in);
+        const void* tiles = byte_reader_view(in, sizeof(*d->tiles) * (size_t)tile_count);
+        if (!tiles || tile_count == 0) continue;
+        d->tiles = (door_tile_info_t*)malloc(sizeof(*d->tiles) * (size_t)tile_count);
+        if (!d->tiles) return false;
+        memcpy(d->tiles, tiles, sizeof(*d->tiles) * (size_t)tile_count);
+        d->tile_count = (int)tile_count;
+    }
+    return in->ok;
+}
+
+void ecs_register_door_component_hooks(void)
+{
+    ecs_register_component_destroy_hook(ENUM_DOOR, ecs_door_on_destroy);
+    ecs_register_component_snapshot_hooks(ENUM_DOOR, (ecs_snapshot_hooks_t){
+        .release = door_snapshot_release,
+        .save = door_snapshot_save,
+        .load = door_snapshot_load,
+    });
 }
 
 void cmp_add_door(ecs_entity_t e, float prox_radius, int tile_count, const door_tile_xy_t* tile_xy)
 {
     int i = ent_index_checked(e);
     if (i < 0) return;
-    cmp_door_t* d = &cmp_door[i];
+    cmp_door_t* d = ecs_sparse_add(&cmp_door_set, i);
+    if (!d) return;
     // reset incase already has door
     door_release_tiles(d);
     *d = (cmp_door_t){ .prox_radius = prox_radius };
@@ -129,5 +187,5 @@ void cmp_add_door(ecs_entity_t e, float prox_radius, int tile_count, const door_
     d->state = DOOR_CLOSED;
     d->anim_time_ms = 0.0f;
     d->intent_open = false;
-    ecs_mask[i] |= CMP_DOOR;
+    ecs_mask_add(i, CMP_DOOR);
 }
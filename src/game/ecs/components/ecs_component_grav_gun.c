@@ -14,5 +14,5 @@ void cmp_add_grav_gun(ecs_entity_t e)
         .eject_timer = 0.0f,
         .toast_pending = false
     };
-    ecs_mask[i] |= CMP_GRAV_GUN;
+    ecs_mask_add(i, CMP_GRAV_GUN);
 }
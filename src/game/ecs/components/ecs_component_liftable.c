@@ -17,10 +17,7 @@ void cmp_add_liftable(ecs_entity_t e)
         .hold_vel_x         = 0.0f,
         .hold_vel_y         = 0.0f,
         .grab_offset_x      = 0.0f,
-        .grab_offset_y      = 0.0f,
-        .just_dropped       = false,
-        .recycle_active     = false,
-        .recycle_target_y   = 0.0f
+        .grab_offset_y      = 0.0f
     };
-    ecs_mask[i] |= CMP_LIFTABLE;
+    ecs_mask_add(i, CMP_LIFTABLE);
 }
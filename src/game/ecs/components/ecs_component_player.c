@@ -8,5 +8,5 @@ void cmp_add_player(ecs_entity_t e)
         .held_gun = ecs_null(),
         .held_liftable = ecs_null()
     };
-    ecs_mask[i] |= CMP_PLAYER;
+    ecs_mask_add(i, CMP_PLAYER);
 }
@@ -4,8 +4,10 @@ void cmp_add_unloader(ecs_entity_t e, ecs_entity_t unpacker_handle)
 {
     int i = ent_index_checked(e);
     if (i < 0) return;
-    cmp_unloader[i] = (cmp_unloader_t){
+    cmp_unloader_t* u = ecs_sparse_add(&cmp_unloader_set, i);
+    if (!u) return;
+    *u = (cmp_unloader_t){
         .unpacker_handle = unpacker_handle
     };
-    ecs_mask[i] |= CMP_UNLOADER;
+    ecs_mask_add(i, CMP_UNLOADER);
 }
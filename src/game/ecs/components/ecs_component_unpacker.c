@@ -4,9 +4,11 @@ void cmp_add_unpacker(ecs_entity_t e)
 {
     int i = ent_index_checked(e);
     if (i < 0) return;
-    cmp_unpacker[i] = (cmp_unpacker_t){
+    cmp_unpacker_t* u = ecs_sparse_add(&cmp_unpacker_set, i);
+    if (!u) return;
+    *u = (cmp_unpacker_t){
         .ready = true,
         .spawned_entity = ecs_null()
     };
-    ecs_mask[i] |= CMP_UNPACKER;
+    ecs_mask_add(i, CMP_UNPACKER);
 }
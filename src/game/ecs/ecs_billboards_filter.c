@@ -5,7 +5,7 @@
 static bool resource_held_for_storage(int idx)
 {
     // True only for liftable resources currently held by the grav gun (eligible for storage).
-    if ((ecs_mask[idx] & (CMP_RESOURCE | CMP_LIFTABLE)) != (CMP_RESOURCE | CMP_LIFTABLE)) return false;
+    if (!component_mask_all(ecs_mask[idx], CMP_SET(CMP_RESOURCE, CMP_LIFTABLE))) return false;
     return cmp_liftable[idx].state == GRAV_GUN_STATE_HELD;
 }
 
@@ -13,11 +13,11 @@ static bool player_has_grav_gun(ecs_entity_t player)
 {
     // Validate the player entity and its held gun pointer; clear stale state if invalid.
     int player_idx = ent_index_checked(player);
-    if (player_idx < 0 || (ecs_mask[player_idx] & CMP_PLAYER) == 0) return false;
+    if (player_idx < 0 || !component_mask_any(ecs_mask[player_idx], CMP_PLAYER)) return false;
 
     ecs_entity_t gun = cmp_player[player_idx].held_gun;
     int gun_idx = ent_index_checked(gun);
-    if (gun_idx < 0 || (ecs_mask[gun_idx] & CMP_GRAV_GUN) == 0) {
+    if (gun_idx < 0 || !component_mask_any(ecs_mask[gun_idx], CMP_GRAV_GUN)) {
         cmp_player[player_idx].held_gun = ecs_null();
         return false;
     }
@@ -36,7 +36,7 @@ static bool billboard_filter_requires_trigger(int trigger_idx, int matched_idx,
     (void)data;
     (void)matched_idx;
     if (trigger_idx < 0) return false;
-    if ((ecs_mask[trigger_idx] & CMP_TRIGGER) == 0) return false;
+    if (!component_mask_any(ecs_mask[trigger_idx], CMP_TRIGGER)) return false;
     return true;
 }
 
@@ -46,7 +46,7 @@ static bool billboard_filter_ignore_held_gun(int trigger_idx, int matched_idx, v
     (void)matched_idx;
     (void)data;
     if (trigger_idx < 0) return false;
-    if ((ecs_mask[trigger_idx] & CMP_GRAV_GUN) && cmp_grav_gun[trigger_idx].held) return false;
+    if (component_mask_any(ecs_mask[trigger_idx], CMP_GRAV_GUN) && cmp_grav_gun[trigger_idx].held) return false;
     return true;
 }
 
@@ -56,10 +56,10 @@ static bool billboard_filter_player_targeting(int trigger_idx, int matched_idx,
     // Special-case gun chargers: show only if the player holds a gun and the charger is empty.
     (void)data;
     if (trigger_idx < 0 || matched_idx < 0) return false;
-    if ((cmp_trigger[trigger_idx].target_mask & CMP_PLAYER) == 0) return true;
-    if ((ecs_mask[matched_idx] & CMP_PLAYER) == 0) return false;
-    if (ecs_mask[trigger_idx] & CMP_GUN_CHARGER) {
-        ecs_entity_t stored = cmp_gun_charger[trigger_idx].stored_gun;
+    if (!component_mask_any(cmp_trigger[trigger_idx].target_mask, CMP_PLAYER)) return true;
+    if (!component_mask_any(ecs_mask[matched_idx], CMP_PLAYER)) return false;
+    if (component_mask_any(ecs_mask[trigger_idx], CMP_GUN_CHARGER)) {
+        ecs_entity_t stored = cmp_gun_charger_get(trigger_idx)->stored_gun;
         const bool charger_empty = !ecs_alive_handle(stored);
         return player_has_grav_gun(handle_from_index(matched_idx)) && charger_empty;
     }
@@ -71,7 +71,7 @@ static bool billboard_filter_resource_targeting(int trigger_idx, int matched_idx
     // Filter: for non-player triggers, only allow held resources intended for storage.
     (void)data;
     if (trigger_idx < 0 || matched_idx < 0) return false;
-    if ((cmp_trigger[trigger_idx].target_mask & CMP_PLAYER) != 0) return true;
+    if (component_mask_any(cmp_trigger[trigger_idx].target_mask, CMP_PLAYER)) return true;
     return resource_held_for_storage(matched_idx);
 }
 
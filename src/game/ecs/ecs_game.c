@@ -9,17 +9,66 @@
 #include "engine/core/logger/logger.h"
 
 // =============== ECS Storage =============
-cmp_player_t    cmp_player[ECS_MAX_ENTITIES];
-cmp_conveyor_t  cmp_conveyor[ECS_MAX_ENTITIES];
-cmp_conveyor_rider_t cmp_conveyor_rider[ECS_MAX_ENTITIES];
-cmp_liftable_t  cmp_liftable[ECS_MAX_ENTITIES];
-cmp_grav_gun_t  cmp_grav_gun[ECS_MAX_ENTITIES];
-cmp_gun_charger_t cmp_gun_charger[ECS_MAX_ENTITIES];
-cmp_door_t      cmp_door[ECS_MAX_ENTITIES];
-cmp_unloader_t  cmp_unloader[ECS_MAX_ENTITIES];
-cmp_unpacker_t  cmp_unpacker[ECS_MAX_ENTITIES];
-resource_type_t cmp_resource_type[ECS_MAX_ENTITIES];
-cmp_storage_t   cmp_storage[ECS_MAX_ENTITIES];
+cmp_player_t*    cmp_player = NULL;
+cmp_conveyor_t*  cmp_conveyor = NULL;
+cmp_conveyor_rider_t* cmp_conveyor_rider = NULL;
+cmp_liftable_t*  cmp_liftable = NULL;
+cmp_grav_gun_t*  cmp_grav_gun = NULL;
+resource_type_t* cmp_resource_type = NULL;
+cmp_storage_t*   cmp_storage = NULL;
+
+ecs_sparse_t cmp_gun_charger_set;
+ecs_sparse_t cmp_door_set;
+ecs_sparse_t cmp_unloader_set;
+ecs_sparse_t cmp_unpacker_set;
+
+// =============== Events ==================
+ecs_event_queue_t game_ev_dropped = ECS_EVENT_QUEUE(game_ev_dropped_t, PHASE_PHYSICS);
+
+// Per-index flags for the visible drop window, plus the indices set in them
+// so the next marking pass clears only those.
+static DA(uint8_t) g_drop_marks;
+static DA(int) g_drop_marked;
+
+bool ecs_liftable_dropped(int idx)
+{
+    ECS_EVENT_EACH(game_ev_dropped, game_ev_dropped_t, ev) {
+        if (ent_index_checked(ev->item) == idx) return true;
+    }
+    return false;
+}
+
+void ecs_liftable_mark_drops(void)
+{
+    for (size_t k = 0; k < g_drop_marked.size; ++k) {
+        g_drop_marks.data[g_drop_marked.data[k]] = 0;
+    }
+    DA_CLEAR(&g_drop_marked);
+
+    const size_t cap = (size_t)ecs_capacity();
+    if (g_drop_marks.size < cap) {
+        DA_RESERVE(&g_drop_marks, cap);
+        memset(g_drop_marks.data + g_drop_marks.size, 0, cap - g_drop_marks.size);
+        g_drop_marks.size = cap;
+    }
+
+    ECS_EVENT_EACH(game_ev_dropped, game_ev_dropped_t, ev) {
+        int idx = ent_index_checked(ev->item);
+        if (idx < 0 || g_drop_marks.data[idx]) continue;
+        g_drop_marks.data[idx] = 1;
+        DA_APPEND(&g_drop_marked, idx);
+    }
+}
+
+bool ecs_liftable_drop_marked(int idx)
+{
+    return idx >= 0 && (size_t)idx < g_drop_marks.size && g_drop_marks.data[idx];
+}
+
+void ecs_liftable_unmark_drop(int idx)
+{
+    if (idx >= 0 && (size_t)idx < g_drop_marks.size) g_drop_marks.data[idx] = 0;
+}
 
 // Defered function ran after entities are created in engine so camera can lock to player
 static void game_post_entities(engine_phase_t phase, void* data)
@@ -47,13 +96,79 @@ static void game_post_entities(engine_phase_t phase, void* data)
     camera_set_config(&cfg);
 }
 
+static void ecs_game_register_storage(void)
+{
+    ECS_REGISTER_STORAGE(cmp_player);
+    ECS_REGISTER_STORAGE(cmp_conveyor);
+    ECS_REGISTER_STORAGE(cmp_conveyor_rider);
+    ECS_REGISTER_STORAGE(cmp_liftable);
+    ECS_REGISTER_STORAGE(cmp_grav_gun);
+    ECS_REGISTER_STORAGE(cmp_resource_type);
+    ECS_REGISTER_STORAGE(cmp_storage);
+    ecs_register_sparse(&cmp_gun_charger_set, ENUM_GUN_CHARGER, sizeof(cmp_gun_charger_t));
+    ecs_register_sparse(&cmp_door_set, ENUM_DOOR, sizeof(cmp_door_t));
+    ecs_register_sparse(&cmp_unloader_set, ENUM_UNLOADER, sizeof(cmp_unloader_t));
+    ecs_register_sparse(&cmp_unpacker_set, ENUM_UNPACKER, sizeof(cmp_unpacker_t));
+    ecs_recycler_register_storage();
+    ecs_event_register(&game_ev_dropped);
+}
+
+// Components that store entity handles rewrite them after ecs_compact so
+// handle equality checks (holder == player, ...) keep matching.
+static void player_remap_hook(int idx)
+{
+    cmp_player[idx].held_gun = ecs_remap_handle(cmp_player[idx].held_gun);
+    cmp_player[idx].held_liftable = ecs_remap_handle(cmp_player[idx].held_liftable);
+}
+
+static void liftable_remap_hook(int idx)
+{
+    cmp_liftable[idx].holder = ecs_remap_handle(cmp_liftable[idx].holder);
+}
+
+static void grav_gun_remap_hook(int idx)
+{
+    cmp_grav_gun[idx].holder = ecs_remap_handle(cmp_grav_gun[idx].holder);
+}
+
+static void gun_charger_remap_hook(int idx)
+{
+    cmp_gun_charger_t* c = cmp_gun_charger_get(idx);
+    if (c) c->stored_gun = ecs_remap_handle(c->stored_gun);
+}
+
+static void unloader_remap_hook(int idx)
+{
+    cmp_unloader_t* u = cmp_unloader_get(idx);
+    if (u) u->unpacker_handle = ecs_remap_handle(u->unpacker_handle);
+}
+
+static void unpacker_remap_hook(int idx)
+{
+    cmp_unpacker_t* u = cmp_unpacker_get(idx);
+    if (u) u->spawned_entity = ecs_remap_handle(u->spawned_entity);
+}
+
+static void ecs_game_register_remap_hooks(void)
+{
+    ecs_register_component_remap_hook(ENUM_PLAYER, player_remap_hook);
+    ecs_register_component_remap_hook(ENUM_LIFTABLE, liftable_remap_hook);
+    ecs_register_component_remap_hook(ENUM_GRAV_GUN, grav_gun_remap_hook);
+    ecs_register_component_remap_hook(ENUM_GUN_CHARGER, gun_charger_remap_hook);
+    ecs_register_component_remap_hook(ENUM_UNLOADER, unloader_remap_hook);
+    ecs_register_component_remap_hook(ENUM_UNPACKER, unpacker_remap_hook);
+    ecs_recycler_register_remap_hook();
+}
+
 // inits the ecs game related systems, components and hooks
 void ecs_game_init(void)
 {
+    ecs_game_register_storage();
     ecs_register_grav_gun_component_hooks();
     ecs_register_liftable_component_hooks();
     ecs_register_resource_component_hooks();
-    ecs_register_component_destroy_hook(ENUM_DOOR, ecs_door_on_destroy);
+    ecs_register_door_component_hooks();
+    ecs_game_register_remap_hooks();
     ecs_billboards_register_game_filter();
     engine_phase_register(ENGINE_PHASE_POST_ENTITIES, 0, game_post_entities, NULL, "game_post_entities");
 }
@@ -61,4 +176,6 @@ void ecs_game_init(void)
 //Might need this no idea yet
 void ecs_game_shutdown(void)
 {
+    DA_FREE(&g_drop_marks);
+    DA_FREE(&g_drop_marked);
 }
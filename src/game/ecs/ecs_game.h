@@ -50,9 +50,6 @@ typedef struct {
     float hold_vel_y;
     float grab_offset_x;
     float grab_offset_y;
-    bool just_dropped;
-    bool recycle_active;
-    float recycle_target_y;
 } cmp_liftable_t;
 
 typedef struct {
@@ -105,17 +102,44 @@ typedef struct {
 } cmp_storage_t;
 
 // ===== Game component storage =====
-extern cmp_player_t cmp_player[ECS_MAX_ENTITIES];
-extern cmp_conveyor_t cmp_conveyor[ECS_MAX_ENTITIES];
-extern cmp_conveyor_rider_t cmp_conveyor_rider[ECS_MAX_ENTITIES];
-extern cmp_liftable_t cmp_liftable[ECS_MAX_ENTITIES];
-extern cmp_grav_gun_t cmp_grav_gun[ECS_MAX_ENTITIES];
-extern cmp_gun_charger_t cmp_gun_charger[ECS_MAX_ENTITIES];
-extern cmp_door_t cmp_door[ECS_MAX_ENTITIES];
-extern cmp_unloader_t cmp_unloader[ECS_MAX_ENTITIES];
-extern cmp_unpacker_t cmp_unpacker[ECS_MAX_ENTITIES];
-extern resource_type_t cmp_resource_type[ECS_MAX_ENTITIES];
-extern cmp_storage_t cmp_storage[ECS_MAX_ENTITIES];
+extern cmp_player_t* cmp_player;
+extern cmp_conveyor_t* cmp_conveyor;
+extern cmp_conveyor_rider_t* cmp_conveyor_rider;
+extern cmp_liftable_t* cmp_liftable;
+extern cmp_grav_gun_t* cmp_grav_gun;
+extern resource_type_t* cmp_resource_type;
+extern cmp_storage_t* cmp_storage;
+
+// Sparse (declared SPARSE in components_game.def); NULL when absent.
+extern ecs_sparse_t cmp_gun_charger_set;
+extern ecs_sparse_t cmp_door_set;
+extern ecs_sparse_t cmp_unloader_set;
+extern ecs_sparse_t cmp_unpacker_set;
+
+static inline cmp_gun_charger_t* cmp_gun_charger_get(int idx) { return ecs_sparse_get(&cmp_gun_charger_set, idx); }
+static inline cmp_door_t*        cmp_door_get(int idx)        { return ecs_sparse_get(&cmp_door_set, idx); }
+static inline cmp_unloader_t*    cmp_unloader_get(int idx)    { return ecs_sparse_get(&cmp_unloader_set, idx); }
+static inline cmp_unpacker_t*    cmp_unpacker_get(int idx)    { return ecs_sparse_get(&cmp_unpacker_set, idx); }
+
+// ===== Game events =====
+// A liftable left the gravity gun. Swaps after PHASE_PHYSICS: drops from
+// input/physics reach the same tick's SIM_POST consumers, later drops the
+// next tick's.
+typedef struct {
+    ecs_entity_t item;
+} game_ev_dropped_t;
+
+extern ecs_event_queue_t game_ev_dropped;
+
+// True if `idx` has a visible drop event (consumers in PHASE_SIM_POST).
+// Scans the whole window; systems testing many entities mark once instead.
+bool ecs_liftable_dropped(int idx);
+// Flags every item in the visible drop window for O(1) ecs_liftable_drop_marked
+// lookups. Marks hold until the next call, so call it at the top of each pass.
+void ecs_liftable_mark_drops(void);
+bool ecs_liftable_drop_marked(int idx);
+// Drops `idx` from the current marks (e.g. once an item has been consumed).
+void ecs_liftable_unmark_drop(int idx);
 
 void ecs_game_init(void);
 void ecs_game_shutdown(void);
@@ -4,3 +4,6 @@ void ecs_register_grav_gun_component_hooks(void);
 void ecs_register_liftable_component_hooks(void);
 void ecs_register_resource_component_hooks(void);
 void ecs_door_on_destroy(int idx);
+void ecs_register_door_component_hooks(void);
+void ecs_recycler_register_storage(void);
+void ecs_recycler_register_remap_hook(void);
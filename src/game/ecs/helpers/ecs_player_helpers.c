@@ -6,10 +6,8 @@
 
 ecs_entity_t ecs_find_player(void)
 {
-    for (int i = 0; i < ECS_MAX_ENTITIES; ++i) {
-        if (ecs_alive_idx(i) && (ecs_mask[i] & CMP_PLAYER)) {
-            return (ecs_entity_t){ .idx = (uint32_t)i, .gen = ecs_gen[i] };
-        }
+    ECS_QUERY_EACH(ecs_query_get(CMP_PLAYER, CMP_NONE), i) {
+        return (ecs_entity_t){ .idx = (uint32_t)i, .gen = ecs_gen[i] };
     }
     return ecs_null();
 }
@@ -43,13 +43,13 @@ void cmp_add_resource(ecs_entity_t e, resource_type_t type)
     if (idx < 0) return;
     if (type < 0 || type >= RESOURCE_TYPE_COUNT) type = RESOURCE_TYPE_PLASTIC;
     cmp_resource_type[idx] = type;
-    ecs_mask[idx] |= CMP_RESOURCE;
+    ecs_mask_add(idx, CMP_RESOURCE);
 }
 
 resource_type_t cmp_resource_type_from_index(int idx)
 {
-    if (idx < 0 || idx >= ECS_MAX_ENTITIES) return RESOURCE_TYPE_PLASTIC;
-    if ((ecs_mask[idx] & CMP_RESOURCE) == 0) return RESOURCE_TYPE_PLASTIC;
+    if (idx < 0 || idx >= ecs_capacity()) return RESOURCE_TYPE_PLASTIC;
+    if (!component_mask_any(ecs_mask[idx], CMP_RESOURCE)) return RESOURCE_TYPE_PLASTIC;
     return cmp_resource_type[idx];
 }
 
@@ -57,14 +57,14 @@ bool cmp_resource_get_type(ecs_entity_t e, resource_type_t* out_type)
 {
     int idx = ent_index_checked(e);
     if (idx < 0) return false;
-    if ((ecs_mask[idx] & CMP_RESOURCE) == 0) return false;
+    if (!component_mask_any(ecs_mask[idx], CMP_RESOURCE)) return false;
     if (out_type) *out_type = cmp_resource_type[idx];
     return true;
 }
 
 static void resource_destroy_hook(int idx)
 {
-    if (idx < 0 || idx >= ECS_MAX_ENTITIES) return;
+    if (idx < 0 || idx >= ecs_capacity()) return;
     cmp_resource_type[idx] = RESOURCE_TYPE_PLASTIC;
 }
 
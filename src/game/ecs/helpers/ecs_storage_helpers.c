@@ -38,14 +38,14 @@ void cmp_add_storage(ecs_entity_t e, int capacity)
     if (i < 0) return;
     if (capacity <= 0) capacity = k_storage_default_capacity;
     cmp_storage[i] = (cmp_storage_t){ .counts = {0}, .capacity = capacity };
-    ecs_mask[i] |= CMP_STORAGE;
+    ecs_mask_add(i, CMP_STORAGE);
 }
 
 bool ecs_storage_get(ecs_entity_t e, int out_counts[RESOURCE_TYPE_COUNT], int* out_capacity)
 {
     int i = ent_index_checked(e);
     if (i < 0) return false;
-    if ((ecs_mask[i] & CMP_STORAGE) == 0) return false;
+    if (!component_mask_any(ecs_mask[i], CMP_STORAGE)) return false;
     if (out_counts) {
         for (int type = 0; type < RESOURCE_TYPE_COUNT; ++type) {
             out_counts[type] = cmp_storage[i].counts[type];
@@ -59,7 +59,7 @@ bool ecs_storage_add_resource(ecs_entity_t e, resource_type_t type, int count)
 {
     int i = ent_index_checked(e);
     if (i < 0) return false;
-    if ((ecs_mask[i] & CMP_STORAGE) == 0) return false;
+    if (!component_mask_any(ecs_mask[i], CMP_STORAGE)) return false;
     if (count <= 0) return false;
     cmp_storage[i].counts[type] += count;
     return true;
@@ -69,7 +69,7 @@ bool ecs_storage_take_random(ecs_entity_t e, resource_type_t* out_type)
 {
     int i = ent_index_checked(e);
     if (i < 0) return false;
-    if ((ecs_mask[i] & CMP_STORAGE) == 0) return false;
+    if (!component_mask_any(ecs_mask[i], CMP_STORAGE)) return false;
 
     int total = storage_total(&cmp_storage[i]);
     if (total <= 0) return false;
@@ -94,22 +94,17 @@ ecs_entity_t ecs_storage_find_player(void)
     ecs_entity_t player = ecs_find_player();
     int idx = ent_index_checked(player);
     if (idx < 0) return ecs_null();
-    if ((ecs_mask[idx] & CMP_STORAGE) == 0) return ecs_null();
+    if (!component_mask_any(ecs_mask[idx], CMP_STORAGE)) return ecs_null();
     return player;
 }
 
 ecs_entity_t ecs_storage_find_tardas(void)
 {
-    for (int i = 0; i < ECS_MAX_ENTITIES; ++i) {
-        if (!ecs_alive_idx(i)) continue;
-        if ((ecs_mask[i] & (CMP_STORAGE | CMP_LIFTABLE)) != (CMP_STORAGE | CMP_LIFTABLE)) continue;
+    ECS_QUERY_EACH(ecs_query_get(CMP_SET(CMP_STORAGE, CMP_LIFTABLE), CMP_NONE), i) {
         return handle_from_index(i);
     }
 
-    for (int i = 0; i < ECS_MAX_ENTITIES; ++i) {
-        if (!ecs_alive_idx(i)) continue;
-        if ((ecs_mask[i] & CMP_STORAGE) == 0) continue;
-        if (ecs_mask[i] & CMP_PLAYER) continue;
+    ECS_QUERY_EACH(ecs_query_get(CMP_STORAGE, CMP_PLAYER), i) {
         return handle_from_index(i);
     }
     return ecs_null();
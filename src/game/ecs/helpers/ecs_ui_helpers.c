@@ -7,7 +7,7 @@ bool ecs_grav_gun_get_charge(float* out_charge, float* out_max)
 {
     ecs_entity_t player = ecs_find_player();
     int player_idx = ent_index_checked(player);
-    if (player_idx < 0 || (ecs_mask[player_idx] & CMP_PLAYER) == 0) {
+    if (player_idx < 0 || !component_mask_any(ecs_mask[player_idx], CMP_PLAYER)) {
         if (out_charge) *out_charge = 0.0f;
         if (out_max) *out_max = 0.0f;
         return false;
@@ -15,7 +15,7 @@ bool ecs_grav_gun_get_charge(float* out_charge, float* out_max)
 
     ecs_entity_t gun = cmp_player[player_idx].held_gun;
     int gun_idx = ent_index_checked(gun);
-    if (gun_idx < 0 || (ecs_mask[gun_idx] & CMP_GRAV_GUN) == 0) {
+    if (gun_idx < 0 || !component_mask_any(ecs_mask[gun_idx], CMP_GRAV_GUN)) {
         cmp_player[player_idx].held_gun = ecs_null();
         if (out_charge) *out_charge = 0.0f;
         if (out_max) *out_max = 0.0f;
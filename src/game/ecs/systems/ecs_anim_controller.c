@@ -10,7 +10,7 @@ static void sys_anim_controller_impl(void)
     int idx = ent_index_checked(player);
     if (idx < 0) return;
 
-    if ((ecs_mask[idx] & (CMP_ANIM | CMP_VEL)) != (CMP_ANIM | CMP_VEL))
+    if (!component_mask_all(ecs_mask[idx], CMP_SET(CMP_ANIM, CMP_VEL)))
         return;
 
     cmp_anim_t*      a = &cmp_anim[idx];
@@ -25,12 +25,12 @@ static void facing_to_vector(facing_t dir, float* out_x, float* out_y)
 
 static bool conveyor_rider_is_held(int idx)
 {
-    return (ecs_mask[idx] & CMP_LIFTABLE) && (cmp_liftable[idx].state == GRAV_GUN_STATE_HELD);
+    return component_mask_any(ecs_mask[idx], CMP_LIFTABLE) && (cmp_liftable[idx].state == GRAV_GUN_STATE_HELD);
 }
 
 static void conveyor_enter_rider(int idx, cmp_conveyor_rider_t* rider)
 {
-    if (!rider || (ecs_mask[idx] & CMP_PHYS_BODY) == 0) return;
+    if (!rider || !component_mask_any(ecs_mask[idx], CMP_PHYS_BODY)) return;
     if (rider->active_count == 0) {
         cmp_phys_body[idx].type = PHYS_KINEMATIC;
     }
@@ -39,7 +39,7 @@ static void conveyor_enter_rider(int idx, cmp_conveyor_rider_t* rider)
 
 static void conveyor_exit_rider(int idx, cmp_conveyor_rider_t* rider)
 {
-    if (!rider || (ecs_mask[idx] & CMP_PHYS_BODY) == 0) return;
+    if (!rider || !component_mask_any(ecs_mask[idx], CMP_PHYS_BODY)) return;
     if (rider->active_count > 0) {
         rider->active_count -= 1;
     }
@@ -48,66 +48,72 @@ static void conveyor_exit_rider(int idx, cmp_conveyor_rider_t* rider)
         cmp_phys_body[idx].category_bits = cmp_phys_body[idx].default_category_bits;
         cmp_phys_body[idx].mask_bits = cmp_phys_body[idx].default_mask_bits;
         *rider = (cmp_conveyor_rider_t){ .active_count = 0 };
-        ecs_mask[idx] &= ~CMP_CONVEYOR_RIDER;
+        ecs_cmd_remove(ecs_cmd_current(), handle_from_index(idx), CMP_CONVEYOR_RIDER);
     }
 }
 
 static void conveyor_force_exit(int idx, cmp_conveyor_rider_t* rider)
 {
-    if (!rider || (ecs_mask[idx] & CMP_PHYS_BODY) == 0) return;
+    if (!rider || !component_mask_any(ecs_mask[idx], CMP_PHYS_BODY)) return;
     rider->active_count = 0;
     cmp_phys_body[idx].type = cmp_phys_body[idx].default_type;
     cmp_phys_body[idx].category_bits = cmp_phys_body[idx].default_category_bits;
     cmp_phys_body[idx].mask_bits = cmp_phys_body[idx].default_mask_bits;
     *rider = (cmp_conveyor_rider_t){ .active_count = 0 };
-    ecs_mask[idx] &= ~CMP_CONVEYOR_RIDER;
+    ecs_cmd_remove(ecs_cmd_current(), handle_from_index(idx), CMP_CONVEYOR_RIDER);
 }
 
 static void sys_conveyor_update_impl(void)
 {
-    float belt_vel_x[ECS_MAX_ENTITIES] = {0};
-    float belt_vel_y[ECS_MAX_ENTITIES] = {0};
-    bool belt_block_input[ECS_MAX_ENTITIES] = {0};
+    float* belt_vel_x = ecs_scratch_acquire(sizeof(float));
+    float* belt_vel_y = ecs_scratch_acquire(sizeof(float));
+    bool* belt_block_input = ecs_scratch_acquire(sizeof(bool));
+    if (!belt_vel_x || !belt_vel_y || !belt_block_input) {
+        ecs_scratch_release(belt_block_input);
+        ecs_scratch_release(belt_vel_y);
+        ecs_scratch_release(belt_vel_x);
+        return;
+    }
 
-    ecs_prox_iter_t enter_it = ecs_prox_enter_begin();
+    ecs_prox_iter_t enter_it = ecs_prox_enter_begin_for(CMP_CONVEYOR);
     ecs_prox_view_t v;
     while (ecs_prox_enter_next(&enter_it, &v)) {
         int belt_idx = ent_index_checked(v.trigger_owner);
         int rider_idx = ent_index_checked(v.matched_entity);
         if (belt_idx < 0 || rider_idx < 0) continue;
-        if ((ecs_mask[belt_idx] & CMP_CONVEYOR) == 0) continue;
-        if ((ecs_mask[rider_idx] & CMP_PHYS_BODY) == 0) continue;
+        if (!component_mask_any(ecs_mask[belt_idx], CMP_CONVEYOR)) continue;
+        if (!component_mask_any(ecs_mask[rider_idx], CMP_PHYS_BODY)) continue;
         if (conveyor_rider_is_held(rider_idx)) continue;
 
-        if ((ecs_mask[rider_idx] & CMP_CONVEYOR_RIDER) == 0) {
+        if (!component_mask_any(ecs_mask[rider_idx], CMP_CONVEYOR_RIDER)) {
             cmp_conveyor_rider[rider_idx] = (cmp_conveyor_rider_t){ .active_count = 0 };
-            ecs_mask[rider_idx] |= CMP_CONVEYOR_RIDER;
+            ecs_mask_add(rider_idx, CMP_CONVEYOR_RIDER);
         }
         conveyor_enter_rider(rider_idx, &cmp_conveyor_rider[rider_idx]);
     }
 
-    ecs_prox_iter_t exit_it = ecs_prox_exit_begin();
+    ecs_prox_iter_t exit_it = ecs_prox_exit_begin_for(CMP_CONVEYOR);
     while (ecs_prox_exit_next(&exit_it, &v)) {
         int belt_idx = ent_index_checked(v.trigger_owner);
         int rider_idx = ent_index_checked(v.matched_entity);
         if (belt_idx < 0 || rider_idx < 0) continue;
-        if ((ecs_mask[belt_idx] & CMP_CONVEYOR) == 0) continue;
-        if ((ecs_mask[rider_idx] & CMP_CONVEYOR_RIDER) == 0) continue;
+        if (!component_mask_any(ecs_mask[belt_idx], CMP_CONVEYOR)) continue;
+        if (!component_mask_any(ecs_mask[rider_idx], CMP_CONVEYOR_RIDER)) continue;
         conveyor_exit_rider(rider_idx, &cmp_conveyor_rider[rider_idx]);
     }
 
-    ecs_prox_iter_t it = ecs_prox_stay_begin();
+    ecs_prox_iter_t it = ecs_prox_stay_begin_for(CMP_CONVEYOR);
     while (ecs_prox_stay_next(&it, &v)) {
         int belt_idx = ent_index_checked(v.trigger_owner);
         int rider_idx = ent_index_checked(v.matched_entity);
         if (belt_idx < 0 || rider_idx < 0) continue;
-        if ((ecs_mask[belt_idx] & CMP_CONVEYOR) == 0) continue;
-        if ((ecs_mask[rider_idx] & CMP_PHYS_BODY) == 0) continue;
+        if (!component_mask_any(ecs_mask[belt_idx], CMP_CONVEYOR)) continue;
+        if (!component_mask_any(ecs_mask[rider_idx], CMP_PHYS_BODY)) continue;
         if (conveyor_rider_is_held(rider_idx)) continue;
 
-        if ((ecs_mask[rider_idx] & CMP_CONVEYOR_RIDER) == 0) {
+        if (!component_mask_any(ecs_mask[rider_idx], CMP_CONVEYOR_RIDER)) {
             cmp_conveyor_rider[rider_idx] = (cmp_conveyor_rider_t){ .active_count = 0 };
-            ecs_mask[rider_idx] |= CMP_CONVEYOR_RIDER;
+            ecs_mask_add(rider_idx, CMP_CONVEYOR_RIDER);
             conveyor_enter_rider(rider_idx, &cmp_conveyor_rider[rider_idx]);
         }
 
@@ -129,9 +135,7 @@ static void sys_conveyor_update_impl(void)
         }
     }
 
-    for (int i = 0; i < ECS_MAX_ENTITIES; ++i) {
-        if (!ecs_alive_idx(i)) continue;
-        if ((ecs_mask[i] & CMP_CONVEYOR_RIDER) == 0) continue;
+    ECS_QUERY_EACH(ecs_query_get(CMP_CONVEYOR_RIDER, CMP_NONE), i) {
 
         cmp_conveyor_rider_t* rider = &cmp_conveyor_rider[i];
         if (conveyor_rider_is_held(i)) {
@@ -143,16 +147,15 @@ static void sys_conveyor_update_impl(void)
         rider->vel_y = belt_vel_y[i];
         rider->block_player_input = belt_block_input[i];
     }
+
+    ecs_scratch_release(belt_block_input);
+    ecs_scratch_release(belt_vel_y);
+    ecs_scratch_release(belt_vel_x);
 }
 
 static void sys_conveyor_apply_impl(void)
 {
-    for (int i = 0; i < ECS_MAX_ENTITIES; ++i) {
-        if (!ecs_alive_idx(i)) continue;
-        if ((ecs_mask[i] & (CMP_CONVEYOR_RIDER | CMP_VEL | CMP_PHYS_BODY)) !=
-            (CMP_CONVEYOR_RIDER | CMP_VEL | CMP_PHYS_BODY)) {
-            continue;
-        }
+    ECS_QUERY_EACH(ecs_query_get(CMP_SET(CMP_CONVEYOR_RIDER, CMP_VEL, CMP_PHYS_BODY), CMP_NONE), i) {
         if (cmp_conveyor_rider[i].active_count <= 0) continue;
         cmp_vel[i].x = cmp_conveyor_rider[i].vel_x;
         cmp_vel[i].y = cmp_conveyor_rider[i].vel_y;
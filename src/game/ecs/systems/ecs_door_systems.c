@@ -57,34 +57,32 @@ static void sys_doors_tick(float dt)
     if (!world_has_map()) return;
 
     // Build intent from proximity stay/enter
-    bool door_should_open[ECS_MAX_ENTITIES] = {0};
-    ecs_prox_iter_t stay_it = ecs_prox_stay_begin();
+    bool* door_should_open = ecs_scratch_acquire(sizeof(bool));
+    if (!door_should_open) return;
+    ecs_prox_iter_t stay_it = ecs_prox_stay_begin_for(CMP_DOOR);
     ecs_prox_view_t v;
     while (ecs_prox_stay_next(&stay_it, &v)) {
         int a = ent_index_checked(v.trigger_owner);
-        if (a >= 0 && (ecs_mask[a] & CMP_DOOR)) {
+        if (a >= 0 && component_mask_any(ecs_mask[a], CMP_DOOR)) {
             door_should_open[a] = true;
         }
     }
-    ecs_prox_iter_t enter_it = ecs_prox_enter_begin();
+    ecs_prox_iter_t enter_it = ecs_prox_enter_begin_for(CMP_DOOR);
     while (ecs_prox_enter_next(&enter_it, &v)) {
         int a = ent_index_checked(v.trigger_owner);
-        if (a >= 0 && (ecs_mask[a] & CMP_DOOR)) {
+        if (a >= 0 && component_mask_any(ecs_mask[a], CMP_DOOR)) {
             door_should_open[a] = true;
         }
     }
 
-    for (int i = 0; i < ECS_MAX_ENTITIES; ++i) {
-        if (!ecs_alive_idx(i)) continue;
-        if ((ecs_mask[i] & CMP_DOOR) != CMP_DOOR) continue;
-        cmp_door_t *d = &cmp_door[i];
+    ECS_QUERY_EACH(ecs_query_get(CMP_DOOR, CMP_NONE), i) {
+        cmp_door_t *d = cmp_door_get(i);
         d->intent_open = door_should_open[i];
     }
+    ecs_scratch_release(door_should_open);
 
-    for (int i = 0; i < ECS_MAX_ENTITIES; ++i) {
-        if (!ecs_alive_idx(i)) continue;
-        if ((ecs_mask[i] & CMP_DOOR) != CMP_DOOR) continue;
-        cmp_door_t *d = &cmp_door[i];
+    ECS_QUERY_EACH(ecs_query_get(CMP_DOOR, CMP_NONE), i) {
+        cmp_door_t *d = cmp_door_get(i);
 
         int primary_total = d->primary_anim_total_ms;
         float prev_t = d->anim_time_ms;
@@ -11,13 +11,19 @@
 #include "engine/asset/asset.h"
 #include "engine/renderer/renderer.h"
 #include "engine/ecs/ecs_physics.h"
+#include "engine/world/world_query.h"
+#include "engine/spatial/spatial.h"
 #include <float.h>
 #include <math.h>
 
 enum { GUN_CHARGER_FLASH_TIME_MS = 750 };
+enum { GRAV_GUN_MAX_CANDIDATES = 16 };
 static const float GUN_CHARGER_FLASH_TIME = 0.001f * (float)GUN_CHARGER_FLASH_TIME_MS;
 static const float GUN_CHARGER_EJECT_DURATION = 0.30f;
 static const float GUN_CHARGER_EJECT_SPEED = 60.0f;
+// Upper bound on a liftable's pickup_distance; the grab search only looks
+// this far from the player.
+static const float GRAV_GUN_MAX_PICKUP_DISTANCE = 256.0f;
 
 static void sprite_clear_component(int idx);
 
@@ -30,9 +36,7 @@ static bool grav_gun_get_mouse_world(const input_t* in, gfx_vec2* out)
 static void grav_gun_destroy_hook(int idx)
 {
     ecs_entity_t gun = handle_from_index(idx);
-    for (int i = 0; i < ECS_MAX_ENTITIES; ++i) {
-        if (!ecs_alive_idx(i)) continue;
-        if ((ecs_mask[i] & CMP_PLAYER) == 0) continue;
+    ECS_QUERY_EACH(ecs_query_get(CMP_PLAYER, CMP_NONE), i) {
         if (cmp_player[i].held_gun.idx == gun.idx && cmp_player[i].held_gun.gen == gun.gen) {
             cmp_player[i].held_gun = ecs_null();
         }
@@ -47,9 +51,7 @@ void ecs_register_grav_gun_component_hooks(void)
 static void liftable_destroy_hook(int idx)
 {
     ecs_entity_t liftable = handle_from_index(idx);
-    for (int i = 0; i < ECS_MAX_ENTITIES; ++i) {
-        if (!ecs_alive_idx(i)) continue;
-        if ((ecs_mask[i] & CMP_PLAYER) == 0) continue;
+    ECS_QUERY_EACH(ecs_query_get(CMP_PLAYER, CMP_NONE), i) {
         if (cmp_player[i].held_liftable.idx == liftable.idx &&
             cmp_player[i].held_liftable.gen == liftable.gen) {
             cmp_player[i].held_liftable = ecs_null();
@@ -65,11 +67,11 @@ void ecs_register_liftable_component_hooks(void)
 static int player_held_gun_index(ecs_entity_t player)
 {
     int player_idx = ent_index_checked(player);
-    if (player_idx < 0 || (ecs_mask[player_idx] & CMP_PLAYER) == 0) return -1;
+    if (player_idx < 0 || !component_mask_any(ecs_mask[player_idx], CMP_PLAYER)) return -1;
 
     ecs_entity_t gun = cmp_player[player_idx].held_gun;
     int gun_idx = ent_index_checked(gun);
-    if (gun_idx < 0 || (ecs_mask[gun_idx] & CMP_GRAV_GUN) == 0) {
+    if (gun_idx < 0 || !component_mask_any(ecs_mask[gun_idx], CMP_GRAV_GUN)) {
         cmp_player[player_idx].held_gun = ecs_null();
         return -1;
     }
@@ -88,11 +90,11 @@ static int player_held_gun_index(ecs_entity_t player)
 static int player_held_liftable_index(ecs_entity_t player)
 {
     int player_idx = ent_index_checked(player);
-    if (player_idx < 0 || (ecs_mask[player_idx] & CMP_PLAYER) == 0) return -1;
+    if (player_idx < 0 || !component_mask_any(ecs_mask[player_idx], CMP_PLAYER)) return -1;
 
     ecs_entity_t liftable = cmp_player[player_idx].held_liftable;
     int liftable_idx = ent_index_checked(liftable);
-    if (liftable_idx < 0 || (ecs_mask[liftable_idx] & CMP_LIFTABLE) == 0) {
+    if (liftable_idx < 0 || !component_mask_any(ecs_mask[liftable_idx], CMP_LIFTABLE)) {
         cmp_player[player_idx].held_liftable = ecs_null();
         return -1;
     }
@@ -107,13 +109,13 @@ static int player_held_liftable_index(ecs_entity_t player)
 
 static int find_grav_gun_near_player(ecs_entity_t player)
 {
-    ecs_prox_iter_t it = ecs_prox_stay_begin();
+    ecs_prox_iter_t it = ecs_prox_stay_begin_for(CMP_GRAV_GUN);
     ecs_prox_view_t v;
     while (ecs_prox_stay_next(&it, &v)) {
         int trigger_idx = ent_index_checked(v.trigger_owner);
         int matched_idx = ent_index_checked(v.matched_entity);
         if (trigger_idx < 0 || matched_idx < 0) continue;
-        if ((ecs_mask[trigger_idx] & CMP_GRAV_GUN) == 0) continue;
+        if (!component_mask_any(ecs_mask[trigger_idx], CMP_GRAV_GUN)) continue;
         if (cmp_grav_gun[trigger_idx].held) continue;
         if (v.matched_entity.idx == player.idx && v.matched_entity.gen == player.gen) {
             return trigger_idx;
@@ -124,12 +126,12 @@ static int find_grav_gun_near_player(ecs_entity_t player)
 
 static int find_gun_charger_near_player(ecs_entity_t player)
 {
-    ecs_prox_iter_t it = ecs_prox_stay_begin();
+    ecs_prox_iter_t it = ecs_prox_stay_begin_for(CMP_GUN_CHARGER);
     ecs_prox_view_t v;
     while (ecs_prox_stay_next(&it, &v)) {
         int trigger_idx = ent_index_checked(v.trigger_owner);
         if (trigger_idx < 0) continue;
-        if ((ecs_mask[trigger_idx] & CMP_GUN_CHARGER) == 0) continue;
+        if (!component_mask_any(ecs_mask[trigger_idx], CMP_GUN_CHARGER)) continue;
         if (v.matched_entity.idx == player.idx && v.matched_entity.gen == player.gen) {
             return trigger_idx;
         }
@@ -139,18 +141,17 @@ static int find_gun_charger_near_player(ecs_entity_t player)
 
 static bool charger_can_accept(int charger_idx)
 {
-    if (charger_idx < 0 || (ecs_mask[charger_idx] & CMP_GUN_CHARGER) == 0) return false;
-    return !ecs_alive_handle(cmp_gun_charger[charger_idx].stored_gun);
+    if (charger_idx < 0 || !component_mask_any(ecs_mask[charger_idx], CMP_GUN_CHARGER)) return false;
+    return !ecs_alive_handle(cmp_gun_charger_get(charger_idx)->stored_gun);
 }
 
 static void clear_charger_for_gun(ecs_entity_t gun)
 {
-    for (int i = 0; i < ECS_MAX_ENTITIES; ++i) {
-        if (!ecs_alive_idx(i)) continue;
-        if ((ecs_mask[i] & CMP_GUN_CHARGER) == 0) continue;
-        if (cmp_gun_charger[i].stored_gun.idx == gun.idx && cmp_gun_charger[i].stored_gun.gen == gun.gen) {
-            cmp_gun_charger[i].stored_gun = ecs_null();
-            cmp_gun_charger[i].flash_timer = 0.0f;
+    ECS_QUERY_EACH(ecs_query_get(CMP_GUN_CHARGER, CMP_NONE), i) {
+        cmp_gun_charger_t* charger = cmp_gun_charger_get(i);
+        if (charger->stored_gun.idx == gun.idx && charger->stored_gun.gen == gun.gen) {
+            charger->stored_gun = ecs_null();
+            charger->flash_timer = 0.0f;
             sprite_clear_component(i);
         }
     }
@@ -159,28 +160,29 @@ static void clear_charger_for_gun(ecs_entity_t gun)
 static void swap_player_sprite_texture(int player_idx, const char* path)
 {
     if (player_idx < 0) return;
-    if ((ecs_mask[player_idx] & CMP_SPR) == 0) return;
+    if (!component_mask_any(ecs_mask[player_idx], CMP_SPR)) return;
     tex_handle_t new_tex = asset_acquire_texture(path);
     if (asset_texture_valid(cmp_spr[player_idx].tex)) {
         asset_release_texture(cmp_spr[player_idx].tex);
     }
     cmp_spr[player_idx].tex = new_tex;
+    ecs_mark_changed(player_idx, CMP_SPR);
 }
 
 static void sprite_clear_component(int idx)
 {
-    if (idx < 0 || (ecs_mask[idx] & CMP_SPR) == 0) return;
+    if (idx < 0 || !component_mask_any(ecs_mask[idx], CMP_SPR)) return;
     if (asset_texture_valid(cmp_spr[idx].tex)) {
         asset_release_texture(cmp_spr[idx].tex);
     }
     cmp_spr[idx] = (cmp_sprite_t){ .tex = (tex_handle_t){ .idx = 0, .gen = 0 } };
-    ecs_mask[idx] &= ~CMP_SPR;
+    ecs_mask_remove(idx, CMP_SPR);
 }
 
 static void charger_assume_gun_sprite(int charger_idx, int gun_idx)
 {
     if (charger_idx < 0 || gun_idx < 0) return;
-    if ((ecs_mask[gun_idx] & CMP_SPR) == 0) return;
+    if (!component_mask_any(ecs_mask[gun_idx], CMP_SPR)) return;
     sprite_clear_component(charger_idx);
     cmp_add_sprite_handle(handle_from_index(charger_idx),
                           cmp_spr[gun_idx].tex,
@@ -195,13 +197,14 @@ static void tool_pickup(int gun_idx, ecs_entity_t player, int player_idx)
     cmp_grav_gun[gun_idx].held = true;
     cmp_grav_gun[gun_idx].holder = player;
     cmp_grav_gun[gun_idx].toast_pending = false;
-    if (ecs_mask[player_idx] & CMP_PLAYER) {
+    if (component_mask_any(ecs_mask[player_idx], CMP_PLAYER)) {
         cmp_player[player_idx].held_gun = handle_from_index(gun_idx);
     }
-    if ((ecs_mask[gun_idx] & CMP_POS) != 0) {
+    if (component_mask_any(ecs_mask[gun_idx], CMP_POS)) {
         cmp_pos[gun_idx].x = cmp_pos[player_idx].x;
         cmp_pos[gun_idx].y = cmp_pos[player_idx].y;
-        ecs_mask[gun_idx] &= ~CMP_POS;
+        ecs_mark_changed(gun_idx, CMP_POS);
+        ecs_mask_remove(gun_idx, CMP_POS);
     }
     swap_player_sprite_texture(player_idx, "assets/images/character_withgun.png");
 }
@@ -210,7 +213,7 @@ static void tool_drop(int gun_idx, int player_idx)
 {
     cmp_grav_gun[gun_idx].held = false;
     cmp_grav_gun[gun_idx].holder = ecs_null();
-    if (ecs_mask[player_idx] & CMP_PLAYER) {
+    if (component_mask_any(ecs_mask[player_idx], CMP_PLAYER)) {
         cmp_player[player_idx].held_gun = ecs_null();
     }
     cmp_add_position((ecs_entity_t){ .idx = (uint32_t)gun_idx, .gen = ecs_gen[gun_idx] },
@@ -221,19 +224,22 @@ static void tool_drop(int gun_idx, int player_idx)
 static void charger_eject_gun(int charger_idx, int gun_idx)
 {
     if (charger_idx < 0 || gun_idx < 0) return;
-    if (ecs_mask[charger_idx] & CMP_POS) {
+    if (component_mask_any(ecs_mask[charger_idx], CMP_POS)) {
         cmp_add_position((ecs_entity_t){ .idx = (uint32_t)gun_idx, .gen = ecs_gen[gun_idx] },
                          cmp_pos[charger_idx].x, cmp_pos[charger_idx].y);
         cmp_grav_gun[gun_idx].eject_timer = GUN_CHARGER_EJECT_DURATION;
-        if ((ecs_mask[gun_idx] & CMP_GRAV_GUN) != 0) {
+        if (component_mask_any(ecs_mask[gun_idx], CMP_GRAV_GUN)) {
             cmp_grav_gun_t* gun = &cmp_grav_gun[gun_idx];
             if (gun->charge >= gun->max_charge) {
                 gun->toast_pending = true;
             }
         }
     }
-    cmp_gun_charger[charger_idx].stored_gun = ecs_null();
-    cmp_gun_charger[charger_idx].flash_timer = 0.0f;
+    cmp_gun_charger_t* charger = cmp_gun_charger_get(charger_idx);
+    if (charger) {
+        charger->stored_gun = ecs_null();
+        charger->flash_timer = 0.0f;
+    }
     sprite_clear_component(charger_idx);
 }
 
@@ -241,46 +247,45 @@ static void tool_place_in_charger(int gun_idx, int player_idx, int charger_idx)
 {
     cmp_grav_gun[gun_idx].held = false;
     cmp_grav_gun[gun_idx].holder = ecs_null();
-    if (ecs_mask[player_idx] & CMP_PLAYER) {
+    if (component_mask_any(ecs_mask[player_idx], CMP_PLAYER)) {
         cmp_player[player_idx].held_gun = ecs_null();
     }
-    if (ecs_mask[gun_idx] & CMP_POS) {
-        ecs_mask[gun_idx] &= ~CMP_POS;
+    if (component_mask_any(ecs_mask[gun_idx], CMP_POS)) {
+        ecs_mask_remove(gun_idx, CMP_POS);
     }
     charger_assume_gun_sprite(charger_idx, gun_idx);
-    cmp_gun_charger[charger_idx].stored_gun = handle_from_index(gun_idx);
-    cmp_gun_charger[charger_idx].flash_timer = 0.0f;
+    cmp_gun_charger_t* charger = cmp_gun_charger_get(charger_idx);
+    charger->stored_gun = handle_from_index(gun_idx);
+    charger->flash_timer = 0.0f;
     if (cmp_grav_gun[gun_idx].charge >= cmp_grav_gun[gun_idx].max_charge) {
-        cmp_gun_charger[charger_idx].flash_timer = GUN_CHARGER_FLASH_TIME;
+        charger->flash_timer = GUN_CHARGER_FLASH_TIME;
     }
     swap_player_sprite_texture(player_idx, "assets/images/character.png");
 }
 
 static void sys_grav_gun_charger_impl(float dt)
 {
-    for (int i = 0; i < ECS_MAX_ENTITIES; ++i) {
-        if (!ecs_alive_idx(i)) continue;
-        if ((ecs_mask[i] & CMP_GUN_CHARGER) == 0) continue;
-
-        ecs_entity_t stored = cmp_gun_charger[i].stored_gun;
+    ECS_QUERY_EACH(ecs_query_get(CMP_GUN_CHARGER, CMP_NONE), i) {
+        cmp_gun_charger_t* charger = cmp_gun_charger_get(i);
+        ecs_entity_t stored = charger->stored_gun;
         if (!ecs_alive_handle(stored)) {
-            cmp_gun_charger[i].stored_gun = ecs_null();
-            cmp_gun_charger[i].flash_timer = 0.0f;
+            charger->stored_gun = ecs_null();
+            charger->flash_timer = 0.0f;
             sprite_clear_component(i);
             continue;
         }
 
         int gun_idx = ent_index_checked(stored);
-        if (gun_idx < 0 || (ecs_mask[gun_idx] & CMP_GRAV_GUN) == 0) {
-            cmp_gun_charger[i].stored_gun = ecs_null();
-            cmp_gun_charger[i].flash_timer = 0.0f;
+        if (gun_idx < 0 || !component_mask_any(ecs_mask[gun_idx], CMP_GRAV_GUN)) {
+            charger->stored_gun = ecs_null();
+            charger->flash_timer = 0.0f;
             sprite_clear_component(i);
             continue;
         }
 
-        if (cmp_gun_charger[i].flash_timer > 0.0f) {
-            cmp_gun_charger[i].flash_timer -= dt;
-            if (cmp_gun_charger[i].flash_timer <= 0.0f) {
+        if (charger->flash_timer > 0.0f) {
+            charger->flash_timer -= dt;
+            if (charger->flash_timer <= 0.0f) {
                 charger_eject_gun(i, gun_idx);
             }
             continue;
@@ -297,17 +302,16 @@ static void sys_grav_gun_charger_impl(float dt)
         }
 
         if (gun->charge >= gun->max_charge && !gun->toast_pending) {
-            cmp_gun_charger[i].flash_timer = 2.0f * GUN_CHARGER_FLASH_TIME;
+            charger->flash_timer = 2.0f * GUN_CHARGER_FLASH_TIME;
             gun->toast_pending = true;
         }
     }
 
-    for (int i = 0; i < ECS_MAX_ENTITIES; ++i) {
-        if (!ecs_alive_idx(i)) continue;
+    ECS_QUERY_EACH(ecs_query_get(CMP_SET(CMP_GRAV_GUN, CMP_POS), CMP_NONE), i) {
         cmp_grav_gun_t* gun = &cmp_grav_gun[i];
         if (gun->eject_timer <= 0.0f) continue;
-        if ((ecs_mask[i] & CMP_POS) == 0) continue;
         cmp_pos[i].y += GUN_CHARGER_EJECT_SPEED * dt;
+        ecs_mark_changed(i, CMP_POS);
         gun->eject_timer -= dt;
         if (gun->eject_timer <= 0.0f) {
             gun->eject_timer = 0.0f;
@@ -320,11 +324,11 @@ static void sys_grav_gun_charger_impl(float dt)
 }
 static bool grav_gun_hit_test(int idx, float mx, float my, float pad)
 {
-    if ((ecs_mask[idx] & CMP_POS) == 0) return false;
+    if (!component_mask_any(ecs_mask[idx], CMP_POS)) return false;
     const float cx = cmp_pos[idx].x;
     const float cy = cmp_pos[idx].y;
 
-    if (ecs_mask[idx] & CMP_COL) {
+    if (component_mask_any(ecs_mask[idx], CMP_COL)) {
         float hx = cmp_col[idx].hx + pad;
         float hy = cmp_col[idx].hy + pad;
         return (mx >= cx - hx && mx <= cx + hx && my >= cy - hy && my <= cy + hy);
@@ -335,38 +339,72 @@ static bool grav_gun_hit_test(int idx, float mx, float my, float pad)
     return (dx * dx + dy * dy) <= (pad * pad);
 }
 
+// Candidates under the cursor are checked for line of sight in one batch. A
+// ray that stops inside the candidate's own box still counts as visible, so
+// bodies resting against a wall can be grabbed.
+static bool grav_gun_ray_reaches(int idx, const world_ray_hit_t* hit)
+{
+    if (!hit->hit) return true;
+    if (!component_mask_any(ecs_mask[idx], CMP_COL)) return false;
+    return fabsf(hit->point.x - cmp_pos[idx].x) <= cmp_col[idx].hx &&
+           fabsf(hit->point.y - cmp_pos[idx].y) <= cmp_col[idx].hy;
+}
+
 static int find_grab_candidate(int player_idx, gfx_vec2 mouse_world)
 {
     const float px = cmp_pos[player_idx].x;
     const float py = cmp_pos[player_idx].y;
 
-    float best_d2 = FLT_MAX;
-    int best_idx = -1;
+    int cand[GRAV_GUN_MAX_CANDIDATES];
+    float cand_d2[GRAV_GUN_MAX_CANDIDATES];
+    world_ray_t rays[GRAV_GUN_MAX_CANDIDATES];
+    world_ray_hit_t hits[GRAV_GUN_MAX_CANDIDATES];
+    int count = 0;
 
-    for (int i = 0; i < ECS_MAX_ENTITIES; ++i) {
+    int* nearby = ecs_scratch_acquire(sizeof(int));
+    if (!nearby) return -1;
+    int nearby_count = spatial_query_radius(px, py, GRAV_GUN_MAX_PICKUP_DISTANCE, CMP_SET(CMP_LIFTABLE, CMP_PHYS_BODY),
+                                            nearby, ecs_capacity());
+    if (nearby_count > ecs_capacity()) nearby_count = ecs_capacity();
+
+    for (int k = 0; k < nearby_count; ++k) {
+        const int i = nearby[k];
         if (i == player_idx) continue;
-        if (!ecs_alive_idx(i)) continue;
-        if ((ecs_mask[i] & (CMP_LIFTABLE | CMP_POS | CMP_PHYS_BODY)) != (CMP_LIFTABLE | CMP_POS | CMP_PHYS_BODY)) continue;
 
         cmp_liftable_t* g = &cmp_liftable[i];
         if (g->state != GRAV_GUN_STATE_FREE) continue;
 
         if (cmp_phys_body[i].type == PHYS_STATIC) continue;
 
-        const float pickup_dist = (g->pickup_distance > 0.0f) ? g->pickup_distance : 48.0f;
+        const float pickup_dist = fminf((g->pickup_distance > 0.0f) ? g->pickup_distance : 48.0f,
+                                        GRAV_GUN_MAX_PICKUP_DISTANCE);
         const float dxp = cmp_pos[i].x - px;
         const float dyp = cmp_pos[i].y - py;
         if ((dxp * dxp + dyp * dyp) > (pickup_dist * pickup_dist)) continue;
 
         const float pad = (g->pickup_radius > 0.0f) ? g->pickup_radius : 8.0f;
         if (!grav_gun_hit_test(i, mouse_world.x, mouse_world.y, pad)) continue;
+        if (count == GRAV_GUN_MAX_CANDIDATES) break;
 
         const float dxm = cmp_pos[i].x - mouse_world.x;
         const float dym = cmp_pos[i].y - mouse_world.y;
-        const float d2 = dxm * dxm + dym * dym;
-        if (d2 < best_d2) {
-            best_d2 = d2;
-            best_idx = i;
+        cand[count] = i;
+        cand_d2[count] = dxm * dxm + dym * dym;
+        rays[count] = (world_ray_t){ px, py, cmp_pos[i].x, cmp_pos[i].y };
+        count++;
+    }
+    ecs_scratch_release(nearby);
+    if (count == 0) return -1;
+
+    world_raycast_batch_px(rays, count, 0.0f, 0.0f, hits);
+
+    float best_d2 = FLT_MAX;
+    int best_idx = -1;
+    for (int k = 0; k < count; ++k) {
+        if (!grav_gun_ray_reaches(cand[k], &hits[k])) continue;
+        if (cand_d2[k] < best_d2) {
+            best_d2 = cand_d2[k];
+            best_idx = cand[k];
         }
     }
 
@@ -375,7 +413,7 @@ static int find_grab_candidate(int player_idx, gfx_vec2 mouse_world)
 
 static void grav_gun_set_player_filter(int idx, bool ignore_player)
 {
-    if ((ecs_mask[idx] & CMP_PHYS_BODY) == 0) return;
+    if (!component_mask_any(ecs_mask[idx], CMP_PHYS_BODY)) return;
 
     if (ignore_player) {
         unsigned int mask = cmp_phys_body[idx].mask_bits;
@@ -383,7 +421,7 @@ static void grav_gun_set_player_filter(int idx, bool ignore_player)
         const unsigned int player_bit = phys_tag_bit("player");
         const unsigned int tardas_bit = phys_tag_bit("tardas");
         mask &= ~player_bit;
-        if (ecs_mask[idx] & CMP_RESOURCE) {
+        if (component_mask_any(ecs_mask[idx], CMP_RESOURCE)) {
             mask &= ~tardas_bit;
         }
         cmp_phys_body[idx].mask_bits = mask;
@@ -397,17 +435,16 @@ static void begin_hold(int idx, ecs_entity_t holder, gfx_vec2 mouse_world)
     cmp_liftable_t* g = &cmp_liftable[idx];
     g->holder = holder;
     g->state = GRAV_GUN_STATE_HELD;
-    g->just_dropped = false;
     g->grab_offset_x = cmp_pos[idx].x - mouse_world.x;
     g->grab_offset_y = cmp_pos[idx].y - mouse_world.y;
     g->hold_vel_x = 0.0f;
     g->hold_vel_y = 0.0f;
     int holder_idx = ent_index_checked(holder);
-    if (holder_idx >= 0 && (ecs_mask[holder_idx] & CMP_PLAYER)) {
+    if (holder_idx >= 0 && component_mask_any(ecs_mask[holder_idx], CMP_PLAYER)) {
         cmp_player[holder_idx].held_liftable = handle_from_index(idx);
     }
 
-    if ((ecs_mask[idx] & CMP_VEL) == 0) {
+    if (!component_mask_any(ecs_mask[idx], CMP_VEL)) {
         cmp_add_velocity(handle_from_index(idx), 0.0f, 0.0f, DIR_SOUTH);
     } else {
         cmp_vel[idx].x = 0.0f;
@@ -422,15 +459,15 @@ static void release_hold(int idx)
     cmp_liftable_t* g = &cmp_liftable[idx];
     ecs_entity_t holder = g->holder;
     int holder_idx = ent_index_checked(holder);
-    if (holder_idx >= 0 && (ecs_mask[holder_idx] & CMP_PLAYER)) {
+    if (holder_idx >= 0 && component_mask_any(ecs_mask[holder_idx], CMP_PLAYER)) {
         cmp_player[holder_idx].held_liftable = ecs_null();
     }
     g->holder = ecs_null();
     g->state = GRAV_GUN_STATE_FREE;
-    g->just_dropped = true;
     g->hold_vel_x = 0.0f;
     g->hold_vel_y = 0.0f;
     grav_gun_set_player_filter(idx, false);
+    ECS_EVENT_EMIT(game_ev_dropped, game_ev_dropped_t, .item = handle_from_index(idx));
 }
 
 static void sys_grav_gun_input_impl(const input_t* in)
@@ -439,7 +476,7 @@ static void sys_grav_gun_input_impl(const input_t* in)
 
     ecs_entity_t player = ecs_find_player();
     int player_idx = ent_index_checked(player);
-    if (player_idx < 0 || (ecs_mask[player_idx] & CMP_POS) == 0) return;
+    if (player_idx < 0 || !component_mask_any(ecs_mask[player_idx], CMP_POS)) return;
     int tool_idx = player_held_gun_index(player);
     if (tool_idx < 0) return;
     if (cmp_grav_gun[tool_idx].charge <= 0.0f) {
@@ -472,7 +509,7 @@ static void sys_grav_gun_tool_impl(const input_t* in)
 
     ecs_entity_t player = ecs_find_player();
     int player_idx = ent_index_checked(player);
-    if (player_idx < 0 || (ecs_mask[player_idx] & CMP_POS) == 0) return;
+    if (player_idx < 0 || !component_mask_any(ecs_mask[player_idx], CMP_POS)) return;
 
     int held_tool_idx = player_held_gun_index(player);
     if (held_tool_idx >= 0) {
@@ -498,7 +535,7 @@ static void sys_grav_gun_tool_impl(const input_t* in)
 static void update_held(int idx, cmp_liftable_t* g, float dt, const input_t* in)
 {
     int holder_idx = ent_index_checked(g->holder);
-    if (holder_idx < 0 || (ecs_mask[holder_idx] & CMP_POS) == 0) {
+    if (holder_idx < 0 || !component_mask_any(ecs_mask[holder_idx], CMP_POS)) {
         release_hold(idx);
         return;
     }
@@ -569,7 +606,7 @@ static void update_held(int idx, cmp_liftable_t* g, float dt, const input_t* in)
     g->hold_vel_x = g->hold_vel_x + (desired_x - g->hold_vel_x) * blend;
     g->hold_vel_y = g->hold_vel_y + (desired_y - g->hold_vel_y) * blend;
 
-    if ((ecs_mask[idx] & CMP_VEL) == 0) {
+    if (!component_mask_any(ecs_mask[idx], CMP_VEL)) {
         cmp_add_velocity(handle_from_index(idx), g->hold_vel_x, g->hold_vel_y, DIR_SOUTH);
     } else {
         cmp_vel[idx].x = g->hold_vel_x;
@@ -579,9 +616,7 @@ static void update_held(int idx, cmp_liftable_t* g, float dt, const input_t* in)
 
 static void sys_grav_gun_motion_impl(float dt, const input_t* in)
 {
-    for (int i = 0; i < ECS_MAX_ENTITIES; ++i) {
-        if (!ecs_alive_idx(i)) continue;
-        if ((ecs_mask[i] & CMP_GRAV_GUN) == 0) continue;
+    ECS_QUERY_EACH(ecs_query_get(CMP_GRAV_GUN, CMP_NONE), i) {
 
         cmp_grav_gun_t* gun = &cmp_grav_gun[i];
         if (gun->max_charge <= 0.0f) continue;
@@ -589,11 +624,11 @@ static void sys_grav_gun_motion_impl(float dt, const input_t* in)
         bool draining = false;
         if (gun->held && ecs_alive_handle(gun->holder)) {
             int holder_idx = ent_index_checked(gun->holder);
-            if (holder_idx >= 0 && (ecs_mask[holder_idx] & CMP_PLAYER)) {
+            if (holder_idx >= 0 && component_mask_any(ecs_mask[holder_idx], CMP_PLAYER)) {
                 ecs_entity_t liftable = cmp_player[holder_idx].held_liftable;
                 int liftable_idx = ent_index_checked(liftable);
                 if (liftable_idx >= 0 &&
-                    (ecs_mask[liftable_idx] & CMP_LIFTABLE) != 0 &&
+                    component_mask_any(ecs_mask[liftable_idx], CMP_LIFTABLE) &&
                     cmp_liftable[liftable_idx].state == GRAV_GUN_STATE_HELD) {
                     draining = true;
                 } else {
@@ -609,9 +644,7 @@ static void sys_grav_gun_motion_impl(float dt, const input_t* in)
         }
     }
 
-    for (int i = 0; i < ECS_MAX_ENTITIES; ++i) {
-        if (!ecs_alive_idx(i)) continue;
-        if ((ecs_mask[i] & CMP_LIFTABLE) == 0) continue;
+    ECS_QUERY_EACH(ecs_query_get(CMP_LIFTABLE, CMP_NONE), i) {
 
         cmp_liftable_t* g = &cmp_liftable[i];
         if (g->state == GRAV_GUN_STATE_HELD) {
@@ -622,19 +655,17 @@ static void sys_grav_gun_motion_impl(float dt, const input_t* in)
 
 static void sys_grav_gun_fx_impl(void)
 {
-    for (int i = 0; i < ECS_MAX_ENTITIES; ++i) {
-        if (!ecs_alive_idx(i)) continue;
-        if ((ecs_mask[i] & (CMP_LIFTABLE | CMP_POS)) != (CMP_LIFTABLE | CMP_POS)) continue;
+    ECS_QUERY_EACH(ecs_query_get(CMP_SET(CMP_LIFTABLE, CMP_POS), CMP_NONE), i) {
 
         cmp_liftable_t* g = &cmp_liftable[i];
         if (g->state != GRAV_GUN_STATE_HELD) continue;
 
         int holder_idx = ent_index_checked(g->holder);
-        if (holder_idx < 0 || (ecs_mask[holder_idx] & CMP_POS) == 0) continue;
+        if (holder_idx < 0 || !component_mask_any(ecs_mask[holder_idx], CMP_POS)) continue;
 
         gfx_color color = (gfx_color){ .r = 0.470588f, .g = 0.784314f, .b = 1.0f, .a = 1.0f  };
         int thickness = 1;
-        if (ecs_mask[i] & CMP_SPR) {
+        if (component_mask_any(ecs_mask[i], CMP_SPR)) {
             cmp_spr[i].fx.highlighted = true;
             color = cmp_spr[i].fx.highlight_base_color;
             if (color.a <= 0.0f) {
@@ -662,7 +693,7 @@ static void sys_grav_gun_fx_impl(void)
             }
         }
 
-        if (ecs_mask[i] & CMP_SPR) {
+        if (component_mask_any(ecs_mask[i], CMP_SPR)) {
             cmp_spr[i].fx.highlight_color = color;
         }
 
@@ -671,21 +702,16 @@ static void sys_grav_gun_fx_impl(void)
         fx_line_push(start, end, (float)thickness, color);
     }
 
-    for (int i = 0; i < ECS_MAX_ENTITIES; ++i) {
-        if (!ecs_alive_idx(i)) continue;
-        if ((ecs_mask[i] & CMP_GUN_CHARGER) == 0) continue;
-        if ((ecs_mask[i] & CMP_SPR) == 0) continue;
-        if (!ecs_alive_handle(cmp_gun_charger[i].stored_gun)) continue;
+    ECS_QUERY_EACH(ecs_query_get(CMP_SET(CMP_GUN_CHARGER, CMP_SPR), CMP_NONE), i) {
+        const cmp_gun_charger_t* charger = cmp_gun_charger_get(i);
+        if (!ecs_alive_handle(charger->stored_gun)) continue;
         cmp_spr[i].fx.front = true;
-        if (cmp_gun_charger[i].flash_timer <= 0.0f) continue;
+        if (charger->flash_timer <= 0.0f) continue;
         cmp_spr[i].fx.highlighted = true;
         cmp_spr[i].fx.highlight_color = (gfx_color){ .r = 0.2f, .g = 1.0f, .b = 0.2f, .a = 1.0f  };
     }
 
-    for (int i = 0; i < ECS_MAX_ENTITIES; ++i) {
-        if (!ecs_alive_idx(i)) continue;
-        if ((ecs_mask[i] & CMP_GRAV_GUN) == 0) continue;
-        if ((ecs_mask[i] & CMP_SPR) == 0) continue;
+    ECS_QUERY_EACH(ecs_query_get(CMP_SET(CMP_GRAV_GUN, CMP_SPR), CMP_NONE), i) {
         if (cmp_grav_gun[i].eject_timer <= 0.0f) continue;
         cmp_spr[i].fx.front = true;
     }
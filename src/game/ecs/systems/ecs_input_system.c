@@ -33,10 +33,8 @@ void sys_input(float dt, const input_t* in)
     const float SPEED       = 120.0f;
     const float CHANGE_TIME = 0.04f;   // 40 ms
 
-    for (int e = 0; e < ECS_MAX_ENTITIES; ++e) {
-        if (!ecs_alive_idx(e)) continue;
-        if ((ecs_mask[e] & (CMP_PLAYER | CMP_VEL)) != (CMP_PLAYER | CMP_VEL)) continue;
-        if ((ecs_mask[e] & CMP_CONVEYOR_RIDER) && cmp_conveyor_rider[e].active_count > 0 &&
+    ECS_QUERY_EACH(ecs_query_get(CMP_SET(CMP_PLAYER, CMP_VEL), CMP_NONE), e) {
+        if (component_mask_any(ecs_mask[e], CMP_CONVEYOR_RIDER) && cmp_conveyor_rider[e].active_count > 0 &&
             cmp_conveyor_rider[e].block_player_input) {
             cmp_vel[e].x = 0.0f;
             cmp_vel[e].y = 0.0f;
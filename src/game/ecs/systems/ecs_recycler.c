@@ -1,5 +1,6 @@
 //==== FROM ecs_recycler.c ====
 #include "game/ecs/ecs_game.h"
+#include "game/ecs/ecs_game_internal.h"
 #include "engine/ecs/ecs_physics.h"
 #include "game/ecs/helpers/ecs_resource_helpers.h"
 #include "engine/ecs/ecs_proximity.h"
@@ -12,7 +13,29 @@ typedef struct {
     ecs_entity_t storage;
 } cmp_recycle_bin_t;
 
-static cmp_recycle_bin_t g_recycle_bin[ECS_MAX_ENTITIES];
+// Accepted item sinking into a bin; destroyed once it reaches target_y.
+typedef struct {
+    float target_y;
+} cmp_recycling_t;
+
+static cmp_recycle_bin_t* g_recycle_bin = NULL;
+static ecs_sparse_t g_recycling_set;
+
+void ecs_recycler_register_storage(void)
+{
+    ECS_REGISTER_STORAGE(g_recycle_bin);
+    ecs_register_sparse(&g_recycling_set, ENUM_RECYCLING, sizeof(cmp_recycling_t));
+}
+
+static void recycle_bin_remap_hook(int idx)
+{
+    g_recycle_bin[idx].storage = ecs_remap_handle(g_recycle_bin[idx].storage);
+}
+
+void ecs_recycler_register_remap_hook(void)
+{
+    ecs_register_component_remap_hook(ENUM_RECYCLE_BIN, recycle_bin_remap_hook);
+}
 
 static const float k_recycle_fall_speed = 50.0f;
 
@@ -21,25 +44,28 @@ void cmp_add_recycle_bin(ecs_entity_t e, resource_type_t type)
     int i = ent_index_checked(e);
     if (i < 0) return;
     g_recycle_bin[i] = (cmp_recycle_bin_t){ .type = type, .storage = ecs_null() };
-    ecs_mask[i] |= CMP_RECYCLE_BIN;
+    ecs_mask_add(i, CMP_RECYCLE_BIN);
 }
 
 static void sys_recycle_bins_impl(void)
 {
-    ecs_prox_iter_t it = ecs_prox_stay_begin();
+    if (ecs_event_count(&game_ev_dropped) == 0) return;
+    ecs_liftable_mark_drops();
+
+    ecs_prox_iter_t it = ecs_prox_stay_begin_for(CMP_RECYCLE_BIN);
     ecs_prox_view_t v;
     while (ecs_prox_stay_next(&it, &v)) {
         int ia = ent_index_checked(v.trigger_owner);
         int ib = ent_index_checked(v.matched_entity);
         if (ia < 0 || ib < 0) continue;
 
-        if ((ecs_mask[ia] & CMP_RECYCLE_BIN) == 0) continue;
-        if ((ecs_mask[ib] & (CMP_RESOURCE | CMP_LIFTABLE)) != (CMP_RESOURCE | CMP_LIFTABLE)) continue;
+        if (!component_mask_any(ecs_mask[ia], CMP_RECYCLE_BIN)) continue;
+        if (!component_mask_all(ecs_mask[ib], CMP_SET(CMP_RESOURCE, CMP_LIFTABLE))) continue;
 
         cmp_liftable_t* g = &cmp_liftable[ib];
         if (g->state == GRAV_GUN_STATE_HELD) continue;
-        if (g->recycle_active) continue;
-        if (!g->just_dropped) continue;
+        if (component_mask_any(ecs_mask[ib], CMP_RECYCLING)) continue;
+        if (!ecs_liftable_drop_marked(ib)) continue;
 
         cmp_recycle_bin_t* bin = &g_recycle_bin[ia];
         resource_type_t dropped_type = cmp_resource_type_from_index(ib);
@@ -50,10 +76,10 @@ static void sys_recycle_bins_impl(void)
 
         ecs_entity_t storage_entity = bin->storage;
         int storage_idx = ent_index_checked(storage_entity);
-        if (storage_idx < 0 || (ecs_mask[storage_idx] & CMP_STORAGE) == 0) {
+        if (storage_idx < 0 || !component_mask_any(ecs_mask[storage_idx], CMP_STORAGE)) {
             storage_entity = ecs_storage_find_player();
             storage_idx = ent_index_checked(storage_entity);
-            if (storage_idx < 0 || (ecs_mask[storage_idx] & CMP_STORAGE) == 0) continue;
+            if (storage_idx < 0 || !component_mask_any(ecs_mask[storage_idx], CMP_STORAGE)) continue;
             bin->storage = storage_entity;
         }
 
@@ -61,27 +87,29 @@ static void sys_recycle_bins_impl(void)
 
         float bin_x = cmp_pos[ia].x;
         float bin_y = cmp_pos[ia].y;
-        float bin_hy = (ecs_mask[ia] & CMP_COL) ? cmp_col[ia].hy : 0.0f;
-        float res_hy = (ecs_mask[ib] & CMP_COL) ? cmp_col[ib].hy : 0.0f;
+        float bin_hy = component_mask_any(ecs_mask[ia], CMP_COL) ? cmp_col[ia].hy : 0.0f;
+        float res_hy = component_mask_any(ecs_mask[ib], CMP_COL) ? cmp_col[ib].hy : 0.0f;
         float top = bin_y - bin_hy + res_hy;
         float bottom = bin_y + bin_hy - res_hy;
         if (bottom < top) bottom = top;
 
         cmp_pos[ib].x = bin_x;
         cmp_pos[ib].y = top;
+        ecs_mark_changed(ib, CMP_POS);
 
-        if (ecs_mask[ib] & CMP_PHYS_BODY) {
+        if (component_mask_any(ecs_mask[ib], CMP_PHYS_BODY)) {
             ecs_phys_body_destroy_for_entity(ib);
-            ecs_mask[ib] &= ~CMP_PHYS_BODY;
+            ecs_mask_remove(ib, CMP_PHYS_BODY);
         }
-        if (ecs_mask[ib] & CMP_VEL) {
+        if (component_mask_any(ecs_mask[ib], CMP_VEL)) {
             cmp_vel[ib].x = 0.0f;
             cmp_vel[ib].y = 0.0f;
         }
 
-        g->recycle_active = true;
-        g->recycle_target_y = bottom;
-        g->just_dropped = false;
+        cmp_recycling_t* r = ecs_sparse_add(&g_recycling_set, ib);
+        if (!r) continue;
+        r->target_y = bottom;
+        ecs_mask_add(ib, CMP_RECYCLING);
 
         ui_toast(1.0f, "%s recycled", resource_type_to_string(dropped_type));
     }
@@ -89,15 +117,12 @@ static void sys_recycle_bins_impl(void)
 
 static void sys_recycle_anim_impl(float dt)
 {
-    for (int i = 0; i < ECS_MAX_ENTITIES; ++i) {
-        if (!ecs_alive_idx(i)) continue;
-        if ((ecs_mask[i] & (CMP_LIFTABLE | CMP_POS)) != (CMP_LIFTABLE | CMP_POS)) continue;
-        cmp_liftable_t* g = &cmp_liftable[i];
-        if (!g->recycle_active) continue;
-
+    ECS_QUERY_EACH(ecs_query_get(CMP_SET(CMP_RECYCLING, CMP_POS), CMP_NONE), i) {
+        const cmp_recycling_t* r = ecs_sparse_get(&g_recycling_set, i);
         cmp_pos[i].y += k_recycle_fall_speed * dt;
-        if (cmp_pos[i].y >= g->recycle_target_y) {
-            ecs_destroy(handle_from_index(i));
+        ecs_mark_changed(i, CMP_POS);
+        if (cmp_pos[i].y >= r->target_y) {
+            ecs_cmd_destroy(ecs_cmd_current(), handle_from_index(i));
         }
     }
 }
@@ -4,37 +4,29 @@
 #include "engine/ecs/ecs_proximity.h"
 #include "game/ecs/helpers/ecs_storage_helpers.h"
 #include "engine/engine/engine_scheduler/engine_scheduler.h"
+#include "engine/world/world_query.h"
+#include "engine/spatial/spatial.h"
 
 #include <float.h>
 
+// How far a spawned resource may be nudged to clear walls around the unpacker.
+#define UNLOADER_SPAWN_SEARCH_PX 64.0f
+
 static ecs_entity_t find_nearest_unpacker(int unloader_idx)
 {
-    ecs_entity_t best = ecs_null();
-    float best_dist = FLT_MAX;
-
-    const bool has_pos = (ecs_mask[unloader_idx] & CMP_POS) != 0;
+    const bool has_pos = component_mask_any(ecs_mask[unloader_idx], CMP_POS);
     const float ux = has_pos ? cmp_pos[unloader_idx].x : 0.0f;
     const float uy = has_pos ? cmp_pos[unloader_idx].y : 0.0f;
 
-    for (int i = 0; i < ECS_MAX_ENTITIES; ++i) {
-        if (!ecs_alive_idx(i)) continue;
-        if ((ecs_mask[i] & (CMP_UNPACKER | CMP_POS)) != (CMP_UNPACKER | CMP_POS)) continue;
-        float dx = cmp_pos[i].x - ux;
-        float dy = cmp_pos[i].y - uy;
-        float d2 = dx * dx + dy * dy;
-        if (d2 < best_dist) {
-            best_dist = d2;
-            best = handle_from_index(i);
-        }
-    }
-
-    return best;
+    int nearest = -1;
+    if (spatial_query_knn(ux, uy, 1, FLT_MAX, CMP_UNPACKER, &nearest) == 0) return ecs_null();
+    return handle_from_index(nearest);
 }
 
 static void unpacker_refresh_ready_state(int idx)
 {
-    if ((ecs_mask[idx] & CMP_UNPACKER) == 0) return;
-    cmp_unpacker_t* u = &cmp_unpacker[idx];
+    if (!component_mask_any(ecs_mask[idx], CMP_UNPACKER)) return;
+    cmp_unpacker_t* u = cmp_unpacker_get(idx);
     if (!u->ready && !ecs_alive_handle(u->spawned_entity)) {
         u->ready = true;
         u->spawned_entity = ecs_null();
@@ -43,26 +35,32 @@ static void unpacker_refresh_ready_state(int idx)
 
 static void sys_unloader_tick_impl(void)
 {
-    for (int i = 0; i < ECS_MAX_ENTITIES; ++i) {
-        if (!ecs_alive_idx(i)) continue;
-        if ((ecs_mask[i] & CMP_UNPACKER) == 0) continue;
+    ECS_QUERY_EACH(ecs_query_get(CMP_UNPACKER, CMP_NONE), i) {
         unpacker_refresh_ready_state(i);
     }
 
-    bool has_target[ECS_MAX_ENTITIES] = {0};
-    ecs_entity_t target[ECS_MAX_ENTITIES];
-    for (int i = 0; i < ECS_MAX_ENTITIES; ++i) {
+    // Spawning below may grow the pool; only entities that existed when the
+    // targets were gathered can have one.
+    const int cap = ecs_capacity();
+    bool* has_target = ecs_scratch_acquire(sizeof(bool));
+    ecs_entity_t* target = ecs_scratch_acquire(sizeof(ecs_entity_t));
+    if (!has_target || !target) {
+        ecs_scratch_release(target);
+        ecs_scratch_release(has_target);
+        return;
+    }
+    for (int i = 0; i < cap; ++i) {
         target[i] = ecs_null();
     }
 
-    ecs_prox_iter_t it = ecs_prox_stay_begin();
+    ecs_prox_iter_t it = ecs_prox_stay_begin_for(CMP_UNLOADER);
     ecs_prox_view_t v;
     while (ecs_prox_stay_next(&it, &v)) {
         int ia = ent_index_checked(v.trigger_owner);
         int ib = ent_index_checked(v.matched_entity);
         if (ia < 0 || ib < 0) continue;
-        if ((ecs_mask[ia] & CMP_UNLOADER) == 0) continue;
-        if ((ecs_mask[ib] & (CMP_STORAGE | CMP_LIFTABLE)) != (CMP_STORAGE | CMP_LIFTABLE)) continue;
+        if (!component_mask_any(ecs_mask[ia], CMP_UNLOADER)) continue;
+        if (!component_mask_all(ecs_mask[ib], CMP_SET(CMP_STORAGE, CMP_LIFTABLE))) continue;
 
         if (!has_target[ia]) {
             has_target[ia] = true;
@@ -70,32 +68,31 @@ static void sys_unloader_tick_impl(void)
         }
     }
 
-    for (int i = 0; i < ECS_MAX_ENTITIES; ++i) {
-        if (!ecs_alive_idx(i)) continue;
-        if ((ecs_mask[i] & CMP_UNLOADER) == 0) continue;
+    ECS_QUERY_EACH(ecs_query_get(CMP_UNLOADER, CMP_NONE), i) {
+        if (i >= cap) break;
         if (!has_target[i]) continue;
 
-        cmp_unloader_t* unloader = &cmp_unloader[i];
+        cmp_unloader_t* unloader = cmp_unloader_get(i);
 
         ecs_entity_t unpacker = unloader->unpacker_handle;
         int unpacker_idx = ent_index_checked(unpacker);
-        if (unpacker_idx < 0 || (ecs_mask[unpacker_idx] & CMP_UNPACKER) == 0) {
+        if (unpacker_idx < 0 || !component_mask_any(ecs_mask[unpacker_idx], CMP_UNPACKER)) {
             unpacker = find_nearest_unpacker(i);
             unloader->unpacker_handle = unpacker;
             unpacker_idx = ent_index_checked(unpacker);
         }
-        if (unpacker_idx < 0 || (ecs_mask[unpacker_idx] & CMP_UNPACKER) == 0) continue;
+        if (unpacker_idx < 0 || !component_mask_any(ecs_mask[unpacker_idx], CMP_UNPACKER)) continue;
         unpacker_refresh_ready_state(unpacker_idx);
-        if (!cmp_unpacker[unpacker_idx].ready) continue;
+        if (!cmp_unpacker_get(unpacker_idx)->ready) continue;
 
         resource_type_t type;
         if (!ecs_storage_take_random(target[i], &type)) {
             continue;
         }
 
-        float spawn_x = (ecs_mask[i] & CMP_POS) ? cmp_pos[i].x : 0.0f;
-        float spawn_y = (ecs_mask[i] & CMP_POS) ? cmp_pos[i].y : 0.0f;
-        if ((ecs_mask[unpacker_idx] & CMP_POS) != 0) {
+        float spawn_x = component_mask_any(ecs_mask[i], CMP_POS) ? cmp_pos[i].x : 0.0f;
+        float spawn_y = component_mask_any(ecs_mask[i], CMP_POS) ? cmp_pos[i].y : 0.0f;
+        if (component_mask_any(ecs_mask[unpacker_idx], CMP_POS)) {
             spawn_x = cmp_pos[unpacker_idx].x;
             spawn_y = cmp_pos[unpacker_idx].y;
         }
@@ -105,11 +102,20 @@ static void sys_unloader_tick_impl(void)
             NULL);
         int spawned_idx = ent_index_checked(spawned);
         if (spawned_idx < 0) continue;
+        // Drop the resource on the closest spot its collider fits, if any.
+        if (component_mask_any(ecs_mask[spawned_idx], CMP_COL)) {
+            world_find_clear_spot_px(&spawn_x, &spawn_y, cmp_col[spawned_idx].hx, cmp_col[spawned_idx].hy,
+                                     UNLOADER_SPAWN_SEARCH_PX);
+        }
         cmp_add_position(spawned, spawn_x, spawn_y);
 
-        cmp_unpacker[unpacker_idx].ready = false;
-        cmp_unpacker[unpacker_idx].spawned_entity = spawned;
+        cmp_unpacker_t* unpacker_cmp = cmp_unpacker_get(unpacker_idx);
+        unpacker_cmp->ready = false;
+        unpacker_cmp->spawned_entity = spawned;
     }
+
+    ecs_scratch_release(target);
+    ecs_scratch_release(has_target);
 }
 
 SYSTEMS_ADAPT_VOID(sys_unloader_tick_adapt, sys_unloader_tick_impl)
@@ -25,7 +25,7 @@ static void pf_component_liftable_apply(ecs_entity_t e, const void* component)
     const pf_component_grav_gun_t* liftable = (const pf_component_grav_gun_t*)component;
     cmp_add_liftable(e);
     int idx = ent_index_checked(e);
-    if (idx >= 0 && (ecs_mask[idx] & CMP_LIFTABLE)) {
+    if (idx >= 0 && component_mask_any(ecs_mask[idx], CMP_LIFTABLE)) {
         if (liftable->has_pickup_distance) cmp_liftable[idx].pickup_distance = liftable->pickup_distance;
         if (liftable->has_pickup_radius) cmp_liftable[idx].pickup_radius = liftable->pickup_radius;
         if (liftable->has_max_hold_distance) cmp_liftable[idx].max_hold_distance = liftable->max_hold_distance;
@@ -5,31 +5,173 @@
 #include <stdint.h>
 #include <strings.h>
 
+#include "engine/utils/bits.h"
+
 typedef enum {
-#define X(name) ENUM_##name,
+#define X(name, storage) ENUM_##name,
 #include "engine/ecs/components_engine.def"
 #include "game/components/components_game.def"
 #undef X
     ENUM_COMPONENT_COUNT
 } ComponentEnum;
 
-typedef uint64_t ComponentMask;
+// Fixed-width component bitset, one bit per ComponentEnum. The word count
+// follows ENUM_COMPONENT_COUNT, so adding components past 64 only widens the
+// mask; every helper below is a straight loop over the words with no
+// data-dependent branches, which the compiler unrolls (and vectorizes for
+// wider masks). Masks are plain values: copy, memset and memcpy freely.
+enum { COMPONENT_MASK_WORDS = (ENUM_COMPONENT_COUNT + 63) / 64 };
+
+typedef struct {
+    uint64_t w[COMPONENT_MASK_WORDS];
+} ComponentMask;
+
+// Constant initializer for a single-bit mask (usable in static tables).
+#define COMPONENT_MASK_BIT_INIT(id) { .w[(id) / 64] = 1ull << ((id) % 64) }
+#define CMP_NONE ((ComponentMask){ { 0 } })
 
-enum {
-#define X(name) CMP_##name = 1ull << ENUM_##name,
+#define X(name, storage) static const ComponentMask CMP_##name = COMPONENT_MASK_BIT_INIT(ENUM_##name);
 #include "engine/ecs/components_engine.def"
 #include "game/components/components_game.def"
 #undef X
-};
+
+static inline ComponentMask component_mask_bit(int id)
+{
+    ComponentMask m = CMP_NONE;
+    m.w[id / 64] = 1ull << (id % 64);
+    return m;
+}
+
+static inline ComponentMask component_mask_or(ComponentMask a, ComponentMask b)
+{
+    for (int i = 0; i < COMPONENT_MASK_WORDS; ++i) a.w[i] |= b.w[i];
+    return a;
+}
+
+static inline ComponentMask component_mask_and(ComponentMask a, ComponentMask b)
+{
+    for (int i = 0; i < COMPONENT_MASK_WORDS; ++i) a.w[i] &= b.w[i];
+    return a;
+}
+
+// a & ~b
+static inline ComponentMask component_mask_andnot(ComponentMask a, ComponentMask b)
+{
+    for (int i = 0; i < COMPONENT_MASK_WORDS; ++i) a.w[i] &= ~b.w[i];
+    return a;
+}
+
+static inline ComponentMask component_mask_xor(ComponentMask a, ComponentMask b)
+{
+    for (int i = 0; i < COMPONENT_MASK_WORDS; ++i) a.w[i] ^= b.w[i];
+    return a;
+}
+
+static inline bool component_mask_empty(ComponentMask m)
+{
+    uint64_t acc = 0;
+    for (int i = 0; i < COMPONENT_MASK_WORDS; ++i) acc |= m.w[i];
+    return acc == 0;
+}
+
+static inline bool component_mask_eq(ComponentMask a, ComponentMask b)
+{
+    uint64_t acc = 0;
+    for (int i = 0; i < COMPONENT_MASK_WORDS; ++i) acc |= a.w[i] ^ b.w[i];
+    return acc == 0;
+}
+
+// (m & bits) != 0
+static inline bool component_mask_any(ComponentMask m, ComponentMask bits)
+{
+    uint64_t acc = 0;
+    for (int i = 0; i < COMPONENT_MASK_WORDS; ++i) acc |= m.w[i] & bits.w[i];
+    return acc != 0;
+}
+
+// (m & bits) == bits
+static inline bool component_mask_all(ComponentMask m, ComponentMask bits)
+{
+    uint64_t miss = 0;
+    for (int i = 0; i < COMPONENT_MASK_WORDS; ++i) miss |= bits.w[i] & ~m.w[i];
+    return miss == 0;
+}
+
+static inline bool component_mask_has(ComponentMask m, int id)
+{
+    return (m.w[id / 64] >> (id % 64)) & 1u;
+}
+
+static inline void component_mask_set(ComponentMask* m, int id)
+{
+    m->w[id / 64] |= 1ull << (id % 64);
+}
+
+static inline void component_mask_clear(ComponentMask* m, int id)
+{
+    m->w[id / 64] &= ~(1ull << (id % 64));
+}
+
+static inline int component_mask_ctz64(uint64_t bits)
+{
+    return bits_ctz64(bits);
+}
+
+// Clears and returns the lowest set bit, or -1 once the mask is empty. Walk a
+// mask with `for (int c; (c = component_mask_pop_lowest(&bits)) >= 0;) { ... }`.
+static inline int component_mask_pop_lowest(ComponentMask* m)
+{
+    for (int i = 0; i < COMPONENT_MASK_WORDS; ++i) {
+        uint64_t w = m->w[i];
+        if (!w) continue;
+        m->w[i] = w & (w - 1);
+        return i * 64 + component_mask_ctz64(w);
+    }
+    return -1;
+}
+
+static inline ComponentMask component_mask_union(const ComponentMask* masks, size_t count)
+{
+    ComponentMask m = CMP_NONE;
+    for (size_t i = 0; i < count; ++i) m = component_mask_or(m, masks[i]);
+    return m;
+}
+
+// Upper-case hex, most significant word first, 16 digits per word and no
+// prefix. `out` needs COMPONENT_MASK_HEX_LEN bytes.
+#define COMPONENT_MASK_HEX_LEN (COMPONENT_MASK_WORDS * 16 + 1)
+static inline const char* component_mask_to_hex(ComponentMask m, char* out)
+{
+    static const char k_digits[] = "0123456789ABCDEF";
+    char* p = out;
+    for (int i = COMPONENT_MASK_WORDS - 1; i >= 0; --i) {
+        for (int shift = 60; shift >= 0; shift -= 4) *p++ = k_digits[(m.w[i] >> shift) & 0xFu];
+    }
+    *p = '\0';
+    return out;
+}
+
+// CMP_SET(CMP_POS, CMP_COL) is the union of the listed masks.
+#define CMP_SET(...) \
+    component_mask_union((const ComponentMask[]){ __VA_ARGS__ }, \
+                         sizeof((ComponentMask[]){ __VA_ARGS__ }) / sizeof(ComponentMask))
+
+// Per-component storage declared in the .def files: DENSE components get an
+// array indexed by entity, SPARSE ones a packed set sized to their owners.
+typedef enum {
+    COMPONENT_STORAGE_DENSE = 0,
+    COMPONENT_STORAGE_SPARSE
+} component_storage_t;
 
 typedef struct {
     const char* name;
     ComponentEnum id;
     ComponentMask mask;
+    component_storage_t storage;
 } component_meta_t;
 
 static const component_meta_t k_component_meta[] = {
-#define X(name) { #name, ENUM_##name, CMP_##name },
+#define X(name, storage) { #name, ENUM_##name, COMPONENT_MASK_BIT_INIT(ENUM_##name), COMPONENT_STORAGE_##storage },
 #include "engine/ecs/components_engine.def"
 #include "game/components/components_game.def"
 #undef X
@@ -43,6 +185,14 @@ static inline const char* component_name_from_id(ComponentEnum id)
     return NULL;
 }
 
+static inline component_storage_t component_storage_from_id(ComponentEnum id)
+{
+    for (size_t i = 0; i < sizeof(k_component_meta) / sizeof(k_component_meta[0]); ++i) {
+        if (k_component_meta[i].id == id) return k_component_meta[i].storage;
+    }
+    return COMPONENT_STORAGE_DENSE;
+}
+
 static inline bool component_id_from_string(const char* s, ComponentEnum* out_id)
 {
     if (!s || !out_id) return false;
@@ -123,6 +123,9 @@ int main(int argc, char **argv)
     if (!build_tool(cc, "tests/unit/core/time/build_time.c", "build/tests/bin/build_time")) return 1;
     if (!run_tool("build/tests/bin/build_time", coverage ? "--coverage" : NULL)) return 1;
 
+    if (!build_tool(cc, "tests/unit/core/jobs/build_jobs.c", "build/tests/bin/build_jobs")) return 1;
+    if (!run_tool("build/tests/bin/build_jobs", coverage ? "--coverage" : NULL)) return 1;
+
     if (!build_tool(cc, "tests/unit/core/logger_backend/build_logger_backend.c", "build/tests/bin/build_logger_backend")) return 1;
     if (!run_tool("build/tests/bin/build_logger_backend", coverage ? "--coverage" : NULL)) return 1;
 
@@ -190,7 +190,7 @@ void test_cmp_print_collider_and_misc(void)
     TEST_ASSERT_NOT_NULL(strstr(s_last_log, "holder=9"));
     TEST_ASSERT_EQUAL_INT(LOG_LVL_INFO, s_last_level);
 
-    cmp_trigger_t trig = { .pad = 1.25f, .target_mask = 0xAABBCCDD };
+    cmp_trigger_t trig = { .pad = 1.25f, .target_mask = { { 0xAABBCCDD } } };
     cmp_print_trigger(NULL, &trig);
     TEST_ASSERT_NOT_NULL(strstr(s_last_log, "TRIGGER(pad=1.25"));
     TEST_ASSERT_NOT_NULL(strstr(s_last_log, "target_mask=0x00000000AABBCCDD"));
@@ -1,4 +1,5 @@
 #include "debug_hotkeys_stubs.h"
+#include <stdlib.h>
 
 #include <stdarg.h>
 #include <stdio.h>
@@ -30,19 +31,34 @@ int g_world_tiles_w = 0;
 int g_world_tiles_h = 0;
 int g_game_storage_counts[RESOURCE_TYPE_COUNT] = {0};
 int g_game_storage_capacity = 0;
-ComponentMask   ecs_mask[ECS_MAX_ENTITIES];
-uint32_t        ecs_gen[ECS_MAX_ENTITIES];
-uint32_t        ecs_next_gen[ECS_MAX_ENTITIES];
-cmp_position_t  cmp_pos[ECS_MAX_ENTITIES];
-cmp_velocity_t  cmp_vel[ECS_MAX_ENTITIES];
-cmp_anim_t      cmp_anim[ECS_MAX_ENTITIES];
-cmp_sprite_t    cmp_spr[ECS_MAX_ENTITIES];
-cmp_collider_t  cmp_col[ECS_MAX_ENTITIES];
-cmp_phys_body_t cmp_phys_body[ECS_MAX_ENTITIES];
-bool g_ecs_alive[ECS_MAX_ENTITIES];
+static ComponentMask ecs_mask_storage[ECS_INITIAL_CAPACITY];
+ComponentMask*   ecs_mask = ecs_mask_storage;
+static uint32_t ecs_gen_storage[ECS_INITIAL_CAPACITY];
+uint32_t*        ecs_gen = ecs_gen_storage;
+static uint32_t ecs_next_gen_storage[ECS_INITIAL_CAPACITY];
+uint32_t*        ecs_next_gen = ecs_next_gen_storage;
+
+int ecs_capacity(void) { return ECS_INITIAL_CAPACITY; }
+void* ecs_scratch_acquire(size_t elem_size) { return calloc(ECS_INITIAL_CAPACITY, elem_size); }
+void ecs_scratch_release(void* p) { free(p); }
+
+static cmp_position_t cmp_pos_storage[ECS_INITIAL_CAPACITY];
+cmp_position_t*  cmp_pos = cmp_pos_storage;
+static cmp_velocity_t cmp_vel_storage[ECS_INITIAL_CAPACITY];
+cmp_velocity_t*  cmp_vel = cmp_vel_storage;
+static cmp_anim_t cmp_anim_storage[ECS_INITIAL_CAPACITY];
+cmp_anim_t*      cmp_anim = cmp_anim_storage;
+static cmp_sprite_t cmp_spr_storage[ECS_INITIAL_CAPACITY];
+cmp_sprite_t*    cmp_spr = cmp_spr_storage;
+static cmp_collider_t cmp_col_storage[ECS_INITIAL_CAPACITY];
+cmp_collider_t*  cmp_col = cmp_col_storage;
+static cmp_phys_body_t cmp_phys_body_storage[ECS_INITIAL_CAPACITY];
+cmp_phys_body_t* cmp_phys_body = cmp_phys_body_storage;
+bool g_ecs_alive[ECS_INITIAL_CAPACITY];
 
 void debug_hotkeys_stub_reset(void)
 {
+    ecs_register_sparse(&cmp_door_set, ENUM_DOOR, sizeof(cmp_door_t));
     g_asset_reload_calls = 0;
     g_asset_log_calls = 0;
     g_renderer_ecs_calls = 0;
@@ -60,15 +76,15 @@ void debug_hotkeys_stub_reset(void)
         g_game_storage_counts[i] = 0;
     }
     g_game_storage_capacity = 0;
-    memset(ecs_mask, 0, sizeof(ecs_mask));
-    memset(ecs_gen, 0, sizeof(ecs_gen));
-    memset(ecs_next_gen, 0, sizeof(ecs_next_gen));
-    memset(cmp_pos, 0, sizeof(cmp_pos));
-    memset(cmp_vel, 0, sizeof(cmp_vel));
-    memset(cmp_anim, 0, sizeof(cmp_anim));
-    memset(cmp_spr, 0, sizeof(cmp_spr));
-    memset(cmp_col, 0, sizeof(cmp_col));
-    memset(cmp_phys_body, 0, sizeof(cmp_phys_body));
+    memset(ecs_mask, 0, sizeof(ecs_mask[0]) * ECS_INITIAL_CAPACITY);
+    memset(ecs_gen, 0, sizeof(ecs_gen[0]) * ECS_INITIAL_CAPACITY);
+    memset(ecs_next_gen, 0, sizeof(ecs_next_gen[0]) * ECS_INITIAL_CAPACITY);
+    memset(cmp_pos, 0, sizeof(cmp_pos[0]) * ECS_INITIAL_CAPACITY);
+    memset(cmp_vel, 0, sizeof(cmp_vel[0]) * ECS_INITIAL_CAPACITY);
+    memset(cmp_anim, 0, sizeof(cmp_anim[0]) * ECS_INITIAL_CAPACITY);
+    memset(cmp_spr, 0, sizeof(cmp_spr[0]) * ECS_INITIAL_CAPACITY);
+    memset(cmp_col, 0, sizeof(cmp_col[0]) * ECS_INITIAL_CAPACITY);
+    memset(cmp_phys_body, 0, sizeof(cmp_phys_body[0]) * ECS_INITIAL_CAPACITY);
     memset(g_ecs_alive, 0, sizeof(g_ecs_alive));
 }
 
@@ -179,26 +195,26 @@ void log_set_min_level(log_level_t lvl)
 
 bool ecs_alive_idx(int i)
 {
-    if (i < 0 || i >= ECS_MAX_ENTITIES) return false;
+    if (i < 0 || i >= ECS_INITIAL_CAPACITY) return false;
     return g_ecs_alive[i];
 }
 
 int ent_index_checked(ecs_entity_t e)
 {
-    if (e.idx < 0 || e.idx >= ECS_MAX_ENTITIES) return -1;
+    if (e.idx < 0 || e.idx >= ECS_INITIAL_CAPACITY) return -1;
     if (!ecs_alive_idx((int)e.idx)) return -1;
     return (int)e.idx;
 }
 
 int ent_index_unchecked(ecs_entity_t e)
 {
-    if (e.idx < 0 || e.idx >= ECS_MAX_ENTITIES) return -1;
+    if (e.idx < 0 || e.idx >= ECS_INITIAL_CAPACITY) return -1;
     return (int)e.idx;
 }
 
 ecs_entity_t handle_from_index(int i)
 {
-    if (i < 0 || i >= ECS_MAX_ENTITIES) return ecs_null();
+    if (i < 0 || i >= ECS_INITIAL_CAPACITY) return ecs_null();
     if (!g_ecs_alive[i]) return ecs_null();
     return (ecs_entity_t){ (uint32_t)i, 1 };
 }
@@ -259,3 +275,23 @@ bool platform_take_screenshot(const char* path)
 void ecs_anim_shutdown_allocator(void) {}
 
 // Delegate actual ECS globals/hooks to the real core implementation (linked for debug builds).
+
+bool world_find_clear_spot_px(float* io_cx, float* io_cy, float hx, float hy, float max_dist_px)
+{
+    (void)io_cx;
+    (void)io_cy;
+    (void)hx;
+    (void)hy;
+    (void)max_dist_px;
+    return true;
+}
+
+int world_raycast_batch_px(const world_ray_t* rays, int count, float hx, float hy, world_ray_hit_t* out_hits)
+{
+    (void)hx;
+    (void)hy;
+    for (int i = 0; i < count; ++i) {
+        out_hits[i] = (world_ray_hit_t){ .t = 1.0f, .point = { rays[i].x1, rays[i].y1 } };
+    }
+    return 0;
+}
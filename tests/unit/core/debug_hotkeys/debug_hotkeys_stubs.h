@@ -18,7 +18,7 @@ extern int g_log_calls;
 extern bool g_engine_reload_world_result;
 extern int g_world_tiles_w;
 extern int g_world_tiles_h;
-extern bool g_ecs_alive[ECS_MAX_ENTITIES];
+extern bool g_ecs_alive[ECS_INITIAL_CAPACITY];
 extern int g_game_storage_counts[RESOURCE_TYPE_COUNT];
 extern int g_game_storage_capacity;
 
@@ -94,9 +94,7 @@ void test_debug_hotkeys_inspect_click_logs_components(void)
 {
     int idx = 1;
     g_ecs_alive[idx] = true;
-    ecs_mask[idx] = CMP_POS | CMP_COL | CMP_VEL | CMP_PHYS_BODY | CMP_SPR | CMP_ANIM |
-                    CMP_PLAYER | CMP_STORAGE |
-                    CMP_TRIGGER | CMP_BILLBOARD | CMP_LIFTABLE | CMP_DOOR;
+    ecs_mask[idx] = CMP_SET(CMP_POS, CMP_COL, CMP_VEL, CMP_PHYS_BODY, CMP_SPR, CMP_ANIM, CMP_PLAYER, CMP_STORAGE, CMP_TRIGGER, CMP_BILLBOARD, CMP_LIFTABLE, CMP_DOOR);
 
     cmp_pos[idx].x = 5.0f;
     cmp_pos[idx].y = 5.0f;
@@ -143,11 +141,13 @@ void test_debug_hotkeys_inspect_click_logs_components(void)
     cmp_liftable[idx].hold_vel_x = 0.1f;
     cmp_liftable[idx].hold_vel_y = 0.2f;
 
-    cmp_door[idx].prox_radius = 5.0f;
-    cmp_door[idx].state = DOOR_OPEN;
-    cmp_door[idx].anim_time_ms = 0.0f;
-    cmp_door[idx].intent_open = true;
-    cmp_door[idx].world_handle = 123u;
+    cmp_door_t* door = ecs_sparse_add(&cmp_door_set, idx);
+    TEST_ASSERT_NOT_NULL(door);
+    door->prox_radius = 5.0f;
+    door->state = DOOR_OPEN;
+    door->anim_time_ms = 0.0f;
+    door->intent_open = true;
+    door->world_handle = 123u;
 
     g_game_storage_counts[RESOURCE_TYPE_PLASTIC] = 2;
     g_game_storage_counts[RESOURCE_TYPE_METAL] = 0;
@@ -9,6 +9,8 @@
 #include "game/ecs/ecs_game.h"
 #include "engine/ecs/ecs_physics.h"
 #include "engine/input/input.h"
+#include "engine/nav/nav.h"
+#include "engine/core/jobs/jobs.h"
 #include "engine/core/logger/logger.h"
 #include "engine/core/platform/platform.h"
 #include "engine/renderer/renderer.h"
@@ -240,6 +242,20 @@ void world_shutdown(void)
     g_world_shutdown_calls++;
 }
 
+void nav_shutdown(void)
+{
+}
+
+bool jobs_init(int workers)
+{
+    (void)workers;
+    return true;
+}
+
+void jobs_shutdown(void)
+{
+}
+
 bool world_size_px(int* out_w, int* out_h)
 {
     if (out_w) *out_w = g_world_px_w;
@@ -0,0 +1,87 @@
+#include "unity.h"
+
+#include "engine/core/jobs/jobs.h"
+
+#include <string.h>
+
+#define JOBS_TEST_COUNT 1000
+
+typedef struct {
+    int hits[JOBS_TEST_COUNT];
+    int workers_seen[JOBS_MAX_WORKERS + 1];
+    int calls;
+} jobs_test_ctx_t;
+
+static void count_range(void* ctx, int begin, int end, int worker)
+{
+    jobs_test_ctx_t* c = ctx;
+    for (int i = begin; i < end; ++i) c->hits[i]++;
+    if (worker >= 0 && worker <= JOBS_MAX_WORKERS) c->workers_seen[worker] = 1;
+}
+
+static void count_calls(void* ctx, int begin, int end, int worker)
+{
+    (void)begin;
+    (void)end;
+    (void)worker;
+    jobs_test_ctx_t* c = ctx;
+    c->calls++;
+}
+
+static jobs_test_ctx_t g_ctx;
+
+void setUp(void)
+{
+    memset(&g_ctx, 0, sizeof(g_ctx));
+}
+
+void tearDown(void)
+{
+    jobs_shutdown();
+}
+
+void test_jobs_parallel_for_without_workers_runs_inline(void)
+{
+    TEST_ASSERT_TRUE(jobs_init(0));
+    TEST_ASSERT_EQUAL_INT(0, jobs_worker_count());
+
+    jobs_parallel_for(JOBS_TEST_COUNT, 16, count_range, &g_ctx);
+    for (int i = 0; i < JOBS_TEST_COUNT; ++i) TEST_ASSERT_EQUAL_INT(1, g_ctx.hits[i]);
+    TEST_ASSERT_EQUAL_INT(1, g_ctx.workers_seen[0]);
+    for (int w = 1; w <= JOBS_MAX_WORKERS; ++w) TEST_ASSERT_EQUAL_INT(0, g_ctx.workers_seen[w]);
+}
+
+void test_jobs_parallel_for_covers_every_item_once(void)
+{
+    TEST_ASSERT_TRUE(jobs_init(3));
+    TEST_ASSERT_EQUAL_INT(3, jobs_worker_count());
+
+    for (int round = 0; round < 20; ++round) {
+        jobs_parallel_for(JOBS_TEST_COUNT, 7, count_range, &g_ctx);
+    }
+    for (int i = 0; i < JOBS_TEST_COUNT; ++i) TEST_ASSERT_EQUAL_INT(20, g_ctx.hits[i]);
+    for (int w = 4; w <= JOBS_MAX_WORKERS; ++w) TEST_ASSERT_EQUAL_INT(0, g_ctx.workers_seen[w]);
+}
+
+void test_jobs_parallel_for_small_loop_is_one_call(void)
+{
+    TEST_ASSERT_TRUE(jobs_init(2));
+
+    jobs_parallel_for(10, 64, count_calls, &g_ctx);
+    TEST_ASSERT_EQUAL_INT(1, g_ctx.calls);
+
+    jobs_parallel_for(0, 64, count_calls, &g_ctx);
+    TEST_ASSERT_EQUAL_INT(1, g_ctx.calls);
+}
+
+void test_jobs_init_clamps_and_restarts(void)
+{
+    TEST_ASSERT_TRUE(jobs_init(JOBS_MAX_WORKERS + 10));
+    TEST_ASSERT_EQUAL_INT(JOBS_MAX_WORKERS, jobs_worker_count());
+
+    TEST_ASSERT_TRUE(jobs_init(1));
+    TEST_ASSERT_EQUAL_INT(1, jobs_worker_count());
+
+    jobs_shutdown();
+    TEST_ASSERT_EQUAL_INT(0, jobs_worker_count());
+}
@@ -1,9 +1,18 @@
 #include "game/ecs/ecs_game.h"
+#include <stdlib.h>
 #include "engine/core/logger/logger.h"
 
-ComponentMask   ecs_mask[ECS_MAX_ENTITIES];
-uint32_t        ecs_gen[ECS_MAX_ENTITIES];
-uint32_t        ecs_next_gen[ECS_MAX_ENTITIES];
+static ComponentMask ecs_mask_storage[ECS_INITIAL_CAPACITY];
+ComponentMask*   ecs_mask = ecs_mask_storage;
+static uint32_t ecs_gen_storage[ECS_INITIAL_CAPACITY];
+uint32_t*        ecs_gen = ecs_gen_storage;
+static uint32_t ecs_next_gen_storage[ECS_INITIAL_CAPACITY];
+uint32_t*        ecs_next_gen = ecs_next_gen_storage;
+
+int ecs_capacity(void) { return ECS_INITIAL_CAPACITY; }
+void* ecs_scratch_acquire(size_t elem_size) { return calloc(ECS_INITIAL_CAPACITY, elem_size); }
+void ecs_scratch_release(void* p) { free(p); }
+
 
 static ecs_entity_t g_player = {0, 0};
 
@@ -14,7 +23,7 @@ void ecs_anim_stub_set_player(ecs_entity_t e)
 
 int ent_index_checked(ecs_entity_t e)
 {
-    return (e.idx < ECS_MAX_ENTITIES && ecs_gen[e.idx] == e.gen && e.gen != 0) ? (int)e.idx : -1;
+    return (e.idx < ECS_INITIAL_CAPACITY && ecs_gen[e.idx] == e.gen && e.gen != 0) ? (int)e.idx : -1;
 }
 
 bool ecs_alive_idx(int i)
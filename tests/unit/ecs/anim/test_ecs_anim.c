@@ -13,11 +13,11 @@ void sys_anim_sprite_adapt(float dt, const input_t* in);
 
 void setUp(void)
 {
-    memset(ecs_mask, 0, sizeof(ecs_mask));
-    memset(ecs_gen, 0, sizeof(ecs_gen));
-    memset(cmp_anim, 0, sizeof(cmp_anim));
-    memset(cmp_vel, 0, sizeof(cmp_vel));
-    memset(cmp_spr, 0, sizeof(cmp_spr));
+    memset(ecs_mask, 0, sizeof(ecs_mask[0]) * ECS_INITIAL_CAPACITY);
+    memset(ecs_gen, 0, sizeof(ecs_gen[0]) * ECS_INITIAL_CAPACITY);
+    memset(cmp_anim, 0, sizeof(cmp_anim[0]) * ECS_INITIAL_CAPACITY);
+    memset(cmp_vel, 0, sizeof(cmp_vel[0]) * ECS_INITIAL_CAPACITY);
+    memset(cmp_spr, 0, sizeof(cmp_spr[0]) * ECS_INITIAL_CAPACITY);
     ecs_anim_reset_allocator();
 }
 
@@ -40,7 +40,7 @@ void test_cmp_add_anim_sets_fields_and_mask(void)
 
     cmp_add_anim(e, 16, 8, 1, frames_per_anim, frames, frame_buffer_width, 4.0f);
 
-    TEST_ASSERT_TRUE(ecs_mask[0] & CMP_ANIM);
+    TEST_ASSERT_TRUEcomponent_mask_any(ecs_mask[0], CMP_ANIM);
     TEST_ASSERT_EQUAL_INT(16, cmp_anim[0].frame_w);
     TEST_ASSERT_EQUAL_INT(8, cmp_anim[0].frame_h);
     TEST_ASSERT_EQUAL_INT(1, cmp_anim[0].anim_count);
@@ -79,7 +79,7 @@ void test_sys_anim_controller_sets_idle_and_walk_anim(void)
 
     const int frame_buffer_width = 1;
     cmp_add_anim(player, 16, 16, MAX_ANIMS, frames_per_anim, frames, frame_buffer_width, 4.0f);
-    ecs_mask[0] |= CMP_VEL;
+    ecs_mask[0] = component_mask_or(ecs_mask[0], CMP_VEL);
     cmp_vel[0].facing.facingDir = DIR_EAST;
     cmp_vel[0].x = 0.0f;
     cmp_vel[0].y = 0.0f;
@@ -105,7 +105,7 @@ void test_sys_anim_controller_ignores_invalid_facing(void)
     };
 
     cmp_add_anim(player, 8, 8, 1, frames_per_anim, frames, frame_buffer_width, 4.0f);
-    ecs_mask[0] |= CMP_VEL;
+    ecs_mask[0] = component_mask_or(ecs_mask[0], CMP_VEL);
     cmp_vel[0].facing.facingDir = (facing_t)30;
     cmp_anim[0].current_anim = 0;
 
@@ -127,7 +127,7 @@ void test_sys_anim_sprite_advances_frame_and_updates_sprite(void)
 
     cmp_add_anim(e, 8, 8, 1, frames_per_anim, frames, frame_buffer_width, 1.0f);
     cmp_spr[0].src = rectf_xywh(0.0f, 0.0f, 8.0f, 8.0f);
-    ecs_mask[0] |= CMP_SPR;
+    ecs_mask[0] = component_mask_or(ecs_mask[0], CMP_SPR);
 
     sys_anim_sprite_adapt(1.1f, NULL);
     TEST_ASSERT_FLOAT_WITHIN(0.001f, 16.0f, cmp_spr[0].src.x);
@@ -173,7 +173,7 @@ void test_sys_anim_sprite_ignores_invalid_anim_index(void)
     cmp_anim[0].frame_index = 0;
     cmp_anim[0].current_time = 0.0f;
     cmp_spr[0].src = rectf_xywh(5.0f, 6.0f, 8.0f, 8.0f);
-    ecs_mask[0] |= CMP_SPR;
+    ecs_mask[0] = component_mask_or(ecs_mask[0], CMP_SPR);
 
     sys_anim_sprite_adapt(1.0f, NULL);
     TEST_ASSERT_FLOAT_WITHIN(0.001f, 5.0f, cmp_spr[0].src.x);
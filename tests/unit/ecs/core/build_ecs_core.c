@@ -118,6 +118,11 @@ int main(int argc, char **argv)
     Nob_File_Paths sources = {0};
     nob_da_append(&sources, "third_party/Unity/src/unity.c");
     nob_da_append(&sources, "src/engine/ecs/ecs_core.c");
+    nob_da_append(&sources, "src/engine/ecs/ecs_query.c");
+    nob_da_append(&sources, "src/engine/ecs/ecs_change.c");
+    nob_da_append(&sources, "src/engine/utils/byte_buf.c");
+    nob_da_append(&sources, "src/engine/ecs/ecs_event.c");
+    nob_da_append(&sources, "src/engine/ecs/ecs_cmd.c");
     nob_da_append(&sources, "src/engine/ecs/ecs_engine.c");
     nob_da_append(&sources, "src/engine/ecs/ecs_render_components.c");
     nob_da_append(&sources, "src/engine/ecs/ecs_iterators.c");
@@ -140,9 +145,12 @@ int main(int argc, char **argv)
     nob_da_append(&sources, "src/game/ecs/systems/ecs_unloader.c");
     nob_da_append(&sources, "src/game/ecs/systems/ecs_recycler.c");
     nob_da_append(&sources, "src/engine/ecs/ecs_proximity.c");
+    nob_da_append(&sources, "src/engine/ecs/ecs_compact.c");
+    nob_da_append(&sources, "src/engine/engine/engine_snapshot/engine_snapshot.c");
     nob_da_append(&sources, "src/engine/ecs/ecs_billboards.c");
     nob_da_append(&sources, "src/game/ecs/ecs_billboards_filter.c");
     nob_da_append(&sources, "src/game/ecs/systems/ecs_gravity_gun.c");
+    nob_da_append(&sources, "src/engine/spatial/spatial.c");
     nob_da_append(&sources, "src/game/ecs/components/ecs_component_doors.c");
     nob_da_append(&sources, "src/game/ecs/systems/ecs_door_systems.c");
     nob_da_append(&sources, "src/game/ecs/systems/ecs_conveyor.c");
@@ -11,6 +11,7 @@
 #include "game/ecs/game_register_systems.h"
 #include "engine/core/logger/logger.h"
 #include "engine/world/world.h"
+#include "engine/world/world_map.h"
 
 int g_asset_acquire_calls = 0;
 int g_asset_release_calls = 0;
@@ -153,6 +154,7 @@ void engine_register_systems(void)
     engine_scheduler_register(PHASE_SIM_POST, 100, NULL, "proximity_view");
     engine_scheduler_register(PHASE_SIM_POST, 200, NULL, "billboards");
     engine_scheduler_register(PHASE_SIM_POST, 300, NULL, "world_apply_edits");
+    engine_scheduler_register(PHASE_SIM_POST, 400, NULL, "entity_compact");
     engine_scheduler_register(PHASE_PRE_RENDER, 100, NULL, "toast_update");
     engine_scheduler_register(PHASE_PRE_RENDER, 200, NULL, "camera_tick");
     engine_scheduler_register(PHASE_PRE_RENDER, 300, NULL, "sprite_anim");
@@ -266,6 +268,16 @@ bool world_resolve_rect_mtv_px(float* io_cx, float* io_cy, float hx, float hy)
     return false;
 }
 
+int world_resolve_rects_mtv_px(float* cx, float* cy, const float* hx, const float* hy, int count, bool* out_moved)
+{
+    int moved = 0;
+    for (int i = 0; i < count; ++i) {
+        out_moved[i] = world_resolve_rect_mtv_px(&cx[i], &cy[i], hx[i], hy[i]);
+        if (out_moved[i]) moved++;
+    }
+    return moved;
+}
+
 int world_subtile_size(void)
 {
     return 16;
@@ -289,6 +301,24 @@ bool world_resolve_rect_axis_px(float* io_cx, float* io_cy, float hx, float hy,
     return false;
 }
 
+bool world_sweep_rect_px(float cx, float cy, float hx, float hy, float dx, float dy, float* out_t, gfx_vec2* out_normal)
+{
+    (void)cx; (void)cy; (void)hx; (void)hy; (void)dx; (void)dy;
+    if (out_t) *out_t = 1.0f;
+    if (out_normal) *out_normal = (gfx_vec2){ 0.0f, 0.0f };
+    return false;
+}
+
+void world_sweep_rects_axis_px(const float* cx, const float* cy, const float* hx, const float* hy,
+                               const float* d, int count, bool axis_x, float* out_t)
+{
+    for (int i = 0; i < count; ++i) {
+        out_t[i] = 1.0f;
+        if (d[i] == 0.0f) continue;
+        world_sweep_rect_px(cx[i], cy[i], hx[i], hy[i], axis_x ? d[i] : 0.0f, axis_x ? 0.0f : d[i], &out_t[i], NULL);
+    }
+}
+
 const world_map_t* world_get_map(void)
 {
     return NULL;
@@ -299,6 +329,23 @@ void world_apply_tile_edits(void)
     g_world_apply_edits_calls++;
 }
 
+// No map is loaded in these tests, so the world section is just its
+// "no map" flag.
+bool world_snapshot_save(byte_buf_t* out)
+{
+    return byte_buf_write_u32(out, 0u);
+}
+
+bool world_snapshot_check(byte_reader_t* in)
+{
+    return byte_reader_u32(in) == 0u && in->ok;
+}
+
+bool world_snapshot_load(byte_reader_t* in)
+{
+    return world_snapshot_check(in);
+}
+
 world_door_handle_t world_door_register(const door_tile_xy_t* tile_xy, size_t tile_count)
 {
     g_world_door_register_calls++;
@@ -338,3 +385,23 @@ void ui_toast_update(float dt)
 {
     (void)dt;
 }
+
+bool world_find_clear_spot_px(float* io_cx, float* io_cy, float hx, float hy, float max_dist_px)
+{
+    (void)io_cx;
+    (void)io_cy;
+    (void)hx;
+    (void)hy;
+    (void)max_dist_px;
+    return true;
+}
+
+int world_raycast_batch_px(const world_ray_t* rays, int count, float hx, float hy, world_ray_hit_t* out_hits)
+{
+    (void)hx;
+    (void)hy;
+    for (int i = 0; i < count; ++i) {
+        out_hits[i] = (world_ray_hit_t){ .t = 1.0f, .point = { rays[i].x1, rays[i].y1 } };
+    }
+    return 0;
+}
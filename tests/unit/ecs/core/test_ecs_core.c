@@ -7,6 +7,9 @@
 #include "engine/input/input.h"
 #include "engine/engine/engine_scheduler/engine_register_systems.h"
 #include "game/ecs/game_register_systems.h"
+#include "engine/engine/engine_snapshot/engine_snapshot.h"
+
+#include <string.h>
 
 void setUp(void)
 {
@@ -36,12 +39,310 @@ void test_ecs_create_destroy_reuses_slot_and_gen(void)
     TEST_ASSERT_TRUE(e2.gen != e1.gen);
 }
 
+void test_ecs_create_grows_past_initial_capacity(void)
+{
+    const int initial = ecs_capacity();
+    TEST_ASSERT_EQUAL_INT(ECS_INITIAL_CAPACITY, initial);
+
+    ecs_entity_t first = ecs_create();
+    for (int i = 1; i < initial; ++i) {
+        TEST_ASSERT_TRUE(ecs_alive_handle(ecs_create()));
+    }
+    ecs_entity_t grown = ecs_create();
+    TEST_ASSERT_TRUE(ecs_alive_handle(grown));
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)initial, grown.idx);
+    TEST_ASSERT_EQUAL_INT(initial + ECS_CHUNK_ENTITIES, ecs_capacity());
+    TEST_ASSERT_TRUE(ecs_alive_handle(first));
+
+    ecs_destroy(first);
+    TEST_ASSERT_EQUAL_UINT32(first.idx, ecs_create().idx);
+}
+
+void test_ecs_query_tracks_mask_changes_in_index_order(void)
+{
+    ecs_entity_t a = ecs_create();
+    ecs_entity_t b = ecs_create();
+    ecs_entity_t c = ecs_create();
+    ecs_mask_add((int)c.idx, CMP_SET(CMP_POS, CMP_COL));
+    ecs_mask_add((int)a.idx, CMP_SET(CMP_POS, CMP_COL));
+    ecs_mask_add((int)b.idx, CMP_POS);
+
+    ecs_query_t* q = ecs_query_get(CMP_SET(CMP_POS, CMP_COL), CMP_NONE);
+    TEST_ASSERT_NOT_NULL(q);
+    TEST_ASSERT_EQUAL_INT(2, (int)q->match.size);
+    TEST_ASSERT_EQUAL_INT((int)a.idx, q->match.data[0]);
+    TEST_ASSERT_EQUAL_INT((int)c.idx, q->match.data[1]);
+    TEST_ASSERT_EQUAL_PTR(q, ecs_query_get(CMP_SET(CMP_POS, CMP_COL), CMP_NONE));
+
+    ecs_mask_add((int)b.idx, CMP_COL);
+    TEST_ASSERT_EQUAL_INT(3, (int)q->match.size);
+    TEST_ASSERT_EQUAL_INT((int)b.idx, q->match.data[1]);
+
+    ecs_query_t* no_col = ecs_query_get(CMP_POS, CMP_COL);
+    TEST_ASSERT_EQUAL_INT(0, (int)no_col->match.size);
+    ecs_mask_remove((int)a.idx, CMP_COL);
+    TEST_ASSERT_EQUAL_INT(2, (int)q->match.size);
+    TEST_ASSERT_EQUAL_INT(1, (int)no_col->match.size);
+
+    ecs_destroy(b);
+    TEST_ASSERT_EQUAL_INT(1, (int)q->match.size);
+    TEST_ASSERT_EQUAL_INT((int)c.idx, q->match.data[0]);
+}
+
+void test_component_mask_helpers_cover_every_word(void)
+{
+    const int last = ENUM_COMPONENT_COUNT - 1;
+    ComponentMask m = component_mask_or(CMP_POS, component_mask_bit(last));
+    TEST_ASSERT_TRUE(component_mask_has(m, last));
+    TEST_ASSERT_TRUE(component_mask_all(m, CMP_POS));
+    TEST_ASSERT_FALSE(component_mask_all(CMP_POS, m));
+    TEST_ASSERT_TRUE(component_mask_any(CMP_POS, m));
+    TEST_ASSERT_TRUE(component_mask_eq(component_mask_andnot(m, CMP_POS), component_mask_bit(last)));
+    TEST_ASSERT_TRUE(component_mask_empty(component_mask_xor(m, m)));
+
+    ComponentMask walk = m;
+    TEST_ASSERT_EQUAL_INT(ENUM_POS, component_mask_pop_lowest(&walk));
+    TEST_ASSERT_EQUAL_INT(last, component_mask_pop_lowest(&walk));
+    TEST_ASSERT_EQUAL_INT(-1, component_mask_pop_lowest(&walk));
+
+    char hex[COMPONENT_MASK_HEX_LEN];
+    TEST_ASSERT_EQUAL_size_t(COMPONENT_MASK_WORDS * 16, strlen(component_mask_to_hex(m, hex)));
+}
+
+void test_ecs_sparse_set_swap_removes_and_follows_mask(void)
+{
+    static ecs_sparse_t set;
+    ecs_register_sparse(&set, ENUM_DOOR, sizeof(int));
+
+    ecs_entity_t a = ecs_create();
+    ecs_entity_t b = ecs_create();
+    *(int*)ecs_sparse_add(&set, (int)a.idx) = 11;
+    *(int*)ecs_sparse_add(&set, (int)b.idx) = 22;
+    ecs_mask_add((int)a.idx, CMP_DOOR);
+    ecs_mask_add((int)b.idx, CMP_DOOR);
+    TEST_ASSERT_EQUAL_INT(2, set.count);
+
+    ecs_mask_remove((int)a.idx, CMP_DOOR);
+    TEST_ASSERT_NULL(ecs_sparse_get(&set, (int)a.idx));
+    TEST_ASSERT_EQUAL_INT(1, set.count);
+    TEST_ASSERT_EQUAL_INT(22, *(int*)ecs_sparse_get(&set, (int)b.idx));
+
+    ecs_destroy(b);
+    TEST_ASSERT_EQUAL_INT(0, set.count);
+}
+
+static void cmd_spawn_with_pos(ecs_entity_t e, void* user)
+{
+    ecs_mask_add((int)e.idx, CMP_POS);
+    *(ecs_entity_t*)user = e;
+}
+
+void test_ecs_cmd_buffers_defer_until_flush_in_worker_order(void)
+{
+    ecs_entity_t a = ecs_create();
+    ecs_entity_t b = ecs_create();
+    ecs_mask_add((int)a.idx, CMP_POS);
+
+    ecs_cmd_remove(ecs_cmd_for_worker(1), a, CMP_POS);
+    ecs_cmd_add(ecs_cmd_current(), a, CMP_COL);
+    ecs_cmd_destroy(ecs_cmd_current(), b);
+    ecs_cmd_destroy(ecs_cmd_for_worker(1), b);
+    ecs_entity_t spawned = ecs_null();
+    ecs_cmd_create(ecs_cmd_current(), cmd_spawn_with_pos, &spawned);
+
+    TEST_ASSERT_TRUE(ecs_cmd_pending());
+    TEST_ASSERT_TRUE(component_mask_eq(CMP_POS, ecs_mask[a.idx]));
+    TEST_ASSERT_TRUE(ecs_alive_handle(b));
+
+    ecs_cmd_flush();
+    TEST_ASSERT_FALSE(ecs_cmd_pending());
+    TEST_ASSERT_TRUE(component_mask_eq(CMP_COL, ecs_mask[a.idx]));
+    TEST_ASSERT_FALSE(ecs_alive_handle(b));
+    TEST_ASSERT_TRUE(ecs_alive_handle(spawned));
+    TEST_ASSERT_TRUE(component_mask_eq(CMP_POS, ecs_mask[spawned.idx]));
+
+    // Every worker id the jobs pool hands out owns a buffer.
+    TEST_ASSERT_NOT_NULL(ecs_cmd_for_worker(JOBS_MAX_WORKERS));
+}
+
+void test_ecs_changed_since_yields_each_written_entity_once(void)
+{
+    TEST_ASSERT_TRUE(ecs_change_tracked(ENUM_POS));
+    ecs_entity_t a = ecs_create();
+    ecs_entity_t b = ecs_create();
+    cmp_add_position(a, 1.0f, 1.0f);
+    cmp_add_position(b, 2.0f, 2.0f);
+    ecs_change_advance();
+    ecs_version_t seen = ecs_change_version();
+
+    ecs_change_advance();
+    ecs_mark_changed((int)b.idx, CMP_POS);
+    ecs_change_advance();
+    ecs_mark_changed((int)b.idx, CMP_POS);
+    ecs_mark_changed((int)b.idx, CMP_POS);
+
+    int count = 0;
+    ECS_CHANGED_EACH(ENUM_POS, seen, i) {
+        TEST_ASSERT_EQUAL_INT((int)b.idx, i);
+        count++;
+    }
+    TEST_ASSERT_EQUAL_INT(1, count);
+    TEST_ASSERT_EQUAL_UINT32(ecs_change_version(), ecs_changed_version((int)b.idx, ENUM_POS));
+
+    ecs_destroy(b);
+    count = 0;
+    ECS_CHANGED_EACH(ENUM_POS, 0, i) {
+        TEST_ASSERT_EQUAL_INT((int)a.idx, i);
+        count++;
+    }
+    TEST_ASSERT_EQUAL_INT(1, count);
+}
+
+typedef struct { int value; } test_ev_t;
+static ecs_event_queue_t g_test_ev = ECS_EVENT_QUEUE(test_ev_t, PHASE_PHYSICS);
+
+void test_ecs_event_queue_shows_previous_window_after_swap(void)
+{
+    ecs_event_register(&g_test_ev);
+    ECS_EVENT_EMIT(g_test_ev, test_ev_t, .value = 1);
+    ECS_EVENT_EMIT(g_test_ev, test_ev_t, .value = 2);
+    TEST_ASSERT_EQUAL_size_t(0, ecs_event_count(&g_test_ev));
+
+    // Only the queue's own phase swaps it.
+    ecs_event_swap_phase(PHASE_INPUT);
+    TEST_ASSERT_EQUAL_size_t(0, ecs_event_count(&g_test_ev));
+    ecs_event_swap_phase(PHASE_PHYSICS);
+    TEST_ASSERT_EQUAL_size_t(2, ecs_event_count(&g_test_ev));
+
+    ECS_EVENT_EMIT(g_test_ev, test_ev_t, .value = 3);
+    int sum = 0;
+    ECS_EVENT_EACH(g_test_ev, test_ev_t, ev) sum += ev->value;
+    TEST_ASSERT_EQUAL_INT(3, sum);
+
+    byte_buf_t blob = {0};
+    TEST_ASSERT_TRUE(ecs_event_snapshot_save(&blob));
+    ecs_event_swap_phase(PHASE_PHYSICS);
+    ecs_event_swap_phase(PHASE_PHYSICS);
+    TEST_ASSERT_EQUAL_size_t(0, ecs_event_count(&g_test_ev));
+
+    byte_reader_t in = byte_reader_make(blob.data, blob.size);
+    TEST_ASSERT_TRUE(ecs_event_snapshot_load(&in));
+    TEST_ASSERT_EQUAL_size_t(2, ecs_event_count(&g_test_ev));
+    ecs_event_swap_phase(PHASE_PHYSICS);
+    TEST_ASSERT_EQUAL_size_t(1, ecs_event_count(&g_test_ev));
+    TEST_ASSERT_EQUAL_INT(3, ((const test_ev_t*)ecs_event_data(&g_test_ev, sizeof(test_ev_t)))->value);
+    byte_buf_free(&blob);
+}
+
+void test_ecs_snapshot_round_trip_restores_entities_and_sparse_sets(void)
+{
+    ecs_entity_t a = ecs_create();
+    ecs_entity_t b = ecs_create();
+    cmp_add_position(a, 1.0f, 2.0f);
+    cmp_add_position(b, 3.0f, 4.0f);
+    cmp_add_gun_charger(b);
+
+    byte_buf_t blob = {0};
+    TEST_ASSERT_TRUE(ecs_snapshot_save(&blob));
+
+    ecs_destroy(a);
+    ecs_entity_t c = ecs_create();
+    cmp_add_position(c, 9.0f, 9.0f);
+    ecs_mask_remove((int)b.idx, CMP_GUN_CHARGER);
+    cmp_pos[b.idx].x = 42.0f;
+
+    byte_reader_t in = byte_reader_make(blob.data, blob.size);
+    TEST_ASSERT_TRUE(ecs_snapshot_load(&in));
+    TEST_ASSERT_EQUAL_size_t(0, byte_reader_remaining(&in));
+
+    TEST_ASSERT_TRUE(ecs_alive_handle(a));
+    TEST_ASSERT_TRUE(ecs_alive_handle(b));
+    TEST_ASSERT_FALSE(ecs_alive_handle(c));
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, cmp_pos[a.idx].x);
+    TEST_ASSERT_EQUAL_FLOAT(3.0f, cmp_pos[b.idx].x);
+    TEST_ASSERT_NOT_NULL(cmp_gun_charger_get((int)b.idx));
+
+    ecs_query_t* q = ecs_query_get(CMP_POS, CMP_NONE);
+    TEST_ASSERT_EQUAL_INT(2, (int)q->match.size);
+
+    // Restored handles keep their generations, so new entities don't alias them.
+    ecs_entity_t d = ecs_create();
+    TEST_ASSERT_TRUE(d.idx != a.idx && d.idx != b.idx);
+
+    // A truncated blob is rejected before anything is touched.
+    byte_reader_t cut = byte_reader_make(blob.data, blob.size / 2);
+    TEST_ASSERT_FALSE(ecs_snapshot_load(&cut));
+    TEST_ASSERT_TRUE(ecs_alive_handle(d));
+    byte_buf_free(&blob);
+}
+
+void test_engine_snapshot_rejected_world_section_leaves_ecs_untouched(void)
+{
+    ecs_entity_t a = ecs_create();
+    cmp_add_position(a, 1.0f, 2.0f);
+
+    byte_buf_t blob = {0};
+    TEST_ASSERT_TRUE(engine_snapshot_save(&blob));
+
+    cmp_pos[a.idx].x = 42.0f;
+    ecs_entity_t b = ecs_create();
+
+    // The world section is last; claiming a map that isn't loaded makes it
+    // fail validation after the ECS section has already passed.
+    byte_buf_t bad = {0};
+    TEST_ASSERT_TRUE(byte_buf_write(&bad, blob.data, blob.size));
+    const uint32_t has_map = 1u;
+    memcpy(bad.data + bad.size - sizeof(has_map), &has_map, sizeof(has_map));
+    TEST_ASSERT_FALSE(engine_snapshot_load(bad.data, bad.size));
+    TEST_ASSERT_EQUAL_FLOAT(42.0f, cmp_pos[a.idx].x);
+    TEST_ASSERT_TRUE(ecs_alive_handle(b));
+
+    TEST_ASSERT_TRUE(engine_snapshot_load(blob.data, blob.size));
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, cmp_pos[a.idx].x);
+    TEST_ASSERT_FALSE(ecs_alive_handle(b));
+    byte_buf_free(&bad);
+    byte_buf_free(&blob);
+}
+
+void test_ecs_compact_renumbers_entities_and_keeps_handles_valid(void)
+{
+    ecs_entity_t a = ecs_create();
+    ecs_entity_t b = ecs_create();
+    ecs_entity_t c = ecs_create();
+    cmp_add_position(a, 1.0f, 0.0f);
+    cmp_add_position(c, 3.0f, 0.0f);
+    cmp_add_gun_charger(c);
+    ecs_destroy(b);
+
+    int order[] = { (int)c.idx, (int)a.idx };
+    TEST_ASSERT_TRUE(ecs_compact(order, 2));
+
+    TEST_ASSERT_EQUAL_INT(0, ent_index_checked(c));
+    TEST_ASSERT_EQUAL_INT(1, ent_index_checked(a));
+    TEST_ASSERT_FALSE(ecs_alive_handle(b));
+    TEST_ASSERT_EQUAL_FLOAT(3.0f, cmp_pos[0].x);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, cmp_pos[1].x);
+    TEST_ASSERT_NOT_NULL(cmp_gun_charger_get(0));
+    TEST_ASSERT_NULL(cmp_gun_charger_get(2));
+
+    ecs_entity_t c_now = ecs_remap_handle(c);
+    TEST_ASSERT_EQUAL_UINT32(0u, c_now.idx);
+    TEST_ASSERT_TRUE(c_now.gen != c.gen);
+
+    // The freed slot hands out a generation no stale handle can match.
+    ecs_entity_t d = ecs_create();
+    TEST_ASSERT_EQUAL_UINT32(2u, d.idx);
+    TEST_ASSERT_TRUE(d.gen != c.gen);
+    ecs_destroy(c);
+    TEST_ASSERT_FALSE(ecs_alive_handle(c_now));
+}
+
 void test_ecs_init_registers_systems_and_tick_runs_phases(void)
 {
 #if DEBUG_BUILD
-    const int expected_registers = 33;
+    const int expected_registers = 34;
 #else
-    const int expected_registers = 32;
+    const int expected_registers = 33;
 #endif
     TEST_ASSERT_EQUAL_INT(expected_registers, g_ecs_register_system_calls);
 
@@ -97,7 +398,7 @@ void test_cmp_add_billboard_warns_without_trigger(void)
 
     int idx = ent_index_checked(e);
     TEST_ASSERT_TRUE(idx >= 0);
-    TEST_ASSERT_TRUE(ecs_mask[idx] & CMP_BILLBOARD);
+    TEST_ASSERT_TRUEcomponent_mask_any(ecs_mask[idx], CMP_BILLBOARD);
     TEST_ASSERT_EQUAL_INT(1, g_log_warn_calls);
 }
 
@@ -163,6 +464,31 @@ void test_ecs_mark_cleanup_and_destroy_pipeline(void)
     TEST_ASSERT_EQUAL_INT(1, g_asset_release_calls);
 }
 
+void test_ecs_destroy_marked_handles_stale_and_reused_entries(void)
+{
+    ecs_entity_t e[4];
+    for (int i = 0; i < 4; ++i) e[i] = ecs_create();
+
+    ecs_mark_destroy(e[3]);
+    ecs_mark_destroy(e[1]);
+    ecs_mark_destroy(e[2]);
+    ecs_destroy(e[1]);                 // destroyed directly while pending
+    ecs_entity_t reused = ecs_create();
+    TEST_ASSERT_EQUAL_UINT32(e[1].idx, reused.idx);
+    ecs_mark_destroy(reused);          // same slot pending twice
+
+    ecs_destroy_marked();
+    TEST_ASSERT_TRUE(ecs_alive_handle(e[0]));
+    TEST_ASSERT_FALSE(ecs_alive_handle(reused));
+    TEST_ASSERT_FALSE(ecs_alive_handle(e[2]));
+    TEST_ASSERT_FALSE(ecs_alive_handle(e[3]));
+
+    // Freed in ascending index order like the old full scan: last freed pops first.
+    TEST_ASSERT_EQUAL_UINT32(e[3].idx, ecs_create().idx);
+    TEST_ASSERT_EQUAL_UINT32(e[2].idx, ecs_create().idx);
+    TEST_ASSERT_EQUAL_UINT32(e[1].idx, ecs_create().idx);
+}
+
 void test_cmp_add_phys_body_creates_when_requirements_met(void)
 {
     ecs_entity_t e = ecs_create();
@@ -172,7 +498,7 @@ void test_cmp_add_phys_body_creates_when_requirements_met(void)
 
     int idx = ent_index_checked(e);
     TEST_ASSERT_TRUE(idx >= 0);
-    TEST_ASSERT_TRUE((ecs_mask[idx] & (CMP_POS | CMP_COL | CMP_PHYS_BODY)) == (CMP_POS | CMP_COL | CMP_PHYS_BODY));
+    TEST_ASSERT_TRUE(component_mask_all(ecs_mask[idx], CMP_SET(CMP_POS, CMP_COL, CMP_PHYS_BODY)));
     TEST_ASSERT_TRUE(cmp_phys_body[idx].created);
     TEST_ASSERT_EQUAL_INT(1, g_phys_create_calls);
 }
@@ -226,9 +552,9 @@ void test_cmp_add_trigger_and_phys_body(void)
 
     int idx = ent_index_checked(e);
     TEST_ASSERT_TRUE(idx >= 0);
-    TEST_ASSERT_TRUE(ecs_mask[idx] & CMP_TRIGGER);
+    TEST_ASSERT_TRUEcomponent_mask_any(ecs_mask[idx], CMP_TRIGGER);
     TEST_ASSERT_FLOAT_WITHIN(0.001f, 2.5f, cmp_trigger[idx].pad);
-    TEST_ASSERT_EQUAL_UINT64(CMP_PLAYER, cmp_trigger[idx].target_mask);
+    TEST_ASSERT_TRUE(component_mask_eq(CMP_PLAYER, cmp_trigger[idx].target_mask));
 
     cmp_add_position(e, 1.0f, 1.0f);
     cmp_add_size(e, 2.0f, 3.0f);
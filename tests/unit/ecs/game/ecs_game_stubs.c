@@ -1,4 +1,5 @@
 #include "ecs_game_stubs.h"
+#include <stdlib.h>
 #include "engine/world/world_door_handle.h"
 
 #include <stdarg.h>
@@ -18,15 +19,29 @@
 void sys_storage_deposit_adapt(float dt, const input_t* in);
 void sys_doors_tick_adapt(float dt, const input_t* in);
 
-ComponentMask   ecs_mask[ECS_MAX_ENTITIES];
-uint32_t        ecs_gen[ECS_MAX_ENTITIES];
-uint32_t        ecs_next_gen[ECS_MAX_ENTITIES];
-cmp_position_t  cmp_pos[ECS_MAX_ENTITIES];
-cmp_velocity_t  cmp_vel[ECS_MAX_ENTITIES];
-cmp_anim_t      cmp_anim[ECS_MAX_ENTITIES];
-cmp_sprite_t    cmp_spr[ECS_MAX_ENTITIES];
-cmp_collider_t  cmp_col[ECS_MAX_ENTITIES];
-cmp_phys_body_t cmp_phys_body[ECS_MAX_ENTITIES];
+static ComponentMask ecs_mask_storage[ECS_INITIAL_CAPACITY];
+ComponentMask*   ecs_mask = ecs_mask_storage;
+static uint32_t ecs_gen_storage[ECS_INITIAL_CAPACITY];
+uint32_t*        ecs_gen = ecs_gen_storage;
+static uint32_t ecs_next_gen_storage[ECS_INITIAL_CAPACITY];
+uint32_t*        ecs_next_gen = ecs_next_gen_storage;
+
+int ecs_capacity(void) { return ECS_INITIAL_CAPACITY; }
+void* ecs_scratch_acquire(size_t elem_size) { return calloc(ECS_INITIAL_CAPACITY, elem_size); }
+void ecs_scratch_release(void* p) { free(p); }
+
+static cmp_position_t cmp_pos_storage[ECS_INITIAL_CAPACITY];
+cmp_position_t*  cmp_pos = cmp_pos_storage;
+static cmp_velocity_t cmp_vel_storage[ECS_INITIAL_CAPACITY];
+cmp_velocity_t*  cmp_vel = cmp_vel_storage;
+static cmp_anim_t cmp_anim_storage[ECS_INITIAL_CAPACITY];
+cmp_anim_t*      cmp_anim = cmp_anim_storage;
+static cmp_sprite_t cmp_spr_storage[ECS_INITIAL_CAPACITY];
+cmp_sprite_t*    cmp_spr = cmp_spr_storage;
+static cmp_collider_t cmp_col_storage[ECS_INITIAL_CAPACITY];
+cmp_collider_t*  cmp_col = cmp_col_storage;
+static cmp_phys_body_t cmp_phys_body_storage[ECS_INITIAL_CAPACITY];
+cmp_phys_body_t* cmp_phys_body = cmp_phys_body_storage;
 
 static ecs_entity_t g_player = {0, 0};
 const world_map_t* g_world_tiled_map = NULL;
@@ -50,10 +65,11 @@ static size_t g_prox_stay_count = 0;
 
 void ecs_game_stub_reset(void)
 {
-    memset(ecs_mask, 0, sizeof(ecs_mask));
-    memset(ecs_gen, 0, sizeof(ecs_gen));
-    memset(cmp_pos, 0, sizeof(cmp_pos));
-    memset(cmp_col, 0, sizeof(cmp_col));
+    memset(ecs_mask, 0, sizeof(ecs_mask[0]) * ECS_INITIAL_CAPACITY);
+    memset(ecs_gen, 0, sizeof(ecs_gen[0]) * ECS_INITIAL_CAPACITY);
+    memset(cmp_pos, 0, sizeof(cmp_pos[0]) * ECS_INITIAL_CAPACITY);
+    memset(cmp_col, 0, sizeof(cmp_col[0]) * ECS_INITIAL_CAPACITY);
+    ecs_register_sparse(&cmp_door_set, ENUM_DOOR, sizeof(cmp_door_t));
     g_player = (ecs_entity_t){0, 0};
     g_world_tiled_map = NULL;
     g_pf_spawn_calls = 0;
@@ -102,7 +118,7 @@ bool ecs_alive_idx(int i)
 
 int ent_index_checked(ecs_entity_t e)
 {
-    return (e.idx < ECS_MAX_ENTITIES && ecs_gen[e.idx] == e.gen && e.gen != 0) ? (int)e.idx : -1;
+    return (e.idx < ECS_INITIAL_CAPACITY && ecs_gen[e.idx] == e.gen && e.gen != 0) ? (int)e.idx : -1;
 }
 
 ecs_entity_t find_player_handle(void)
@@ -117,7 +133,7 @@ ecs_entity_t ecs_find_player(void)
 
 ecs_entity_t handle_from_index(int i)
 {
-    if (i < 0 || i >= ECS_MAX_ENTITIES) return ecs_null();
+    if (i < 0 || i >= ECS_INITIAL_CAPACITY) return ecs_null();
     if (ecs_gen[i] == 0) return ecs_null();
     return (ecs_entity_t){ (uint32_t)i, ecs_gen[i] };
 }
@@ -133,16 +149,17 @@ void ecs_destroy(ecs_entity_t e)
     int idx = ent_index_checked(e);
     if (idx < 0) return;
     ecs_gen[idx] = 0;
-    ecs_mask[idx] = 0;
+    ecs_mask[idx] = CMP_NONE;
 }
 
 void ecs_phys_body_destroy_for_entity(int idx)
 {
-    if (idx < 0 || idx >= ECS_MAX_ENTITIES) return;
+    if (idx < 0 || idx >= ECS_INITIAL_CAPACITY) return;
     cmp_phys_body[idx].created = false;
 }
 
 ecs_prox_iter_t ecs_prox_enter_begin(void) { return (ecs_prox_iter_t){ .i = 0 }; }
+ecs_prox_iter_t ecs_prox_enter_begin_for(ComponentMask owner_mask) { (void)owner_mask; return ecs_prox_enter_begin(); }
 
 bool ecs_prox_enter_next(ecs_prox_iter_t* it, ecs_prox_view_t* out)
 {
@@ -153,6 +170,7 @@ bool ecs_prox_enter_next(ecs_prox_iter_t* it, ecs_prox_view_t* out)
 }
 
 ecs_prox_iter_t ecs_prox_stay_begin(void) { return (ecs_prox_iter_t){ .i = 0 }; }
+ecs_prox_iter_t ecs_prox_stay_begin_for(ComponentMask owner_mask) { (void)owner_mask; return ecs_prox_stay_begin(); }
 
 bool ecs_prox_stay_next(ecs_prox_iter_t* it, ecs_prox_view_t* out)
 {
@@ -235,3 +253,23 @@ void game_register_systems(void)
     engine_scheduler_register(PHASE_SIM_POST, 120, sys_storage_deposit_adapt, "storage_deposit");
     engine_scheduler_register(PHASE_SIM_POST, 295, sys_doors_tick_adapt, "doors_tick");
 }
+
+bool world_find_clear_spot_px(float* io_cx, float* io_cy, float hx, float hy, float max_dist_px)
+{
+    (void)io_cx;
+    (void)io_cy;
+    (void)hx;
+    (void)hy;
+    (void)max_dist_px;
+    return true;
+}
+
+int world_raycast_batch_px(const world_ray_t* rays, int count, float hx, float hy, world_ray_hit_t* out_hits)
+{
+    (void)hx;
+    (void)hy;
+    for (int i = 0; i < count; ++i) {
+        out_hits[i] = (world_ray_hit_t){ .t = 1.0f, .point = { rays[i].x1, rays[i].y1 } };
+    }
+    return 0;
+}
@@ -45,9 +45,11 @@ void test_sys_storage_deposit_moves_plastic_into_tardas(void)
 
     cmp_add_storage(tardas, 2);
     cmp_add_resource(plastic, RESOURCE_TYPE_PLASTIC);
-    ecs_mask[plastic.idx] |= CMP_LIFTABLE;
+    ecs_mask[plastic.idx] = component_mask_or(ecs_mask[plastic.idx], CMP_LIFTABLE);
     cmp_liftable[plastic.idx].state = GRAV_GUN_STATE_FREE;
-    cmp_liftable[plastic.idx].just_dropped = true;
+    ecs_event_register(&game_ev_dropped);
+    ECS_EVENT_EMIT(game_ev_dropped, game_ev_dropped_t, .item = plastic);
+    ecs_event_swap_phase(PHASE_PHYSICS);
 
     ecs_prox_view_t stay = { .trigger_owner = tardas, .matched_entity = plastic };
     ecs_game_stub_set_prox_stay(&stay, 1);
@@ -66,6 +68,43 @@ void test_sys_storage_deposit_moves_plastic_into_tardas(void)
     TEST_ASSERT_TRUE(g_ui_toast_calls > 0);
 }
 
+void test_sys_storage_deposit_stores_item_once_across_overlapping_storages(void)
+{
+    ecs_gen[0] = 1;
+    ecs_gen[1] = 1;
+    ecs_gen[2] = 1;
+    ecs_entity_t first = {0, 1};
+    ecs_entity_t second = {1, 1};
+    ecs_entity_t plastic = {2, 1};
+
+    cmp_add_storage(first, 2);
+    cmp_add_storage(second, 2);
+    cmp_add_resource(plastic, RESOURCE_TYPE_PLASTIC);
+    ecs_mask[plastic.idx] = component_mask_or(ecs_mask[plastic.idx], CMP_LIFTABLE);
+    cmp_liftable[plastic.idx].state = GRAV_GUN_STATE_FREE;
+    ecs_event_register(&game_ev_dropped);
+    ECS_EVENT_EMIT(game_ev_dropped, game_ev_dropped_t, .item = plastic);
+    ECS_EVENT_EMIT(game_ev_dropped, game_ev_dropped_t, .item = plastic);
+    ecs_event_swap_phase(PHASE_PHYSICS);
+
+    ecs_prox_view_t stay[2] = {
+        { .trigger_owner = first, .matched_entity = plastic },
+        { .trigger_owner = second, .matched_entity = plastic },
+    };
+    ecs_game_stub_set_prox_stay(stay, 2);
+
+    game_register_systems();
+    TEST_ASSERT_NOT_NULL(g_ecs_sys_storage);
+    g_ecs_sys_storage(0.0f, NULL);
+
+    int first_counts[RESOURCE_TYPE_COUNT] = {0};
+    int second_counts[RESOURCE_TYPE_COUNT] = {0};
+    int capacity = 0;
+    TEST_ASSERT_TRUE(ecs_storage_get(first, first_counts, &capacity));
+    TEST_ASSERT_TRUE(ecs_storage_get(second, second_counts, &capacity));
+    TEST_ASSERT_EQUAL_INT(1, first_counts[RESOURCE_TYPE_PLASTIC] + second_counts[RESOURCE_TYPE_PLASTIC]);
+}
+
 void test_sys_doors_intent_and_present_updates_state(void)
 {
     world_map_t map = {0};
@@ -73,8 +112,10 @@ void test_sys_doors_intent_and_present_updates_state(void)
     ecs_gen[2] = 1;
     ecs_entity_t door = {2, 1};
     ecs_mask[door.idx] = CMP_DOOR;
-    cmp_door[door.idx].state = DOOR_CLOSED;
-    cmp_door[door.idx].world_handle = 7u;
+    cmp_door_t* d = ecs_sparse_add(&cmp_door_set, door.idx);
+    TEST_ASSERT_NOT_NULL(d);
+    d->state = DOOR_CLOSED;
+    d->world_handle = 7u;
 
     ecs_prox_view_t stay = { .trigger_owner = door, .matched_entity = ecs_null() };
     ecs_game_stub_set_prox_stay(&stay, 1);
@@ -83,15 +124,15 @@ void test_sys_doors_intent_and_present_updates_state(void)
     g_world_door_primary_duration = 100;
     TEST_ASSERT_NOT_NULL(g_ecs_sys_doors_tick);
     g_ecs_sys_doors_tick(0.05f, NULL);
-    TEST_ASSERT_TRUE(cmp_door[door.idx].intent_open);
-    TEST_ASSERT_EQUAL_INT(DOOR_OPENING, cmp_door[door.idx].state);
+    TEST_ASSERT_TRUE(d->intent_open);
+    TEST_ASSERT_EQUAL_INT(DOOR_OPENING, d->state);
     TEST_ASSERT_TRUE(g_world_door_last_forward);
     TEST_ASSERT_TRUE(g_world_door_last_time > 0.0f);
 
     ecs_game_stub_set_prox_stay(NULL, 0);
-    cmp_door[door.idx].state = DOOR_OPEN;
-    cmp_door[door.idx].intent_open = false;
+    d->state = DOOR_OPEN;
+    d->intent_open = false;
     g_ecs_sys_doors_tick(0.05f, NULL);
-    TEST_ASSERT_EQUAL_INT(DOOR_CLOSING, cmp_door[door.idx].state);
+    TEST_ASSERT_EQUAL_INT(DOOR_CLOSING, d->state);
     TEST_ASSERT_FALSE(g_world_door_last_forward);
 }
@@ -102,6 +102,9 @@ int main(int argc, char **argv)
     nob_da_append(&sources, "src/engine/ecs/ecs_engine.c");
     nob_da_append(&sources, "src/engine/ecs/ecs_render_components.c");
     nob_da_append(&sources, "src/engine/ecs/ecs_iterators.c");
+    nob_da_append(&sources, "src/engine/ecs/ecs_query.c");
+    nob_da_append(&sources, "tests/unit/stubs/ecs_core_mask_stubs.c");
+    nob_da_append(&sources, "src/engine/utils/byte_buf.c");
     nob_da_append(&sources, "src/engine/ecs/ecs_physics.c");
     nob_da_append(&sources, "src/engine/ecs/ecs_physics_hooks.c");
     nob_da_append(&sources, "src/engine/ecs/ecs_physics_system.c");
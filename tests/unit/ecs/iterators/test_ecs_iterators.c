@@ -9,14 +9,14 @@
 
 static void reset_ecs_storage(void)
 {
-    memset(ecs_mask, 0, sizeof(ecs_mask));
-    memset(ecs_gen, 0, sizeof(ecs_gen));
-    memset(cmp_pos, 0, sizeof(cmp_pos));
-    memset(cmp_spr, 0, sizeof(cmp_spr));
-    memset(cmp_col, 0, sizeof(cmp_col));
-    memset(cmp_trigger, 0, sizeof(cmp_trigger));
-    memset(cmp_billboard, 0, sizeof(cmp_billboard));
-    memset(cmp_phys_body, 0, sizeof(cmp_phys_body));
+    memset(ecs_mask, 0, sizeof(ecs_mask[0]) * ECS_INITIAL_CAPACITY);
+    memset(ecs_gen, 0, sizeof(ecs_gen[0]) * ECS_INITIAL_CAPACITY);
+    memset(cmp_pos, 0, sizeof(cmp_pos[0]) * ECS_INITIAL_CAPACITY);
+    memset(cmp_spr, 0, sizeof(cmp_spr[0]) * ECS_INITIAL_CAPACITY);
+    memset(cmp_col, 0, sizeof(cmp_col[0]) * ECS_INITIAL_CAPACITY);
+    memset(cmp_trigger, 0, sizeof(cmp_trigger[0]) * ECS_INITIAL_CAPACITY);
+    memset(cmp_billboard, 0, sizeof(cmp_billboard[0]) * ECS_INITIAL_CAPACITY);
+    memset(cmp_phys_body, 0, sizeof(cmp_phys_body[0]) * ECS_INITIAL_CAPACITY);
 }
 
 void setUp(void)
@@ -31,7 +31,7 @@ void tearDown(void)
 void test_ecs_sprites_iterator_returns_sprite_views(void)
 {
     ecs_gen[0] = 1;
-    ecs_mask[0] = CMP_POS | CMP_SPR;
+    ecs_mask[0] = CMP_SET(CMP_POS, CMP_SPR);
     cmp_pos[0] = (cmp_position_t){ 1.0f, 2.0f };
     cmp_spr[0].tex = (tex_handle_t){ 3, 4 };
     cmp_spr[0].src = rectf_xywh(0.0f, 0.0f, 8.0f, 8.0f);
@@ -39,7 +39,7 @@ void test_ecs_sprites_iterator_returns_sprite_views(void)
     cmp_spr[0].oy = 2.0f;
 
     ecs_gen[1] = 1;
-    ecs_mask[1] = CMP_POS | CMP_SPR;
+    ecs_mask[1] = CMP_SET(CMP_POS, CMP_SPR);
     cmp_pos[1] = (cmp_position_t){ 5.0f, 6.0f };
     cmp_spr[1].tex = (tex_handle_t){ 7, 8 };
 
@@ -60,7 +60,7 @@ void test_ecs_sprites_iterator_returns_sprite_views(void)
 void test_ecs_colliders_iterator_reports_phys_state(void)
 {
     ecs_gen[0] = 1;
-    ecs_mask[0] = CMP_POS | CMP_COL | CMP_PHYS_BODY;
+    ecs_mask[0] = CMP_SET(CMP_POS, CMP_COL, CMP_PHYS_BODY);
     cmp_pos[0] = (cmp_position_t){ 2.0f, 3.0f };
     cmp_col[0] = (cmp_collider_t){ 4.0f, 5.0f };
     cmp_phys_body[0].created = true;
@@ -78,7 +78,7 @@ void test_ecs_colliders_iterator_reports_phys_state(void)
 void test_ecs_triggers_iterator_includes_collider_size(void)
 {
     ecs_gen[0] = 1;
-    ecs_mask[0] = CMP_POS | CMP_TRIGGER | CMP_COL;
+    ecs_mask[0] = CMP_SET(CMP_POS, CMP_TRIGGER, CMP_COL);
     cmp_pos[0] = (cmp_position_t){ 1.0f, 1.0f };
     cmp_col[0] = (cmp_collider_t){ 2.0f, 3.0f };
     cmp_trigger[0] = (cmp_trigger_t){ 1.5f, CMP_RESOURCE };
@@ -94,7 +94,7 @@ void test_ecs_triggers_iterator_includes_collider_size(void)
 void test_ecs_billboards_iterator_filters_and_fades(void)
 {
     ecs_gen[0] = 1;
-    ecs_mask[0] = CMP_POS | CMP_BILLBOARD;
+    ecs_mask[0] = CMP_SET(CMP_POS, CMP_BILLBOARD);
     cmp_pos[0] = (cmp_position_t){ 1.0f, 2.0f };
     cmp_billboard[0].state = BILLBOARD_ACTIVE;
     cmp_billboard[0].timer = 1.0f;
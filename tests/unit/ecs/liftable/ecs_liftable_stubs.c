@@ -1,19 +1,34 @@
 #include "game/ecs/ecs_game.h"
+#include <stdlib.h>
 #include "engine/ecs/ecs_proximity.h"
 #include "engine/renderer/renderer.h"
 #include "engine/world/world.h"
 #include "engine/asset/asset.h"
 #include "engine/runtime/toast.h"
 
-ComponentMask   ecs_mask[ECS_MAX_ENTITIES];
-uint32_t        ecs_gen[ECS_MAX_ENTITIES];
-uint32_t        ecs_next_gen[ECS_MAX_ENTITIES];
-cmp_position_t  cmp_pos[ECS_MAX_ENTITIES];
-cmp_velocity_t  cmp_vel[ECS_MAX_ENTITIES];
-cmp_anim_t      cmp_anim[ECS_MAX_ENTITIES];
-cmp_sprite_t    cmp_spr[ECS_MAX_ENTITIES];
-cmp_collider_t  cmp_col[ECS_MAX_ENTITIES];
-cmp_phys_body_t cmp_phys_body[ECS_MAX_ENTITIES];
+static ComponentMask ecs_mask_storage[ECS_INITIAL_CAPACITY];
+ComponentMask*   ecs_mask = ecs_mask_storage;
+static uint32_t ecs_gen_storage[ECS_INITIAL_CAPACITY];
+uint32_t*        ecs_gen = ecs_gen_storage;
+static uint32_t ecs_next_gen_storage[ECS_INITIAL_CAPACITY];
+uint32_t*        ecs_next_gen = ecs_next_gen_storage;
+
+int ecs_capacity(void) { return ECS_INITIAL_CAPACITY; }
+void* ecs_scratch_acquire(size_t elem_size) { return calloc(ECS_INITIAL_CAPACITY, elem_size); }
+void ecs_scratch_release(void* p) { free(p); }
+
+static cmp_position_t cmp_pos_storage[ECS_INITIAL_CAPACITY];
+cmp_position_t*  cmp_pos = cmp_pos_storage;
+static cmp_velocity_t cmp_vel_storage[ECS_INITIAL_CAPACITY];
+cmp_velocity_t*  cmp_vel = cmp_vel_storage;
+static cmp_anim_t cmp_anim_storage[ECS_INITIAL_CAPACITY];
+cmp_anim_t*      cmp_anim = cmp_anim_storage;
+static cmp_sprite_t cmp_spr_storage[ECS_INITIAL_CAPACITY];
+cmp_sprite_t*    cmp_spr = cmp_spr_storage;
+static cmp_collider_t cmp_col_storage[ECS_INITIAL_CAPACITY];
+cmp_collider_t*  cmp_col = cmp_col_storage;
+static cmp_phys_body_t cmp_phys_body_storage[ECS_INITIAL_CAPACITY];
+cmp_phys_body_t* cmp_phys_body = cmp_phys_body_storage;
 
 static ecs_entity_t g_player = {0, 0};
 
@@ -29,7 +44,7 @@ bool ecs_alive_handle(ecs_entity_t e)
 
 int ent_index_checked(ecs_entity_t e)
 {
-    return (e.idx < ECS_MAX_ENTITIES && ecs_gen[e.idx] == e.gen && e.gen != 0) ? (int)e.idx : -1;
+    return (e.idx < ECS_INITIAL_CAPACITY && ecs_gen[e.idx] == e.gen && e.gen != 0) ? (int)e.idx : -1;
 }
 
 ecs_entity_t find_player_handle(void)
@@ -63,7 +78,7 @@ void cmp_add_velocity(ecs_entity_t e, float x, float y, facing_t direction)
         .candidateTime = 0.0f
     };
     cmp_vel[i] = (cmp_velocity_t){ x, y, smoothed_dir };
-    ecs_mask[i] |= CMP_VEL;
+    ecs_mask[i] = component_mask_or(ecs_mask[i], CMP_VEL);
 }
 
 void cmp_add_position(ecs_entity_t e, float x, float y)
@@ -71,7 +86,7 @@ void cmp_add_position(ecs_entity_t e, float x, float y)
     int i = ent_index_checked(e);
     if (i < 0) return;
     cmp_pos[i] = (cmp_position_t){ x, y };
-    ecs_mask[i] |= CMP_POS;
+    ecs_mask[i] = component_mask_or(ecs_mask[i], CMP_POS);
 }
 
 void cmp_add_sprite_handle(ecs_entity_t e, tex_handle_t h, rectf src, float ox, float oy)
@@ -84,7 +99,7 @@ void cmp_add_sprite_handle(ecs_entity_t e, tex_handle_t h, rectf src, float ox,
         .ox = ox,
         .oy = oy
     };
-    ecs_mask[i] |= CMP_SPR;
+    ecs_mask[i] = component_mask_or(ecs_mask[i], CMP_SPR);
 }
 
 bool renderer_screen_to_world(float screen_x, float screen_y, float* out_x, float* out_y)
@@ -156,3 +171,23 @@ void ui_toast(float secs, const char* fmt, ...)
     (void)secs;
     (void)fmt;
 }
+
+bool world_find_clear_spot_px(float* io_cx, float* io_cy, float hx, float hy, float max_dist_px)
+{
+    (void)io_cx;
+    (void)io_cy;
+    (void)hx;
+    (void)hy;
+    (void)max_dist_px;
+    return true;
+}
+
+int world_raycast_batch_px(const world_ray_t* rays, int count, float hx, float hy, world_ray_hit_t* out_hits)
+{
+    (void)hx;
+    (void)hy;
+    for (int i = 0; i < count; ++i) {
+        out_hits[i] = (world_ray_hit_t){ .t = 1.0f, .point = { rays[i].x1, rays[i].y1 } };
+    }
+    return 0;
+}
@@ -12,15 +12,15 @@ void sys_grav_gun_motion_adapt(float dt, const input_t* in);
 
 void setUp(void)
 {
-    memset(ecs_mask, 0, sizeof(ecs_mask));
-    memset(ecs_gen, 0, sizeof(ecs_gen));
-    memset(cmp_pos, 0, sizeof(cmp_pos));
-    memset(cmp_vel, 0, sizeof(cmp_vel));
-    memset(cmp_player, 0, sizeof(cmp_player));
-    memset(cmp_liftable, 0, sizeof(cmp_liftable));
-    memset(cmp_grav_gun, 0, sizeof(cmp_grav_gun));
-    memset(cmp_phys_body, 0, sizeof(cmp_phys_body));
-    memset(cmp_col, 0, sizeof(cmp_col));
+    memset(ecs_mask, 0, sizeof(ecs_mask[0]) * ECS_INITIAL_CAPACITY);
+    memset(ecs_gen, 0, sizeof(ecs_gen[0]) * ECS_INITIAL_CAPACITY);
+    memset(cmp_pos, 0, sizeof(cmp_pos[0]) * ECS_INITIAL_CAPACITY);
+    memset(cmp_vel, 0, sizeof(cmp_vel[0]) * ECS_INITIAL_CAPACITY);
+    memset(cmp_player, 0, sizeof(cmp_player[0]) * ECS_INITIAL_CAPACITY);
+    memset(cmp_liftable, 0, sizeof(cmp_liftable[0]) * ECS_INITIAL_CAPACITY);
+    memset(cmp_grav_gun, 0, sizeof(cmp_grav_gun[0]) * ECS_INITIAL_CAPACITY);
+    memset(cmp_phys_body, 0, sizeof(cmp_phys_body[0]) * ECS_INITIAL_CAPACITY);
+    memset(cmp_col, 0, sizeof(cmp_col[0]) * ECS_INITIAL_CAPACITY);
 }
 
 void tearDown(void)
@@ -30,12 +30,12 @@ void tearDown(void)
 void test_grav_gun_grab_and_release(void)
 {
     ecs_gen[0] = 1;
-    ecs_mask[0] = CMP_POS | CMP_PLAYER | CMP_PHYS_BODY;
+    ecs_mask[0] = CMP_SET(CMP_POS, CMP_PLAYER, CMP_PHYS_BODY);
     cmp_pos[0] = (cmp_position_t){ 0.0f, 0.0f };
     cmp_phys_body[0].category_bits = PHYS_CAT_PLAYER;
 
     ecs_gen[1] = 1;
-    ecs_mask[1] = CMP_POS | CMP_PHYS_BODY | CMP_COL | CMP_LIFTABLE;
+    ecs_mask[1] = CMP_SET(CMP_POS, CMP_PHYS_BODY, CMP_COL, CMP_LIFTABLE);
     cmp_pos[1] = (cmp_position_t){ 10.0f, 0.0f };
     cmp_col[1] = (cmp_collider_t){ 3.0f, 3.0f };
     cmp_phys_body[1].type = PHYS_DYNAMIC;
@@ -76,11 +76,11 @@ void test_grav_gun_grab_and_release(void)
 void test_grav_gun_motion_updates_velocity(void)
 {
     ecs_gen[0] = 1;
-    ecs_mask[0] = CMP_POS | CMP_PLAYER | CMP_PHYS_BODY;
+    ecs_mask[0] = CMP_SET(CMP_POS, CMP_PLAYER, CMP_PHYS_BODY);
     cmp_pos[0] = (cmp_position_t){ 0.0f, 0.0f };
 
     ecs_gen[1] = 1;
-    ecs_mask[1] = CMP_POS | CMP_PHYS_BODY | CMP_LIFTABLE;
+    ecs_mask[1] = CMP_SET(CMP_POS, CMP_PHYS_BODY, CMP_LIFTABLE);
     cmp_pos[1] = (cmp_position_t){ 0.0f, 0.0f };
     cmp_phys_body[1].type = PHYS_DYNAMIC;
     cmp_liftable[1].state = GRAV_GUN_STATE_HELD;
@@ -104,7 +104,7 @@ void test_grav_gun_motion_updates_velocity(void)
     in.mouse.y = 0.0f;
     sys_grav_gun_motion_adapt(1.0f, &in);
 
-    TEST_ASSERT_TRUE((ecs_mask[1] & CMP_VEL) != 0);
+    TEST_ASSERT_TRUE(component_mask_any(ecs_mask[1], CMP_VEL));
     TEST_ASSERT_TRUE(cmp_vel[1].x > 0.0f);
     TEST_ASSERT_EQUAL_INT(GRAV_GUN_STATE_HELD, cmp_liftable[1].state);
 }
@@ -121,9 +121,15 @@ int main(int argc, char **argv)
     nob_da_append(&sources, "src/game/ecs/systems/ecs_unloader.c");
     nob_da_append(&sources, "src/game/ecs/systems/ecs_recycler.c");
     nob_da_append(&sources, "src/engine/ecs/ecs_proximity.c");
+    nob_da_append(&sources, "src/engine/ecs/ecs_query.c");
+    nob_da_append(&sources, "src/engine/ecs/ecs_cmd.c");
+    nob_da_append(&sources, "tests/unit/stubs/ecs_core_mask_stubs.c");
+    nob_da_append(&sources, "src/engine/utils/byte_buf.c");
+    nob_da_append(&sources, "src/engine/ecs/ecs_event.c");
     nob_da_append(&sources, "src/engine/ecs/ecs_billboards.c");
     nob_da_append(&sources, "src/game/ecs/ecs_billboards_filter.c");
     nob_da_append(&sources, "src/game/ecs/systems/ecs_gravity_gun.c");
+    nob_da_append(&sources, "src/engine/spatial/spatial.c");
     nob_da_append(&sources, "src/game/ecs/components/ecs_component_doors.c");
     nob_da_append(&sources, "src/game/ecs/systems/ecs_door_systems.c");
     nob_da_append(&sources, "src/game/ecs/systems/ecs_conveyor.c");
@@ -5,6 +5,7 @@
 #include <string.h>
 
 #include "game/ecs/ecs_game.h"
+#include "engine/world/world_query.h"
 #include "engine/ecs/ecs_render.h"
 #include "engine/core/logger/logger.h"
 #include "engine/prefab/components/pf_components_engine.h"
@@ -12,15 +13,29 @@
 #include "engine/prefab/registry/pf_registry.h"
 #include "engine/tiled/tiled.h"
 
-ComponentMask   ecs_mask[ECS_MAX_ENTITIES];
-uint32_t        ecs_gen[ECS_MAX_ENTITIES];
-uint32_t        ecs_next_gen[ECS_MAX_ENTITIES];
-cmp_position_t  cmp_pos[ECS_MAX_ENTITIES];
-cmp_velocity_t  cmp_vel[ECS_MAX_ENTITIES];
-cmp_anim_t      cmp_anim[ECS_MAX_ENTITIES];
-cmp_sprite_t    cmp_spr[ECS_MAX_ENTITIES];
-cmp_collider_t  cmp_col[ECS_MAX_ENTITIES];
-cmp_phys_body_t cmp_phys_body[ECS_MAX_ENTITIES];
+static ComponentMask ecs_mask_storage[ECS_INITIAL_CAPACITY];
+ComponentMask*   ecs_mask = ecs_mask_storage;
+static uint32_t ecs_gen_storage[ECS_INITIAL_CAPACITY];
+uint32_t*        ecs_gen = ecs_gen_storage;
+static uint32_t ecs_next_gen_storage[ECS_INITIAL_CAPACITY];
+uint32_t*        ecs_next_gen = ecs_next_gen_storage;
+
+int ecs_capacity(void) { return ECS_INITIAL_CAPACITY; }
+void* ecs_scratch_acquire(size_t elem_size) { return calloc(ECS_INITIAL_CAPACITY, elem_size); }
+void ecs_scratch_release(void* p) { free(p); }
+
+static cmp_position_t cmp_pos_storage[ECS_INITIAL_CAPACITY];
+cmp_position_t*  cmp_pos = cmp_pos_storage;
+static cmp_velocity_t cmp_vel_storage[ECS_INITIAL_CAPACITY];
+cmp_velocity_t*  cmp_vel = cmp_vel_storage;
+static cmp_anim_t cmp_anim_storage[ECS_INITIAL_CAPACITY];
+cmp_anim_t*      cmp_anim = cmp_anim_storage;
+static cmp_sprite_t cmp_spr_storage[ECS_INITIAL_CAPACITY];
+cmp_sprite_t*    cmp_spr = cmp_spr_storage;
+static cmp_collider_t cmp_col_storage[ECS_INITIAL_CAPACITY];
+cmp_collider_t*  cmp_col = cmp_col_storage;
+static cmp_phys_body_t cmp_phys_body_storage[ECS_INITIAL_CAPACITY];
+cmp_phys_body_t* cmp_phys_body = cmp_phys_body_storage;
 
 static ecs_entity_t g_player = {0, 0};
 
@@ -35,8 +50,8 @@ int g_log_warn_calls = 0;
 
 void pf_loading_stub_reset(void)
 {
-    memset(ecs_mask, 0, sizeof(ecs_mask));
-    memset(ecs_gen, 0, sizeof(ecs_gen));
+    memset(ecs_mask, 0, sizeof(ecs_mask[0]) * ECS_INITIAL_CAPACITY);
+    memset(ecs_gen, 0, sizeof(ecs_gen[0]) * ECS_INITIAL_CAPACITY);
     g_player = ecs_null();
     g_cmp_add_position_calls = 0;
     g_cmp_add_size_calls = 0;
@@ -61,7 +76,7 @@ ecs_entity_t ecs_create(void)
 
 int ent_index_checked(ecs_entity_t e)
 {
-    return (e.idx < ECS_MAX_ENTITIES && ecs_gen[e.idx] == e.gen && e.gen != 0) ? (int)e.idx : -1;
+    return (e.idx < ECS_INITIAL_CAPACITY && ecs_gen[e.idx] == e.gen && e.gen != 0) ? (int)e.idx : -1;
 }
 
 ecs_entity_t ecs_find_player(void)
@@ -75,7 +90,7 @@ void cmp_add_position(ecs_entity_t e, float x, float y)
     if (idx < 0) return;
     g_cmp_add_position_calls++;
     cmp_pos[idx] = (cmp_position_t){ x, y };
-    ecs_mask[idx] |= CMP_POS;
+    ecs_mask[idx] = component_mask_or(ecs_mask[idx], CMP_POS);
 }
 
 void cmp_add_velocity(ecs_entity_t e, float x, float y, facing_t direction)
@@ -126,21 +141,21 @@ void cmp_add_liftable(ecs_entity_t e)
 {
     int idx = ent_index_checked(e);
     if (idx < 0) return;
-    ecs_mask[idx] |= CMP_LIFTABLE;
+    ecs_mask[idx] = component_mask_or(ecs_mask[idx], CMP_LIFTABLE);
 }
 
 void cmp_add_grav_gun(ecs_entity_t e)
 {
     int idx = ent_index_checked(e);
     if (idx < 0) return;
-    ecs_mask[idx] |= CMP_GRAV_GUN;
+    ecs_mask[idx] = component_mask_or(ecs_mask[idx], CMP_GRAV_GUN);
 }
 
 void cmp_add_gun_charger(ecs_entity_t e)
 {
     int idx = ent_index_checked(e);
     if (idx < 0) return;
-    ecs_mask[idx] |= CMP_GUN_CHARGER;
+    ecs_mask[idx] = component_mask_or(ecs_mask[idx], CMP_GUN_CHARGER);
 }
 
 void cmp_add_trigger(ecs_entity_t e, float pad, ComponentMask target_mask, trigger_match_t match)
@@ -382,3 +397,23 @@ void ecs_register_grav_gun_component_hooks(void) {}
 void ecs_register_liftable_component_hooks(void) {}
 void ecs_anim_reset_allocator(void) {}
 void ecs_anim_shutdown_allocator(void) {}
+
+bool world_find_clear_spot_px(float* io_cx, float* io_cy, float hx, float hy, float max_dist_px)
+{
+    (void)io_cx;
+    (void)io_cy;
+    (void)hx;
+    (void)hy;
+    (void)max_dist_px;
+    return true;
+}
+
+int world_raycast_batch_px(const world_ray_t* rays, int count, float hx, float hy, world_ray_hit_t* out_hits)
+{
+    (void)hx;
+    (void)hy;
+    for (int i = 0; i < count; ++i) {
+        out_hits[i] = (world_ray_hit_t){ .t = 1.0f, .point = { rays[i].x1, rays[i].y1 } };
+    }
+    return 0;
+}
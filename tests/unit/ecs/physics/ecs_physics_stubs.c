@@ -1,16 +1,31 @@
 #include "game/ecs/ecs_game.h"
+#include <stdlib.h>
 
-ComponentMask   ecs_mask[ECS_MAX_ENTITIES];
-uint32_t        ecs_gen[ECS_MAX_ENTITIES];
-uint32_t        ecs_next_gen[ECS_MAX_ENTITIES];
-cmp_trigger_t   cmp_trigger[ECS_MAX_ENTITIES];
-cmp_conveyor_t  cmp_conveyor[ECS_MAX_ENTITIES];
-cmp_conveyor_rider_t cmp_conveyor_rider[ECS_MAX_ENTITIES];
-cmp_billboard_t cmp_billboard[ECS_MAX_ENTITIES];
-cmp_liftable_t  cmp_liftable[ECS_MAX_ENTITIES];
-cmp_grav_gun_t  cmp_grav_gun[ECS_MAX_ENTITIES];
-cmp_gun_charger_t cmp_gun_charger[ECS_MAX_ENTITIES];
-cmp_door_t      cmp_door[ECS_MAX_ENTITIES];
+static ComponentMask ecs_mask_storage[ECS_INITIAL_CAPACITY];
+ComponentMask*   ecs_mask = ecs_mask_storage;
+static uint32_t ecs_gen_storage[ECS_INITIAL_CAPACITY];
+uint32_t*        ecs_gen = ecs_gen_storage;
+static uint32_t ecs_next_gen_storage[ECS_INITIAL_CAPACITY];
+uint32_t*        ecs_next_gen = ecs_next_gen_storage;
+
+int ecs_capacity(void) { return ECS_INITIAL_CAPACITY; }
+void* ecs_scratch_acquire(size_t elem_size) { return calloc(ECS_INITIAL_CAPACITY, elem_size); }
+void ecs_scratch_release(void* p) { free(p); }
+
+static cmp_trigger_t cmp_trigger_storage[ECS_INITIAL_CAPACITY];
+cmp_trigger_t*   cmp_trigger = cmp_trigger_storage;
+static cmp_conveyor_t cmp_conveyor_storage[ECS_INITIAL_CAPACITY];
+cmp_conveyor_t*  cmp_conveyor = cmp_conveyor_storage;
+static cmp_conveyor_rider_t cmp_conveyor_rider_storage[ECS_INITIAL_CAPACITY];
+cmp_conveyor_rider_t* cmp_conveyor_rider = cmp_conveyor_rider_storage;
+static cmp_billboard_t cmp_billboard_storage[ECS_INITIAL_CAPACITY];
+cmp_billboard_t* cmp_billboard = cmp_billboard_storage;
+static cmp_liftable_t cmp_liftable_storage[ECS_INITIAL_CAPACITY];
+cmp_liftable_t*  cmp_liftable = cmp_liftable_storage;
+static cmp_grav_gun_t cmp_grav_gun_storage[ECS_INITIAL_CAPACITY];
+cmp_grav_gun_t*  cmp_grav_gun = cmp_grav_gun_storage;
+ecs_sparse_t     cmp_gun_charger_set;
+ecs_sparse_t     cmp_door_set;
 
 bool ecs_alive_idx(int i)
 {
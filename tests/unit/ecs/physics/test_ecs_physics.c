@@ -7,9 +7,9 @@
 
 void setUp(void)
 {
-    memset(ecs_mask, 0, sizeof(ecs_mask));
-    memset(ecs_gen, 0, sizeof(ecs_gen));
-    memset(cmp_phys_body, 0, sizeof(cmp_phys_body));
+    memset(ecs_mask, 0, sizeof(ecs_mask[0]) * ECS_INITIAL_CAPACITY);
+    memset(ecs_gen, 0, sizeof(ecs_gen[0]) * ECS_INITIAL_CAPACITY);
+    memset(cmp_phys_body, 0, sizeof(cmp_phys_body[0]) * ECS_INITIAL_CAPACITY);
 }
 
 void tearDown(void)
@@ -19,7 +19,7 @@ void tearDown(void)
 void test_ecs_phys_body_create_requires_components(void)
 {
     ecs_gen[0] = 1;
-    ecs_mask[0] = CMP_POS | CMP_COL | CMP_PHYS_BODY;
+    ecs_mask[0] = CMP_SET(CMP_POS, CMP_COL, CMP_PHYS_BODY);
 
     ecs_phys_body_create_for_entity(0);
     TEST_ASSERT_TRUE(cmp_phys_body[0].created);
@@ -1,14 +1,30 @@
 #include "game/ecs/ecs_game.h"
+#include "engine/world/world_query.h"
+#include <stdlib.h>
 
-ComponentMask   ecs_mask[ECS_MAX_ENTITIES];
-uint32_t        ecs_gen[ECS_MAX_ENTITIES];
-uint32_t        ecs_next_gen[ECS_MAX_ENTITIES];
-cmp_position_t  cmp_pos[ECS_MAX_ENTITIES];
-cmp_velocity_t  cmp_vel[ECS_MAX_ENTITIES];
-cmp_anim_t      cmp_anim[ECS_MAX_ENTITIES];
-cmp_sprite_t    cmp_spr[ECS_MAX_ENTITIES];
-cmp_collider_t  cmp_col[ECS_MAX_ENTITIES];
-cmp_phys_body_t cmp_phys_body[ECS_MAX_ENTITIES];
+static ComponentMask ecs_mask_storage[ECS_INITIAL_CAPACITY];
+ComponentMask*   ecs_mask = ecs_mask_storage;
+static uint32_t ecs_gen_storage[ECS_INITIAL_CAPACITY];
+uint32_t*        ecs_gen = ecs_gen_storage;
+static uint32_t ecs_next_gen_storage[ECS_INITIAL_CAPACITY];
+uint32_t*        ecs_next_gen = ecs_next_gen_storage;
+
+int ecs_capacity(void) { return ECS_INITIAL_CAPACITY; }
+void* ecs_scratch_acquire(size_t elem_size) { return calloc(ECS_INITIAL_CAPACITY, elem_size); }
+void ecs_scratch_release(void* p) { free(p); }
+
+static cmp_position_t cmp_pos_storage[ECS_INITIAL_CAPACITY];
+cmp_position_t*  cmp_pos = cmp_pos_storage;
+static cmp_velocity_t cmp_vel_storage[ECS_INITIAL_CAPACITY];
+cmp_velocity_t*  cmp_vel = cmp_vel_storage;
+static cmp_anim_t cmp_anim_storage[ECS_INITIAL_CAPACITY];
+cmp_anim_t*      cmp_anim = cmp_anim_storage;
+static cmp_sprite_t cmp_spr_storage[ECS_INITIAL_CAPACITY];
+cmp_sprite_t*    cmp_spr = cmp_spr_storage;
+static cmp_collider_t cmp_col_storage[ECS_INITIAL_CAPACITY];
+cmp_collider_t*  cmp_col = cmp_col_storage;
+static cmp_phys_body_t cmp_phys_body_storage[ECS_INITIAL_CAPACITY];
+cmp_phys_body_t* cmp_phys_body = cmp_phys_body_storage;
 
 bool ecs_alive_idx(int i)
 {
@@ -17,7 +33,7 @@ bool ecs_alive_idx(int i)
 
 bool ecs_alive_handle(ecs_entity_t e)
 {
-    return (e.idx < ECS_MAX_ENTITIES && ecs_gen[e.idx] == e.gen && e.gen != 0);
+    return (e.idx < ECS_INITIAL_CAPACITY && ecs_gen[e.idx] == e.gen && e.gen != 0);
 }
 
 int ent_index_checked(ecs_entity_t e)
@@ -34,3 +50,23 @@ float clampf(float v, float a, float b)
 {
     return (v < a) ? a : ((v > b) ? b : v);
 }
+
+bool world_find_clear_spot_px(float* io_cx, float* io_cy, float hx, float hy, float max_dist_px)
+{
+    (void)io_cx;
+    (void)io_cy;
+    (void)hx;
+    (void)hy;
+    (void)max_dist_px;
+    return true;
+}
+
+int world_raycast_batch_px(const world_ray_t* rays, int count, float hx, float hy, world_ray_hit_t* out_hits)
+{
+    (void)hx;
+    (void)hy;
+    for (int i = 0; i < count; ++i) {
+        out_hits[i] = (world_ray_hit_t){ .t = 1.0f, .point = { rays[i].x1, rays[i].y1 } };
+    }
+    return 0;
+}
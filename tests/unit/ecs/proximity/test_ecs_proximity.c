@@ -12,13 +12,13 @@ void sys_billboards_adapt(float dt, const input_t* in);
 
 static void reset_storage(void)
 {
-    memset(ecs_mask, 0, sizeof(ecs_mask));
-    memset(ecs_gen, 0, sizeof(ecs_gen));
-    memset(cmp_pos, 0, sizeof(cmp_pos));
-    memset(cmp_col, 0, sizeof(cmp_col));
-    memset(cmp_trigger, 0, sizeof(cmp_trigger));
-    memset(cmp_billboard, 0, sizeof(cmp_billboard));
-    memset(cmp_liftable, 0, sizeof(cmp_liftable));
+    memset(ecs_mask, 0, sizeof(ecs_mask[0]) * ECS_INITIAL_CAPACITY);
+    memset(ecs_gen, 0, sizeof(ecs_gen[0]) * ECS_INITIAL_CAPACITY);
+    memset(cmp_pos, 0, sizeof(cmp_pos[0]) * ECS_INITIAL_CAPACITY);
+    memset(cmp_col, 0, sizeof(cmp_col[0]) * ECS_INITIAL_CAPACITY);
+    memset(cmp_trigger, 0, sizeof(cmp_trigger[0]) * ECS_INITIAL_CAPACITY);
+    memset(cmp_billboard, 0, sizeof(cmp_billboard[0]) * ECS_INITIAL_CAPACITY);
+    memset(cmp_liftable, 0, sizeof(cmp_liftable[0]) * ECS_INITIAL_CAPACITY);
 }
 
 void setUp(void)
@@ -34,7 +34,7 @@ void tearDown(void)
 void test_proximity_enter_stay_exit(void)
 {
     ecs_gen[0] = 1;
-    ecs_mask[0] = CMP_POS | CMP_COL | CMP_TRIGGER | CMP_BILLBOARD;
+    ecs_mask[0] = CMP_SET(CMP_POS, CMP_COL, CMP_TRIGGER, CMP_BILLBOARD);
     cmp_pos[0] = (cmp_position_t){ 0.0f, 0.0f };
     cmp_col[0] = (cmp_collider_t){ 1.0f, 1.0f };
     cmp_trigger[0] = (cmp_trigger_t){ 0.0f, CMP_RESOURCE };
@@ -43,7 +43,7 @@ void test_proximity_enter_stay_exit(void)
     cmp_billboard[0].timer = 0.0f;
 
     ecs_gen[1] = 1;
-    ecs_mask[1] = CMP_POS | CMP_COL | CMP_RESOURCE | CMP_LIFTABLE;
+    ecs_mask[1] = CMP_SET(CMP_POS, CMP_COL, CMP_RESOURCE, CMP_LIFTABLE);
     cmp_pos[1] = (cmp_position_t){ 0.5f, 0.5f };
     cmp_col[1] = (cmp_collider_t){ 1.0f, 1.0f };
     cmp_liftable[1].state = GRAV_GUN_STATE_HELD;
@@ -72,3 +72,127 @@ void test_proximity_enter_stay_exit(void)
     ecs_prox_iter_t exit_it = ecs_prox_exit_begin();
     TEST_ASSERT_TRUE(ecs_prox_exit_next(&exit_it, &v));
 }
+
+void test_proximity_binned_pairs_keep_scan_order(void)
+{
+    // Two triggers far apart, small bodies scattered around them (some just
+    // touching, some just out of reach), and one body big enough to skip the
+    // bins but still reach both triggers.
+    const float trig_x[2] = { 0.0f, 900.0f };
+    for (int i = 0; i < 2; ++i) {
+        ecs_gen[i] = 1;
+        ecs_mask[i] = CMP_SET(CMP_POS, CMP_COL, CMP_TRIGGER);
+        cmp_pos[i] = (cmp_position_t){ trig_x[i], 0.0f };
+        cmp_col[i] = (cmp_collider_t){ 8.0f, 8.0f };
+        cmp_trigger[i] = (cmp_trigger_t){ 4.0f, CMP_RESOURCE };
+    }
+
+    const float body_x[6] = { 900.0f, 17.0f, 400.0f, 918.0f, -18.0f, 919.0f };
+    for (int i = 0; i < 6; ++i) {
+        const int e = 2 + i;
+        ecs_gen[e] = 1;
+        ecs_mask[e] = CMP_SET(CMP_POS, CMP_COL, CMP_RESOURCE);
+        cmp_pos[e] = (cmp_position_t){ body_x[i], 3.0f };
+        cmp_col[e] = (cmp_collider_t){ 6.0f, 6.0f };
+    }
+    ecs_gen[8] = 1;
+    ecs_mask[8] = CMP_SET(CMP_POS, CMP_COL, CMP_RESOURCE);
+    cmp_pos[8] = (cmp_position_t){ 450.0f, 0.0f };
+    cmp_col[8] = (cmp_collider_t){ 460.0f, 10.0f };
+
+    sys_prox_build_adapt(0.0f, NULL);
+
+    // Owner order first, then body order within each owner.
+    const int want_owner[6] = { 0, 0, 0, 1, 1, 1 };
+    const int want_body[6]  = { 3, 6, 8, 2, 5, 8 };
+    ecs_prox_iter_t it = ecs_prox_stay_begin();
+    ecs_prox_view_t v;
+    for (int i = 0; i < 6; ++i) {
+        TEST_ASSERT_TRUE(ecs_prox_stay_next(&it, &v));
+        TEST_ASSERT_EQUAL_UINT32((uint32_t)want_owner[i], v.trigger_owner.idx);
+        TEST_ASSERT_EQUAL_UINT32((uint32_t)want_body[i], v.matched_entity.idx);
+    }
+    TEST_ASSERT_FALSE(ecs_prox_stay_next(&it, &v));
+}
+
+void test_proximity_enter_exit_lists_follow_pair_order(void)
+{
+    ecs_gen[0] = 1;
+    ecs_mask[0] = CMP_SET(CMP_POS, CMP_COL, CMP_TRIGGER);
+    cmp_pos[0] = (cmp_position_t){ 0.0f, 0.0f };
+    cmp_col[0] = (cmp_collider_t){ 16.0f, 16.0f };
+    cmp_trigger[0] = (cmp_trigger_t){ 0.0f, CMP_RESOURCE };
+
+    enum { BODIES = 40 };
+    for (int i = 1; i <= BODIES; ++i) {
+        ecs_gen[i] = 1;
+        ecs_mask[i] = CMP_SET(CMP_POS, CMP_COL, CMP_RESOURCE);
+        cmp_pos[i] = (cmp_position_t){ (float)(i % 8) - 4.0f, (float)(i / 8) - 2.0f };
+        cmp_col[i] = (cmp_collider_t){ 1.0f, 1.0f };
+    }
+
+    sys_prox_build_adapt(0.0f, NULL);
+    int count = 0;
+    const ecs_prox_view_t* enter = ecs_prox_enter_list(&count);
+    TEST_ASSERT_EQUAL_INT(BODIES, count);
+    for (int i = 0; i < count; ++i) TEST_ASSERT_EQUAL_UINT32((uint32_t)(i + 1), enter[i].matched_entity.idx);
+
+    // Odd bodies leave; the rest stay and produce neither enter nor exit.
+    for (int i = 1; i <= BODIES; i += 2) cmp_pos[i].x += 500.0f;
+    sys_prox_build_adapt(0.0f, NULL);
+    ecs_prox_enter_list(&count);
+    TEST_ASSERT_EQUAL_INT(0, count);
+    const ecs_prox_view_t* exit_list = ecs_prox_exit_list(&count);
+    TEST_ASSERT_EQUAL_INT(BODIES / 2, count);
+    for (int i = 0; i < count; ++i) TEST_ASSERT_EQUAL_UINT32((uint32_t)(2 * i + 1), exit_list[i].matched_entity.idx);
+
+    // A dead entity stays in the list but the iterator skips it.
+    ecs_gen[1] = 0;
+    ecs_prox_iter_t it = ecs_prox_exit_begin();
+    ecs_prox_view_t v;
+    TEST_ASSERT_TRUE(ecs_prox_exit_next(&it, &v));
+    TEST_ASSERT_EQUAL_UINT32(3u, v.matched_entity.idx);
+}
+
+void test_proximity_owner_streams_only_visit_their_owners(void)
+{
+    // Billboard trigger, plain trigger, billboard trigger; one shared body.
+    for (int i = 0; i < 3; ++i) {
+        ecs_gen[i] = 1;
+        ecs_mask[i] = (i == 1) ? CMP_SET(CMP_POS, CMP_COL, CMP_TRIGGER)
+                               : CMP_SET(CMP_POS, CMP_COL, CMP_TRIGGER, CMP_BILLBOARD);
+        cmp_pos[i] = (cmp_position_t){ (float)i, 0.0f };
+        cmp_col[i] = (cmp_collider_t){ 4.0f, 4.0f };
+        cmp_trigger[i] = (cmp_trigger_t){ 0.0f, CMP_RESOURCE };
+    }
+    ecs_gen[3] = 1;
+    ecs_mask[3] = CMP_SET(CMP_POS, CMP_COL, CMP_RESOURCE);
+    cmp_pos[3] = (cmp_position_t){ 1.0f, 1.0f };
+    cmp_col[3] = (cmp_collider_t){ 1.0f, 1.0f };
+
+    sys_prox_build_adapt(0.0f, NULL);
+
+    ecs_prox_view_t v;
+    ecs_prox_iter_t it = ecs_prox_enter_begin_for(CMP_BILLBOARD);
+    TEST_ASSERT_TRUE(ecs_prox_enter_next(&it, &v));
+    TEST_ASSERT_EQUAL_UINT32(0u, v.trigger_owner.idx);
+    TEST_ASSERT_TRUE(ecs_prox_enter_next(&it, &v));
+    TEST_ASSERT_EQUAL_UINT32(2u, v.trigger_owner.idx);
+    TEST_ASSERT_FALSE(ecs_prox_enter_next(&it, &v));
+
+    it = ecs_prox_stay_begin_for(CMP_RESOURCE);
+    TEST_ASSERT_FALSE(ecs_prox_stay_next(&it, &v));
+
+    // The body leaves: the billboard stream reports both exits, the full
+    // list all three.
+    cmp_pos[3].x = 200.0f;
+    sys_prox_build_adapt(0.0f, NULL);
+    int seen = 0;
+    it = ecs_prox_exit_begin_for(CMP_BILLBOARD);
+    while (ecs_prox_exit_next(&it, &v)) seen++;
+    TEST_ASSERT_EQUAL_INT(2, seen);
+    seen = 0;
+    it = ecs_prox_exit_begin();
+    while (ecs_prox_exit_next(&it, &v)) seen++;
+    TEST_ASSERT_EQUAL_INT(3, seen);
+}
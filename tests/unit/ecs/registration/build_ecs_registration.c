@@ -112,6 +112,11 @@ int main(int argc, char **argv)
     nob_da_append(&sources, "src/engine/engine/engine_scheduler/engine_register_systems.c");
     nob_da_append(&sources, "src/game/ecs/game_register_systems.c");
     nob_da_append(&sources, "src/engine/ecs/ecs_core.c");
+    nob_da_append(&sources, "src/engine/ecs/ecs_query.c");
+    nob_da_append(&sources, "src/engine/ecs/ecs_change.c");
+    nob_da_append(&sources, "src/engine/utils/byte_buf.c");
+    nob_da_append(&sources, "src/engine/ecs/ecs_event.c");
+    nob_da_append(&sources, "src/engine/ecs/ecs_cmd.c");
     nob_da_append(&sources, "src/game/ecs/ecs_game.c");
     nob_da_append(&sources, "src/game/ecs/components/ecs_component_player.c");
     nob_da_append(&sources, "src/game/ecs/components/ecs_component_conveyor.c");
@@ -129,6 +134,7 @@ int main(int argc, char **argv)
     nob_da_append(&sources, "src/engine/ecs/ecs_billboards.c");
     nob_da_append(&sources, "src/game/ecs/ecs_billboards_filter.c");
     nob_da_append(&sources, "src/game/ecs/systems/ecs_gravity_gun.c");
+    nob_da_append(&sources, "src/engine/spatial/spatial.c");
     nob_da_append(&sources, "src/game/ecs/components/ecs_component_doors.c");
     nob_da_append(&sources, "src/game/ecs/systems/ecs_door_systems.c");
     nob_da_append(&sources, "src/game/ecs/systems/ecs_conveyor.c");
@@ -2,10 +2,12 @@
 
 #include <string.h>
 #include "game/ecs/ecs_game.h"
+#include "engine/world/world_query.h"
 #include "engine/core/logger/logger.h"
 
 ecs_component_hook_fn phys_body_create_hook = NULL;
-cmp_phys_body_t cmp_phys_body[ECS_MAX_ENTITIES];
+static cmp_phys_body_t cmp_phys_body_storage[ECS_INITIAL_CAPACITY];
+cmp_phys_body_t* cmp_phys_body = cmp_phys_body_storage;
 systems_registration_call_t g_systems_registration_calls[32];
 int g_systems_registration_call_count = 0;
 int g_systems_init_seq = 0;
@@ -242,12 +244,24 @@ void sys_camera_tick_adapt(float dt, const input_t* in)
     (void)in;
 }
 
+void sys_compact_adapt(float dt, const input_t* in)
+{
+    (void)dt;
+    (void)in;
+}
+
 void sys_world_apply_edits_adapt(float dt, const input_t* in)
 {
     (void)dt;
     (void)in;
 }
 
+void sys_nav_tick_adapt(float dt, const input_t* in)
+{
+    (void)dt;
+    (void)in;
+}
+
 void sys_asset_collect_adapt(float dt, const input_t* in)
 {
     (void)dt;
@@ -300,3 +314,23 @@ void ecs_door_on_destroy(int idx)
 {
     (void)idx;
 }
+
+bool world_find_clear_spot_px(float* io_cx, float* io_cy, float hx, float hy, float max_dist_px)
+{
+    (void)io_cx;
+    (void)io_cy;
+    (void)hx;
+    (void)hy;
+    (void)max_dist_px;
+    return true;
+}
+
+int world_raycast_batch_px(const world_ray_t* rays, int count, float hx, float hy, world_ray_hit_t* out_hits)
+{
+    (void)hx;
+    (void)hy;
+    for (int i = 0; i < count; ++i) {
+        out_hits[i] = (world_ray_hit_t){ .t = 1.0f, .point = { rays[i].x1, rays[i].y1 } };
+    }
+    return 0;
+}
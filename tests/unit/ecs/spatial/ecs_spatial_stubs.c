@@ -0,0 +1,25 @@
+#include "engine/ecs/ecs_core.h"
+#include "engine/ecs/ecs_engine.h"
+#include <stdlib.h>
+
+static ComponentMask ecs_mask_storage[ECS_INITIAL_CAPACITY];
+ComponentMask*   ecs_mask = ecs_mask_storage;
+static uint32_t ecs_gen_storage[ECS_INITIAL_CAPACITY];
+uint32_t*        ecs_gen = ecs_gen_storage;
+
+static cmp_position_t cmp_pos_storage[ECS_INITIAL_CAPACITY];
+cmp_position_t*  cmp_pos = cmp_pos_storage;
+
+int ecs_capacity(void) { return ECS_INITIAL_CAPACITY; }
+
+bool ecs_alive_idx(int i)
+{
+    return ecs_gen[i] != 0;
+}
+
+void ecs_register_storage(void** slot, size_t elem_size)
+{
+    if (!slot) return;
+    free(*slot);
+    *slot = calloc(ECS_INITIAL_CAPACITY, elem_size);
+}
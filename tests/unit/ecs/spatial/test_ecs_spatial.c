@@ -0,0 +1,115 @@
+#include "unity.h"
+
+#include "engine/ecs/ecs_change.h"
+#include "engine/ecs/ecs_core.h"
+#include "engine/ecs/ecs_engine.h"
+#include "engine/ecs/ecs_query.h"
+#include "engine/spatial/spatial.h"
+
+#include <float.h>
+#include <string.h>
+
+static void spawn(int idx, float x, float y, ComponentMask mask)
+{
+    const ComponentMask old_mask = ecs_mask[idx];
+    ecs_gen[idx] = 1;
+    ecs_mask[idx] = component_mask_or(mask, CMP_POS);
+    cmp_pos[idx] = (cmp_position_t){ x, y };
+    ecs_query_track(idx, false, old_mask, true, ecs_mask[idx]);
+    ecs_mark_changed(idx, ecs_mask[idx]);
+}
+
+static void move_to(int idx, float x, float y)
+{
+    cmp_pos[idx] = (cmp_position_t){ x, y };
+    ecs_mark_changed(idx, CMP_POS);
+}
+
+static void destroy(int idx)
+{
+    ecs_change_on_destroy(idx);
+    ecs_query_track(idx, true, ecs_mask[idx], false, ecs_mask[idx]);
+    ecs_gen[idx] = 0;
+    ecs_mask[idx] = CMP_NONE;
+}
+
+void setUp(void)
+{
+    ecs_query_reset_all();
+    ecs_change_reset_all();
+    memset(ecs_mask, 0, sizeof(ecs_mask[0]) * ECS_INITIAL_CAPACITY);
+    memset(ecs_gen, 0, sizeof(ecs_gen[0]) * ECS_INITIAL_CAPACITY);
+    memset(cmp_pos, 0, sizeof(cmp_pos[0]) * ECS_INITIAL_CAPACITY);
+    ecs_track_changes(ENUM_POS);
+    spatial_reset();
+}
+
+void tearDown(void)
+{
+}
+
+void test_spatial_radius_and_box_return_ascending_indices(void)
+{
+    spawn(5, 10.0f, 10.0f, CMP_COL);
+    spawn(2, 300.0f, 10.0f, CMP_COL);
+    spawn(9, -20.0f, 0.0f, CMP_NONE);
+    spawn(3, 0.0f, 30.0f, CMP_COL);
+
+    int out[8];
+    TEST_ASSERT_EQUAL_INT(3, spatial_query_radius(0.0f, 0.0f, 30.0f, CMP_NONE, out, 8));
+    TEST_ASSERT_EQUAL_INT(3, out[0]);
+    TEST_ASSERT_EQUAL_INT(5, out[1]);
+    TEST_ASSERT_EQUAL_INT(9, out[2]);
+
+    TEST_ASSERT_EQUAL_INT(2, spatial_query_radius(0.0f, 0.0f, 30.0f, CMP_COL, out, 8));
+    TEST_ASSERT_EQUAL_INT(3, out[0]);
+    TEST_ASSERT_EQUAL_INT(5, out[1]);
+
+    // The count covers every match even when `out` is too small.
+    TEST_ASSERT_EQUAL_INT(4, spatial_query_box(-50.0f, -50.0f, 400.0f, 50.0f, CMP_NONE, out, 2));
+    TEST_ASSERT_EQUAL_INT(2, out[0]);
+    TEST_ASSERT_EQUAL_INT(3, out[1]);
+}
+
+void test_spatial_follows_position_writes_and_destroys(void)
+{
+    spawn(1, 0.0f, 0.0f, CMP_NONE);
+    spawn(2, 500.0f, 500.0f, CMP_NONE);
+
+    int out[4];
+    TEST_ASSERT_EQUAL_INT(1, spatial_query_radius(0.0f, 0.0f, 8.0f, CMP_NONE, out, 4));
+
+    ecs_change_advance();
+    move_to(1, 1000.0f, 0.0f);
+    move_to(2, 4.0f, 4.0f);
+    TEST_ASSERT_EQUAL_INT(1, spatial_query_radius(0.0f, 0.0f, 8.0f, CMP_NONE, out, 4));
+    TEST_ASSERT_EQUAL_INT(2, out[0]);
+
+    // Written again in the same version after a query: still picked up.
+    move_to(1, 2.0f, 0.0f);
+    TEST_ASSERT_EQUAL_INT(2, spatial_query_radius(0.0f, 0.0f, 8.0f, CMP_NONE, out, 4));
+
+    ecs_change_advance();
+    destroy(2);
+    TEST_ASSERT_EQUAL_INT(1, spatial_query_radius(0.0f, 0.0f, 8.0f, CMP_NONE, out, 4));
+    TEST_ASSERT_EQUAL_INT(1, out[0]);
+}
+
+void test_spatial_knn_orders_by_distance_then_index(void)
+{
+    spawn(7, 100.0f, 0.0f, CMP_COL);
+    spawn(4, -100.0f, 0.0f, CMP_COL);
+    spawn(6, 10.0f, 0.0f, CMP_NONE);
+    spawn(8, 0.0f, 2000.0f, CMP_COL);
+
+    int out[4];
+    TEST_ASSERT_EQUAL_INT(3, spatial_query_knn(0.0f, 0.0f, 3, FLT_MAX, CMP_COL, out));
+    TEST_ASSERT_EQUAL_INT(4, out[0]);
+    TEST_ASSERT_EQUAL_INT(7, out[1]);
+    TEST_ASSERT_EQUAL_INT(8, out[2]);
+
+    TEST_ASSERT_EQUAL_INT(1, spatial_query_knn(0.0f, 0.0f, 4, 50.0f, CMP_NONE, out));
+    TEST_ASSERT_EQUAL_INT(6, out[0]);
+
+    TEST_ASSERT_EQUAL_INT(0, spatial_query_knn(0.0f, 0.0f, 2, 5.0f, CMP_NONE, out));
+}
@@ -1,33 +1,66 @@
 #include "game/ecs/ecs_game.h"
+#include <stdlib.h>
 #include "engine/ecs/ecs_physics.h"
+#include "engine/ecs/ecs_query.h"
 #include "engine/world/world.h"
+#include "engine/core/jobs/jobs.h"
 
 #include <string.h>
 
-ComponentMask   ecs_mask[ECS_MAX_ENTITIES];
-uint32_t        ecs_gen[ECS_MAX_ENTITIES];
-uint32_t        ecs_next_gen[ECS_MAX_ENTITIES];
+static ComponentMask ecs_mask_storage[ECS_INITIAL_CAPACITY];
+ComponentMask*   ecs_mask = ecs_mask_storage;
+static uint32_t ecs_gen_storage[ECS_INITIAL_CAPACITY];
+uint32_t*        ecs_gen = ecs_gen_storage;
+static uint32_t ecs_next_gen_storage[ECS_INITIAL_CAPACITY];
+uint32_t*        ecs_next_gen = ecs_next_gen_storage;
+
+int ecs_capacity(void) { return ECS_INITIAL_CAPACITY; }
+void* ecs_scratch_acquire(size_t elem_size) { return calloc(ECS_INITIAL_CAPACITY, elem_size); }
+void ecs_scratch_release(void* p) { free(p); }
+
+// Worker count the jobs stub pretends to have. Items are dealt out to the
+// workers round-robin and the last worker's share runs first, so results
+// that depend on how a batch is scheduled differ between counts.
+int g_jobs_stub_workers = 1;
+
+void jobs_parallel_for(int count, int grain, jobs_range_fn fn, void* ctx)
+{
+    (void)grain;
+    if (count <= 0) return;
+    const int workers = g_jobs_stub_workers > 1 ? g_jobs_stub_workers : 1;
+    if (workers == 1) {
+        fn(ctx, 0, count, 0);
+        return;
+    }
+    for (int w = workers - 1; w >= 0; --w) {
+        for (int k = w; k < count; k += workers) fn(ctx, k, k + 1, w);
+    }
+}
 
 bool g_world_has_map = true;
 int g_world_subtile = 0;
 bool g_world_has_los = true;
 bool g_world_walkable = true;
-int g_world_resolve_axis_calls = 0;
+int g_world_sweep_calls = 0;
 int g_world_resolve_mtv_calls = 0;
 int g_phys_create_calls = 0;
 
 void ecs_system_domains_stub_reset(void)
 {
-    memset(ecs_mask, 0, sizeof(ecs_mask));
-    memset(ecs_gen, 0, sizeof(ecs_gen));
-    memset(ecs_next_gen, 0, sizeof(ecs_next_gen));
+    memset(ecs_mask, 0, sizeof(ecs_mask[0]) * ECS_INITIAL_CAPACITY);
+    memset(ecs_gen, 0, sizeof(ecs_gen[0]) * ECS_INITIAL_CAPACITY);
+    memset(ecs_next_gen, 0, sizeof(ecs_next_gen[0]) * ECS_INITIAL_CAPACITY);
+    // Masks are wiped behind the queries' back; drop the cached ones so the
+    // next ecs_query_get refills from whatever the test sets up.
+    ecs_query_reset_all();
     g_world_has_map = true;
     g_world_subtile = 0;
     g_world_has_los = true;
     g_world_walkable = true;
-    g_world_resolve_axis_calls = 0;
+    g_world_sweep_calls = 0;
     g_world_resolve_mtv_calls = 0;
     g_phys_create_calls = 0;
+    g_jobs_stub_workers = 1;
 }
 
 bool ecs_alive_idx(int i)
@@ -37,7 +70,7 @@ bool ecs_alive_idx(int i)
 
 int ent_index_checked(ecs_entity_t e)
 {
-    return (e.idx < ECS_MAX_ENTITIES && ecs_gen[e.idx] == e.gen && e.gen != 0)
+    return (e.idx < ECS_INITIAL_CAPACITY && ecs_gen[e.idx] == e.gen && e.gen != 0)
         ? (int)e.idx : -1;
 }
 
@@ -92,17 +125,30 @@ bool world_has_map(void)
     return g_world_has_map;
 }
 
-bool world_resolve_rect_axis_px(float* cx, float* cy, float hx, float hy, bool resolve_x)
+bool world_sweep_rect_px(float cx, float cy, float hx, float hy, float dx, float dy, float* out_t, gfx_vec2* out_normal)
 {
     (void)cx;
     (void)cy;
     (void)hx;
     (void)hy;
-    (void)resolve_x;
-    g_world_resolve_axis_calls++;
+    (void)dx;
+    (void)dy;
+    if (out_t) *out_t = 1.0f;
+    if (out_normal) *out_normal = (gfx_vec2){ 0.0f, 0.0f };
+    g_world_sweep_calls++;
     return false;
 }
 
+void world_sweep_rects_axis_px(const float* cx, const float* cy, const float* hx, const float* hy,
+                               const float* d, int count, bool axis_x, float* out_t)
+{
+    for (int i = 0; i < count; ++i) {
+        out_t[i] = 1.0f;
+        if (d[i] == 0.0f) continue;
+        world_sweep_rect_px(cx[i], cy[i], hx[i], hy[i], axis_x ? d[i] : 0.0f, axis_x ? 0.0f : d[i], &out_t[i], NULL);
+    }
+}
+
 bool world_resolve_rect_mtv_px(float* cx, float* cy, float hx, float hy)
 {
     (void)cx;
@@ -113,9 +159,56 @@ bool world_resolve_rect_mtv_px(float* cx, float* cy, float hx, float hy)
     return false;
 }
 
+int world_resolve_rects_mtv_px(float* cx, float* cy, const float* hx, const float* hy, int count, bool* out_moved)
+{
+    int moved = 0;
+    for (int i = 0; i < count; ++i) {
+        out_moved[i] = world_resolve_rect_mtv_px(&cx[i], &cy[i], hx[i], hy[i]);
+        if (out_moved[i]) moved++;
+    }
+    return moved;
+}
+
+int world_tile_size(void)
+{
+    return 32;
+}
+
+bool world_size_px(int* out_w, int* out_h)
+{
+    if (out_w) *out_w = 32 * 32;
+    if (out_h) *out_h = 32 * 32;
+    return true;
+}
+
+uint32_t world_collision_revision(void)
+{
+    return 0;
+}
+
 void ecs_phys_body_create_for_entity(int idx)
 {
     g_phys_create_calls++;
-    if (idx < 0 || idx >= ECS_MAX_ENTITIES) return;
+    if (idx < 0 || idx >= ECS_INITIAL_CAPACITY) return;
     cmp_phys_body[idx].created = true;
 }
+
+bool world_find_clear_spot_px(float* io_cx, float* io_cy, float hx, float hy, float max_dist_px)
+{
+    (void)io_cx;
+    (void)io_cy;
+    (void)hx;
+    (void)hy;
+    (void)max_dist_px;
+    return true;
+}
+
+int world_raycast_batch_px(const world_ray_t* rays, int count, float hx, float hy, world_ray_hit_t* out_hits)
+{
+    (void)hx;
+    (void)hy;
+    for (int i = 0; i < count; ++i) {
+        out_hits[i] = (world_ray_hit_t){ .t = 1.0f, .point = { rays[i].x1, rays[i].y1 } };
+    }
+    return 0;
+}
@@ -2,16 +2,22 @@
 
 #include "game/ecs/ecs_game.h"
 #include "engine/ecs/ecs_physics.h"
+#include "engine/ecs/ecs_query.h"
 #include "engine/input/input.h"
 
+#include <math.h>
+#include <string.h>
+
 void sys_input(float dt, const input_t* in);
 void sys_physics_integrate_impl(float dt);
 
 void ecs_system_domains_stub_reset(void);
 extern bool g_world_has_los;
 extern bool g_world_walkable;
-extern int g_world_resolve_axis_calls;
+extern int g_world_sweep_calls;
+extern int g_world_resolve_mtv_calls;
 extern int g_phys_create_calls;
+extern int g_jobs_stub_workers;
 
 void setUp(void)
 {
@@ -25,7 +31,7 @@ void tearDown(void)
 void test_sys_input_updates_velocity_and_facing(void)
 {
     ecs_gen[0] = 1;
-    ecs_mask[0] = CMP_PLAYER | CMP_VEL;
+    ecs_mask[0] = CMP_SET(CMP_PLAYER, CMP_VEL);
     cmp_vel[0].facing = (smoothed_facing_t){
         .rawDir = DIR_SOUTH,
         .facingDir = DIR_SOUTH,
@@ -48,7 +54,7 @@ void test_sys_input_updates_velocity_and_facing(void)
 void test_sys_physics_integrate_applies_velocity_and_clears(void)
 {
     ecs_gen[0] = 1;
-    ecs_mask[0] = CMP_POS | CMP_VEL | CMP_COL | CMP_PHYS_BODY;
+    ecs_mask[0] = CMP_SET(CMP_POS, CMP_VEL, CMP_COL, CMP_PHYS_BODY);
     cmp_pos[0] = (cmp_position_t){ 0.0f, 0.0f };
     cmp_vel[0] = (cmp_velocity_t){ 10.0f, 0.0f, {0} };
     cmp_col[0] = (cmp_collider_t){ 1.0f, 1.0f };
@@ -60,13 +66,55 @@ void test_sys_physics_integrate_applies_velocity_and_clears(void)
     TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.0f, cmp_pos[0].y);
     TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.0f, cmp_vel[0].x);
     TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.0f, cmp_vel[0].y);
-    TEST_ASSERT_EQUAL_INT(1, g_world_resolve_axis_calls);
+    TEST_ASSERT_EQUAL_INT(1, g_world_sweep_calls);
+}
+
+void test_sys_physics_resting_body_sleeps_and_skips_tile_resolution(void)
+{
+    ecs_gen[0] = 1;
+    ecs_mask[0] = CMP_SET(CMP_POS, CMP_COL, CMP_PHYS_BODY);
+    cmp_pos[0] = (cmp_position_t){ 64.0f, 64.0f };
+    cmp_col[0] = (cmp_collider_t){ 4.0f, 4.0f };
+    cmp_phys_body[0] = (cmp_phys_body_t){ .type = PHYS_DYNAMIC, .mass = 1.0f, .inv_mass = 1.0f, .created = true };
+
+    for (int t = 0; t < PHYS_SLEEP_TICKS; ++t) {
+        sys_physics_integrate_impl(1.0f / 60.0f);
+    }
+    TEST_ASSERT_EQUAL_INT(PHYS_SLEEP_TICKS, cmp_phys_body[0].quiet_ticks);
+
+    const int calls = g_world_resolve_mtv_calls;
+    sys_physics_integrate_impl(1.0f / 60.0f);
+    TEST_ASSERT_EQUAL_INT(calls, g_world_resolve_mtv_calls);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 64.0f, cmp_pos[0].x);
+}
+
+void test_sys_physics_body_joining_settled_scene_is_separated(void)
+{
+    ecs_gen[0] = 1;
+    ecs_mask[0] = CMP_SET(CMP_POS, CMP_COL, CMP_PHYS_BODY);
+    cmp_pos[0] = (cmp_position_t){ 64.0f, 64.0f };
+    cmp_col[0] = (cmp_collider_t){ 4.0f, 4.0f };
+    cmp_phys_body[0] = (cmp_phys_body_t){ .type = PHYS_DYNAMIC, .mass = 1.0f, .inv_mass = 1.0f, .created = true };
+    for (int t = 0; t < 3; ++t) {
+        sys_physics_integrate_impl(1.0f / 60.0f);
+    }
+
+    // No change stamps (the stubs record none): only the new body itself
+    // tells the solver to look for its contacts.
+    ecs_gen[1] = 1;
+    cmp_pos[1] = (cmp_position_t){ 66.0f, 64.0f };
+    cmp_col[1] = (cmp_collider_t){ 4.0f, 4.0f };
+    cmp_phys_body[1] = (cmp_phys_body_t){ .type = PHYS_DYNAMIC, .mass = 1.0f, .inv_mass = 1.0f, .created = true };
+    ecs_mask_add(1, CMP_SET(CMP_POS, CMP_COL, CMP_PHYS_BODY));
+    sys_physics_integrate_impl(1.0f / 60.0f);
+
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 8.0f, cmp_pos[1].x - cmp_pos[0].x);
 }
 
 void test_sys_physics_integrate_creates_missing_body(void)
 {
     ecs_gen[0] = 1;
-    ecs_mask[0] = CMP_POS | CMP_COL | CMP_PHYS_BODY;
+    ecs_mask[0] = CMP_SET(CMP_POS, CMP_COL, CMP_PHYS_BODY);
     cmp_pos[0] = (cmp_position_t){ 0.0f, 0.0f };
     cmp_col[0] = (cmp_collider_t){ 1.0f, 1.0f };
     cmp_phys_body[0] = (cmp_phys_body_t){ .type = PHYS_DYNAMIC, .mass = 1.0f, .inv_mass = 1.0f, .created = false };
@@ -76,3 +124,133 @@ void test_sys_physics_integrate_creates_missing_body(void)
     TEST_ASSERT_EQUAL_INT(1, g_phys_create_calls);
     TEST_ASSERT_TRUE(cmp_phys_body[0].created);
 }
+
+#define PILE_BODIES 48
+
+static void add_body(int idx, float x, float y, float h, cmp_phys_body_t body)
+{
+    ecs_gen[idx] = 1;
+    cmp_pos[idx] = (cmp_position_t){ x, y };
+    cmp_col[idx] = (cmp_collider_t){ h, h };
+    cmp_phys_body[idx] = body;
+    ecs_mask_add(idx, CMP_SET(CMP_POS, CMP_COL, CMP_PHYS_BODY));
+}
+
+// Steps a scene whose pairs spread over several colours. `base` keeps each
+// run on fresh indices so the solver's sleep and contact state from an
+// earlier run can't leak in.
+static void run_pile(int workers, int base, cmp_position_t out[PILE_BODIES + 3])
+{
+    ecs_system_domains_stub_reset();
+    g_jobs_stub_workers = workers;
+
+    // A static crate touched by a massive body and a massless one: the
+    // massive pair only reads the crate, the massless pair moves it, and
+    // that move flips the axis the massive body is pushed along.
+    add_body(base + 0, 64.0f, 64.0f, 4.0f, (cmp_phys_body_t){ .type = PHYS_STATIC, .created = true });
+    add_body(base + 1, 70.5f, 57.25f, 4.0f,
+             (cmp_phys_body_t){ .type = PHYS_DYNAMIC, .mass = 1.0f, .inv_mass = 1.0f, .created = true });
+    add_body(base + 2, 64.0f, 71.0f, 4.0f,
+             (cmp_phys_body_t){ .type = PHYS_DYNAMIC, .mass = 0.0f, .inv_mass = 0.0f, .created = true });
+
+    // A crowded heap of mixed masses around a second static crate.
+    uint32_t seed = 7u;
+    for (int k = 0; k < PILE_BODIES; ++k) {
+        seed = seed * 1664525u + 1013904223u;
+        const float x = 200.0f + (float)((seed >> 8) % 48u);
+        const float y = 200.0f + (float)((seed >> 16) % 48u);
+        const float mass = (k % 5 == 0) ? 0.0f : 1.0f + (float)(k % 3);
+        const PhysicsType type = (k % 11 == 0) ? PHYS_STATIC : PHYS_DYNAMIC;
+        add_body(base + 3 + k, x, y, 3.0f + (float)(k % 3),
+                 (cmp_phys_body_t){ .type = type, .mass = mass, .inv_mass = mass > 0.0f ? 1.0f / mass : 0.0f, .created = true });
+    }
+
+    sys_physics_integrate_impl(1.0f / 60.0f);
+    memcpy(out, &cmp_pos[base], (PILE_BODIES + 3) * sizeof(*out));
+}
+
+void test_sys_physics_pair_solve_matches_across_worker_counts(void)
+{
+    cmp_position_t serial[PILE_BODIES + 3];
+    cmp_position_t parallel[PILE_BODIES + 3];
+    run_pile(1, 64, serial);
+    for (int workers = 2; workers <= 4; ++workers) {
+        run_pile(workers, 64 + workers * 64, parallel);
+        for (int i = 0; i < PILE_BODIES + 3; ++i) {
+            TEST_ASSERT_EQUAL_FLOAT(serial[i].x, parallel[i].x);
+            TEST_ASSERT_EQUAL_FLOAT(serial[i].y, parallel[i].y);
+        }
+    }
+}
+
+#define GRID_BODIES 96
+
+// Static bodies only touch, so one step tests every neighbouring pair once
+// and nothing moves; the touching pairs are then exactly what the broadphase
+// found overlapping.
+void test_sys_physics_grid_pairs_match_brute_force(void)
+{
+    const int base = 512;
+    const cmp_phys_body_t wall = { .type = PHYS_STATIC, .created = true };
+    int n = 0;
+
+    // The largest regular body is 12px across, so cells are 13px: pairs
+    // straddling the cell lines, either side and across corners.
+    for (int c = 1; c <= 8; ++c) {
+        const float line = 13.0f * (float)(c * 2);
+        add_body(base + n++, line - 0.5f, 40.0f, 3.0f, wall);
+        add_body(base + n++, line + 4.5f, 40.25f, 2.5f, wall);
+        add_body(base + n++, line - 1.0f, line - 1.0f, 3.0f, wall);
+        add_body(base + n++, line + 1.5f, line + 1.5f, 2.0f, wall);
+    }
+    // Clamped into the edge cells.
+    add_body(base + n++, -2.0f, 5.0f, 4.0f, wall);
+    add_body(base + n++, 3.0f, 1.0f, 4.0f, wall);
+
+    // A crowd of mixed sizes.
+    uint32_t seed = 11u;
+    while (n < GRID_BODIES - 1) {
+        seed = seed * 1664525u + 1013904223u;
+        const float x = 300.0f + (float)((seed >> 8) % 80u) + 0.25f * (float)((seed >> 4) % 4u);
+        const float y = 300.0f + (float)((seed >> 16) % 80u) + 0.25f * (float)((seed >> 2) % 4u);
+        add_body(base + n++, x, y, 2.0f + (float)(n % 5), wall);
+    }
+    // Wider than two tiles, so it spans several cells and sits on the
+    // oversized list.
+    add_body(base + n++, 340.0f, 340.0f, 40.0f, wall);
+    TEST_ASSERT_EQUAL_INT(GRID_BODIES, n);
+
+    sys_physics_integrate_impl(1.0f / 60.0f);
+
+    static bool found[GRID_BODIES][GRID_BODIES];
+    memset(found, 0, sizeof(found));
+    int pa[GRID_BODIES * GRID_BODIES];
+    int pb[GRID_BODIES * GRID_BODIES];
+    const size_t count = ecs_phys_touching_pairs(pa, pb, GRID_BODIES * GRID_BODIES);
+    TEST_ASSERT_TRUE(count <= GRID_BODIES * GRID_BODIES);
+    for (size_t k = 0; k < count; ++k) {
+        const int a = pa[k] - base;
+        const int b = pb[k] - base;
+        TEST_ASSERT_TRUE(a >= 0 && a < b && b < GRID_BODIES);
+        TEST_ASSERT_FALSE(found[a][b]);
+        found[a][b] = true;
+    }
+
+    int expected = 0;
+    int oversized = 0;
+    for (int a = 0; a < GRID_BODIES; ++a) {
+        for (int b = a + 1; b < GRID_BODIES; ++b) {
+            const int ea = base + a;
+            const int eb = base + b;
+            const float px = (cmp_col[ea].hx + cmp_col[eb].hx) - fabsf(cmp_pos[eb].x - cmp_pos[ea].x);
+            const float py = (cmp_col[ea].hy + cmp_col[eb].hy) - fabsf(cmp_pos[eb].y - cmp_pos[ea].y);
+            const bool overlap = px > 0.0f && py > 0.0f;
+            TEST_ASSERT_EQUAL(overlap, found[a][b]);
+            if (overlap) expected++;
+            if (overlap && b == GRID_BODIES - 1) oversized++;
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(expected, (int)count);
+    TEST_ASSERT_TRUE(expected > GRID_BODIES);
+    TEST_ASSERT_TRUE(oversized > 0);
+}
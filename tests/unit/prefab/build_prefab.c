@@ -133,6 +133,8 @@ int main(int argc, char **argv)
     nob_da_append(&sources, "third_party/Unity/src/unity.c");
     nob_da_append(&sources, "src/engine/core/logger/logger.c");
     nob_da_append(&sources, "src/engine/ecs/ecs_core.c");
+    nob_da_append(&sources, "src/engine/utils/byte_buf.c");
+    nob_da_append(&sources, "src/engine/ecs/ecs_event.c");
     nob_da_append(&sources, "src/engine/ecs/ecs_engine.c");
     nob_da_append(&sources, "src/engine/ecs/ecs_render_components.c");
     nob_da_append(&sources, "src/engine/ecs/ecs_iterators.c");
@@ -143,6 +145,7 @@ int main(int argc, char **argv)
     nob_da_append(&sources, "src/engine/ecs/ecs_effects.c");
     nob_da_append(&sources, "src/shared/bump_alloc.c");
     nob_da_append(&sources, "src/engine/tiled/tiled.c");
+    nob_da_append(&sources, "src/engine/tiled/tiled_gid_table.c");
     nob_da_append(&sources, "src/engine/tiled/tiled_layers.c");
     nob_da_append(&sources, "src/engine/tiled/tiled_objects.c");
     nob_da_append(&sources, "src/engine/tiled/tiled_tilesets.c");
@@ -176,6 +179,7 @@ int main(int argc, char **argv)
     nob_da_append(&sources, "src/engine/ecs/ecs_billboards.c");
     nob_da_append(&sources, "src/game/ecs/ecs_billboards_filter.c");
     nob_da_append(&sources, "src/game/ecs/systems/ecs_gravity_gun.c");
+    nob_da_append(&sources, "src/engine/spatial/spatial.c");
     nob_da_append(&sources, "src/game/ecs/components/ecs_component_doors.c");
     nob_da_append(&sources, "src/game/ecs/systems/ecs_door_systems.c");
     nob_da_append(&sources, "src/game/ecs/systems/ecs_conveyor.c");
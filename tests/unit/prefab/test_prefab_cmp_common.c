@@ -28,8 +28,8 @@ void test_prefab_parse_mask_parses_names_and_sets_out_ok(void)
     bool ok = false;
     ComponentMask mask = pf_parse_mask("RESOURCE|COL", &ok);
     TEST_ASSERT_TRUE(ok);
-    TEST_ASSERT_TRUE((mask & CMP_RESOURCE) != 0);
-    TEST_ASSERT_TRUE((mask & CMP_COL) != 0);
+    TEST_ASSERT_TRUE(component_mask_any(mask, CMP_RESOURCE));
+    TEST_ASSERT_TRUE(component_mask_any(mask, CMP_COL));
 }
 
 void test_prefab_parse_mask_accepts_commas_spaces_and_numeric_fallback(void)
@@ -37,13 +37,13 @@ void test_prefab_parse_mask_accepts_commas_spaces_and_numeric_fallback(void)
     bool ok = false;
     ComponentMask mask = pf_parse_mask(" RESOURCE , COL ", &ok);
     TEST_ASSERT_TRUE(ok);
-    TEST_ASSERT_TRUE((mask & CMP_RESOURCE) != 0);
-    TEST_ASSERT_TRUE((mask & CMP_COL) != 0);
+    TEST_ASSERT_TRUE(component_mask_any(mask, CMP_RESOURCE));
+    TEST_ASSERT_TRUE(component_mask_any(mask, CMP_COL));
 
     ok = false;
     mask = pf_parse_mask("0x3", &ok);
     TEST_ASSERT_TRUE(ok);
-    TEST_ASSERT_EQUAL_UINT64(0x3u, mask);
+    TEST_ASSERT_EQUAL_UINT64(0x3u, mask.w[0]);
 }
 
 void test_prefab_parse_mask_invalid_sets_out_ok_false(void)
@@ -51,5 +51,5 @@ void test_prefab_parse_mask_invalid_sets_out_ok_false(void)
     bool ok = true;
     ComponentMask mask = pf_parse_mask("NOT_A_COMPONENT", &ok);
     TEST_ASSERT_FALSE(ok);
-    TEST_ASSERT_EQUAL_UINT64(0u, mask);
+    TEST_ASSERT_TRUE(component_mask_empty(mask));
 }
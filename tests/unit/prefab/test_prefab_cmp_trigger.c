@@ -52,6 +52,6 @@ void test_prefab_cmp_trigger_build_uses_object_proximity_radius_when_pad_missing
     pf_component_trigger_t out = {0};
     TEST_ASSERT_TRUE(pf_component_trigger_build(&comp, &ovr, &out));
     TEST_ASSERT_EQUAL_FLOAT(12.5f, out.pad);
-    TEST_ASSERT_TRUE((out.target_mask & CMP_RESOURCE) != 0);
-    TEST_ASSERT_TRUE((out.target_mask & CMP_COL) != 0);
+    TEST_ASSERT_TRUE(component_mask_any(out.target_mask, CMP_RESOURCE));
+    TEST_ASSERT_TRUE(component_mask_any(out.target_mask, CMP_COL));
 }
@@ -0,0 +1,126 @@
+// Mask/sparse-set/change-tracking/snapshot/remap stand-ins for suites that stub out ecs_core.c.
+// Storage is sized to ECS_INITIAL_CAPACITY, matching the stubbed arrays.
+#include "engine/ecs/ecs_core.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static ecs_sparse_t* g_stub_sparse_sets[ENUM_COMPONENT_COUNT];
+
+void ecs_register_sparse(ecs_sparse_t* set, ComponentEnum comp, size_t elem_size)
+{
+    if (!set || comp < 0 || comp >= ENUM_COMPONENT_COUNT || elem_size == 0) return;
+    free(set->slot_of);
+    free(set->owners);
+    free(set->data);
+    *set = (ecs_sparse_t){ .comp = comp, .elem_size = elem_size };
+    set->slot_of = calloc(ECS_INITIAL_CAPACITY, sizeof(*set->slot_of));
+    set->owners = calloc(ECS_INITIAL_CAPACITY, sizeof(*set->owners));
+    set->data = calloc(ECS_INITIAL_CAPACITY, elem_size);
+    set->cap = ECS_INITIAL_CAPACITY;
+    g_stub_sparse_sets[comp] = set;
+}
+
+void* ecs_sparse_get(const ecs_sparse_t* set, int idx)
+{
+    if (!set || !set->slot_of || idx < 0 || idx >= ECS_INITIAL_CAPACITY) return NULL;
+    int slot = set->slot_of[idx] - 1;
+    return (slot >= 0) ? (char*)set->data + set->elem_size * (size_t)slot : NULL;
+}
+
+void* ecs_sparse_add(ecs_sparse_t* set, int idx)
+{
+    void* existing = ecs_sparse_get(set, idx);
+    if (existing) return existing;
+    if (!set || !set->slot_of || idx < 0 || idx >= ECS_INITIAL_CAPACITY) return NULL;
+    int slot = set->count++;
+    set->owners[slot] = idx;
+    set->slot_of[idx] = slot + 1;
+    void* p = (char*)set->data + set->elem_size * (size_t)slot;
+    memset(p, 0, set->elem_size);
+    return p;
+}
+
+void ecs_sparse_remove(ecs_sparse_t* set, int idx)
+{
+    if (!set || !set->slot_of || idx < 0 || idx >= ECS_INITIAL_CAPACITY) return;
+    int slot = set->slot_of[idx] - 1;
+    if (slot < 0) return;
+    int last = --set->count;
+    if (slot != last) {
+        memcpy((char*)set->data + set->elem_size * (size_t)slot,
+               (char*)set->data + set->elem_size * (size_t)last, set->elem_size);
+        set->owners[slot] = set->owners[last];
+        set->slot_of[set->owners[slot]] = slot + 1;
+    }
+    set->slot_of[idx] = 0;
+}
+
+void ecs_mask_add(int idx, ComponentMask bits)
+{
+    ComponentMask old_mask = ecs_mask[idx];
+    ecs_mask[idx] = component_mask_or(old_mask, bits);
+    bool alive = ecs_alive_idx(idx);
+    ecs_query_track(idx, alive, old_mask, alive, ecs_mask[idx]);
+}
+
+void ecs_mask_remove(int idx, ComponentMask bits)
+{
+    ComponentMask old_mask = ecs_mask[idx];
+    ecs_mask[idx] = component_mask_andnot(old_mask, bits);
+    bool alive = ecs_alive_idx(idx);
+    ecs_query_track(idx, alive, old_mask, alive, ecs_mask[idx]);
+    ComponentMask dropped = component_mask_and(old_mask, bits);
+    for (int comp; (comp = component_mask_pop_lowest(&dropped)) >= 0;) {
+        if (g_stub_sparse_sets[comp]) {
+            ecs_sparse_remove(g_stub_sparse_sets[comp], idx);
+        }
+    }
+}
+
+void ecs_track_changes(ComponentEnum comp)
+{
+    (void)comp;
+}
+
+bool ecs_change_tracked(ComponentEnum comp)
+{
+    (void)comp;
+    return false;
+}
+
+void ecs_mark_changed(int idx, ComponentMask bits)
+{
+    (void)idx; (void)bits;
+}
+
+ecs_version_t ecs_change_version(void)
+{
+    return 1;
+}
+
+ecs_changed_iter_t ecs_changed_begin(ComponentEnum comp, ecs_version_t since)
+{
+    return (ecs_changed_iter_t){ .comp = comp, .since = since };
+}
+
+bool ecs_changed_next(ecs_changed_iter_t* it, int* out_idx)
+{
+    (void)it; (void)out_idx;
+    return false;
+}
+
+void ecs_register_component_snapshot_hooks(ComponentEnum comp, ecs_snapshot_hooks_t hooks)
+{
+    (void)comp; (void)hooks;
+}
+
+ecs_entity_t ecs_remap_handle(ecs_entity_t e)
+{
+    return e;
+}
+
+void ecs_register_component_remap_hook(ComponentEnum comp, ecs_component_hook_fn fn)
+{
+    (void)comp; (void)fn;
+}
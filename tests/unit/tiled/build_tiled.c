@@ -92,6 +92,7 @@ int main(int argc, char **argv)
     nob_da_append(&sources, "src/engine/core/logger/logger.c");
     nob_da_append(&sources, "src/shared/bump_alloc.c");
     nob_da_append(&sources, "src/engine/tiled/tiled.c");
+    nob_da_append(&sources, "src/engine/tiled/tiled_gid_table.c");
     nob_da_append(&sources, "src/engine/tiled/tiled_layers.c");
     nob_da_append(&sources, "src/engine/tiled/tiled_objects.c");
     nob_da_append(&sources, "src/engine/tiled/tiled_tilesets.c");
@@ -127,6 +127,104 @@ void test_tiled_load_map_external_tsx_properties_and_animation(void)
     tiled_free_map(&map);
 }
 
+void test_tiled_load_map_builds_gid_table(void)
+{
+    char dir[128], tmx[160], tsx[160], png[160];
+    setup_tiled_fixture_paths(dir, sizeof(dir), tmx, sizeof(tmx), tsx, sizeof(tsx), png, sizeof(png));
+
+    write_text_file(png, "not a real png, just needs to exist");
+
+    const char *tsx_text =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        "<tileset name=\"test\" tilewidth=\"32\" tileheight=\"32\" tilecount=\"4\" columns=\"2\">\n"
+        "  <image source=\"tiles.png\" width=\"64\" height=\"64\"/>\n"
+        "  <tile id=\"3\">\n"
+        "    <properties>\n"
+        "      <property name=\"collider\" value=\"[1100],[1000],[0000],[0000]\"/>\n"
+        "      <property name=\"renderstyle\" value=\"painters\"/>\n"
+        "      <property name=\"painteroffset\" value=\"5\"/>\n"
+        "    </properties>\n"
+        "  </tile>\n"
+        "</tileset>\n";
+    write_text_file(tsx, tsx_text);
+
+    const char *tmx_text =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        "<map width=\"2\" height=\"1\" tilewidth=\"32\" tileheight=\"32\">\n"
+        "  <tileset firstgid=\"3\" source=\"tiles.tsx\"/>\n"
+        "  <layer name=\"walls\" width=\"2\" height=\"1\">\n"
+        "    <data>6,0</data>\n"
+        "  </layer>\n"
+        "</map>\n";
+    write_text_file(tmx, tmx_text);
+
+    world_map_t map = {0};
+    TEST_ASSERT_TRUE(tiled_load_map(tmx, &map));
+    TEST_ASSERT_NOT_NULL(map.gid_info);
+    TEST_ASSERT_EQUAL_UINT32(7, (uint32_t)map.gid_info_count);
+
+    TEST_ASSERT_NULL(tiled_gid_lookup(&map, 0, NULL));
+    TEST_ASSERT_NULL(tiled_gid_lookup(&map, 2, NULL));
+    TEST_ASSERT_NULL(tiled_gid_lookup(&map, 7, NULL));
+
+    const tiled_gid_info_t *info = tiled_gid_lookup(&map, 6, NULL);
+    TEST_ASSERT_NOT_NULL(info);
+    TEST_ASSERT_EQUAL_INT(0, info->tileset);
+    TEST_ASSERT_EQUAL_INT(3, info->local);
+    TEST_ASSERT_TRUE(info->painter);
+    TEST_ASSERT_EQUAL_INT(5, info->painter_offset);
+    TEST_ASSERT_EQUAL_INT(32, (int)info->src_x);
+    TEST_ASSERT_EQUAL_INT(32, (int)info->src_y);
+
+    // Flip variants of the collider are precomputed per flip combination.
+    TEST_ASSERT_EQUAL_HEX16(0x0013, info->colliders[0]);
+    TEST_ASSERT_EQUAL_HEX16(0x008C, info->colliders[tiled_gid_flip_index(6u | TILED_FLIPPED_HORIZONTALLY_FLAG)]);
+    TEST_ASSERT_EQUAL_HEX16(0x3100, info->colliders[tiled_gid_flip_index(6u | TILED_FLIPPED_VERTICALLY_FLAG)]);
+    TEST_ASSERT_EQUAL_HEX16(0xC800, info->colliders[TILED_GID_FLIP_H | TILED_GID_FLIP_V]);
+
+    // Maps without a table decode the same entry on demand.
+    tiled_gid_info_t *table = map.gid_info;
+    size_t table_count = map.gid_info_count;
+    map.gid_info = NULL;
+    map.gid_info_count = 0;
+    tiled_gid_info_t scratch;
+    const tiled_gid_info_t *slow = tiled_gid_lookup(&map, 6, &scratch);
+    TEST_ASSERT_TRUE(slow == &scratch);
+    TEST_ASSERT_EQUAL_INT(info->local, slow->local);
+    TEST_ASSERT_EQUAL_INT(info->painter_offset, slow->painter_offset);
+    TEST_ASSERT_EQUAL_HEX16(info->colliders[TILED_GID_FLIP_V], slow->colliders[TILED_GID_FLIP_V]);
+    map.gid_info = table;
+    map.gid_info_count = table_count;
+
+    tiled_free_map(&map);
+    TEST_ASSERT_NULL(map.gid_info);
+}
+
+void test_tiled_gid_table_keeps_first_tileset_on_overlap(void)
+{
+    tiled_tileset_t tilesets[2] = {
+        { .first_gid = 1, .tilecount = 4, .columns = 2, .tilewidth = 16, .tileheight = 16 },
+        { .first_gid = 3, .tilecount = 4, .columns = 2, .tilewidth = 16, .tileheight = 16 },
+    };
+    world_map_t map = { .tilesets = tilesets, .tileset_count = 2 };
+    const int want_tileset[] = { -1, 0, 0, 0, 0, 1, 1 };
+    const int want_local[]   = { -1, 0, 1, 2, 3, 2, 3 };
+
+    // Decoded on demand first, then through the table.
+    tiled_gid_info_t scratch;
+    for (int pass = 0; pass < 2; ++pass) {
+        if (pass == 1) TEST_ASSERT_TRUE(tiled_gid_table_build(&map));
+        for (uint32_t gid = 1; gid < 7; ++gid) {
+            const tiled_gid_info_t *info = tiled_gid_lookup(&map, gid, &scratch);
+            TEST_ASSERT_NOT_NULL(info);
+            TEST_ASSERT_EQUAL_INT(want_tileset[gid], info->tileset);
+            TEST_ASSERT_EQUAL_INT(want_local[gid], info->local);
+        }
+        TEST_ASSERT_NULL(tiled_gid_lookup(&map, 7, &scratch));
+    }
+    tiled_gid_table_free(&map);
+}
+
 void test_tiled_load_map_accepts_bom_and_xml_pi(void)
 {
     char dir[128], tmx[160], tsx[160], png[160];
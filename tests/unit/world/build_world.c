@@ -71,6 +71,7 @@ int main(int argc, char **argv)
     nob_da_append(&test_sources, "tests/unit/world/test_world_collision_slide.c");
     nob_da_append(&test_sources, "tests/unit/world/test_world_collision_decode.c");
     nob_da_append(&test_sources, "tests/unit/world/test_world_collision_grid.c");
+    nob_da_append(&test_sources, "tests/unit/world/test_world_nav.c");
 
     const char *runner_path = "build/tests/gen/tests_world_runner.c";
     if (!generate_unity_runner("world", &test_sources, runner_path)) return 1;
@@ -95,6 +96,7 @@ int main(int argc, char **argv)
     nob_da_append(&sources, "src/engine/core/logger/logger.c");
     nob_da_append(&sources, "src/shared/bump_alloc.c");
     nob_da_append(&sources, "src/engine/tiled/tiled.c");
+    nob_da_append(&sources, "src/engine/tiled/tiled_gid_table.c");
     nob_da_append(&sources, "src/engine/tiled/tiled_layers.c");
     nob_da_append(&sources, "src/engine/tiled/tiled_objects.c");
     nob_da_append(&sources, "src/engine/tiled/tiled_tilesets.c");
@@ -103,11 +105,14 @@ int main(int argc, char **argv)
     nob_da_append(&sources, "src/engine/world/world_collision.c");
     nob_da_append(&sources, "src/engine/world/world_door.c");
     nob_da_append(&sources, "src/engine/world/world_map.c");
+    nob_da_append(&sources, "src/engine/nav/nav.c");
+    nob_da_append(&sources, "src/engine/utils/byte_buf.c");
     nob_da_append(&sources, "tests/unit/stubs/test_log_sink.c");
     nob_da_append(&sources, "tests/unit/world/test_world_map_edits.c");
     nob_da_append(&sources, "tests/unit/world/test_world_collision_slide.c");
     nob_da_append(&sources, "tests/unit/world/test_world_collision_decode.c");
     nob_da_append(&sources, "tests/unit/world/test_world_collision_grid.c");
+    nob_da_append(&sources, "tests/unit/world/test_world_nav.c");
     nob_da_append(&sources, runner_path);
 
     Nob_File_Paths objs = {0};
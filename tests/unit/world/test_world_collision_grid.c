@@ -113,6 +113,109 @@ void test_world_collision_refresh_tile_updates_mask_and_dynamic(void)
     free(layer.gids);
 }
 
+void test_world_collision_rect_queries_span_row_words(void)
+{
+    // One solid subtile per tile: local (3,1) and local (0,2).
+    uint16_t colliders[3] = {0, (uint16_t)(1u << 7), (uint16_t)(1u << 8)};
+    tiled_tileset_t tilesets[1] = {0};
+    tilesets[0].first_gid = 1;
+    tilesets[0].tilecount = 3;
+    tilesets[0].colliders = colliders;
+
+    // 17 tiles = 68 subtiles, so each subtile row takes two 64-bit words.
+    tiled_layer_t layer = {0};
+    layer.name = "walls";
+    layer.width = 17;
+    layer.height = 2;
+    layer.collision = true;
+    layer.gids = (uint32_t*)calloc(17 * 2, sizeof(uint32_t));
+    TEST_ASSERT_NOT_NULL(layer.gids);
+    layer.gids[1 * 17 + 15] = 2u; // subtile (63, 5), last bit of word 0
+    layer.gids[0 * 17 + 16] = 3u; // subtile (64, 2), first bit of word 1
+
+    tiled_layer_t layers[1] = { layer };
+    world_map_t map = make_min_map(17, 2, tilesets, 1, layers, 1);
+    TEST_ASSERT_TRUE(world_collision_build_from_map(&map, "walls"));
+
+    TEST_ASSERT_FALSE(world_is_walkable_subtile(63, 5));
+    TEST_ASSERT_TRUE(world_is_walkable_subtile(64, 5));
+    TEST_ASSERT_FALSE(world_is_walkable_subtile(64, 2));
+    TEST_ASSERT_FALSE(world_is_walkable_subtile(68, 2)); // off the map
+
+    // Rects over subtiles 60..67 of one row.
+    TEST_ASSERT_FALSE(world_is_walkable_rect_px(512.0f, 20.0f, 30.0f, 2.0f));
+    TEST_ASSERT_TRUE(world_is_walkable_rect_px(512.0f, 28.0f, 30.0f, 2.0f));
+    TEST_ASSERT_FALSE(world_is_walkable_rect_px(512.0f, 44.0f, 30.0f, 2.0f));
+    TEST_ASSERT_TRUE(world_is_walkable_rect_px(516.0f, 44.0f, 2.0f, 2.0f));
+    // Partly off the map counts as blocked.
+    TEST_ASSERT_FALSE(world_is_walkable_rect_px(4.0f, 28.0f, 8.0f, 2.0f));
+
+    // A rect overlapping the word-1 subtile is pushed out of it.
+    float cx = 515.0f;
+    float cy = 20.0f;
+    TEST_ASSERT_TRUE(world_resolve_rect_mtv_px(&cx, &cy, 2.0f, 2.0f));
+    TEST_ASSERT_TRUE(world_is_walkable_rect_px(cx, cy, 2.0f, 2.0f));
+
+    layer.gids[0 * 17 + 16] = 1u;
+    world_collision_refresh_tile(&map, 16, 0);
+    TEST_ASSERT_TRUE(world_is_walkable_rect_px(512.0f, 20.0f, 30.0f, 2.0f));
+    TEST_ASSERT_FALSE(world_is_walkable_rect_px(512.0f, 44.0f, 30.0f, 2.0f));
+
+    world_collision_shutdown();
+    free(layer.gids);
+}
+
+void test_world_collision_clearance_tracks_runtime_edits(void)
+{
+    const uint16_t FULL = (uint16_t)((1u << 16) - 1u);
+
+    uint16_t colliders[2] = {0, FULL};
+    tiled_tileset_t tilesets[1] = {0};
+    tilesets[0].first_gid = 1;
+    tilesets[0].tilecount = 2;
+    tilesets[0].colliders = colliders;
+
+    tiled_layer_t layer = {0};
+    layer.name = "walls";
+    layer.width = 12;
+    layer.height = 12;
+    layer.collision = true;
+    layer.gids = (uint32_t*)calloc(12 * 12, sizeof(uint32_t));
+    TEST_ASSERT_NOT_NULL(layer.gids);
+    for (int i = 0; i < 12 * 12; ++i) layer.gids[i] = 1u;
+
+    tiled_layer_t layers[1] = { layer };
+    world_map_t map = make_min_map(12, 12, tilesets, 1, layers, 1);
+    TEST_ASSERT_TRUE(world_collision_build_from_map(&map, "walls"));
+
+    // Only the map edge limits an empty map.
+    TEST_ASSERT_EQUAL_INT(0, world_clearance_subtiles(-1, 5));
+    TEST_ASSERT_EQUAL_INT(1, world_clearance_subtiles(0, 5));
+    TEST_ASSERT_EQUAL_INT(4, world_clearance_subtiles(20, 3));
+
+    // A solid tile at (6, 6) covers subtiles 24..27 on both axes.
+    layer.gids[6 * 12 + 6] = 2u;
+    world_collision_refresh_tile(&map, 6, 6);
+    TEST_ASSERT_EQUAL_INT(0, world_clearance_subtiles(25, 25));
+    TEST_ASSERT_EQUAL_INT(1, world_clearance_subtiles(28, 27));
+    TEST_ASSERT_EQUAL_INT(3, world_clearance_subtiles(21, 30));
+
+    // A rect inside the wall moves to the nearest spot it fits.
+    float cx = 6.0f * 32.0f + 2.0f;
+    float cy = 6.0f * 32.0f + 16.0f;
+    TEST_ASSERT_FALSE(world_is_walkable_rect_px(cx, cy, 3.0f, 3.0f));
+    TEST_ASSERT_TRUE(world_find_clear_spot_px(&cx, &cy, 3.0f, 3.0f, 32.0f));
+    TEST_ASSERT_TRUE(world_is_walkable_rect_px(cx, cy, 3.0f, 3.0f));
+    TEST_ASSERT_TRUE(cx < 6.0f * 32.0f);
+
+    layer.gids[6 * 12 + 6] = 1u;
+    world_collision_refresh_tile(&map, 6, 6);
+    TEST_ASSERT_EQUAL_INT(16, world_clearance_subtiles(25, 25)); // capped
+
+    world_collision_shutdown();
+    free(layer.gids);
+}
+
 void test_world_collision_line_of_sight_blocked_by_solid(void)
 {
     const uint16_t FULL = (uint16_t)((1u << 16) - 1u);
@@ -192,6 +295,68 @@ void test_world_collision_line_of_sight_clear_returns_true(void)
     free(layer.gids);
 }
 
+void test_world_collision_raycast_reports_hit_point_and_normal(void)
+{
+    const uint16_t FULL = (uint16_t)((1u << 16) - 1u);
+
+    uint16_t colliders[2] = {0, FULL};
+    tiled_tileset_t tilesets[1] = {0};
+    tilesets[0].first_gid = 1;
+    tilesets[0].tilecount = 2;
+    tilesets[0].colliders = colliders;
+
+    tiled_layer_t layer = {0};
+    layer.name = "walls";
+    layer.width = 4;
+    layer.height = 4;
+    layer.collision = true;
+    layer.gids = (uint32_t*)calloc(4 * 4, sizeof(uint32_t));
+    TEST_ASSERT_NOT_NULL(layer.gids);
+    for (int i = 0; i < 4 * 4; ++i) layer.gids[i] = 1u;
+    layer.gids[1 * 4 + 2] = 2u; // solid (2, 1)
+    layer.gids[2 * 4 + 1] = 2u; // solid (1, 2)
+
+    tiled_layer_t layers[1] = { layer };
+    world_map_t map = make_min_map(4, 4, tilesets, 1, layers, 1);
+    TEST_ASSERT_TRUE(world_collision_build_from_map(&map, "walls"));
+
+    // Point ray into the left face of tile (2, 1).
+    world_ray_hit_t hit;
+    TEST_ASSERT_TRUE(world_raycast_px(16.0f, 48.0f, 100.0f, 48.0f, 0.0f, 0.0f, &hit));
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 64.0f, hit.point.x);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 48.0f, hit.point.y);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, -1.0f, hit.normal.x);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 0.0f, hit.normal.y);
+
+    // A ray through the exact corner between two diagonal solids is blocked.
+    TEST_ASSERT_TRUE(world_raycast_px(48.0f, 48.0f, 80.0f, 80.0f, 0.0f, 0.0f, &hit));
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 0.5f, hit.t);
+    TEST_ASSERT_FALSE(world_has_line_of_sight(48.0f, 48.0f, 80.0f, 80.0f, -1.0f, 0.0f, 0.0f));
+
+    // A box stops when its leading edge reaches the wall, and at the map edge.
+    TEST_ASSERT_TRUE(world_raycast_px(16.0f, 48.0f, 100.0f, 48.0f, 4.0f, 4.0f, &hit));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 60.0f, hit.point.x);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, -1.0f, hit.normal.x);
+    TEST_ASSERT_TRUE(world_raycast_px(16.0f, 16.0f, 16.0f, 200.0f, 4.0f, 4.0f, &hit));
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 124.0f, hit.point.y);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, -1.0f, hit.normal.y);
+
+    world_ray_t rays[3] = {
+        { 16.0f, 48.0f, 100.0f, 48.0f },
+        { 16.0f, 16.0f, 112.0f, 16.0f },
+        { 48.0f, 48.0f, 80.0f, 80.0f },
+    };
+    world_ray_hit_t hits[3];
+    TEST_ASSERT_EQUAL_INT(2, world_raycast_batch_px(rays, 3, 0.0f, 0.0f, hits));
+    TEST_ASSERT_TRUE(hits[0].hit);
+    TEST_ASSERT_FALSE(hits[1].hit);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 1.0f, hits[1].t);
+    TEST_ASSERT_TRUE(hits[2].hit);
+
+    world_collision_shutdown();
+    free(layer.gids);
+}
+
 void test_world_collision_decode_raw_gid_fails_without_matching_tileset(void)
 {
     uint16_t colliders[1] = {0};
@@ -155,3 +155,103 @@ void test_world_resolve_rect_mtv_px_resolves_ceiling_without_lateral_shove(void)
     world_collision_shutdown();
     free(layer.gids);
 }
+
+void test_world_sweep_rect_px_stops_fast_rect_at_thin_wall(void)
+{
+    const uint16_t LEFT_COLUMN = 0x1111u; // one subtile wide, full height
+
+    uint16_t colliders[2] = {0, LEFT_COLUMN};
+    bool no_merge[2] = {false, false};
+    tiled_tileset_t tilesets[1] = {0};
+    tilesets[0].first_gid = 1;
+    tilesets[0].tilecount = 2;
+    tilesets[0].colliders = colliders;
+    tilesets[0].no_merge_collider = no_merge;
+
+    tiled_layer_t layer = {0};
+    layer.name = "walls";
+    layer.width = 3;
+    layer.height = 1;
+    layer.collision = true;
+    layer.z_order = 0;
+    layer.gids = (uint32_t*)calloc(3, sizeof(uint32_t));
+    TEST_ASSERT_NOT_NULL(layer.gids);
+    layer.gids[0] = 1u;
+    layer.gids[1] = 2u; // wall at x in [32, 40)
+    layer.gids[2] = 1u;
+
+    tiled_layer_t layers[1] = { layer };
+    world_map_t map = make_min_map(3, 1, tilesets, 1, layers, 1);
+    TEST_ASSERT_TRUE_MESSAGE(world_collision_build_from_map(&map, "walls"), "world_collision_build_from_map failed");
+
+    // A 64 px step would land well past the wall; the push-out resolvers
+    // would never see the overlap.
+    const float cx = 16.0f, cy = 16.0f, hx = 4.0f, hy = 4.0f, dx = 64.0f;
+    float t = 0.0f;
+    gfx_vec2 n = {0};
+    TEST_ASSERT_TRUE(world_sweep_rect_px(cx, cy, hx, hy, dx, 0.0f, &t, &n));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 32.0f - hx, cx + dx * t);
+    TEST_ASSERT_TRUE(cx + dx * t + hx <= 32.0f);
+    TEST_ASSERT_EQUAL_FLOAT(-1.0f, n.x);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, n.y);
+
+    // Moving parallel to the wall, or out of a subtile it already overlaps,
+    // is not a hit.
+    TEST_ASSERT_FALSE(world_sweep_rect_px(28.0f - 0.5f, cy, hx, hy, 0.0f, 8.0f, &t, &n));
+    TEST_ASSERT_FALSE(world_sweep_rect_px(38.0f, cy, hx, hy, 8.0f, 0.0f, &t, &n));
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, t);
+
+    world_collision_shutdown();
+    free(layer.gids);
+}
+
+void test_world_batched_rect_queries_match_single_rect_calls(void)
+{
+    const uint16_t LEFT_COLUMN = 0x1111u; // one subtile wide, full height
+
+    uint16_t colliders[2] = {0, LEFT_COLUMN};
+    tiled_tileset_t tilesets[1] = {0};
+    tilesets[0].first_gid = 1;
+    tilesets[0].tilecount = 2;
+    tilesets[0].colliders = colliders;
+
+    tiled_layer_t layer = {0};
+    layer.name = "walls";
+    layer.width = 8;
+    layer.height = 8;
+    layer.collision = true;
+    layer.gids = (uint32_t*)calloc(8 * 8, sizeof(uint32_t));
+    TEST_ASSERT_NOT_NULL(layer.gids);
+    for (int i = 0; i < 8 * 8; ++i) layer.gids[i] = 1u;
+    layer.gids[3 * 8 + 4] = 2u; // wall at x in [128, 136), y in [96, 128)
+
+    tiled_layer_t layers[1] = { layer };
+    world_map_t map = make_min_map(8, 8, tilesets, 1, layers, 1);
+    TEST_ASSERT_TRUE(world_collision_build_from_map(&map, "walls"));
+
+    // Open floor, a rect sweeping into the wall, one overlapping it, and a
+    // still one.
+    float cx[4] = { 64.0f, 112.0f, 130.0f, 200.0f };
+    float cy[4] = { 64.0f, 112.0f, 112.0f, 200.0f };
+    const float hx[4] = { 4.0f, 4.0f, 4.0f, 4.0f };
+    const float hy[4] = { 4.0f, 4.0f, 4.0f, 4.0f };
+    const float dx[4] = { 16.0f, 32.0f, 0.0f, 0.0f };
+    float t[4];
+    world_sweep_rects_axis_px(cx, cy, hx, hy, dx, 4, true, t);
+    for (int i = 0; i < 4; ++i) {
+        float single = 0.0f;
+        world_sweep_rect_px(cx[i], cy[i], hx[i], hy[i], dx[i], 0.0f, &single, NULL);
+        TEST_ASSERT_EQUAL_FLOAT(single, t[i]);
+    }
+    TEST_ASSERT_TRUE(t[1] < 1.0f);
+
+    bool moved[4];
+    TEST_ASSERT_EQUAL_INT(1, world_resolve_rects_mtv_px(cx, cy, hx, hy, 4, moved));
+    TEST_ASSERT_FALSE(moved[0]);
+    TEST_ASSERT_TRUE(moved[2]);
+    TEST_ASSERT_TRUE(world_is_walkable_rect_px(cx[2], cy[2], hx[2], hy[2]));
+    TEST_ASSERT_EQUAL_FLOAT(64.0f, cx[0]);
+
+    world_collision_shutdown();
+    free(layer.gids);
+}
@@ -198,6 +198,51 @@ void test_world_apply_tile_edits_refreshes_collision_only_for_collision_layers(v
     world_shutdown();
 }
 
+void test_world_collision_change_log_lists_edits_since_a_revision(void)
+{
+    ensure_clean_world();
+
+    const char* full = "[1111],[1111],[1111],[1111]";
+    TEST_ASSERT_TRUE(write_world_testdata(false, 1u, 0u, false, full));
+    TEST_ASSERT_TRUE(world_load_from_tmx("build/testdata/world_map/map.tmx", NULL));
+
+    const uint32_t loaded = world_collision_revision();
+    const world_collision_change_t* changes = NULL;
+    size_t count = 0;
+    TEST_ASSERT_TRUE(world_collision_changes_since(loaded, &changes, &count));
+    TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)count);
+    // Nothing before the load is on record.
+    TEST_ASSERT_FALSE(world_collision_changes_since(loaded - 1u, &changes, &count));
+
+    TEST_ASSERT_TRUE(world_set_tile_gid(0, 0, 0, 0u));
+    world_apply_tile_edits();
+    const uint32_t opened = world_collision_revision();
+    TEST_ASSERT_TRUE(opened != loaded);
+    TEST_ASSERT_TRUE(world_collision_changes_since(loaded, &changes, &count));
+    TEST_ASSERT_EQUAL_UINT32(1u, (uint32_t)count);
+    TEST_ASSERT_EQUAL_UINT32(opened, changes[0].revision);
+    TEST_ASSERT_EQUAL_INT(0, changes[0].tx);
+    TEST_ASSERT_EQUAL_INT(0, changes[0].ty);
+    TEST_ASSERT_TRUE(world_collision_changes_since(opened, &changes, &count));
+    TEST_ASSERT_EQUAL_UINT32(0u, (uint32_t)count);
+
+    // Writing the same gid back changes nothing and logs nothing.
+    TEST_ASSERT_TRUE(world_set_tile_gid(0, 0, 0, 0u));
+    world_apply_tile_edits();
+    TEST_ASSERT_EQUAL_UINT32(opened, world_collision_revision());
+
+    // Enough toggles overflow the log; recent revisions stay covered.
+    for (int i = 0; i < 5000; ++i) {
+        TEST_ASSERT_TRUE(world_set_tile_gid(0, 0, 0, (i & 1) ? 0u : 1u));
+        world_apply_tile_edits();
+    }
+    TEST_ASSERT_FALSE(world_collision_changes_since(opened, &changes, &count));
+    TEST_ASSERT_TRUE(world_collision_changes_since(world_collision_revision() - 2u, &changes, &count));
+    TEST_ASSERT_EQUAL_UINT32(2u, (uint32_t)count);
+
+    world_shutdown();
+}
+
 void test_world_apply_tile_edits_is_safe_when_unloaded(void)
 {
     ensure_clean_world();
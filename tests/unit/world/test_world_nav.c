@@ -0,0 +1,202 @@
+#include "unity.h"
+
+#include "engine/nav/nav.h"
+#include "engine/world/world.h"
+#include "engine/world/world_query.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+
+#define NAV_MAP_W 8
+#define NAV_MAP_H 8
+#define NAV_WALL_X 4
+
+static bool ensure_dir(const char* path)
+{
+    if (mkdir(path, 0755) == 0) return true;
+    return errno == EEXIST;
+}
+
+static bool write_text_file(const char* path, const char* contents)
+{
+    FILE* f = fopen(path, "w");
+    if (!f) return false;
+    fputs(contents, f);
+    fclose(f);
+    return true;
+}
+
+// 8x8 tiles with a solid column at NAV_WALL_X, open only in the bottom row.
+static void load_walled_map(void)
+{
+    char tsx[512];
+    snprintf(tsx, sizeof(tsx),
+        "<tileset name=\"test\" tilewidth=\"%d\" tileheight=\"%d\" tilecount=\"1\" columns=\"1\">"
+        "<image source=\"tiles.png\" width=\"%d\" height=\"%d\"/>"
+        "<tile id=\"0\"><properties>"
+        "<property name=\"collider\" value=\"[1111],[1111],[1111],[1111]\"/>"
+        "</properties></tile>"
+        "</tileset>",
+        world_tile_size(), world_tile_size(), world_tile_size(), world_tile_size());
+
+    char data[NAV_MAP_W * NAV_MAP_H * 2 + 1];
+    int n = 0;
+    for (int ty = 0; ty < NAV_MAP_H; ++ty) {
+        for (int tx = 0; tx < NAV_MAP_W; ++tx) {
+            const bool wall = tx == NAV_WALL_X && ty != NAV_MAP_H - 1;
+            data[n++] = wall ? '1' : '0';
+            data[n++] = (ty == NAV_MAP_H - 1 && tx == NAV_MAP_W - 1) ? '\0' : ',';
+        }
+    }
+
+    char tmx[1024];
+    snprintf(tmx, sizeof(tmx),
+        "<map width=\"%d\" height=\"%d\" tilewidth=\"%d\" tileheight=\"%d\">"
+        "<tileset firstgid=\"1\" source=\"tiles.tsx\"/>"
+        "<layer name=\"L0\" width=\"%d\" height=\"%d\">"
+        "<properties><property name=\"collision\" value=\"true\"/></properties>"
+        "<data encoding=\"csv\">%s</data></layer>"
+        "</map>",
+        NAV_MAP_W, NAV_MAP_H, world_tile_size(), world_tile_size(), NAV_MAP_W, NAV_MAP_H, data);
+
+    TEST_ASSERT_TRUE(ensure_dir("build"));
+    TEST_ASSERT_TRUE(ensure_dir("build/testdata"));
+    TEST_ASSERT_TRUE(ensure_dir("build/testdata/world_nav"));
+    TEST_ASSERT_TRUE(write_text_file("build/testdata/world_nav/tiles.tsx", tsx));
+    TEST_ASSERT_TRUE(write_text_file("build/testdata/world_nav/map.tmx", tmx));
+    TEST_ASSERT_TRUE(world_load_from_tmx("build/testdata/world_nav/map.tmx", NULL));
+}
+
+static float tile_centre(int t)
+{
+    return ((float)t + 0.5f) * (float)world_tile_size();
+}
+
+static int sign_of(int v)
+{
+    return (v > 0) - (v < 0);
+}
+
+// Every leg must be a straight or diagonal run through walkable subtiles
+// that never cuts a solid corner.
+static void assert_path_walkable(float sx, float sy, const gfx_vec2* pts, int count)
+{
+    const float sub = (float)world_subtile_size();
+    int x = (int)(sx / sub), y = (int)(sy / sub);
+    for (int i = 0; i < count; ++i) {
+        const int nx = (int)(pts[i].x / sub), ny = (int)(pts[i].y / sub);
+        const int dx = sign_of(nx - x), dy = sign_of(ny - y);
+        TEST_ASSERT_TRUE(dx == 0 || dy == 0 || abs(nx - x) == abs(ny - y));
+        while (x != nx || y != ny) {
+            if (dx && dy) {
+                TEST_ASSERT_TRUE(world_is_walkable_subtile(x + dx, y));
+                TEST_ASSERT_TRUE(world_is_walkable_subtile(x, y + dy));
+            }
+            x += dx;
+            y += dy;
+            TEST_ASSERT_TRUE(world_is_walkable_subtile(x, y));
+        }
+    }
+}
+
+static bool path_uses_bottom_row(const gfx_vec2* pts, int count)
+{
+    for (int i = 0; i < count; ++i) {
+        if (pts[i].y >= (float)((NAV_MAP_H - 1) * world_tile_size())) return true;
+    }
+    return false;
+}
+
+void test_nav_routes_through_the_only_gap_in_a_wall(void)
+{
+    world_shutdown();
+    load_walled_map();
+
+    gfx_vec2 pts[64];
+    const float sx = tile_centre(1), sy = tile_centre(1);
+    const float gx = tile_centre(6), gy = tile_centre(1);
+    const int count = nav_find_path_px(sx, sy, gx, gy, pts, 64);
+    TEST_ASSERT_TRUE(count > 0);
+    TEST_ASSERT_TRUE(count <= 64);
+    TEST_ASSERT_EQUAL_FLOAT(gx, pts[count - 1].x);
+    TEST_ASSERT_EQUAL_FLOAT(gy, pts[count - 1].y);
+    assert_path_walkable(sx, sy, pts, count);
+    TEST_ASSERT_TRUE(path_uses_bottom_row(pts, count));
+
+    // A goal inside the wall has no path.
+    TEST_ASSERT_EQUAL_INT(-1, nav_find_path_px(sx, sy, tile_centre(NAV_WALL_X), tile_centre(1), pts, 64));
+
+    nav_shutdown();
+    world_shutdown();
+}
+
+void test_nav_follows_runtime_tile_edits(void)
+{
+    world_shutdown();
+    load_walled_map();
+
+    gfx_vec2 pts[64];
+    const float sx = tile_centre(1), sy = tile_centre(1);
+    const float gx = tile_centre(6), gy = tile_centre(1);
+    int count = nav_find_path_px(sx, sy, gx, gy, pts, 64);
+    TEST_ASSERT_TRUE(path_uses_bottom_row(pts, count));
+
+    // Opening the wall next to the start takes the short way through.
+    TEST_ASSERT_TRUE(world_set_tile_gid(0, NAV_WALL_X, 1, 0u));
+    world_apply_tile_edits();
+    count = nav_find_path_px(sx, sy, gx, gy, pts, 64);
+    TEST_ASSERT_TRUE(count > 0);
+    TEST_ASSERT_FALSE(path_uses_bottom_row(pts, count));
+    assert_path_walkable(sx, sy, pts, count);
+
+    // Sealing both openings cuts the map in two.
+    TEST_ASSERT_TRUE(world_set_tile_gid(0, NAV_WALL_X, 1, 1u));
+    TEST_ASSERT_TRUE(world_set_tile_gid(0, NAV_WALL_X, NAV_MAP_H - 1, 1u));
+    world_apply_tile_edits();
+    TEST_ASSERT_EQUAL_INT(-1, nav_find_path_px(sx, sy, gx, gy, pts, 64));
+
+    TEST_ASSERT_TRUE(world_set_tile_gid(0, NAV_WALL_X, NAV_MAP_H - 1, 0u));
+    world_apply_tile_edits();
+    count = nav_find_path_px(sx, sy, gx, gy, pts, 64);
+    TEST_ASSERT_TRUE(count > 0);
+    TEST_ASSERT_TRUE(path_uses_bottom_row(pts, count));
+    assert_path_walkable(sx, sy, pts, count);
+
+    nav_shutdown();
+    world_shutdown();
+}
+
+void test_nav_queue_serves_requests_on_tick(void)
+{
+    world_shutdown();
+    load_walled_map();
+
+    const nav_path_id_t ok = nav_request_path(tile_centre(1), tile_centre(1), tile_centre(6), tile_centre(6));
+    const nav_path_id_t blocked = nav_request_path(tile_centre(1), tile_centre(1), tile_centre(NAV_WALL_X), tile_centre(0));
+    TEST_ASSERT_EQUAL_INT(NAV_PATH_PENDING, nav_path_status(ok));
+    TEST_ASSERT_EQUAL_INT(NAV_PATH_PENDING, nav_path_status(blocked));
+
+    nav_tick();
+    TEST_ASSERT_EQUAL_INT(NAV_PATH_READY, nav_path_status(ok));
+    TEST_ASSERT_EQUAL_INT(NAV_PATH_FAILED, nav_path_status(blocked));
+    TEST_ASSERT_EQUAL_INT(0, nav_path_points(blocked, NULL, 0));
+
+    gfx_vec2 pts[64];
+    const int count = nav_path_points(ok, pts, 64);
+    TEST_ASSERT_TRUE(count > 0);
+    TEST_ASSERT_EQUAL_FLOAT(tile_centre(6), pts[count - 1].x);
+    assert_path_walkable(tile_centre(1), tile_centre(1), pts, count);
+
+    // Released ids go stale even when their slot is reused.
+    nav_path_release(ok);
+    nav_path_release(blocked);
+    TEST_ASSERT_EQUAL_INT(NAV_PATH_INVALID, nav_path_status(ok));
+    const nav_path_id_t again = nav_request_path(tile_centre(1), tile_centre(1), tile_centre(2), tile_centre(1));
+    TEST_ASSERT_EQUAL_INT(NAV_PATH_INVALID, nav_path_status(ok));
+    TEST_ASSERT_EQUAL_INT(NAV_PATH_PENDING, nav_path_status(again));
+
+    nav_shutdown();
+    world_shutdown();
+}